@@ -211,6 +211,12 @@ AgentInterface::raft_commit_t Agent::waitFor(index_t index, double timeout) {
 //  AgentCallback reports id of follower and its highest processed index
 void Agent::reportIn(std::string const& peerId, index_t index, size_t toLog) {
 
+  // Transactions newly applied to the read db, for the supervision. They
+  // are copied, because compaction may drop the log entries once _ioLock
+  // is released
+  Builder committed;
+  committed.openArray();
+
   {
     // Enforce _lastCommitIndex, _readDB and compaction to progress atomically
     MUTEX_LOCKER(ioLocker, _ioLock);
@@ -241,10 +247,13 @@ void Agent::reportIn(std::string const& peerId, index_t index, size_t toLog) {
           << "Critical mass for commiting " << _lastCommitIndex + 1
           << " through " << index << " to read db";
 
-        _readDB.apply(
-          _state.slices(
-            _lastCommitIndex + 1, index), _lastCommitIndex, _constituent.term());
-        
+        auto slices = _state.slices(_lastCommitIndex + 1, index);
+        _readDB.apply(slices, _lastCommitIndex, _constituent.term());
+
+        for (auto const& slice : slices) {
+          committed.add(slice);
+        }
+
         _lastCommitIndex   = index;
         _lastAppliedIndex  = index;
 
@@ -259,6 +268,17 @@ void Agent::reportIn(std::string const& peerId, index_t index, size_t toLog) {
     }
   } // MUTEX_LOCKER
 
+  committed.close();
+
+  // Supervision reacts to changes to the read db, not under _ioLock
+  if (!committed.slice().isEmptyArray()) {
+    std::vector<VPackSlice> transactions;
+    for (auto const& transaction : VPackArrayIterator(committed.slice())) {
+      transactions.push_back(transaction);
+    }
+    _supervision.notify(transactions);
+  }
+
   { // Wake up rest handler
     CONDITION_LOCKER(guard, _waitForCV);
     guard.broadcast();
@@ -480,6 +500,7 @@ query_t Agent::activate(query_t const& everything) {
         _readDB.apply(batch, lastCommitIndex, _constituent.term());
         _spearhead = _readDB;
       }
+      _supervision.readStoreReplaced();
 
       //_state.persistReadDB(everything->slice().get("compact").get("_key"));
       //_state.log((everything->slice().get("logs"));
@@ -1193,6 +1214,9 @@ void Agent::notify(query_t const& message) {
 // Rebuild key value stores
 arangodb::consensus::index_t Agent::rebuildDBs() {
 
+  // The supervision's snapshot is taken from the rebuilt read db
+  TRI_DEFER(_supervision.readStoreReplaced());
+
   MUTEX_LOCKER(ioLocker, _ioLock);
   MUTEX_LOCKER(liLocker, _liLock);
 
@@ -1266,6 +1290,9 @@ Store const& Agent::transient() const { return _transient; }
 
 /// Rebuild from persisted state
 Agent& Agent::operator=(VPackSlice const& compaction) {
+  // The supervision's snapshot is taken from the new read db
+  TRI_DEFER(_supervision.readStoreReplaced());
+
   // Catch up with compacted state
   MUTEX_LOCKER(ioLocker, _ioLock);
   _spearhead = compaction.get("readDB");
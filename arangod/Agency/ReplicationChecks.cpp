@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ReplicationChecks.h"
+
+#include "Basics/MutexLocker.h"
+#include "Basics/StringUtils.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::consensus;
+
+static std::string const planColPrefix = "/Plan/Collections/";
+
+constexpr double ReplicationChecks::fullCheckInterval;
+
+ReplicationChecks::ReplicationChecks()
+  : _snapshotOutdated(true),
+    _allCollectionsChanged(false),
+    _checkAllCollections(true) {}
+
+// Called by agent, after its read store has applied the transactions
+bool ReplicationChecks::record(
+  std::string const& agencyPrefix,
+  std::vector<VPackSlice> const& transactions) {
+
+  auto splitPath = [](std::string const& key) {
+    std::vector<std::string> path;
+    for (auto& part : basics::StringUtils::split(key, '/', '\0')) {
+      if (!part.empty()) {
+        path.emplace_back(std::move(part));
+      }
+    }
+    return path;
+  };
+
+  std::vector<std::string> const prefix = splitPath(agencyPrefix);
+  bool relevant = false;
+
+  MUTEX_LOCKER(locker, _changesLock);
+
+  for (auto const& transaction : transactions) {
+    if (!transaction.isObject()) {
+      continue;
+    }
+    for (auto const& operation : VPackObjectIterator(transaction)) {
+      std::vector<std::string> path = splitPath(operation.key.copyString());
+      if (path.size() < prefix.size() ||
+          !std::equal(prefix.begin(), prefix.end(), path.begin())) {
+        continue;
+      }
+      path.erase(path.begin(), path.begin() + prefix.size());
+
+      _snapshotOutdated = true;
+
+      if (path.empty() || (path.size() == 1 && path[0] == "Plan")) {
+        _allCollectionsChanged = true;
+        relevant = true;
+      } else if (path.size() == 1) {  // e.g. Shutdown
+        relevant = true;
+      } else if (path[0] == "Plan" && path[1] == "Collections") {
+        if (path.size() < 4) {  // database created or dropped
+          _allCollectionsChanged = true;
+        } else {
+          _changedCollections.emplace(path[2] + "/" + path[3]);
+        }
+        relevant = true;
+      } else if ((path[0] == "Plan" && path[1] == "DBServers") ||
+                 (path[0] == "Target" && path[1] == "ToDo")) {
+        relevant = true;
+      }
+    }
+  }
+
+  return relevant;
+
+}
+
+// Called by agent
+void ReplicationChecks::recordAll() {
+  MUTEX_LOCKER(locker, _changesLock);
+  _snapshotOutdated = true;
+  _allCollectionsChanged = true;
+}
+
+// Called by the supervision thread
+bool ReplicationChecks::collect() {
+  MUTEX_LOCKER(locker, _changesLock);
+
+  bool outdated = _snapshotOutdated;
+  if (_allCollectionsChanged) {
+    _checkAllCollections = true;
+  } else {
+    _collectionsToCheck.insert(
+      _changedCollections.begin(), _changedCollections.end());
+  }
+
+  _snapshotOutdated = false;
+  _allCollectionsChanged = false;
+  _changedCollections.clear();
+
+  return outdated;
+}
+
+std::vector<std::string> ReplicationChecks::due(
+  Node const& snapshot, TimePoint now) {
+
+  if (std::chrono::duration<double>(now - _lastFullCheck).count() >
+      fullCheckInterval) {
+    _checkAllCollections = true;
+  }
+
+  if (_checkAllCollections) {
+    _collectionsToCheck.clear();
+    if (snapshot.has(planColPrefix)) {
+      for (auto const& db : snapshot(planColPrefix).children()) {
+        for (auto const& col : db.second->children()) {
+          _collectionsToCheck.emplace(db.first + "/" + col.first);
+        }
+      }
+    }
+    _checkAllCollections = false;
+    _lastFullCheck = now;
+  }
+
+  // mop: satellites => distribute to every server, which depends on health
+  _collectionsToCheck.insert(_satellites.begin(), _satellites.end());
+
+  std::vector<std::string> names(
+    _collectionsToCheck.begin(), _collectionsToCheck.end());
+  std::sort(names.begin(), names.end());
+  _collectionsToCheck.clear();
+
+  return names;
+}
+
+void ReplicationChecks::checked(
+  std::string const& name, bool satellite, bool inLine) {
+  if (satellite) {
+    _satellites.emplace(name);
+  } else {
+    _satellites.erase(name);
+  }
+  if (!inLine) {
+    _collectionsToCheck.emplace(name);
+  }
+}
@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_CONSENSUS_REPLICATION_CHECKS_H
+#define ARANGOD_CONSENSUS_REPLICATION_CHECKS_H 1
+
+#include "Agency/Node.h"
+#include "Basics/Mutex.h"
+
+#include <chrono>
+#include <unordered_set>
+
+namespace arangodb {
+namespace consensus {
+
+/// @brief Keeps track of the collections whose replication the supervision
+/// has to check. The agent records the changes of committed transactions,
+/// the supervision thread takes them over at the beginning of each round.
+/// Collections are named "<database>/<collection>"
+class ReplicationChecks {
+ public:
+  typedef std::chrono::system_clock::time_point TimePoint;
+
+  /// @brief All collections are checked this often, in seconds, regardless
+  /// of the recorded changes
+  static constexpr double fullCheckInterval = 60.0;
+
+  ReplicationChecks();
+
+  /// @brief Record the operations of transactions committed to the agent's
+  /// read store. Returns true if anything of relevance to the supervision
+  /// has changed
+  bool record(std::string const& agencyPrefix,
+              std::vector<VPackSlice> const& transactions);
+
+  /// @brief Record that the read store was replaced or rebuilt without
+  /// individual transactions
+  void recordAll();
+
+  /// @brief Take over the recorded changes, returns true if the snapshot of
+  /// the read store is outdated
+  bool collect();
+
+  /// @brief Check all collections in the next round
+  void checkAll() { _checkAllCollections = true; }
+
+  /// @brief Whether all collections are checked in the next round
+  bool checksAll() const { return _checkAllCollections; }
+
+  /// @brief The collections to check in this round: the changed ones, those
+  /// out of line in the last round and the satellites. All collections of
+  /// the snapshot's Plan after checkAll() and every fullCheckInterval
+  std::vector<std::string> due(Node const& snapshot, TimePoint now);
+
+  /// @brief Result of checking a collection of this round. Collections out
+  /// of line are checked again in the next round, satellites in every round
+  void checked(std::string const& name, bool satellite, bool inLine);
+
+  std::unordered_set<std::string> const& satellites() const {
+    return _satellites;
+  }
+
+ private:
+  /// @brief Recorded changes, guarded by _changesLock. This is not the
+  /// supervision's lock, since its main loop holds that while waiting for
+  /// the agent
+  Mutex _changesLock;
+  bool _snapshotOutdated;
+  bool _allCollectionsChanged;
+  std::unordered_set<std::string> _changedCollections;
+
+  /// @brief Only used by the supervision thread
+  std::unordered_set<std::string> _collectionsToCheck;
+  std::unordered_set<std::string> _satellites;
+  bool _checkAllCollections;
+  TimePoint _lastFullCheck;
+};
+}
+}
+
+#endif
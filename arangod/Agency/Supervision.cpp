@@ -36,6 +36,7 @@
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/MutexLocker.h"
+#include "Basics/StringUtils.h"
 
 using namespace arangodb;
 
@@ -56,7 +57,9 @@ Supervision::Supervision()
   _jobId(0),
   _jobIdMax(0),
   _selfShutdown(false),
-  _upgraded(false) {}
+  _upgraded(false),
+  _wakeUp(false),
+  _wasLeading(false) {}
 
 Supervision::~Supervision() {
   if (!isStopping()) {
@@ -461,8 +464,20 @@ bool Supervision::updateSnapshot() {
     return false;
   }
   
-  if (_agent->readDB().has(_agencyPrefix)) {
-    _snapshot = _agent->readDB().get(_agencyPrefix);
+  bool leading = _agent->leading();
+  if (leading != _wasLeading) {
+    _wasLeading = leading;
+    _replicationChecks.checkAll();
+  }
+
+  // Only the leader announces committed changes, copy the read store
+  // otherwise or after the agent has told us about changes. Changes are
+  // taken over before copying, so none applied meanwhile go unnoticed.
+  bool outdated = _replicationChecks.collect();
+  if (outdated || !leading || _replicationChecks.checksAll()) {
+    if (_agent->readDB().has(_agencyPrefix)) {
+      _snapshot = _agent->readDB().get(_agencyPrefix);
+    }
   }
   
   if (_agent->transient().has(_agencyPrefix)) {
@@ -508,48 +523,52 @@ void Supervision::run() {
   }
 
   bool shutdown = false;
-  {
-    CONDITION_LOCKER(guard, _cv);
-    TRI_ASSERT(_agent != nullptr);
+  TRI_ASSERT(_agent != nullptr);
 
-    while (!this->isStopping()) {
+  while (!this->isStopping()) {
 
-      // Get bunch of job IDs from agency for future jobs
-      if (_agent->leading() && (_jobId == 0 || _jobId == _jobIdMax)) {
-        getUniqueIds();  // cannot fail but only hang
-      }
+    // Get bunch of job IDs from agency for future jobs
+    if (_agent->leading() && (_jobId == 0 || _jobId == _jobIdMax)) {
+      getUniqueIds();  // cannot fail but only hang
+    }
 
-      {
-        MUTEX_LOCKER(locker, _lock);
+    {
+      MUTEX_LOCKER(locker, _lock);
 
-        updateSnapshot();
+      updateSnapshot();
 
-        if (_agent->leading()) {
+      if (_agent->leading()) {
 
-          if (!_upgraded) {
-            upgradeAgency();
-          }
+        if (!_upgraded) {
+          upgradeAgency();
+        }
 
-          auto secondsSinceLeader = std::chrono::duration<double>(
-            std::chrono::system_clock::now() - _agent->leaderSince()).count();
-          if (secondsSinceLeader > _gracePeriod) {
-            doChecks();
-          }
+        auto secondsSinceLeader = std::chrono::duration<double>(
+          std::chrono::system_clock::now() - _agent->leaderSince()).count();
+        if (secondsSinceLeader > _gracePeriod) {
+          doChecks();
         }
+      }
 
-        if (isShuttingDown()) {
-          handleShutdown();
-        } else if (_selfShutdown) {
-          shutdown = true;
+      if (isShuttingDown()) {
+        handleShutdown();
+      } else if (_selfShutdown) {
+        shutdown = true;
+        break;
+      } else if (_agent->leading()) {
+        if (!handleJobs()) {
           break;
-        } else if (_agent->leading()) {
-          if (!handleJobs()) {
-            break;
-          }
         }
       }
+    }
+
+    // _cv is not held while working, so that the agent is never blocked
+    // by a supervision round when it notifies us
+    CONDITION_LOCKER(guard, _cv);
+    if (!_wakeUp && !this->isStopping()) {
       _cv.wait(static_cast<uint64_t>(1000000 * _frequency));
     }
+    _wakeUp = false;
   }
   if (shutdown) {
     ApplicationServer::server->beginShutdown();
@@ -644,76 +663,113 @@ void Supervision::workJobs() {
 
 
 void Supervision::enforceReplication() {
-  auto const& plannedDBs = _snapshot(planColPrefix).children();
 
-  for (const auto& db_ : plannedDBs) { // Planned databases
-    auto const& db = *(db_.second);
-    for (const auto& col_ : db.children()) { // Planned collections
-      auto const& col = *(col_.second);
-      
-      size_t replicationFactor;
-      if (col.has("replicationFactor") && col("replicationFactor").isUInt()) {
-        replicationFactor = col("replicationFactor").getUInt();
-      } else {
-        LOG_TOPIC(DEBUG, Logger::SUPERVISION)
-          << "no replicationFactor entry in " << col.toJson();
-        continue;
-      }
+  auto due = _replicationChecks.due(_snapshot, std::chrono::system_clock::now());
+  for (auto const& name : due) {
+    size_t pos = name.find('/');
+    TRI_ASSERT(pos != std::string::npos);
+    enforceReplication(name.substr(0, pos), name.substr(pos + 1));
+  }
 
-      // mop: satellites => distribute to every server
-      if (replicationFactor == 0) {
-        auto available = Job::availableServers(_snapshot);
-        replicationFactor = available.size();
-      }
-      
-      bool clone = col.has("distributeShardsLike");
+}
 
-      if (!clone) {
-        for (auto const& shard_ : col("shards").children()) { // Pl shards
-          auto const& shard = *(shard_.second);
-          
-          size_t actualReplicationFactor = shard.slice().length();
-          if (actualReplicationFactor != replicationFactor) {
-            // Check that there is not yet an addFollower or removeFollower
-            // or moveShard job in ToDo for this shard:
-            auto const& todo = _snapshot(toDoPrefix).children();
-            bool found = false;
-            for (auto const& pair : todo) {
-              auto const& job = pair.second;
-              if (job->has("type") &&
-                  ((*job)("type").getString() == "addFollower" ||
-                   (*job)("type").getString() == "removeFollower" ||
-                   (*job)("type").getString() == "moveShard") &&
-                  job->has("shard") &&
-                  (*job)("shard").getString() == shard_.first) {
-                found = true;
-                LOG_TOPIC(DEBUG, Logger::SUPERVISION) << "already found "
-                  "addFollower or removeFollower job in ToDo, not scheduling "
-                  "again for shard " << shard_.first;
-                break;
-              }
-            }
-            // Check that shard is not locked:
-            if (_snapshot.has(blockedShardsPrefix + shard_.first)) {
-              found = true;
-            }
-            if (!found) {
-              if (actualReplicationFactor < replicationFactor) {
-                AddFollower(
-                  _snapshot, _agent, std::to_string(_jobId++), "supervision",
-                  db_.first, col_.first, shard_.first).run();
-              } else {
-                RemoveFollower(
-                  _snapshot, _agent, std::to_string(_jobId++), "supervision",
-                  db_.first, col_.first, shard_.first).run();
-              }
-            }
-          }
+void Supervision::enforceReplication(
+  std::string const& dbName, std::string const& colName) {
+
+  std::string const name = dbName + "/" + colName;
+  std::string const path = planColPrefix + name;
+  if (!_snapshot.has(path)) {  // dropped meanwhile
+    _replicationChecks.checked(name, false, true);
+    return;
+  }
+  auto const& col = _snapshot(path);
+
+  size_t replicationFactor;
+  if (col.has("replicationFactor") && col("replicationFactor").isUInt()) {
+    replicationFactor = col("replicationFactor").getUInt();
+  } else {
+    LOG_TOPIC(DEBUG, Logger::SUPERVISION)
+      << "no replicationFactor entry in " << col.toJson();
+    _replicationChecks.checked(name, false, true);
+    return;
+  }
+
+  // mop: satellites => distribute to every server
+  bool const satellite = (replicationFactor == 0);
+  if (satellite) {
+    auto available = Job::availableServers(_snapshot);
+    replicationFactor = available.size();
+  }
+
+  if (col.has("distributeShardsLike")) {
+    _replicationChecks.checked(name, satellite, true);
+    return;
+  }
+
+  bool inLine = true;
+  for (auto const& shard_ : col("shards").children()) { // Pl shards
+    auto const& shard = *(shard_.second);
+
+    size_t actualReplicationFactor = shard.slice().length();
+    if (actualReplicationFactor != replicationFactor) {
+      inLine = false;
+      // Check that there is not yet an addFollower or removeFollower
+      // or moveShard job in ToDo for this shard:
+      auto const& todo = _snapshot(toDoPrefix).children();
+      bool found = false;
+      for (auto const& pair : todo) {
+        auto const& job = pair.second;
+        if (job->has("type") &&
+            ((*job)("type").getString() == "addFollower" ||
+             (*job)("type").getString() == "removeFollower" ||
+             (*job)("type").getString() == "moveShard") &&
+            job->has("shard") &&
+            (*job)("shard").getString() == shard_.first) {
+          found = true;
+          LOG_TOPIC(DEBUG, Logger::SUPERVISION) << "already found "
+            "addFollower or removeFollower job in ToDo, not scheduling "
+            "again for shard " << shard_.first;
+          break;
+        }
+      }
+      // Check that shard is not locked:
+      if (_snapshot.has(blockedShardsPrefix + shard_.first)) {
+        found = true;
+      }
+      if (!found) {
+        if (actualReplicationFactor < replicationFactor) {
+          AddFollower(
+            _snapshot, _agent, std::to_string(_jobId++), "supervision",
+            dbName, colName, shard_.first).run();
+        } else {
+          RemoveFollower(
+            _snapshot, _agent, std::to_string(_jobId++), "supervision",
+            dbName, colName, shard_.first).run();
         }
       }
     }
   }
-  
+
+  _replicationChecks.checked(name, satellite, inLine);
+
+}
+
+// Called by agent, after its read store has applied the transactions
+void Supervision::notify(std::vector<VPackSlice> const& transactions) {
+  if (_replicationChecks.record(_agencyPrefix, transactions)) {
+    CONDITION_LOCKER(guard, _cv);
+    _wakeUp = true;
+    guard.signal();
+  }
+}
+
+// Called by agent
+void Supervision::readStoreReplaced() {
+  _replicationChecks.recordAll();
+
+  CONDITION_LOCKER(guard, _cv);
+  _wakeUp = true;
+  guard.signal();
 }
 
 void Supervision::fixPrototypeChain(Builder& migrate) {
@@ -25,6 +25,7 @@
 #define ARANGOD_CONSENSUS_SUPERVISION_H 1
 
 #include "Agency/Node.h"
+#include "Agency/ReplicationChecks.h"
 #include "AgencyCommon.h"
 #include "Basics/ConditionVariable.h"
 #include "Basics/Mutex.h"
@@ -110,6 +111,16 @@ class Supervision : public arangodb::Thread {
   /// @brief Upgrade agency
   void upgradeAgency();
 
+  /// @brief Called by the agent with transactions committed to its read
+  /// store. Remembers the Plan collections they touch and wakes us up early
+  /// if anything of relevance to the supervision has changed
+  void notify(std::vector<VPackSlice> const& transactions);
+
+  /// @brief Called by the agent when its read store was replaced or rebuilt
+  /// without individual transactions, e.g. by compaction or a leader's
+  /// snapshot. The next round copies the store and checks all collections
+  void readStoreReplaced();
+
   static constexpr char const* HEALTH_STATUS_GOOD = "GOOD";
   static constexpr char const* HEALTH_STATUS_BAD = "BAD";
   static constexpr char const* HEALTH_STATUS_FAILED = "FAILED";
@@ -136,8 +147,15 @@ class Supervision : public arangodb::Thread {
   void missingPrototype();
 
   /// @brief Check for inconsistencies in replication factor vs dbs entries
+  /// of the collections changed since the last run, of those still out of
+  /// line and of the satellite collections. All collections are checked
+  /// after a change of leadership and every fullCheckInterval seconds
   void enforceReplication();
 
+  /// @brief Check replication of a single collection and report the result
+  /// to _replicationChecks
+  void enforceReplication(std::string const& db, std::string const& col);
+
   /// @brief Move shard from one db server to other db server
   bool moveShard(std::string const& from, std::string const& to);
 
@@ -198,6 +216,14 @@ class Supervision : public arangodb::Thread {
   bool _selfShutdown;
 
   std::atomic<bool> _upgraded;
+
+  /// @brief Wake up before _frequency has passed, guarded by _cv
+  bool _wakeUp;
+
+  /// @brief Changes recorded by notify and the collections to check by
+  /// enforceReplication
+  ReplicationChecks _replicationChecks;
+  bool _wasLeading;
   
   std::string serverHealth(std::string const&);
 
@@ -23,6 +23,7 @@
 
 #include "Aggregator.h"
 #include "Basics/VelocyPackHelper.h"
+#include "Transaction/Context.h"
 #include "Transaction/Methods.h"
 
 #include <velocypack/Builder.h>
@@ -62,6 +63,15 @@ std::unique_ptr<Aggregator> Aggregator::fromTypeString(transaction::Methods* trx
   if (type == "STDDEV_SAMPLE") {
     return std::make_unique<AggregatorStddev>(trx, false);
   }
+  if (type == "COUNT_DISTINCT") {
+    return std::make_unique<AggregatorCountDistinct>(trx);
+  }
+  if (type == "COUNT_DISTINCT_APPROX") {
+    return std::make_unique<AggregatorCountDistinctApprox>(trx);
+  }
+  if (type == "PERCENTILE_APPROX") {
+    return std::make_unique<AggregatorPercentileApprox>(trx);
+  }
 
   // aggregator function name should have been validated before
   THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid aggregator type");
@@ -86,7 +96,17 @@ bool Aggregator::isSupported(std::string const& type) {
           type == "AVG" || type == "VARIANCE_POPULATION" ||
           type == "VARIANCE" || type == "VARIANCE_SAMPLE" ||
           type == "STDDEV_POPULATION" || type == "STDDEV" ||
-          type == "STDDEV_SAMPLE");
+          type == "STDDEV_SAMPLE" || type == "COUNT_DISTINCT" ||
+          type == "COUNT_DISTINCT_APPROX" ||
+          type == "PERCENTILE_APPROX");
+}
+
+size_t Aggregator::numArguments(std::string const& type) {
+  if (type == "PERCENTILE_APPROX") {
+    // value and percentile
+    return 2;
+  }
+  return 1;
 }
 
 bool Aggregator::requiresInput(std::string const& type) {
@@ -307,3 +327,140 @@ AqlValue AggregatorStddev::stealValue() {
   reset();
   return temp;
 }
+
+namespace {
+/// @brief size of the blocks that hold the distinct values, larger values
+/// get a block of their own
+static size_t const DistinctBlockSize = 4096;
+}
+
+DistinctValues::DistinctValues(VPackOptions const* options)
+    : seen(8, arangodb::basics::VelocyPackHelper::VPackHashedStringHash(),
+           ValueEqual(options)),
+      used(0) {}
+
+bool DistinctValues::ValueEqual::operator()(
+    VPackHashedSlice const& lhs, VPackHashedSlice const& rhs) const {
+  return lhs.hash == rhs.hash &&
+         VelocyPackHelper::compare(lhs.slice, rhs.slice, false, options) == 0;
+}
+
+bool DistinctValues::add(VPackSlice s) {
+  VPackHashedSlice value(s, s.normalizedHash());
+  if (seen.find(value) != seen.end()) {
+    return false;
+  }
+
+  value.slice = store(s);
+  seen.emplace(value);
+  return true;
+}
+
+void DistinctValues::clear() {
+  seen.clear();
+  blocks.clear();
+  used = 0;
+}
+
+VPackSlice DistinctValues::store(VPackSlice value) {
+  size_t const size = static_cast<size_t>(value.byteSize());
+  uint8_t* target;
+
+  if (size > DistinctBlockSize / 4) {
+    blocks.emplace_back(new uint8_t[size]);
+    target = blocks.back().get();
+    // the next value starts a new block
+    used = DistinctBlockSize;
+  } else {
+    if (blocks.empty() || used + size > DistinctBlockSize) {
+      blocks.emplace_back(new uint8_t[DistinctBlockSize]);
+      used = 0;
+    }
+    target = blocks.back().get() + used;
+    used += size;
+  }
+
+  memcpy(target, value.begin(), size);
+  return VPackSlice(target);
+}
+
+AggregatorCountDistinct::AggregatorCountDistinct(transaction::Methods* trx)
+    : Aggregator(trx),
+      values(trx->transactionContextPtr()->getVPackOptions()) {}
+
+void AggregatorCountDistinct::reset() { values.clear(); }
+
+void AggregatorCountDistinct::reduce(AqlValue const& cmpValue) {
+  AqlValueMaterializer materializer(trx);
+  values.add(materializer.slice(cmpValue, true));
+}
+
+AqlValue AggregatorCountDistinct::stealValue() {
+  builder.clear();
+  builder.add(VPackValue(static_cast<uint64_t>(values.size())));
+  AqlValue temp(builder.slice());
+  reset();
+  return temp;
+}
+
+void AggregatorCountDistinctApprox::reset() { sketch.clear(); }
+
+void AggregatorCountDistinctApprox::reduce(AqlValue const& cmpValue) {
+  sketch.insert(cmpValue.hash(trx));
+}
+
+AqlValue AggregatorCountDistinctApprox::stealValue() {
+  builder.clear();
+  builder.add(VPackValue(sketch.estimate()));
+  AqlValue temp(builder.slice());
+  reset();
+  return temp;
+}
+
+void AggregatorPercentileApprox::reset() {
+  digest.clear();
+  percentile = 0.0;
+  invalid = false;
+}
+
+void AggregatorPercentileApprox::reduce(AqlValue const& cmpValue) {
+  if (invalid) {
+    return;
+  }
+
+  AqlValueMaterializer materializer(trx);
+  VPackSlice s = materializer.slice(cmpValue, false);
+  TRI_ASSERT(s.isArray() && s.length() == 2);
+
+  VPackSlice value = s.at(0);
+  if (value.isNull()) {
+    // ignore `null` values here
+    return;
+  }
+  if (value.isNumber()) {
+    double const number = value.getNumber<double>();
+    if (!std::isnan(number) && number != HUGE_VAL && number != -HUGE_VAL) {
+      if (digest.empty()) {
+        // the percentile is a constant, see ExecutionPlan::fromNodeCollect
+        percentile = s.at(1).getNumber<double>();
+      }
+      digest.insert(number);
+      return;
+    }
+  }
+
+  invalid = true;
+}
+
+AqlValue AggregatorPercentileApprox::stealValue() {
+  if (invalid || digest.empty() || percentile <= 0.0 || percentile > 100.0) {
+    reset();
+    return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
+  }
+
+  builder.clear();
+  builder.add(VPackValue(digest.quantile(percentile / 100.0)));
+  AqlValue temp(builder.slice());
+  reset();
+  return temp;
+}
@@ -26,6 +26,9 @@
 
 #include "Basics/Common.h"
 #include "Aql/AqlValue.h"
+#include "Basics/HyperLogLog.h"
+#include "Basics/TDigest.h"
+#include "Basics/VelocyPackHelper.h"
 
 #include <velocypack/Builder.h>
 
@@ -57,6 +60,10 @@ struct Aggregator {
   static bool isSupported(std::string const&);
   static bool requiresInput(std::string const&);
 
+  /// @brief number of arguments of the aggregate function. Aggregators with
+  /// more than one argument get all arguments as an array per input row
+  static size_t numArguments(std::string const&);
+
   transaction::Methods* trx;
 
   arangodb::velocypack::Builder builder;
@@ -183,6 +190,90 @@ struct AggregatorStddev final : public AggregatorVarianceBase {
   AqlValue stealValue() override final;
 };
 
+/// @brief the distinct values of COUNT_DISTINCT. The set holds each
+/// distinct value once, with its hash, so memory grows with the number of
+/// distinct values but not with the number of values added. Values are
+/// copied, so they need not outlive the call to add
+struct DistinctValues {
+  explicit DistinctValues(arangodb::velocypack::Options const* options);
+
+  /// @brief adds a value, returns false if an equal value was added before
+  bool add(arangodb::velocypack::Slice value);
+
+  size_t size() const { return seen.size(); }
+
+  void clear();
+
+  /// @brief values are equal if their hashes match and they compare equal
+  struct ValueEqual {
+    explicit ValueEqual(arangodb::velocypack::Options const* options)
+        : options(options) {}
+    bool operator()(arangodb::basics::VPackHashedSlice const&,
+                    arangodb::basics::VPackHashedSlice const&) const;
+
+    arangodb::velocypack::Options const* options;
+  };
+
+  /// @brief copies a value into the value blocks
+  arangodb::velocypack::Slice store(arangodb::velocypack::Slice);
+
+  std::unordered_set<arangodb::basics::VPackHashedSlice,
+                     arangodb::basics::VelocyPackHelper::VPackHashedStringHash,
+                     ValueEqual>
+      seen;
+
+  /// @brief blocks holding the copies of the distinct values, which are
+  /// referenced by `seen`. `used` is the fill level of the last block
+  std::vector<std::unique_ptr<uint8_t[]>> blocks;
+  size_t used;
+};
+
+/// @brief counts the distinct values exactly
+struct AggregatorCountDistinct final : public Aggregator {
+  explicit AggregatorCountDistinct(transaction::Methods* trx);
+
+  char const* name() const override final { return "COUNT_DISTINCT"; }
+
+  void reset() override final;
+  void reduce(AqlValue const&) override final;
+  AqlValue stealValue() override final;
+
+  DistinctValues values;
+};
+
+/// @brief estimates the number of distinct values with a HyperLogLog sketch,
+/// so the memory used per group does not grow with the number of values
+struct AggregatorCountDistinctApprox final : public Aggregator {
+  explicit AggregatorCountDistinctApprox(transaction::Methods* trx)
+      : Aggregator(trx) {}
+
+  char const* name() const override final { return "COUNT_DISTINCT_APPROX"; }
+
+  void reset() override final;
+  void reduce(AqlValue const&) override final;
+  AqlValue stealValue() override final;
+
+  arangodb::basics::HyperLogLog sketch;
+};
+
+/// @brief estimates a percentile with a t-digest. The input values are
+/// arrays of the value and the percentile, as built by the execution plan
+/// from the two function call arguments
+struct AggregatorPercentileApprox final : public Aggregator {
+  explicit AggregatorPercentileApprox(transaction::Methods* trx)
+      : Aggregator(trx), percentile(0.0), invalid(false) {}
+
+  char const* name() const override final { return "PERCENTILE_APPROX"; }
+
+  void reset() override final;
+  void reduce(AqlValue const&) override final;
+  AqlValue stealValue() override final;
+
+  arangodb::basics::TDigest digest;
+  double percentile;
+  bool invalid;
+};
+
 }  // namespace arangodb::aql
 }  // namespace arangodb
 
@@ -343,6 +343,8 @@ void AqlFunctionFeature::addListFunctions() {
        &Functions::Median});
   add({"PERCENTILE", "AQL_PERCENTILE", "l,n|s", true, true, false, true, true,
        &Functions::Percentile});
+  add({"PERCENTILE_APPROX", "AQL_PERCENTILE_APPROX", "l,n", true, true, false,
+       true, true, &Functions::PercentileApprox});
   add({"AVERAGE", "AQL_AVERAGE", "l", true, true, false, true, true,
        &Functions::Average});
   add({"AVG", "AQL_AVERAGE", "l", true, true, false, true, true,
@@ -360,6 +362,10 @@ void AqlFunctionFeature::addListFunctions() {
        true, true, &Functions::StdDevPopulation});
   add({"STDDEV", "AQL_STDDEV_POPULATION", "l", true, true, false, true, true,
        &Functions::StdDevPopulation});  // alias for STDDEV_POPULATION()
+  add({"COUNT_DISTINCT", "AQL_COUNT_DISTINCT", "l", true, true, false, true,
+       true, &Functions::CountDistinct});
+  add({"COUNT_DISTINCT_APPROX", "AQL_COUNT_DISTINCT_APPROX", "l", true, true,
+       false, true, true, &Functions::CountDistinctApprox});
   add({"UNIQUE", "AQL_UNIQUE", "l", true, true, false, true, true,
        &Functions::Unique});
   add({"SORTED_UNIQUE", "AQL_SORTED_UNIQUE", "l", true, true, false, true, true,
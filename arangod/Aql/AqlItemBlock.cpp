@@ -321,6 +321,36 @@ void AqlItemBlock::clearRegisters(
   }
 }
 
+/// @brief sets a register to a copy of the value in another block, sharing
+/// the copy of the previous row if the value is unchanged
+bool AqlItemBlock::inheritValue(AqlItemBlock const* src, size_t srcRow,
+                                size_t dstRow, RegisterId reg) {
+  auto const& value = src->getValueReference(srcRow, reg);
+
+  if (value.isEmpty()) {
+    return false;
+  }
+
+  if (value.requiresDestruction() && srcRow > 0 && dstRow > 0 &&
+      std::equal_to<AqlValue>()(value,
+                                src->getValueReference(srcRow - 1, reg))) {
+    // same value as in the previous row, which was inherited into the
+    // previous row here. share that copy, the reference count keeps it
+    auto const& previous = getValueReference(dstRow - 1, reg);
+    if (!previous.isEmpty()) {
+      setValue(dstRow, reg, previous);
+      return false;
+    }
+  }
+
+  AqlValue a = value.clone();
+  AqlValueGuard guard(a, true);
+
+  setValue(dstRow, reg, a);
+  guard.steal();
+  return true;
+}
+
 /// @brief slice/clone, this does a deep copy of all entries
 AqlItemBlock* AqlItemBlock::slice(size_t from, size_t to) const {
   TRI_ASSERT(from < to && to <= _nrItems);
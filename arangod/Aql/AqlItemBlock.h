@@ -248,6 +248,14 @@ class AqlItemBlock {
   /// necessary, using the reference count.
   void clearRegisters(std::unordered_set<RegisterId> const& toClear);
 
+  /// @brief sets a register of row dstRow to a copy of its value in row
+  /// srcRow of src. A value unchanged from the previous source row shares
+  /// the copy in the previous row instead of being cloned again, so rows of
+  /// the same source block must be copied in ascending order. Returns true
+  /// if the value was cloned
+  bool inheritValue(AqlItemBlock const* src, size_t srcRow, size_t dstRow,
+                    RegisterId reg);
+
   /// @brief slice/clone, this does a deep copy of all entries
   AqlItemBlock* slice(size_t from, size_t to) const;
 
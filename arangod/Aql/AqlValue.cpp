@@ -785,6 +785,27 @@ v8::Handle<v8::Value> AqlValue::toV8Partial(
   return TRI_VPackToV8(isolate, s, options);
 }
 
+/// @brief construct a V8 value for a query result, whose objects only
+/// convert their attributes when accessed
+v8::Handle<v8::Value> AqlValue::toV8Lazy(
+    v8::Isolate* isolate, transaction::Methods* trx) const {
+  switch (type()) {
+    case VPACK_SLICE_POINTER:
+    case VPACK_INLINE:
+    case VPACK_MANAGED: {
+      VPackOptions* options = trx->transactionContext()->getVPackOptions();
+      return TRI_VPackToV8Lazy(isolate, slice(), options);
+    }
+    case DOCVEC:
+    case RANGE: {
+      return toV8(isolate, trx);
+    }
+  }
+
+  // we shouldn't get here
+  return v8::Null(isolate);
+}
+
 /// @brief construct a V8 value as input for the expression execution in V8
 v8::Handle<v8::Value> AqlValue::toV8(
     v8::Isolate* isolate, transaction::Methods* trx) const {
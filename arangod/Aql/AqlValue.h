@@ -456,6 +456,11 @@ struct AqlValue final {
   /// @brief construct a V8 value as input for the expression execution in V8
   v8::Handle<v8::Value> toV8(v8::Isolate* isolate, transaction::Methods*) const;
 
+  /// @brief construct a V8 value for a query result, whose objects only
+  /// convert their attributes when accessed
+  v8::Handle<v8::Value> toV8Lazy(v8::Isolate* isolate,
+                                 transaction::Methods*) const;
+
   /// @brief materializes a value into the builder
   void toVelocyPack(transaction::Methods*,
                     arangodb::velocypack::Builder& builder,
@@ -1333,9 +1333,59 @@ AstNode* Ast::createNodeNaryOperator(AstNodeType type, AstNode const* child) {
 }
 
 /// @brief injects bind parameters into the AST
-void Ast::injectBindParameters(BindParameters& parameters) {
+void Ast::injectBindParameters(BindParameters& parameters,
+                               std::unordered_set<std::string>* deferred) {
   auto& p = parameters.get();
 
+  // create the value node for a bind parameter
+  auto createValue = [&](VPackSlice const& value) -> AstNode* {
+    AstNode* node = nodeFromVPack(value, true);
+
+    if (node != nullptr) {
+      // already mark node as constant here
+      node->setFlag(DETERMINED_CONSTANT, VALUE_CONSTANT);
+      // mark node as simple
+      node->setFlag(DETERMINED_SIMPLE, VALUE_SIMPLE);
+      // mark node as executable on db-server
+      node->setFlag(DETERMINED_RUNONDBSERVER, VALUE_RUNONDBSERVER);
+      // mark node as non-throwing
+      node->setFlag(DETERMINED_THROWS);
+      // mark node as deterministic
+      node->setFlag(DETERMINED_NONDETERMINISTIC);
+
+      // finally note that the node was created from a bind parameter
+      node->setFlag(FLAG_BIND_PARAMETER);
+    }
+    return node;
+  };
+
+  // inject the values of deferred parameters which are needed to build
+  // the plan. these parameters are removed from deferred
+  std::function<AstNode*(AstNode*)> undefer = [&](AstNode* node) -> AstNode* {
+    if (deferred == nullptr || node == nullptr) {
+      return node;
+    }
+    if (node->type == NODE_TYPE_PARAMETER) {
+      std::string const param = node->getString();
+      auto const& it = p.find(param);
+      if (it == p.end() || deferred->find(param) == deferred->end()) {
+        return node;
+      }
+      deferred->erase(param);
+      return createValue((*it).second.first);
+    }
+
+    size_t const n = node->numMembers();
+    for (size_t i = 0; i < n; ++i) {
+      auto member = node->getMemberUnchecked(i);
+      auto replacement = undefer(member);
+      if (replacement != member) {
+        node->changeMember(i, replacement);
+      }
+    }
+    return node;
+  };
+
   auto func = [&](AstNode* node, void*) -> AstNode* {
     if (node->type == NODE_TYPE_PARAMETER) {
       // found a bind parameter in the query string
@@ -1360,6 +1410,12 @@ void Ast::injectBindParameters(BindParameters& parameters) {
       auto& value = (*it).second.first;
 
       TRI_ASSERT(!param.empty());
+      if (param[0] != '@' && deferred != nullptr &&
+          deferred->find(param) != deferred->end()) {
+        // keep the parameter node, its value is injected into the plan later
+        return node;
+      }
+
       if (param[0] == '@') {
         // collection parameter
         TRI_ASSERT(value.isString());
@@ -1412,27 +1468,15 @@ void Ast::injectBindParameters(BindParameters& parameters) {
           }
         }
       } else {
-        node = nodeFromVPack(value, true);
-
-        if (node != nullptr) {
-          // already mark node as constant here
-          node->setFlag(DETERMINED_CONSTANT, VALUE_CONSTANT);
-          // mark node as simple
-          node->setFlag(DETERMINED_SIMPLE, VALUE_SIMPLE);
-          // mark node as executable on db-server
-          node->setFlag(DETERMINED_RUNONDBSERVER, VALUE_RUNONDBSERVER);
-          // mark node as non-throwing
-          node->setFlag(DETERMINED_THROWS);
-          // mark node as deterministic
-          node->setFlag(DETERMINED_NONDETERMINISTIC);
-
-          // finally note that the node was created from a bind parameter
-          node->setFlag(FLAG_BIND_PARAMETER);
-        }
+        node = createValue(value);
       }
+    } else if (node->type == NODE_TYPE_LIMIT ||
+               node->type == NODE_TYPE_DIRECTION) {
+      // LIMIT values and traversal depths are needed to build the plan
+      undefer(node);
     } else if (node->type == NODE_TYPE_BOUND_ATTRIBUTE_ACCESS) {
       // look at second sub-node. this is the (replaced) bind parameter
-      auto name = node->getMember(1);
+      auto name = undefer(node->getMember(1));
 
       if (name->type == NODE_TYPE_VALUE) {
         if (name->value.type == VALUE_TYPE_STRING && name->value.length != 0) {
@@ -1473,7 +1517,8 @@ void Ast::injectBindParameters(BindParameters& parameters) {
       THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_BIND_PARAMETER_TYPE,
                                     node->getString().c_str());
     } else if (node->type == NODE_TYPE_TRAVERSAL) {
-      auto graphNode = node->getMember(2);
+      auto graphNode = undefer(node->getMember(2));
+      node->changeMember(2, graphNode);
       if (graphNode->type == NODE_TYPE_VALUE) {
         TRI_ASSERT(graphNode->isStringValue());
         std::string graphName = graphNode->getString();
@@ -1502,7 +1547,8 @@ void Ast::injectBindParameters(BindParameters& parameters) {
         }
       }
     } else if (node->type == NODE_TYPE_SHORTEST_PATH) {
-      auto graphNode = node->getMember(3);
+      auto graphNode = undefer(node->getMember(3));
+      node->changeMember(3, graphNode);
       if (graphNode->type == NODE_TYPE_VALUE) {
         TRI_ASSERT(graphNode->isStringValue());
         std::string graphName = graphNode->getString();
@@ -361,8 +361,12 @@ class Ast {
   /// @brief create an AST n-ary operator
   AstNode* createNodeNaryOperator(AstNodeType, AstNode const*);
 
-  /// @brief injects bind parameters into the AST
-  void injectBindParameters(BindParameters&);
+  /// @brief injects bind parameters into the AST. value parameters in
+  /// deferred are left in the AST as parameter nodes, unless their values
+  /// are needed to build the plan (e.g. bound attribute names, graph names,
+  /// LIMIT values). these are injected anyway and removed from deferred
+  void injectBindParameters(BindParameters&,
+                            std::unordered_set<std::string>* deferred = nullptr);
 
   /// @brief replace variables
   AstNode* replaceVariables(
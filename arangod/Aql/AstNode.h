@@ -452,6 +452,13 @@ struct AstNode {
   /// this may also set the FLAG_CONSTANT or the FLAG_DYNAMIC flags for the node
   bool isConstant() const;
 
+  /// @brief whether or not a node has a constant value, or is a bind
+  /// parameter that was left in a plan template. plan templates are only
+  /// used for non-null values of such parameters
+  inline bool isConstantOrDeferred() const {
+    return (type == NODE_TYPE_PARAMETER || isConstant());
+  }
+
   /// @brief whether or not a node is a simple comparison operator
   bool isSimpleComparisonOperator() const;
 
@@ -99,6 +99,9 @@ class RemoteNode : public ExecutionNode {
   /// @brief return the collection
   Collection const* collection() const { return _collection; }
 
+  /// @brief set the collection
+  void setCollection(Collection const* collection) { _collection = collection; }
+
   /// @brief return the server name
   std::string server() const { return _server; }
 
@@ -181,3 +181,51 @@ bool Collection::isSmart() const {
 bool Collection::isSatellite() const {
   return getCollection()->isSatellite();
 }
+
+/// @brief wait until the local copy of a satellite collection is in sync
+/// with its leader. throws if this does not happen within maxWait seconds
+void Collection::waitForSatelliteSync(double maxWait) const {
+  auto logicalCollection = getCollection();
+  auto cid = std::to_string(logicalCollection->planId());
+  auto dbName = logicalCollection->dbName();
+  auto clusterInfo = ClusterInfo::instance();
+
+  bool inSync = false;
+  // wait interval in microseconds. starts at 10ms and backs off, so we do
+  // not hammer the cluster info while the follower catches up
+  TRI_usleep_t waitInterval = 10000;
+  TRI_usleep_t const maxWaitInterval = 500000;
+  double const endTime = TRI_microtime() + maxWait;
+
+  while (true) {
+    // refetch the current state, as it changes while we are waiting
+    auto collectionInfoCurrent =
+        clusterInfo->getCollectionCurrent(dbName, cid);
+    auto followers = collectionInfoCurrent->servers(getName());
+    inSync = std::find(followers.begin(), followers.end(),
+                       ServerState::instance()->getId()) != followers.end();
+    if (inSync) {
+      break;
+    }
+
+    double const remaining = endTime - TRI_microtime();
+    if (remaining <= 0.0) {
+      break;
+    }
+
+    // never sleep longer than the remaining time (converted from seconds),
+    // but at least 10ms
+    TRI_usleep_t interval = waitInterval;
+    if (remaining * 1000000.0 < static_cast<double>(interval)) {
+      interval = (std::max)(static_cast<TRI_usleep_t>(remaining * 1000000.0),
+                            static_cast<TRI_usleep_t>(10000));
+    }
+    usleep(interval);
+    waitInterval = (std::min)(waitInterval * 2, maxWaitInterval);
+  }
+
+  if (!inSync) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CLUSTER_AQL_COLLECTION_OUT_OF_SYNC,
+                                   "collection " + name);
+  }
+}
@@ -100,6 +100,10 @@ struct Collection {
   /// @brief check if collection is a satellite collection
   bool isSatellite() const;
 
+  /// @brief wait until the local copy of a satellite collection is in sync
+  /// with its leader. throws if this does not happen within maxWait seconds
+  void waitForSatelliteSync(double maxWait) const;
+
  private:
 
   arangodb::LogicalCollection* collection;
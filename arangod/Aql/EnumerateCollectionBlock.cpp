@@ -57,41 +57,9 @@ int EnumerateCollectionBlock::initialize() {
   _mustStoreResult = ep->isVarUsedLater(ep->_outVariable);
 
   if (_collection->isSatellite()) {
-    auto logicalCollection = _collection->getCollection();
-    auto cid = logicalCollection->planId();
-    auto dbName = logicalCollection->dbName();
-    auto collectionInfoCurrent = ClusterInfo::instance()->getCollectionCurrent(
-        dbName, std::to_string(cid));
-
-    double maxWait = _engine->getQuery()->getNumericOption<double>(
-        "satelliteSyncWait", 60.0);
-    bool inSync = false;
-    unsigned long waitInterval = 10000;
-    double startTime = TRI_microtime();
-    double now = startTime;
-    double endTime = startTime + maxWait;
-
-    while (!inSync) {
-      auto followers = collectionInfoCurrent->servers(_collection->getName());
-      inSync = std::find(followers.begin(), followers.end(),
-                         ServerState::instance()->getId()) != followers.end();
-      if (!inSync) {
-        if (endTime - now < waitInterval) {
-          waitInterval = static_cast<unsigned long>(endTime - now);
-        }
-        usleep((TRI_usleep_t)waitInterval);
-      }
-      now = TRI_microtime();
-      if (now > endTime) {
-        break;
-      }
-    }
-
-    if (!inSync) {
-      THROW_ARANGO_EXCEPTION_MESSAGE(
-          TRI_ERROR_CLUSTER_AQL_COLLECTION_OUT_OF_SYNC,
-          "collection " + _collection->name);
-    }
+    _collection->waitForSatelliteSync(
+        _engine->getQuery()->getNumericOption<double>("satelliteSyncWait",
+                                                      60.0));
   }
 
   return ExecutionBlock::initialize();
@@ -202,6 +170,7 @@ AqlItemBlock* EnumerateCollectionBlock::getSome(size_t,  // atLeast,
           } else {
             AqlValue a(_mmdr->createAqlValue());
             AqlValueGuard guard(a, true);
+            countCopy(a);
             res->setValue(send, static_cast<arangodb::aql::RegisterId>(curRegs), a);
             guard.steal();
           }
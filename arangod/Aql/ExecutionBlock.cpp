@@ -225,14 +225,8 @@ void ExecutionBlock::inheritRegisters(AqlItemBlock const* src,
 
   for (RegisterId i = 0; i < n; i++) {
     if (planNode->_regsToClear.find(i) == planNode->_regsToClear.end()) {
-      auto const& value = src->getValueReference(srcRow, i);
-
-      if (!value.isEmpty()) {
-        AqlValue a = value.clone();
-        AqlValueGuard guard(a, true);
-
-        dst->setValue(dstRow, i, a);
-        guard.steal();
+      if (dst->inheritValue(src, srcRow, dstRow, i)) {
+        countCopy(dst->getValueReference(dstRow, i));
       }
     }
   }
@@ -254,6 +248,7 @@ void ExecutionBlock::inheritRegisters(AqlItemBlock const* src,
       if (!value.isEmpty()) {
         AqlValue a = value.clone();
         AqlValueGuard guard(a, true);
+        countCopy(a);
 
         TRI_IF_FAILURE("ExecutionBlock::inheritRegisters") {
           THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
@@ -268,6 +263,14 @@ void ExecutionBlock::inheritRegisters(AqlItemBlock const* src,
   DEBUG_END_BLOCK();
 }
 
+/// @brief account a value that was copied into query-owned memory
+void ExecutionBlock::countCopy(AqlValue const& value) {
+  if (value.requiresDestruction()) {
+    ++_engine->_stats.documentsCopied;
+    _engine->_stats.bytesCopied += static_cast<int64_t>(value.memoryUsage());
+  }
+}
+
 /// @brief the following is internal to pull one more block and append it to
 /// our _buffer deque. Returns true if a new block was appended and false if
 /// the dependent node is exhausted.
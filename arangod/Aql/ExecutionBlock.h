@@ -169,9 +169,17 @@ class ExecutionBlock {
   /// register values are cloned
   void inheritRegisters(AqlItemBlock const* src, AqlItemBlock* dst, size_t row);
 
+  /// @brief copy register data from one block (src) into another (dst).
+  /// rows of the same source block must be inherited in ascending order.
+  /// values that are unchanged from the previous source row are shared with
+  /// the previous destination row instead of being cloned again
   void inheritRegisters(AqlItemBlock const* src, AqlItemBlock* dst, size_t,
                         size_t);
 
+  /// @brief account a value that was copied into query-owned memory in the
+  /// execution statistics. values that are only referenced are not counted
+  void countCopy(AqlValue const& value);
+
   /// @brief the following is internal to pull one more block and append it to
   /// our _buffer deque. Returns true if a new block was appended and false if
   /// the dependent node is exhausted.
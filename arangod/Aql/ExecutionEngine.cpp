@@ -46,6 +46,7 @@
 #include "Basics/VelocyPackHelper.h"
 #include "Cluster/ClusterComm.h"
 #include "Cluster/ClusterInfo.h"
+#include "Cluster/ClusterMethods.h"
 #include "Cluster/CollectionLockState.h"
 #include "Cluster/TraverserEngineRegistry.h"
 #include "Logger/Logger.h"
@@ -408,6 +409,24 @@ struct CoordinatorInstanciator : public WalkerWorker<ExecutionNode> {
           localCollection = const_cast<Collection*>(
               static_cast<ModificationNode*>((*en))->collection());
           collectionFn(localCollection);
+        } else if ((*en)->getType() == ExecutionNode::SUBQUERY &&
+                   location == DBSERVER) {
+          // subqueries on DB servers only read satellite collections
+          std::vector<ExecutionNode*> stack(
+              {static_cast<SubqueryNode*>((*en))->getSubquery()});
+          while (!stack.empty()) {
+            ExecutionNode* current = stack.back();
+            stack.pop_back();
+            if (current->getType() == ExecutionNode::ENUMERATE_COLLECTION) {
+              auxiliaryCollections.emplace(const_cast<Collection*>(
+                  static_cast<EnumerateCollectionNode*>(current)
+                      ->collection()));
+            } else if (current->getType() == ExecutionNode::INDEX) {
+              auxiliaryCollections.emplace(const_cast<Collection*>(
+                  static_cast<IndexNode*>(current)->collection()));
+            }
+            current->addDependencies(stack);
+          }
         }
       }
       // mop: no non satellite collection found
@@ -488,6 +507,13 @@ struct CoordinatorInstanciator : public WalkerWorker<ExecutionNode> {
   // coordinator. Note that the main query and engine is not put into
   // this map at all.
 
+  std::unordered_map<std::string, std::string> shardDestinations;
+  // the ClusterComm destinations used for the shards of the query. if dirty
+  // reads are allowed, these can point to in-sync followers of the shards.
+  // all snippets for a shard must go to the same server
+
+  bool const allowDirtyReads;
+
   std::unordered_map<traverser::TraverserEngineID, std::unordered_set<std::string>> traverserEngines;
   // This map allows to find all traverser engine parts of the query.
   // The first value is the engine id. The second value is a list of
@@ -503,7 +529,8 @@ struct CoordinatorInstanciator : public WalkerWorker<ExecutionNode> {
         root(nullptr),
         currentLocation(COORDINATOR),
         currentEngineId(0),
-        engines() {
+        engines(),
+        allowDirtyReads(query->allowDirtyReads()) {
     TRI_ASSERT(query != nullptr);
     TRI_ASSERT(queryRegistry != nullptr);
 
@@ -512,13 +539,27 @@ struct CoordinatorInstanciator : public WalkerWorker<ExecutionNode> {
 
   ~CoordinatorInstanciator() {}
 
+  /// @brief the ClusterComm destination for the snippets of a shard
+  std::string const& destinationForShard(std::string const& shardId) {
+    auto it = shardDestinations.find(shardId);
+
+    if (it == shardDestinations.end()) {
+      it = shardDestinations
+               .emplace(shardId,
+                        shardReadDestination(shardId, allowDirtyReads))
+               .first;
+    }
+
+    return (*it).second;
+  }
+
   /// @brief generatePlanForOneShard
   void generatePlanForOneShard(VPackBuilder& builder, size_t nr,
                                EngineInfo* info, QueryId& connectedId,
                                std::string const& shardId, bool verbose) {
     // copy the relevant fragment of the plan for each shard
-    // Note that in these parts of the query there are no SubqueryNodes,
-    // since they are all on the coordinator!
+    // Note that SubqueryNodes in these parts of the query only read
+    // satellite collections. They are cloned together with their subqueries
     ExecutionPlan plan(query->ast());
 
     ExecutionNode* previous = nullptr;
@@ -605,6 +646,9 @@ struct CoordinatorInstanciator : public WalkerWorker<ExecutionNode> {
     result.add("tracing", VPackValue(tracing));
     double satelliteSyncWait = query->getNumericOption<double>("satelliteSyncWait", 60.0);
     result.add("satelliteSyncWait", VPackValue(satelliteSyncWait));
+    if (allowDirtyReads && query->readTick() != 0) {
+      result.add("readTick", VPackValue(TRI_RidToString(query->readTick())));
+    }
     result.close(); // options
 
     result.close();
@@ -626,25 +670,23 @@ struct CoordinatorInstanciator : public WalkerWorker<ExecutionNode> {
 
       auto headers = std::make_unique<std::unordered_map<std::string, std::string>>();
       (*headers)["X-Arango-Nolock"] = shardId;  // Prevent locking
-      cc->asyncRequest("", coordTransactionID, "shard:" + shardId,
+      cc->asyncRequest("", coordTransactionID, destinationForShard(shardId),
                        arangodb::rest::RequestType::POST,
                        url, body, headers, nullptr, 90.0);
     }
   }
 
-  /// @brief aggregateQueryIds, get answers for all shards in a Scatter/Gather
-  void aggregateQueryIds(EngineInfo* info,
-                         std::shared_ptr<arangodb::ClusterComm>& cc,
-                         arangodb::CoordTransactionID& coordTransactionID,
-                         Collection* collection) {
-    // pick up the remote query ids
-    auto shardIds = collection->shardIds(_includedShards);
-
+  /// @brief aggregateQueryIds, get answers for all shards in a Scatter/Gather.
+  /// returns the shards for which followers rejected to serve dirty reads
+  std::vector<std::string> aggregateQueryIds(
+      EngineInfo* info, std::shared_ptr<arangodb::ClusterComm>& cc,
+      arangodb::CoordTransactionID& coordTransactionID, size_t numShards) {
+    std::vector<std::string> rejected;
     std::string error;
     int count = 0;
     int nrok = 0;
     int errorCode = TRI_ERROR_NO_ERROR;
-    for (count = (int)shardIds->size(); count > 0; count--) {
+    for (count = (int)numShards; count > 0; count--) {
       auto res = cc->wait("", coordTransactionID, 0, "", 90.0);
 
       if (res.status == arangodb::CL_COMM_RECEIVED) {
@@ -671,6 +713,9 @@ struct CoordinatorInstanciator : public WalkerWorker<ExecutionNode> {
             queryId += "*";
           }
           queryIds.emplace(theID, queryId);
+        } else if (allowDirtyReads && isFollowerNotInSync(res)) {
+          // the follower has not yet applied the client's writes
+          rejected.emplace_back(res.shardID);
         } else {
           error += "DB SERVER ANSWERED WITH ERROR: ";
           error += res.answer->payload().toJson();
@@ -684,15 +729,16 @@ struct CoordinatorInstanciator : public WalkerWorker<ExecutionNode> {
       }
     }
      
-    size_t numShards = shardIds->size();   
     //LOG_TOPIC(ERR, arangodb::Logger::FIXME) << "GOT ALL RESPONSES FROM DB SERVERS: " << nrok << "\n";
 
-    if (nrok != static_cast<int>(numShards)) {
+    if (nrok + rejected.size() != numShards) {
       if (errorCode == TRI_ERROR_NO_ERROR) {
         errorCode = TRI_ERROR_INTERNAL; // must have an error
       }
       THROW_ARANGO_EXCEPTION_MESSAGE(errorCode, error);
     }
+
+    return rejected;
   }
 
   /// @brief distributePlansToShards, for a single Scatter/Gather block
@@ -712,25 +758,47 @@ struct CoordinatorInstanciator : public WalkerWorker<ExecutionNode> {
     if (cc != nullptr) {
       // nullptr only happens on controlled shutdown
       // iterate over all shards of the collection
-      size_t nr = 0;
       auto shardIds = collection->shardIds(_includedShards);
-      for (auto const& shardId : *shardIds) {
-        // inject the current shard id into the collection
-        VPackBuilder b;
-        collection->setCurrentShard(shardId);
-        generatePlanForOneShard(b, nr++, info, connectedId, shardId, true);
-
-        distributePlanToShard(coordTransactionID, info,
-                              connectedId, shardId,
-                              b.slice());
+
+      auto distribute = [&](std::vector<std::string> const& shards) {
+        for (auto const& shardId : shards) {
+          // the first shard of the collection is responsible for forwarding
+          // initializeCursor and shutDown requests
+          size_t nr = std::find(shardIds->begin(), shardIds->end(), shardId) -
+                      shardIds->begin();
+          // inject the current shard id into the collection
+          VPackBuilder b;
+          collection->setCurrentShard(shardId);
+          generatePlanForOneShard(b, nr, info, connectedId, shardId, true);
+
+          distributePlanToShard(coordTransactionID, info,
+                                connectedId, shardId,
+                                b.slice());
+        }
+        collection->resetCurrentShard();
+      };
+
+      distribute(*shardIds);
+      auto rejected =
+          aggregateQueryIds(info, cc, coordTransactionID, shardIds->size());
+
+      if (!rejected.empty()) {
+        // followers that have not yet applied the client's writes rejected
+        // the dirty reads. use the shard leaders instead
+        for (auto const& shardId : rejected) {
+          shardDestinations[shardId] = "shard:" + shardId;
+        }
+        coordTransactionID = TRI_NewTickServer();
+        distribute(rejected);
+        rejected =
+            aggregateQueryIds(info, cc, coordTransactionID, rejected.size());
+        TRI_ASSERT(rejected.empty());
       }
-      collection->resetCurrentShard();
+
       for (auto const& auxiliaryCollection: auxiliaryCollections) {
         TRI_ASSERT(auxiliaryCollection->shardIds()->size() == 1);
         auxiliaryCollection->resetCurrentShard();
       }
-
-      aggregateQueryIds(info, cc, coordTransactionID, collection);
     }
   }
 
@@ -815,7 +883,7 @@ struct CoordinatorInstanciator : public WalkerWorker<ExecutionNode> {
               idThere.pop_back();
             }
             ExecutionBlock* r = new RemoteBlock(engine.get(), remoteNode,
-                                                "shard:" + shardId,  // server
+                                                destinationForShard(shardId),  // server
                                                 "",                  // ownName
                                                 idThere);            // queryId
 
@@ -1172,6 +1240,11 @@ struct CoordinatorInstanciator : public WalkerWorker<ExecutionNode> {
     return false;
   }
 
+  /// @brief subqueries in DB server snippets are shipped as a whole
+  virtual bool enterSubquery(ExecutionNode*, ExecutionNode*) override final {
+    return currentLocation == COORDINATOR;
+  }
+
   /// @brief after method for collection of pieces phase
   virtual void after(ExecutionNode* en) override final {
     auto const nodeType = en->getType();
@@ -1339,7 +1412,8 @@ ExecutionEngine* ExecutionEngine::instantiateFromPlan(
                 "/_db/" +
                 arangodb::basics::StringUtils::urlEncode(vocbase->name()) +
                 "/_api/aql/lock/" + queryId);
-            res = cc->syncRequest("", coordTransactionID, "shard:" + shardId,
+            res = cc->syncRequest("", coordTransactionID,
+                                  inst->destinationForShard(shardId),
                                   RequestType::PUT, url, "{}", headers, 90.0);
           }
           if (res->status != CL_COMM_SENT) {
@@ -1379,7 +1453,8 @@ ExecutionEngine* ExecutionEngine::instantiateFromPlan(
                   "/_api/aql/shutdown/" + queryId);
               std::unordered_map<std::string, std::string> headers;
               auto res =
-                  cc->syncRequest("", coordTransactionID, "shard:" + shardId,
+                  cc->syncRequest("", coordTransactionID,
+                                  inst->destinationForShard(shardId),
                                   arangodb::rest::RequestType::PUT,
                                   url, "{\"code\": 0}", headers, 120.0);
               // Ignore result, we need to try to remove all.
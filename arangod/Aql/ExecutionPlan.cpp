@@ -22,6 +22,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "ExecutionPlan.h"
+#include "Aql/Aggregator.h"
 #include "Aql/Ast.h"
 #include "Aql/AstNode.h"
 #include "Aql/CollectNode.h"
@@ -1089,13 +1090,26 @@ ExecutionNode* ExecutionPlan::fromNodeCollect(ExecutionNode* previous,
       TRI_ASSERT(expression->numMembers() == 1);
 
       auto args = expression->getMember(0);
-      // the number of arguments should also be one (note: this has been
-      // validated before)
+      // the number of arguments has been validated before
       TRI_ASSERT(args->type == NODE_TYPE_ARRAY);
-      TRI_ASSERT(args->numMembers() == 1);
+      TRI_ASSERT(args->numMembers() ==
+                 Aggregator::numArguments(func->externalName));
 
       auto arg = args->getMember(0);
 
+      if (args->numMembers() > 1) {
+        // the other arguments are parameters of the aggregate function
+        // and must be the same for all rows
+        for (size_t j = 1; j < args->numMembers(); ++j) {
+          if (!args->getMember(j)->isConstant()) {
+            THROW_ARANGO_EXCEPTION(
+                TRI_ERROR_QUERY_INVALID_AGGREGATE_EXPRESSION);
+          }
+        }
+        // the aggregator gets all arguments as one array
+        arg = args;
+      }
+
       if (arg->type == NODE_TYPE_REFERENCE) {
         // operand is a variable
         auto e = static_cast<Variable*>(arg->getData());
@@ -39,6 +39,8 @@ void ExecutionStats::toVelocyPack(VPackBuilder& builder) const {
   builder.add("scannedIndex", VPackValue(scannedIndex));
   builder.add("filtered", VPackValue(filtered));
   builder.add("httpRequests", VPackValue(httpRequests));
+  builder.add("documentsCopied", VPackValue(documentsCopied));
+  builder.add("bytesCopied", VPackValue(bytesCopied));
 
   if (fullCount > -1) {
     // fullCount is exceptional. it has a default value of -1 and is
@@ -58,6 +60,8 @@ void ExecutionStats::toVelocyPackStatic(VPackBuilder& builder) {
   builder.add("scannedIndex", VPackValue(0));
   builder.add("filtered", VPackValue(0));
   builder.add("httpRequests", VPackValue(0));
+  builder.add("documentsCopied", VPackValue(0));
+  builder.add("bytesCopied", VPackValue(0));
   builder.add("fullCount", VPackValue(-1));
   builder.add("executionTime", VPackValue(0.0));
   builder.close();
@@ -70,6 +74,8 @@ ExecutionStats::ExecutionStats()
       scannedIndex(0),
       filtered(0),
       httpRequests(0),
+      documentsCopied(0),
+      bytesCopied(0),
       fullCount(-1),
       executionTime(0.0) {}
 
@@ -90,6 +96,14 @@ ExecutionStats::ExecutionStats(VPackSlice const& slice)
     httpRequests = slice.get("httpRequests").getNumber<int64_t>();
   }
 
+  // note: the copy counters are not sent by older servers
+  if (slice.hasKey("documentsCopied")) {
+    documentsCopied = slice.get("documentsCopied").getNumber<int64_t>();
+  }
+  if (slice.hasKey("bytesCopied")) {
+    bytesCopied = slice.get("bytesCopied").getNumber<int64_t>();
+  }
+
   // note: fullCount is an optional attribute!
   if (slice.hasKey("fullCount")) {
     fullCount = slice.get("fullCount").getNumber<int64_t>();
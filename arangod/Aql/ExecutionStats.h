@@ -58,6 +58,8 @@ struct ExecutionStats {
     scannedIndex += summand.scannedIndex;
     filtered += summand.filtered;
     httpRequests += summand.httpRequests;
+    documentsCopied += summand.documentsCopied;
+    bytesCopied += summand.bytesCopied;
     if (summand.fullCount > 0) {
       // fullCount may be negative, don't add it then
       fullCount += summand.fullCount;
@@ -72,6 +74,8 @@ struct ExecutionStats {
     scannedIndex = 0;
     filtered = 0;
     httpRequests = 0;
+    documentsCopied = 0;
+    bytesCopied = 0;
     fullCount = -1;
     executionTime = 0.0;
   }
@@ -94,6 +98,15 @@ struct ExecutionStats {
 
   int64_t httpRequests;
 
+  /// @brief number of documents and values that had to be copied into
+  /// query-owned memory while passing through the execution blocks.
+  /// documents that can be referenced in place (e.g. in the memory-mapped
+  /// datafiles of the MMFiles engine) are not counted
+  int64_t documentsCopied;
+
+  /// @brief total number of bytes copied for the above
+  int64_t bytesCopied;
+
   /// @brief total number of results, before applying last limit
   int64_t fullCount;
   
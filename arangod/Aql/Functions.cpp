@@ -28,11 +28,14 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include "Aql/Aggregator.h"
 #include "Aql/Function.h"
 #include "Aql/Query.h"
 #include "Basics/Exceptions.h"
+#include "Basics/HyperLogLog.h"
 #include "Basics/ScopeGuard.h"
 #include "Basics/StringBuffer.h"
+#include "Basics/TDigest.h"
 #include "Basics/Utf8Helper.h"
 #include "Basics/VPackStringBufferAdapter.h"
 #include "Basics/VelocyPackHelper.h"
@@ -3597,6 +3600,121 @@ AqlValue Functions::Percentile(arangodb::aql::Query* query,
   return NumberValue(trx, values[static_cast<size_t>(pos) - 1], true);
 }
 
+/// @brief function COUNT_DISTINCT
+AqlValue Functions::CountDistinct(arangodb::aql::Query* query,
+                                  transaction::Methods* trx,
+                                  VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "COUNT_DISTINCT", 1, 1);
+
+  AqlValue list = ExtractFunctionParameterValue(trx, parameters, 0);
+
+  if (!list.isArray()) {
+    RegisterWarning(query, "COUNT_DISTINCT", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
+  }
+
+  AqlValueMaterializer materializer(trx);
+  VPackSlice slice = materializer.slice(list, false);
+
+  // same semantics as the COUNT_DISTINCT aggregator
+  DistinctValues values(trx->transactionContextPtr()->getVPackOptions());
+
+  for (auto const& s : VPackArrayIterator(slice)) {
+    if (!s.isNone()) {
+      values.add(s);
+    }
+  }
+
+  transaction::BuilderLeaser builder(trx);
+  builder->add(VPackValue(static_cast<uint64_t>(values.size())));
+  return AqlValue(builder.get());
+}
+
+/// @brief function COUNT_DISTINCT_APPROX
+AqlValue Functions::CountDistinctApprox(
+    arangodb::aql::Query* query, transaction::Methods* trx,
+    VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "COUNT_DISTINCT_APPROX", 1, 1);
+
+  AqlValue list = ExtractFunctionParameterValue(trx, parameters, 0);
+
+  if (!list.isArray()) {
+    RegisterWarning(query, "COUNT_DISTINCT_APPROX",
+                    TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
+  }
+
+  AqlValueMaterializer materializer(trx);
+  VPackSlice slice = materializer.slice(list, false);
+
+  arangodb::basics::HyperLogLog sketch;
+  for (auto const& element : VPackArrayIterator(slice)) {
+    sketch.insert(element.normalizedHash());
+  }
+
+  transaction::BuilderLeaser builder(trx);
+  builder->add(VPackValue(sketch.estimate()));
+  return AqlValue(builder.get());
+}
+
+/// @brief function PERCENTILE_APPROX
+AqlValue Functions::PercentileApprox(
+    arangodb::aql::Query* query, transaction::Methods* trx,
+    VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "PERCENTILE_APPROX", 2, 2);
+
+  AqlValue list = ExtractFunctionParameterValue(trx, parameters, 0);
+
+  if (!list.isArray()) {
+    RegisterWarning(query, "PERCENTILE_APPROX", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
+  }
+
+  AqlValue border = ExtractFunctionParameterValue(trx, parameters, 1);
+
+  if (!border.isNumber()) {
+    RegisterWarning(query, "PERCENTILE_APPROX",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
+  }
+
+  bool unused = false;
+  double p = border.toDouble(trx, unused);
+  if (p <= 0.0 || p > 100.0) {
+    RegisterWarning(query, "PERCENTILE_APPROX",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
+  }
+
+  AqlValueMaterializer materializer(trx);
+  VPackSlice slice = materializer.slice(list, false);
+
+  arangodb::basics::TDigest digest;
+  for (auto const& element : VPackArrayIterator(slice)) {
+    if (element.isNull()) {
+      continue;
+    }
+    if (!element.isNumber()) {
+      RegisterWarning(query, "PERCENTILE_APPROX",
+                      TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
+      return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
+    }
+    double const number = ValueToNumber(element, unused);
+    if (!std::isfinite(number)) {
+      RegisterWarning(query, "PERCENTILE_APPROX",
+                      TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
+      return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
+    }
+    digest.insert(number);
+  }
+
+  if (digest.empty()) {
+    return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
+  }
+
+  return NumberValue(trx, digest.quantile(p / 100.0), true);
+}
+
 /// @brief function RANGE
 AqlValue Functions::Range(arangodb::aql::Query* query,
                           transaction::Methods* trx,
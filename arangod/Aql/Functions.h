@@ -297,6 +297,14 @@ struct Functions {
                           VPackFunctionParameters const&);
    static AqlValue Percentile(arangodb::aql::Query*, transaction::Methods*,
                               VPackFunctionParameters const&);
+   static AqlValue CountDistinct(arangodb::aql::Query*, transaction::Methods*,
+                                 VPackFunctionParameters const&);
+   static AqlValue CountDistinctApprox(arangodb::aql::Query*,
+                                       transaction::Methods*,
+                                       VPackFunctionParameters const&);
+   static AqlValue PercentileApprox(arangodb::aql::Query*,
+                                    transaction::Methods*,
+                                    VPackFunctionParameters const&);
    static AqlValue Range(arangodb::aql::Query*, transaction::Methods*,
                          VPackFunctionParameters const&);
    static AqlValue Position(arangodb::aql::Query*, transaction::Methods*,
@@ -153,6 +153,14 @@ void IndexBlock::executeExpressions() {
 
 int IndexBlock::initialize() {
   DEBUG_BEGIN_BLOCK();
+  if (_collection->isSatellite()) {
+    // satellite lookups can be part of the snippets of other collections.
+    // make sure the local copy is up-to-date
+    _collection->waitForSatelliteSync(
+        _engine->getQuery()->getNumericOption<double>("satelliteSyncWait",
+                                                      60.0));
+  }
+
   int res = ExecutionBlock::initialize();
 
   auto en = static_cast<IndexNode const*>(getPlanNode());
@@ -517,9 +525,12 @@ AqlItemBlock* IndexBlock::getSome(size_t atLeast, size_t atMost) {
         }
       }
       if (_cursor->collection()->readDocument(_trx, token, *_mmdr)) {
+        AqlValue a(_mmdr->createAqlValue());
+        AqlValueGuard guard(a, true);
+        countCopy(a);
         res->setValue(_returned,
-                      static_cast<arangodb::aql::RegisterId>(curRegs),
-                      _mmdr->createAqlValue());
+                      static_cast<arangodb::aql::RegisterId>(curRegs), a);
+        guard.steal();
 
         if (_returned > 0) {
           // re-use already copied AqlValues
@@ -536,9 +547,12 @@ AqlItemBlock* IndexBlock::getSome(size_t atLeast, size_t atMost) {
     callback = [&](DocumentIdentifierToken const& token) {
       TRI_ASSERT(res.get() != nullptr);
       if (_cursor->collection()->readDocument(_trx, token, *_mmdr)) {
+        AqlValue a(_mmdr->createAqlValue());
+        AqlValueGuard guard(a, true);
+        countCopy(a);
         res->setValue(_returned,
-                      static_cast<arangodb::aql::RegisterId>(curRegs),
-                      _mmdr->createAqlValue());
+                      static_cast<arangodb::aql::RegisterId>(curRegs), a);
+        guard.steal();
 
         if (_returned > 0) {
           // re-use already copied AqlValues
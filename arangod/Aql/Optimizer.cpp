@@ -28,6 +28,11 @@
 
 using namespace arangodb::aql;
 
+/// @brief plans whose estimated cost exceeds the cost of the cheapest plan
+/// by more than this factor are discarded once all index-selecting rules
+/// have run
+static double const PruneCostFactor = 10.0;
+
 // @brief constructor, this will initialize the rules database
 Optimizer::Optimizer(size_t maxNumberOfPlans)
     : _maxNumberOfPlans(maxNumberOfPlans > 0 ? maxNumberOfPlans
@@ -90,6 +95,7 @@ int Optimizer::createPlans(ExecutionPlan* plan,
   }
 
   bool runOnlyRequiredRules = false;
+  bool plansPruned = false;
   int leastDoneLevel = 0;
 
   TRI_ASSERT(!OptimizerRulesFeature::_rules.empty());
@@ -185,6 +191,15 @@ int Optimizer::createPlans(ExecutionPlan* plan,
     }
     // std::cout << "Least done level is " << leastDoneLevel << std::endl;
 
+    if (!plansPruned &&
+        leastDoneLevel >= static_cast<int>(OptimizerRule::useIndexForSortRule_pass6)) {
+      // all plans have passed the rules that pick indexes. their costs are
+      // now meaningful enough to throw away the hopeless ones, so they
+      // don't need to go through all of the remaining rules
+      prunePlans();
+      plansPruned = true;
+    }
+
     // Stop if the result gets out of hand:
     if (!runOnlyRequiredRules && _plans.size() >= _maxNumberOfPlans) {
       // must still iterate over all REQUIRED remaining transformation rules
@@ -194,7 +209,7 @@ int Optimizer::createPlans(ExecutionPlan* plan,
     }
   }
 
-  _stats.plansCreated = _plans.size();
+  _stats.plansCreated = _plans.size() + _stats.plansPruned;
 
   TRI_ASSERT(_plans.size() >= 1);
 
@@ -226,6 +241,40 @@ void Optimizer::estimatePlans() {
   }
 }
 
+/// @brief prunePlans, drops all plans that are much more expensive than
+/// the currently cheapest plan. the cheapest plan is always kept
+void Optimizer::prunePlans() {
+  if (_plans.size() <= 1) {
+    return;
+  }
+
+  estimatePlans();
+
+  double bestCost = _plans.list.front()->getCost();
+  for (auto& p : _plans.list) {
+    bestCost = (std::min)(bestCost, p->getCost());
+  }
+
+  double const threshold = bestCost * PruneCostFactor;
+
+  PlanList kept;
+  while (_plans.size() > 0) {
+    int level;
+    std::unique_ptr<ExecutionPlan> p(_plans.pop_front(level));
+
+    if (p->getCost() > threshold) {
+      // p will be deleted here
+      ++_stats.plansPruned;
+      continue;
+    }
+
+    kept.push_back(p.get(), level);
+    p.release();
+  }
+
+  _plans.steal(kept);
+}
+
 /// @brief sortPlans
 void Optimizer::sortPlans() {
   std::sort(_plans.list.begin(), _plans.list.end(),
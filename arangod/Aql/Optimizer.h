@@ -43,6 +43,7 @@ class Optimizer {
     int64_t rulesExecuted = 0;
     int64_t rulesSkipped = 0;
     int64_t plansCreated = 1;  // 1 for the initial plan
+    int64_t plansPruned = 0;
 
     std::shared_ptr<VPackBuilder> toVelocyPack() const {
       auto result = std::make_shared<VPackBuilder>();
@@ -51,6 +52,7 @@ class Optimizer {
         result->add("rulesExecuted", VPackValue(rulesExecuted));
         result->add("rulesSkipped", VPackValue(rulesSkipped));
         result->add("plansCreated", VPackValue(plansCreated));
+        result->add("plansPruned", VPackValue(plansPruned));
       }
       return result;
     }
@@ -216,6 +218,9 @@ class Optimizer {
   /// @brief estimatePlans
   void estimatePlans();
 
+  /// @brief prunePlans
+  void prunePlans();
+
   /// @brief sortPlans
   void sortPlans();
 
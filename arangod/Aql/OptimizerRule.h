@@ -191,6 +191,10 @@ struct OptimizerRule {
     removeSatelliteJoinsRule_pass10,
 #endif
 
+    // move lookups in satellite collections into the DB server snippets
+    // of the collections they are joined with
+    distributeSatelliteJoinsRule_pass10,
+
     // recognize that a RemoveNode can be moved to the shards
     undistributeRemoveAfterEnumCollRule_pass10
   };
@@ -2065,6 +2065,264 @@ static bool NextPermutationTuple(std::vector<size_t>& data,
   return false;
 }
 
+/// @brief maximum length of a run of adjacent enumerations for which the
+/// join order is searched with dynamic programming (the search is exponential
+/// in the length of the run)
+static size_t const MaxJoinOrderSearchLength = 12;
+
+/// @brief determine the cheapest nesting order of enumerations producing
+/// counts[i] items each, given the index lookups possible in predicates
+bool arangodb::aql::findCheapestJoinOrder(
+    std::vector<double> const& counts,
+    std::vector<JoinPredicate> const& predicates,
+    std::vector<size_t>& result) {
+  size_t const n = counts.size();
+
+  if (n < 2 || n > MaxJoinOrderSearchLength) {
+    return false;
+  }
+
+  size_t const numSubsets = static_cast<size_t>(1) << n;
+  double const unset = -1.0;
+
+  // costs[s] is the cost of the cheapest nesting of the nodes in subset s,
+  // items[s] the number of items produced by it, and last[s] the innermost
+  // node of that nesting
+  std::vector<double> costs(numSubsets, unset);
+  std::vector<double> items(numSubsets, 0.0);
+  std::vector<size_t> last(numSubsets, 0);
+  costs[0] = 0.0;
+  items[0] = 1.0;
+
+  for (size_t subset = 0; subset < numSubsets; ++subset) {
+    if (costs[subset] < 0.0) {
+      continue;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+      size_t const bit = static_cast<size_t>(1) << i;
+      if ((subset & bit) != 0) {
+        continue;
+      }
+
+      // full scan of the node per incoming item, unless an index lookup
+      // is possible with the values provided by the outer loops
+      double produced = counts[i];
+      double work = counts[i];
+      for (auto const& p : predicates) {
+        if (p.target == i && (p.dependsOn & ~subset) == 0 &&
+            p.matches < produced) {
+          produced = p.matches;
+          work = p.matches + 1.0;
+        }
+      }
+
+      size_t const next = subset | bit;
+      double const cost = costs[subset] + items[subset] * work;
+
+      if (costs[next] < 0.0 || cost < costs[next]) {
+        costs[next] = cost;
+        items[next] = items[subset] * produced;
+        last[next] = i;
+      }
+    }
+  }
+
+  // walk back from the full set, collecting the nodes from the inside out
+  result.clear();
+  size_t subset = numSubsets - 1;
+  while (subset != 0) {
+    size_t const i = last[subset];
+    result.emplace_back(i);
+    subset &= ~(static_cast<size_t>(1) << i);
+  }
+
+  TRI_ASSERT(result.size() == n);
+  return true;
+}
+
+/// @brief estimate the number of documents returned for a lookup of
+/// attribute in the collection of the EnumerateCollectionNode, or return
+/// a negative value if no index can be used for the lookup
+static double EstimateIndexLookup(
+    transaction::Methods* trx, EnumerateCollectionNode const* node,
+    std::vector<arangodb::basics::AttributeName> const& attribute,
+    double count) {
+  double best = -1.0;
+
+  for (auto const& idx :
+       trx->indexesForCollection(node->collection()->name)) {
+    auto const& fields = idx->fields();
+
+    if (fields.empty() || idx->sparse() ||
+        !arangodb::basics::AttributeName::isIdentical(fields[0], attribute,
+                                                      false)) {
+      continue;
+    }
+
+    double matches;
+    if (idx->unique() && fields.size() == 1) {
+      matches = 1.0;
+    } else if (idx->hasSelectivityEstimate() &&
+               idx->selectivityEstimate() > 0.0) {
+      matches = 1.0 / idx->selectivityEstimate();
+    } else {
+      // no estimate available. assume the index will filter out most
+      // of the documents
+      matches = count / 10.0;
+    }
+    matches = (std::max)(1.0, (std::min)(matches, count));
+
+    if (best < 0.0 || matches < best) {
+      best = matches;
+    }
+  }
+
+  return best;
+}
+
+/// @brief collect the equality join conditions from all FILTERs in the plan
+/// that connect the enumerations of a run
+static void FindJoinPredicates(
+    ExecutionPlan* plan, std::vector<ExecutionNode*> const& run,
+    std::vector<double> const& counts,
+    std::vector<JoinPredicate>& predicates) {
+  std::unordered_map<Variable const*, size_t> positions;
+  for (size_t i = 0; i < run.size(); ++i) {
+    for (auto const& v : run[i]->getVariablesSetHere()) {
+      positions.emplace(v, i);
+    }
+  }
+
+  transaction::Methods* trx = plan->getAst()->query()->trx();
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> filters{a};
+  plan->findNodesOfType(filters, EN::FILTER, true);
+
+  std::vector<AstNode const*> stack;
+  for (auto const& f : filters) {
+    auto setter = plan->getVarSetBy(
+        static_cast<FilterNode const*>(f)->getVariablesUsedHere()[0]->id);
+
+    if (setter == nullptr || setter->getType() != EN::CALCULATION) {
+      continue;
+    }
+    auto expression = static_cast<CalculationNode const*>(setter)->expression();
+    if (expression == nullptr || expression->node() == nullptr) {
+      continue;
+    }
+
+    stack.clear();
+    stack.emplace_back(expression->node());
+
+    while (!stack.empty()) {
+      AstNode const* node = stack.back();
+      stack.pop_back();
+
+      if (node->type == NODE_TYPE_OPERATOR_BINARY_AND ||
+          node->type == NODE_TYPE_OPERATOR_NARY_AND) {
+        for (size_t i = 0; i < node->numMembers(); ++i) {
+          stack.emplace_back(node->getMember(i));
+        }
+        continue;
+      }
+
+      if (node->type != NODE_TYPE_OPERATOR_BINARY_EQ) {
+        continue;
+      }
+
+      for (size_t side = 0; side < 2; ++side) {
+        AstNode const* lookup = node->getMember(side);
+        AstNode const* value = node->getMember(1 - side);
+
+        std::pair<Variable const*,
+                  std::vector<arangodb::basics::AttributeName>> access;
+        if (!lookup->isAttributeAccessForVariable(access)) {
+          continue;
+        }
+
+        auto it = positions.find(access.first);
+        if (it == positions.end() ||
+            run[it->second]->getType() != EN::ENUMERATE_COLLECTION) {
+          continue;
+        }
+        size_t const target = it->second;
+
+        std::unordered_set<Variable const*> referenced;
+        Ast::getReferencedVariables(value, referenced);
+
+        uint32_t dependsOn = 0;
+        bool selfReference = false;
+        for (auto const& v : referenced) {
+          auto it2 = positions.find(v);
+          if (it2 == positions.end()) {
+            // variables from outside the run are available anyway
+            continue;
+          }
+          if (it2->second == target) {
+            selfReference = true;
+            break;
+          }
+          dependsOn |= (static_cast<uint32_t>(1) << it2->second);
+        }
+
+        if (selfReference) {
+          continue;
+        }
+
+        double matches = EstimateIndexLookup(
+            trx, static_cast<EnumerateCollectionNode const*>(run[target]),
+            access.second, counts[target]);
+
+        if (matches >= 0.0) {
+          predicates.emplace_back(JoinPredicate{target, dependsOn, matches});
+        }
+      }
+    }
+  }
+}
+
+/// @brief determine the cheapest nesting order of a run of adjacent
+/// enumerations, using dynamic programming over all subsets of the run.
+/// run contains the nodes from the innermost to the outermost loop. the
+/// result has the same layout as a permutation tuple: result[i] is the
+/// position in run of the node that becomes the i-th node from the inside
+static bool FindCheapestJoinOrder(ExecutionPlan* plan,
+                                  std::vector<ExecutionNode*> const& run,
+                                  std::vector<size_t>& result) {
+  size_t const n = run.size();
+
+  if (n < 2 || n > MaxJoinOrderSearchLength) {
+    return false;
+  }
+
+  transaction::Methods* trx = plan->getAst()->query()->trx();
+
+  // number of items produced by each enumeration per incoming item
+  std::vector<double> counts;
+  counts.reserve(n);
+  for (auto const& node : run) {
+    double count;
+    if (node->getType() == EN::ENUMERATE_COLLECTION) {
+      count = static_cast<double>(
+          static_cast<EnumerateCollectionNode const*>(node)->collection()->count(trx));
+    } else {
+      size_t incoming = 0;
+      node->getFirstDependency()->getCost(incoming);
+      size_t nrItems = 0;
+      node->getCost(nrItems);
+      count = (incoming > 0) ? static_cast<double>(nrItems) / incoming : 100.0;
+    }
+    counts.emplace_back((std::max)(1.0, count));
+  }
+
+  std::vector<JoinPredicate> predicates;
+  FindJoinPredicates(plan, run, counts, predicates);
+
+  return arangodb::aql::findCheapestJoinOrder(counts, predicates, result);
+}
+
 /// @brief interchange adjacent EnumerateCollectionNodes in all possible ways
 void arangodb::aql::interchangeAdjacentEnumerationsRule(
     Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
@@ -2135,16 +2393,7 @@ void arangodb::aql::interchangeAdjacentEnumerationsRule(
   // independently. This is why we need to compute all permutation tuples.
 
   if (!starts.empty()) {
-    NextPermutationTuple(permTuple, starts);  // will never return false
-
-    do {
-      // check if we already have enough plans (plus the one plan that we will
-      // add at the end of this function)
-      if (opt->hasEnoughPlans(1)) {
-        // have enough plans. stop permutations
-        break;
-      }
-
+    auto addPermutedPlan = [&](std::vector<size_t> const& tuple) {
       // Clone the plan:
       std::unique_ptr<ExecutionPlan> newPlan(plan->clone());
 
@@ -2159,11 +2408,11 @@ void arangodb::aql::interchangeAdjacentEnumerationsRule(
       for (size_t i = 0; i < starts.size(); i++) {
         size_t lowBound = starts[i];
         size_t highBound =
-            (i < starts.size() - 1) ? starts[i + 1] : permTuple.size();
+            (i < starts.size() - 1) ? starts[i + 1] : tuple.size();
         // We need to remove the nodes
         // newNodes[lowBound..highBound-1] in newPlan and replace
         // them by the same ones in a different order, given by
-        // permTuple[lowBound..highBound-1].
+        // tuple[lowBound..highBound-1].
         auto parent = newNodes[lowBound]->getFirstParent();
 
         TRI_ASSERT(parent != nullptr);
@@ -2175,12 +2424,54 @@ void arangodb::aql::interchangeAdjacentEnumerationsRule(
 
         // And insert them in the new order:
         for (size_t j = highBound; j-- != lowBound;) {
-          newPlan->insertDependency(parent, newNodes[permTuple[j]]);
+          newPlan->insertDependency(parent, newNodes[tuple[j]]);
         }
       }
 
       // OK, the new plan is ready, let's report it:
       opt->addPlan(std::move(newPlan), rule, true);
+    };
+
+    // Search the cheapest order of each run first, so that it is part of
+    // the plans even if the number of permutations exceeds the maximum
+    // number of plans
+    std::vector<size_t> cheapestTuple(permTuple);
+    std::vector<size_t> runOrder;
+    for (size_t i = 0; i < starts.size(); i++) {
+      size_t lowBound = starts[i];
+      size_t highBound =
+          (i < starts.size() - 1) ? starts[i + 1] : permTuple.size();
+
+      std::vector<ExecutionNode*> run(nodesToPermute.begin() + lowBound,
+                                      nodesToPermute.begin() + highBound);
+
+      if (FindCheapestJoinOrder(plan.get(), run, runOrder)) {
+        for (size_t j = 0; j < runOrder.size(); j++) {
+          cheapestTuple[lowBound + j] = lowBound + runOrder[j];
+        }
+      }
+    }
+
+    if (cheapestTuple != permTuple && !opt->hasEnoughPlans(1)) {
+      addPermutedPlan(cheapestTuple);
+    }
+
+    NextPermutationTuple(permTuple, starts);  // will never return false
+
+    do {
+      // check if we already have enough plans (plus the one plan that we will
+      // add at the end of this function)
+      if (opt->hasEnoughPlans(1)) {
+        // have enough plans. stop permutations
+        break;
+      }
+
+      if (permTuple == cheapestTuple) {
+        // already added above
+        continue;
+      }
+
+      addPermutedPlan(permTuple);
     } while (NextPermutationTuple(permTuple, starts));
   }
 
@@ -2816,6 +3107,298 @@ void arangodb::aql::removeUnnecessaryRemoteScatterRule(
   opt->addPlan(std::move(plan), rule, !toUnlink.empty());
 }
 
+/// @brief whether or not a node reads from a satellite collection
+static bool IsSatelliteAccess(ExecutionNode const* node) {
+  if (node->getType() == EN::ENUMERATE_COLLECTION) {
+    return static_cast<EnumerateCollectionNode const*>(node)
+        ->collection()
+        ->isSatellite();
+  }
+  if (node->getType() == EN::INDEX) {
+    return static_cast<IndexNode const*>(node)->collection()->isSatellite();
+  }
+  return false;
+}
+
+/// @brief whether or not the DB server snippet ending in <node> contains
+/// data-modification operations
+static bool SnippetModifiesData(ExecutionNode const* node) {
+  while (node != nullptr && node->getType() != EN::REMOTE) {
+    if (node->isModificationNode()) {
+      return true;
+    }
+    node = node->getFirstDependency();
+  }
+  return false;
+}
+
+/// @brief find the cluster nodes inside a subquery that only reads
+/// satellite collections. returns false if the subquery cannot be executed
+/// on a DB server or if it does not read any satellite collection
+static bool FindSatelliteSubqueryClusterNodes(
+    SubqueryNode const* sub, std::vector<ExecutionNode*>& clusterNodes) {
+  std::vector<ExecutionNode*> stack({sub->getSubquery()});
+  bool readsSatellite = false;
+
+  while (!stack.empty()) {
+    ExecutionNode* current = stack.back();
+    stack.pop_back();
+
+    switch (current->getType()) {
+      case EN::SINGLETON:
+      case EN::FILTER:
+      case EN::ENUMERATE_LIST:
+      case EN::SORT:
+      case EN::LIMIT:
+      case EN::COLLECT:
+      case EN::RETURN:
+        break;
+
+      case EN::CALCULATION:
+        if (!static_cast<CalculationNode const*>(current)
+                 ->expression()
+                 ->canRunOnDBServer()) {
+          return false;
+        }
+        break;
+
+      case EN::ENUMERATE_COLLECTION:
+      case EN::INDEX:
+        if (!IsSatelliteAccess(current)) {
+          return false;
+        }
+        readsSatellite = true;
+        break;
+
+      case EN::SCATTER:
+      case EN::REMOTE:
+      case EN::GATHER:
+        clusterNodes.emplace_back(current);
+        break;
+
+      default:
+        // modifications, traversals, nested subqueries etc.
+        return false;
+    }
+
+    current->addDependencies(stack);
+  }
+
+  return readsSatellite;
+}
+
+/// @brief find the upper REMOTE of a satellite snippet that follows a
+/// SCATTER, i.e. SCATTER -> REMOTE -> satellite access -> ... -> REMOTE ->
+/// GATHER. returns nullptr if the snippet cannot be joined on the shards
+static RemoteNode* FindSatelliteSnippetEnd(ExecutionNode const* scatter) {
+  if (scatter->getParents().size() != 1 ||
+      scatter->getFirstParent()->getType() != EN::REMOTE) {
+    return nullptr;
+  }
+  auto satRemote = scatter->getFirstParent();
+  if (satRemote->getParents().size() != 1 ||
+      !IsSatelliteAccess(satRemote->getFirstParent())) {
+    return nullptr;
+  }
+
+  // all nodes of the satellite snippet must produce the same result when
+  // executed once per shard of the sharded collection
+  ExecutionNode* current = satRemote->getFirstParent();
+  while (current != nullptr && current->getType() != EN::REMOTE) {
+    auto type = current->getType();
+    if (type == EN::CALCULATION) {
+      if (!static_cast<CalculationNode const*>(current)
+               ->expression()
+               ->canRunOnDBServer()) {
+        return nullptr;
+      }
+    } else if (type != EN::FILTER && type != EN::ENUMERATE_LIST &&
+               !IsSatelliteAccess(current)) {
+      return nullptr;
+    }
+    current = (current->getParents().size() == 1 ? current->getFirstParent()
+                                                 : nullptr);
+  }
+  if (current == nullptr || current->getParents().size() != 1 ||
+      current->getFirstParent()->getType() != EN::GATHER) {
+    return nullptr;
+  }
+
+  return static_cast<RemoteNode*>(current);
+}
+
+/// @brief returns how many of the nodes following a gather are moved into
+/// the DB server snippet below it
+size_t arangodb::aql::satelliteJoinMoves(
+    std::vector<SatelliteJoinNode> const& nodes) {
+  size_t moves = 0;
+
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    if (nodes[i] == SatelliteJoinNode::OTHER) {
+      break;
+    }
+    if (nodes[i] == SatelliteJoinNode::JOIN) {
+      // the join and all filters and calculations before it
+      moves = i + 1;
+    }
+  }
+
+  return moves;
+}
+
+/// @brief move satellite collection joins into the DB server snippets of
+/// the sharded collections they are joined with. this turns
+///
+///   ... sharded -> REMOTE -> GATHER -> SCATTER -> REMOTE -> satellite ...
+///
+/// into a lookup of the local copy of the satellite collection on each
+/// DB server, and does the same for subqueries that only read satellite
+/// collections. filters and calculations between the gather and such a
+/// join are moved along, but plans without satellite joins are left alone.
+/// this rule modifies the plan in place
+void arangodb::aql::distributeSatelliteJoinsRule(
+    Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
+    OptimizerRule const* rule) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::GATHER, true);
+
+  std::unordered_set<ExecutionNode*> unlinked;
+  bool modified = false;
+
+  for (auto& n : nodes) {
+    if (unlinked.find(n) != unlinked.end()) {
+      continue;
+    }
+
+    auto gather = static_cast<GatherNode*>(n);
+    auto remote = static_cast<RemoteNode*>(gather->getFirstDependency());
+    if (remote == nullptr || remote->getType() != EN::REMOTE ||
+        remote->collection() == nullptr ||
+        remote->collection()->isSatellite() ||
+        SnippetModifiesData(remote->getFirstDependency())) {
+      continue;
+    }
+
+    // inspect the nodes following the gather without modifying the plan.
+    // satellite snippets are looked through up to their upper gather
+    std::vector<ExecutionNode*> following;
+    std::vector<SatelliteJoinNode> kinds;
+    ExecutionNode* last = gather;
+
+    while (last->getParents().size() == 1) {
+      auto inspectNode = last->getFirstParent();
+      auto next = inspectNode;
+      SatelliteJoinNode kind = SatelliteJoinNode::OTHER;
+
+      switch (inspectNode->getType()) {
+        case EN::CALCULATION:
+          if (static_cast<CalculationNode const*>(inspectNode)
+                  ->expression()
+                  ->canRunOnDBServer()) {
+            kind = SatelliteJoinNode::FILTER;
+          }
+          break;
+
+        case EN::FILTER:
+          kind = SatelliteJoinNode::FILTER;
+          break;
+
+        case EN::SUBQUERY: {
+          std::vector<ExecutionNode*> clusterNodes;
+          if (FindSatelliteSubqueryClusterNodes(
+                  static_cast<SubqueryNode const*>(inspectNode),
+                  clusterNodes)) {
+            kind = SatelliteJoinNode::JOIN;
+          }
+          break;
+        }
+
+        case EN::SCATTER: {
+          auto upperRemote = FindSatelliteSnippetEnd(inspectNode);
+          if (upperRemote != nullptr) {
+            kind = SatelliteJoinNode::JOIN;
+            // continue after the upper gather
+            next = upperRemote->getFirstParent();
+          }
+          break;
+        }
+
+        default:
+          break;
+      }
+
+      if (kind == SatelliteJoinNode::OTHER) {
+        break;
+      }
+      following.emplace_back(inspectNode);
+      kinds.emplace_back(kind);
+      last = next;
+    }
+
+    size_t moves = satelliteJoinMoves(kinds);
+
+    for (size_t i = 0; i < moves; ++i) {
+      auto current = following[i];
+
+      switch (current->getType()) {
+        case EN::CALCULATION:
+        case EN::FILTER:
+          plan->unlinkNode(current);
+          plan->insertDependency(remote, current);
+          break;
+
+        case EN::SUBQUERY: {
+          // satellite collections have a single shard, so the gathers
+          // inside the subquery do not need to merge any sorted streams
+          std::vector<ExecutionNode*> clusterNodes;
+          FindSatelliteSubqueryClusterNodes(
+              static_cast<SubqueryNode const*>(current), clusterNodes);
+          for (auto& it : clusterNodes) {
+            plan->unlinkNode(it);
+            unlinked.emplace(it);
+          }
+          plan->unlinkNode(current);
+          plan->insertDependency(remote, current);
+          break;
+        }
+
+        case EN::SCATTER: {
+          auto satRemote = current->getFirstParent();
+          auto upperRemote = FindSatelliteSnippetEnd(current);
+          TRI_ASSERT(upperRemote != nullptr);
+          auto upperGather =
+              static_cast<GatherNode*>(upperRemote->getFirstParent());
+
+          // the upper snippet now runs on the shards of the sharded
+          // collection, and its results must be merged as before
+          upperRemote->setCollection(remote->collection());
+          upperGather->setCollection(gather->collection());
+          upperGather->setElements(gather->getElements());
+
+          for (auto& it : std::vector<ExecutionNode*>(
+                   {remote, gather, current, satRemote})) {
+            plan->unlinkNode(it);
+            unlinked.emplace(it);
+          }
+
+          gather = upperGather;
+          remote = upperRemote;
+          break;
+        }
+
+        default:
+          TRI_ASSERT(false);
+          break;
+      }
+
+      modified = true;
+    }
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
 /// WalkerWorker for undistributeRemoveAfterEnumColl
 class RemoveToEnumCollFinder final : public WalkerWorker<ExecutionNode> {
   ExecutionPlan* _plan;
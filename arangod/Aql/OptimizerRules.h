@@ -102,6 +102,22 @@ void useIndexForSortRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRu
 void removeFiltersCoveredByIndexRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
                                      OptimizerRule const*);
 
+/// @brief an equality join condition that allows looking up the documents
+/// of an enumeration via an index once some other enumerations are present
+struct JoinPredicate {
+  size_t target;     // position of the looked up enumeration in the run
+  uint32_t dependsOn;  // bitmask of run positions the lookup value depends on
+  double matches;    // estimated number of documents per lookup
+};
+
+/// @brief determine the cheapest nesting order of a run of adjacent
+/// enumerations which produce counts[i] items each per incoming item. the
+/// result lists the positions from the innermost to the outermost loop.
+/// returns false if the run is too short or too long to be searched
+bool findCheapestJoinOrder(std::vector<double> const& counts,
+                           std::vector<JoinPredicate> const& predicates,
+                           std::vector<size_t>& result);
+
 /// @brief interchange adjacent EnumerateCollectionNodes in all possible ways
 void interchangeAdjacentEnumerationsRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
                                          OptimizerRule const*);
@@ -167,6 +183,25 @@ void removeUnnecessaryRemoteScatterRule(Optimizer*, std::unique_ptr<ExecutionPla
 void undistributeRemoveAfterEnumCollRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
                                          OptimizerRule const*);
 
+/// @brief the nodes following a gather, as seen by
+/// distributeSatelliteJoinsRule
+enum class SatelliteJoinNode {
+  FILTER,  // a filter or calculation that can run on a DB server
+  JOIN,    // a satellite snippet or subquery that can be joined on the shards
+  OTHER    // anything else, ends the search
+};
+
+/// @brief returns how many of the nodes following a gather are moved into
+/// the DB server snippet below it. filters and calculations are only moved
+/// along with a satellite join that follows them
+size_t satelliteJoinMoves(std::vector<SatelliteJoinNode> const& nodes);
+
+/// @brief move joins with satellite collections and subqueries that only
+/// read satellite collections into the DB server snippets of the sharded
+/// collections they are joined with
+void distributeSatelliteJoinsRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                                  OptimizerRule const*);
+
 /// @brief this rule replaces expressions of the type:
 ///   x.val == 1 || x.val == 2 || x.val == 3
 //  with
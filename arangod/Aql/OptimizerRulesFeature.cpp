@@ -255,6 +255,10 @@ void OptimizerRulesFeature::addRules() {
                  removeSatelliteJoinsRule,
                  OptimizerRule::removeSatelliteJoinsRule_pass10, DoesNotCreateAdditionalPlans, CanBeDisabled);
 #endif
+
+    registerRule("distribute-satellite-joins",
+                 distributeSatelliteJoinsRule,
+                 OptimizerRule::distributeSatelliteJoinsRule_pass10, DoesNotCreateAdditionalPlans, CanBeDisabled);
   }
   
   // finally add the storage-engine specific rules
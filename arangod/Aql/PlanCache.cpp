@@ -22,22 +22,166 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "PlanCache.h"
-#include "Aql/Ast.h"
-#include "Aql/ExecutionPlan.h"
-#include "Aql/Query.h"
-#include "Basics/ReadLocker.h"
-#include "Basics/WriteLocker.h"
-#include "VocBase/vocbase.h"
+#include "Aql/AstNode.h"
+#include "Basics/Exceptions.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/fasthash.h"
+#include "VocBase/ticks.h"
 
 #include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb::aql;
 
 /// @brief singleton instance of the plan cache
 static arangodb::aql::PlanCache Instance;
 
+/// @brief check the bind parameter values of an execution against the
+/// bind parameters of the statement
+arangodb::Result PreparedStatement::checkBindParameters(
+    VPackSlice const& values) const {
+  for (auto const& it : bindParameters) {
+    if (!values.isObject() || !values.hasKey(it)) {
+      return Result(TRI_ERROR_QUERY_BIND_PARAMETER_MISSING,
+                    arangodb::basics::Exception::FillExceptionString(
+                        TRI_ERROR_QUERY_BIND_PARAMETER_MISSING, it.c_str()));
+    }
+  }
+
+  if (values.isObject()) {
+    for (auto const& it : VPackObjectIterator(values)) {
+      std::string const name = it.key.copyString();
+
+      if (std::find(bindParameters.begin(), bindParameters.end(), name) ==
+          bindParameters.end()) {
+        return Result(TRI_ERROR_QUERY_BIND_PARAMETER_UNDECLARED,
+                      arangodb::basics::Exception::FillExceptionString(
+                          TRI_ERROR_QUERY_BIND_PARAMETER_UNDECLARED,
+                          name.c_str()));
+      }
+    }
+  }
+
+  return Result();
+}
+
+/// @brief whether or not the value of a bind parameter can be left out of
+/// a plan template
+bool PlanTemplate::isDeferrable(VPackSlice const& value) {
+  if (value.isNull()) {
+    return false;
+  }
+
+  if (value.isArray()) {
+    for (auto const& it : VPackArrayIterator(value)) {
+      if (it.isNull()) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+/// @brief hash the class of a deferred value into a plan cache key
+uint64_t PlanTemplate::hashValueClass(VPackSlice const& value,
+                                      uint64_t hash) {
+  // integers and doubles are of the same class
+  char const* type = (value.isNumber() ? "number" : value.typeName());
+  hash = fasthash64(type, strlen(type), hash);
+
+  if (value.isArray()) {
+    uint64_t length = value.length();
+    uint64_t magnitude = 0;
+
+    while (length > 0) {
+      ++magnitude;
+      length >>= 1;
+    }
+    hash = fasthash64(&magnitude, sizeof(magnitude), hash);
+  }
+
+  return hash;
+}
+
+/// @brief whether or not a serialized AST node is a parameter node
+bool PlanTemplate::isParameterNode(VPackSlice const& slice) {
+  VPackSlice type = slice.get("typeID");
+  return (type.isNumber() &&
+          type.getNumber<int>() == static_cast<int>(NODE_TYPE_PARAMETER) &&
+          slice.get("name").isString());
+}
+
+/// @brief whether or not a serialized AST node is a value node
+bool PlanTemplate::isValueNode(VPackSlice const& slice) {
+  VPackSlice type = slice.get("typeID");
+  return (type.isNumber() &&
+          type.getNumber<int>() == static_cast<int>(NODE_TYPE_VALUE) &&
+          slice.hasKey("value"));
+}
+
+/// @brief count the parameter nodes in a serialized plan
+void PlanTemplate::countParameterNodes(
+    VPackSlice const& slice, std::unordered_map<std::string, size_t>& nodes) {
+  if (slice.isObject()) {
+    if (isParameterNode(slice)) {
+      ++nodes[slice.get("name").copyString()];
+      return;
+    }
+    if (isValueNode(slice)) {
+      return;
+    }
+    for (auto const& it : VPackObjectIterator(slice)) {
+      countParameterNodes(it.value, nodes);
+    }
+  } else if (slice.isArray()) {
+    for (auto const& it : VPackArrayIterator(slice)) {
+      countParameterNodes(it, nodes);
+    }
+  }
+}
+
+/// @brief copy a plan template, replacing its parameter nodes with the
+/// serialized values
+void PlanTemplate::inject(VPackSlice const& slice, VPackBuilder& builder,
+                          ValueWriter const& writer) {
+  if (slice.isObject()) {
+    if (isParameterNode(slice)) {
+      writer(slice.get("name").copyString(), builder);
+      return;
+    }
+    if (isValueNode(slice)) {
+      builder.add(slice);
+      return;
+    }
+
+    VPackObjectBuilder guard(&builder);
+    for (auto const& it : VPackObjectIterator(slice)) {
+      builder.add(it.key);
+      inject(it.value, builder, writer);
+    }
+  } else if (slice.isArray()) {
+    VPackArrayBuilder guard(&builder);
+    for (auto const& it : VPackArrayIterator(slice)) {
+      inject(it, builder, writer);
+    }
+  } else {
+    builder.add(slice);
+  }
+}
+
 /// @brief create the plan cache
-PlanCache::PlanCache() : _lock(), _plans() {}
+PlanCache::PlanCache(size_t maxPlansPerDatabase,
+                     size_t maxStatementsPerDatabase, double statementTtl,
+                     std::function<double()> clock)
+    : _lock(),
+      _plans(),
+      _statements(),
+      _maxPlansPerDatabase(maxPlansPerDatabase),
+      _maxStatementsPerDatabase(maxStatementsPerDatabase),
+      _statementTtl(statementTtl),
+      _clock(clock) {}
 
 /// @brief destroy the plan cache
 PlanCache::~PlanCache() {}
@@ -46,7 +190,7 @@ PlanCache::~PlanCache() {}
 std::shared_ptr<PlanCacheEntry> PlanCache::lookup(TRI_vocbase_t* vocbase, uint64_t hash,
                                                   char const* queryString,
                                                   size_t queryStringLength) {
-  READ_LOCKER(readLocker, _lock);
+  MUTEX_LOCKER(locker, _lock);
 
   auto it = _plans.find(vocbase);
 
@@ -55,44 +199,188 @@ std::shared_ptr<PlanCacheEntry> PlanCache::lookup(TRI_vocbase_t* vocbase, uint64
     return std::shared_ptr<PlanCacheEntry>();
   }
 
-  auto it2 = (*it).second.find(hash);
+  DatabasePlans& plans = (*it).second;
+  auto it2 = plans.plans.find(hash);
   
-  if (it2 == (*it).second.end()) {
+  if (it2 == plans.plans.end()) {
     // plan not found in cache
     return std::shared_ptr<PlanCacheEntry>();
   }
 
-  // plan found in cache
-  return (*it2).second;
+  auto const& entry = (*it2).second.first;
+
+  if (entry->queryString.size() != queryStringLength ||
+      memcmp(entry->queryString.c_str(), queryString,
+             queryStringLength) != 0) {
+    // different query string with the same hash value
+    return std::shared_ptr<PlanCacheEntry>();
+  }
+
+  // plan found in cache. it is now the most recently used one
+  plans.usage.splice(plans.usage.begin(), plans.usage, (*it2).second.second);
+  return entry;
 }
 
 /// @brief store a plan in the cache
-void PlanCache::store(
-    TRI_vocbase_t* vocbase, uint64_t hash, char const* queryString,
-    size_t queryStringLength, ExecutionPlan const* plan) {
- 
-  auto entry = std::make_unique<PlanCacheEntry>(std::string(queryString, queryStringLength), plan->toVelocyPack(plan->getAst(), true)); 
+void PlanCache::store(TRI_vocbase_t* vocbase, uint64_t hash,
+                      std::shared_ptr<PlanCacheEntry> entry) {
+  MUTEX_LOCKER(locker, _lock);
 
-  WRITE_LOCKER(writeLocker, _lock);
+  DatabasePlans& plans = _plans[vocbase];
 
-  auto it = _plans.find(vocbase);
+  auto it = plans.plans.find(hash);
 
-  if (it == _plans.end()) {
-    // create entry for the current database
-    it = _plans.emplace(vocbase, std::unordered_map<uint64_t, std::shared_ptr<PlanCacheEntry>>()).first;
+  if (it != plans.plans.end()) {
+    // replace the existing entry
+    (*it).second.first = std::move(entry);
+    plans.usage.splice(plans.usage.begin(), plans.usage, (*it).second.second);
+    return;
   }
 
-  // store cache entry
-  (*it).second.emplace(hash, std::move(entry));
+  while (!plans.usage.empty() && plans.plans.size() >= _maxPlansPerDatabase) {
+    // evict the least recently used plan
+    plans.plans.erase(plans.usage.back());
+    plans.usage.pop_back();
+  }
+
+  plans.usage.emplace_front(hash);
+  plans.plans.emplace(hash, std::make_pair(std::move(entry), plans.usage.begin()));
 }
 
 /// @brief invalidate all queries for a particular database
 void PlanCache::invalidate(TRI_vocbase_t* vocbase) {
-  WRITE_LOCKER(writeLocker, _lock);
+  MUTEX_LOCKER(locker, _lock);
 
   _plans.erase(vocbase);
 }
 
+/// @brief invalidate all queries for all databases
+void PlanCache::invalidate() {
+  MUTEX_LOCKER(locker, _lock);
+
+  _plans.clear();
+}
+
+/// @brief remove all plans and prepared statements for a database
+void PlanCache::drop(TRI_vocbase_t* vocbase) {
+  MUTEX_LOCKER(locker, _lock);
+
+  _plans.erase(vocbase);
+  _statements.erase(vocbase);
+}
+
+/// @brief register a prepared statement
+uint64_t PlanCache::registerStatement(
+    TRI_vocbase_t* vocbase, std::string&& queryString,
+    std::vector<std::string>&& bindParameters) {
+  uint64_t const id = TRI_NewTickServer();
+  auto statement = std::make_shared<PreparedStatement>(
+      id, std::move(queryString), std::move(bindParameters));
+
+  double const now = _clock();
+  statement->lastUsed = now;
+
+  MUTEX_LOCKER(locker, _lock);
+
+  DatabaseStatements& statements = _statements[vocbase];
+  expireStatements(statements, now);
+
+  while (!statements.usage.empty() &&
+         statements.statements.size() >= _maxStatementsPerDatabase) {
+    // evict the least recently used statement
+    statements.statements.erase(statements.usage.back());
+    statements.usage.pop_back();
+  }
+
+  statements.usage.emplace_front(id);
+  statements.statements.emplace(
+      id, std::make_pair(std::move(statement), statements.usage.begin()));
+
+  return id;
+}
+
+/// @brief lookup a prepared statement
+std::shared_ptr<PreparedStatement> PlanCache::lookupStatement(
+    TRI_vocbase_t* vocbase, uint64_t id) {
+  double const now = _clock();
+
+  MUTEX_LOCKER(locker, _lock);
+
+  auto it = _statements.find(vocbase);
+
+  if (it == _statements.end()) {
+    return std::shared_ptr<PreparedStatement>();
+  }
+
+  DatabaseStatements& statements = (*it).second;
+  expireStatements(statements, now);
+
+  auto it2 = statements.statements.find(id);
+
+  if (it2 == statements.statements.end()) {
+    return std::shared_ptr<PreparedStatement>();
+  }
+
+  auto const& statement = (*it2).second.first;
+  statement->lastUsed = now;
+  statements.usage.splice(statements.usage.begin(), statements.usage,
+                          (*it2).second.second);
+  return statement;
+}
+
+/// @brief remove a prepared statement
+bool PlanCache::removeStatement(TRI_vocbase_t* vocbase, uint64_t id) {
+  MUTEX_LOCKER(locker, _lock);
+
+  auto it = _statements.find(vocbase);
+
+  if (it == _statements.end()) {
+    return false;
+  }
+
+  DatabaseStatements& statements = (*it).second;
+  auto it2 = statements.statements.find(id);
+
+  if (it2 == statements.statements.end()) {
+    return false;
+  }
+
+  statements.usage.erase((*it2).second.second);
+  statements.statements.erase(it2);
+  return true;
+}
+
+/// @brief number of cached plans of a database
+size_t PlanCache::numberOfPlans(TRI_vocbase_t* vocbase) {
+  MUTEX_LOCKER(locker, _lock);
+
+  auto it = _plans.find(vocbase);
+  return (it == _plans.end()) ? 0 : (*it).second.plans.size();
+}
+
+/// @brief number of prepared statements of a database
+size_t PlanCache::numberOfStatements(TRI_vocbase_t* vocbase) {
+  MUTEX_LOCKER(locker, _lock);
+
+  auto it = _statements.find(vocbase);
+  return (it == _statements.end()) ? 0 : (*it).second.statements.size();
+}
+
+/// @brief remove expired statements, the least recently used ones are at
+/// the end of the usage list
+void PlanCache::expireStatements(DatabaseStatements& statements, double now) {
+  while (!statements.usage.empty()) {
+    auto it = statements.statements.find(statements.usage.back());
+    TRI_ASSERT(it != statements.statements.end());
+
+    if ((*it).second.first->lastUsed + _statementTtl >= now) {
+      break;
+    }
+
+    statements.statements.erase(it);
+    statements.usage.pop_back();
+  }
+}
+
 /// @brief get the plan cache instance
 PlanCache* PlanCache::instance() { return &Instance; }
-
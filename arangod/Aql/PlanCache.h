@@ -25,7 +25,12 @@
 #define ARANGOD_AQL_PLAN_CACHE_H 1
 
 #include "Basics/Common.h"
-#include "Basics/ReadWriteLock.h"
+#include "Basics/Mutex.h"
+#include "Basics/Result.h"
+
+#include <velocypack/Slice.h>
+
+#include <list>
 
 struct TRI_vocbase_t;
 
@@ -35,16 +40,83 @@ class Builder;
 }
 
 namespace aql {
-class ExecutionPlan;
-class VariableGenerator;
 
+/// @brief a cached plan. the plan is a template: bind parameters which are
+/// not part of the cache key are left in it as parameter nodes, and their
+/// values are injected into a copy of the plan for each execution
 struct PlanCacheEntry {
   PlanCacheEntry(std::string&& queryString, 
-                 std::shared_ptr<arangodb::velocypack::Builder> builder)
-      : queryString(std::move(queryString)), builder(builder) {}
+                 std::shared_ptr<arangodb::velocypack::Builder> builder,
+                 std::vector<std::string>&& structuralParameters,
+                 bool isModificationQuery)
+      : queryString(std::move(queryString)), builder(builder),
+        structuralParameters(std::move(structuralParameters)),
+        isModificationQuery(isModificationQuery) {}
 
   std::string queryString;
+  /// @brief the plan template. a nullptr means that the plans of the query
+  /// depend on the values of structuralParameters, and are cached under a
+  /// key that includes these values
   std::shared_ptr<arangodb::velocypack::Builder> builder;
+  /// @brief bind parameters whose values were folded into the plan
+  std::vector<std::string> structuralParameters;
+  bool isModificationQuery;
+};
+
+/// @brief a server-side prepared statement. executions of a prepared
+/// statement use the plan cache, so the statement is only parsed and
+/// optimized once, independent of the bind parameter values
+struct PreparedStatement {
+  PreparedStatement(uint64_t id, std::string&& queryString,
+                    std::vector<std::string>&& bindParameters)
+      : id(id), queryString(std::move(queryString)),
+        bindParameters(std::move(bindParameters)), lastUsed(0.0) {}
+
+  /// @brief check the bind parameter values of an execution against the
+  /// bind parameters of the statement
+  Result checkBindParameters(arangodb::velocypack::Slice const&) const;
+
+  uint64_t const id;
+  std::string const queryString;
+  std::vector<std::string> const bindParameters;
+  /// @brief protected by the cache's lock
+  double lastUsed;
+};
+
+/// @brief helpers for plan templates. a plan template is a serialized plan
+/// in which the deferred bind parameters are left as parameter nodes
+struct PlanTemplate {
+  /// @brief serializes the value of the named bind parameter as an AST node
+  typedef std::function<void(std::string const&,
+                             arangodb::velocypack::Builder&)> ValueWriter;
+
+  /// @brief whether or not the value of a bind parameter can be left out of
+  /// a plan template. null, and arrays containing null, decide whether
+  /// sparse indexes can be used, so the plan depends on these values.
+  /// plan templates may treat the parameter nodes as non-null constants
+  static bool isDeferrable(arangodb::velocypack::Slice const&);
+
+  /// @brief hash the class of a deferred value into a plan cache key.
+  /// values of another type, and arrays whose length is in another power
+  /// of two range, are optimized again and get their own plan
+  static uint64_t hashValueClass(arangodb::velocypack::Slice const&,
+                                 uint64_t);
+
+  /// @brief whether or not a serialized AST node is a parameter node
+  static bool isParameterNode(arangodb::velocypack::Slice const&);
+
+  /// @brief whether or not a serialized AST node is a value node. the
+  /// values are user data and must not be looked into
+  static bool isValueNode(arangodb::velocypack::Slice const&);
+
+  /// @brief count the parameter nodes in a serialized plan
+  static void countParameterNodes(arangodb::velocypack::Slice const&,
+                                  std::unordered_map<std::string, size_t>&);
+
+  /// @brief copy a plan template, replacing its parameter nodes with the
+  /// serialized values
+  static void inject(arangodb::velocypack::Slice const&,
+                     arangodb::velocypack::Builder&, ValueWriter const&);
 };
 
 class PlanCache {
@@ -52,8 +124,12 @@ class PlanCache {
   PlanCache(PlanCache const&) = delete;
   PlanCache& operator=(PlanCache const&) = delete;
 
-  /// @brief create cache
-  PlanCache();
+  /// @brief create cache. the clock returns the current time in seconds,
+  /// and is used for the expiry of statements
+  PlanCache(size_t maxPlansPerDatabase = 4096,
+            size_t maxStatementsPerDatabase = 1024,
+            double statementTtl = 3600.0,
+            std::function<double()> clock = TRI_microtime);
 
   /// @brief destroy the cache
   ~PlanCache();
@@ -62,21 +138,77 @@ class PlanCache {
   /// @brief lookup a plan in the cache
   std::shared_ptr<PlanCacheEntry> lookup(TRI_vocbase_t*, uint64_t, char const*, size_t);
 
-  /// @brief store a plan in the cache
-  void store(TRI_vocbase_t*, uint64_t, char const*, size_t, ExecutionPlan const*);
+  /// @brief store a plan in the cache, evicting the least recently used
+  /// plan of the database if the cache is full
+  void store(TRI_vocbase_t*, uint64_t, std::shared_ptr<PlanCacheEntry>);
 
   /// @brief invalidate all plans for a particular database
   void invalidate(TRI_vocbase_t*);
 
+  /// @brief invalidate all plans for all databases
+  void invalidate();
+
+  /// @brief remove all plans and prepared statements of a database that is
+  /// going to be dropped
+  void drop(TRI_vocbase_t*);
+
+  /// @brief register a prepared statement, returns its id. expired
+  /// statements are removed, and the least recently used statement of the
+  /// database is evicted if the database has too many
+  uint64_t registerStatement(TRI_vocbase_t*, std::string&& queryString,
+                             std::vector<std::string>&& bindParameters);
+
+  /// @brief lookup a prepared statement by id
+  std::shared_ptr<PreparedStatement> lookupStatement(TRI_vocbase_t*, uint64_t);
+
+  /// @brief remove a prepared statement, returns false if it did not exist
+  bool removeStatement(TRI_vocbase_t*, uint64_t);
+
+  /// @brief number of cached plans of a database
+  size_t numberOfPlans(TRI_vocbase_t*);
+
+  /// @brief number of prepared statements of a database
+  size_t numberOfStatements(TRI_vocbase_t*);
+
   /// @brief get the pointer to the global plan cache
   static PlanCache* instance();
 
  private:
-  /// @brief read-write lock for the cache
-  arangodb::basics::ReadWriteLock _lock;
+  struct DatabasePlans {
+    /// @brief keys, most recently used first
+    std::list<uint64_t> usage;
+    std::unordered_map<uint64_t,
+                       std::pair<std::shared_ptr<PlanCacheEntry>,
+                                 std::list<uint64_t>::iterator>> plans;
+  };
+
+  struct DatabaseStatements {
+    /// @brief ids, most recently used first
+    std::list<uint64_t> usage;
+    std::unordered_map<uint64_t,
+                       std::pair<std::shared_ptr<PreparedStatement>,
+                                 std::list<uint64_t>::iterator>> statements;
+  };
+
+  /// @brief remove the statements which have not been used for longer than
+  /// the statement ttl. must be called with the lock held
+  void expireStatements(DatabaseStatements&, double now);
+
+ private:
+  /// @brief protects the plans and statements. lookups reorder the usage
+  /// lists, so there are no readers
+  arangodb::Mutex _lock;
 
   /// @brief cached query plans, organized per database
-  std::unordered_map<TRI_vocbase_t*, std::unordered_map<uint64_t, std::shared_ptr<PlanCacheEntry>>> _plans;
+  std::unordered_map<TRI_vocbase_t*, DatabasePlans> _plans;
+
+  /// @brief prepared statements, organized per database
+  std::unordered_map<TRI_vocbase_t*, DatabaseStatements> _statements;
+
+  size_t const _maxPlansPerDatabase;
+  size_t const _maxStatementsPerDatabase;
+  double const _statementTtl;
+  std::function<double()> const _clock;
 };
 }
 }
@@ -25,10 +25,14 @@
 
 #include "Aql/AqlItemBlock.h"
 #include "Aql/AqlTransaction.h"
+#include "Aql/Collection.h"
+#include "Aql/Condition.h"
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionEngine.h"
 #include "Aql/ExecutionPlan.h"
 #include "Aql/Executor.h"
+#include "Aql/IndexNode.h"
+#include "Aql/ModificationNodes.h"
 #include "Aql/Optimizer.h"
 #include "Aql/Parser.h"
 #include "Aql/PlanCache.h"
@@ -36,10 +40,13 @@
 #include "Aql/QueryList.h"
 #include "Aql/QueryProfile.h"
 #include "Basics/Exceptions.h"
+#include "Basics/MemoryArenas.h"
+#include "Basics/StaticStrings.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/WorkMonitor.h"
 #include "Basics/fasthash.h"
 #include "Cluster/ServerState.h"
+#include "Indexes/Index.h"
 #include "Logger/Logger.h"
 #include "RestServer/AqlFeature.h"
 #include "StorageEngine/TransactionState.h"
@@ -56,10 +63,6 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
-#ifndef USE_PLAN_CACHE
-#undef USE_PLAN_CACHE
-#endif
-
 using namespace arangodb;
 using namespace arangodb::aql;
 
@@ -67,6 +70,138 @@ namespace {
 static std::atomic<TRI_voc_tick_t> NextQueryId(1);
 
 constexpr uint64_t DontCache = 0;
+
+/// @brief extract the document keys from a primary index condition. returns
+/// false if the condition does not restrict _key to constant string values
+static bool ExtractKeysFromCondition(AstNode const* root,
+                                     std::vector<std::string>& keys) {
+  if (root == nullptr || root->type != NODE_TYPE_OPERATOR_NARY_OR) {
+    return false;
+  }
+
+  for (size_t i = 0; i < root->numMembers(); ++i) {
+    auto andNode = root->getMemberUnchecked(i);
+
+    if (andNode->type != NODE_TYPE_OPERATOR_NARY_AND) {
+      return false;
+    }
+
+    bool found = false;
+
+    for (size_t j = 0; j < andNode->numMembers() && !found; ++j) {
+      auto op = andNode->getMemberUnchecked(j);
+
+      if (op->type != NODE_TYPE_OPERATOR_BINARY_EQ &&
+          op->type != NODE_TYPE_OPERATOR_BINARY_IN) {
+        continue;
+      }
+
+      auto lhs = op->getMember(0);
+      auto rhs = op->getMember(1);
+
+      if (op->type == NODE_TYPE_OPERATOR_BINARY_EQ &&
+          lhs->type != NODE_TYPE_ATTRIBUTE_ACCESS) {
+        std::swap(lhs, rhs);
+      }
+
+      if (lhs->type != NODE_TYPE_ATTRIBUTE_ACCESS ||
+          lhs->getString() != StaticStrings::KeyString ||
+          lhs->getMember(0)->type != NODE_TYPE_REFERENCE ||
+          !rhs->isConstant()) {
+        continue;
+      }
+
+      if (op->type == NODE_TYPE_OPERATOR_BINARY_EQ && rhs->isStringValue()) {
+        keys.emplace_back(rhs->getString());
+        found = true;
+      } else if (op->type == NODE_TYPE_OPERATOR_BINARY_IN && rhs->isArray()) {
+        found = true;
+        for (size_t k = 0; k < rhs->numMembers(); ++k) {
+          auto value = rhs->getMemberUnchecked(k);
+          if (!value->isStringValue()) {
+            return false;
+          }
+          keys.emplace_back(value->getString());
+        }
+      }
+    }
+
+    if (!found) {
+      // this branch of the condition is not restricted to keys
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/// @brief determine the documents a query result depends on. results for
+/// collections that are only accessed via primary index lookups of constant
+/// keys can be invalidated per document, all other collections are
+/// invalidated as a whole
+static QueryCacheKeyDependencies KeyDependencies(ExecutionPlan* plan) {
+  QueryCacheKeyDependencies result;
+
+  if (plan == nullptr || plan->getAst()->functionsMayAccessDocuments()) {
+    return result;
+  }
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, {ExecutionNode::TRAVERSAL,
+                                ExecutionNode::SHORTEST_PATH},
+                        true);
+
+  if (!nodes.empty()) {
+    // graph operations may access arbitrary documents
+    return result;
+  }
+
+  nodes.clear();
+  plan->findNodesOfType(
+      nodes, {ExecutionNode::ENUMERATE_COLLECTION, ExecutionNode::INDEX,
+              ExecutionNode::INSERT, ExecutionNode::UPDATE,
+              ExecutionNode::REPLACE, ExecutionNode::REMOVE,
+              ExecutionNode::UPSERT},
+      true);
+
+  std::unordered_set<std::string> full;
+
+  for (auto const& n : nodes) {
+    if (n->getType() == ExecutionNode::ENUMERATE_COLLECTION) {
+      full.emplace(
+          static_cast<EnumerateCollectionNode const*>(n)->collection()->name);
+      continue;
+    }
+    if (n->getType() != ExecutionNode::INDEX) {
+      full.emplace(static_cast<ModificationNode const*>(n)->collection()->name);
+      continue;
+    }
+
+    auto node = static_cast<IndexNode const*>(n);
+    auto const& name = node->collection()->name;
+    auto const& indexes = node->getIndexes();
+    std::vector<std::string> keys;
+
+    if (indexes.size() != 1 ||
+        indexes[0].getIndex()->type() !=
+            arangodb::Index::TRI_IDX_TYPE_PRIMARY_INDEX ||
+        node->condition() == nullptr ||
+        !ExtractKeysFromCondition(node->condition()->root(), keys)) {
+      full.emplace(name);
+      continue;
+    }
+
+    auto& target = result[name];
+    target.insert(target.end(), keys.begin(), keys.end());
+  }
+
+  for (auto const& name : full) {
+    result.erase(name);
+  }
+
+  return result;
+}
 }
 
 /// @brief global memory limit for AQL queries
@@ -392,17 +527,19 @@ void Query::prepare(QueryRegistry* registry, uint64_t queryStringHash) {
 
   std::unique_ptr<ExecutionPlan> plan;
 
-#if USE_PLAN_CACHE
-  if (_queryString != nullptr && 
-      queryStringHash != DontCache &&
-      _part == PART_MAIN) {
-    // LOG_TOPIC(INFO, Logger::FIXME) << "trying to find query in execution plan cache: '" << std::string(_queryString, _queryStringLength) << "', hash: " << queryStringHash;
+  bool const usePlanCache = (_queryString != nullptr &&
+                             queryStringHash != DontCache &&
+                             _part == PART_MAIN &&
+                             this->usePlanCache());
 
-    // store & lookup velocypack plans!!
-    std::shared_ptr<PlanCacheEntry> planCacheEntry = PlanCache::instance()->lookup(_vocbase, queryStringHash, _queryString, _queryStringLength);
-    if (planCacheEntry != nullptr) {
-      // LOG_TOPIC(INFO, Logger::FIXME) << "query found in execution plan cache: '" << std::string(_queryString, _queryStringLength) << "'";
+  if (usePlanCache) {
+    std::shared_ptr<PlanCacheEntry> planCacheEntry = lookupPlanTemplate();
 
+    if (planCacheEntry == nullptr) {
+      planCacheEntry = createPlanTemplate();
+    }
+
+    if (planCacheEntry != nullptr) {
       TRI_ASSERT(_trx == nullptr); 
       TRI_ASSERT(_collections.empty());
   
@@ -412,21 +549,25 @@ void Query::prepare(QueryRegistry* registry, uint64_t queryStringHash) {
         _part == PART_MAIN);
       _trx = trx;
 
-      VPackBuilder* builder = planCacheEntry->builder.get();
-      VPackSlice slice = builder->slice();
+      // put in the values of the bind parameters
+      VPackBuilder builder;
+      injectPlanTemplate(planCacheEntry->builder->slice(), builder);
+      VPackSlice slice = builder.slice();
+
       ExecutionPlan::getCollectionsFromVelocyPack(_ast.get(), slice);
       _ast->variables()->fromVelocyPack(slice);
+      _isModificationQuery = planCacheEntry->isModificationQuery;
     
       enterState(QueryExecutionState::ValueType::LOADING_COLLECTIONS);
     
-      int res = trx->addCollections(*_collections.collections());
+      Result res = trx->addCollections(*_collections.collections());
       
-      if (res == TRI_ERROR_NO_ERROR) {
+      if (res.ok()) {
         res = _trx->begin();
       }
     
-      if (res != TRI_ERROR_NO_ERROR) {
-        THROW_ARANGO_EXCEPTION_MESSAGE(res, buildErrorMessage(res));
+      if (!res.ok()) {
+        THROW_ARANGO_EXCEPTION(res);
       }
     
       enterState(QueryExecutionState::ValueType::PLAN_INSTANTIATION);
@@ -436,23 +577,11 @@ void Query::prepare(QueryRegistry* registry, uint64_t queryStringHash) {
       TRI_ASSERT(plan != nullptr);
     }
   }
-#endif
 
   if (plan == nullptr) {
     plan.reset(prepare());
 
     TRI_ASSERT(plan != nullptr);
-
-#if USE_PLAN_CACHE
-    if (_queryString != nullptr && 
-        queryStringHash != DontCache && 
-        _part == PART_MAIN &&
-        _warnings.empty() && 
-        _ast->root()->isCacheable()) {
-      // LOG_TOPIC(INFO, Logger::FIXME) << "storing query in execution plan cache '" << std::string(_queryString, _queryStringLength) << "', hash: " << queryStringHash;
-      PlanCache::instance()->store(_vocbase, queryStringHash, _queryString, _queryStringLength, plan.get());
-    }
-#endif
   }
 
   enterState(QueryExecutionState::ValueType::EXECUTION);
@@ -477,7 +606,7 @@ void Query::prepare(QueryRegistry* registry, uint64_t queryStringHash) {
 /// execute calls it internally. The purpose of this separate method is
 /// to be able to only prepare a query from VelocyPack and then store it in the
 /// QueryRegistry.
-ExecutionPlan* Query::prepare() {
+ExecutionPlan* Query::prepare(DeferredParameters* deferred) {
   LOG_TOPIC(DEBUG, Logger::QUERIES) << TRI_microtime() - _startTime << " "
                                     << "Query::prepare"
                                     << " this: " << (uintptr_t) this;
@@ -488,7 +617,19 @@ ExecutionPlan* Query::prepare() {
     
     parser->parse(false);
     // put in bind parameters
-    parser->ast()->injectBindParameters(_bindParameters);
+    if (deferred == nullptr) {
+      parser->ast()->injectBindParameters(_bindParameters);
+    } else {
+      parser->ast()->injectBindParameters(_bindParameters, &deferred->names);
+
+      // count the parameter nodes which are left in the AST
+      auto counter = [deferred](AstNode const* node, void*) {
+        if (node->type == NODE_TYPE_PARAMETER) {
+          ++deferred->nodes[node->getString()];
+        }
+      };
+      Ast::traverseReadOnly(parser->ast()->root(), counter, nullptr);
+    }
     _isModificationQuery = parser->isModificationQuery();
   }
 
@@ -575,6 +716,164 @@ ExecutionPlan* Query::prepare() {
   return plan.release();
 }
 
+/// @brief look up the plan template of the query in the plan cache
+std::shared_ptr<PlanCacheEntry> Query::lookupPlanTemplate() {
+  auto cache = PlanCache::instance();
+  auto entry = cache->lookup(_vocbase, planCacheKey({}), _queryString,
+                             _queryStringLength);
+
+  if (entry != nullptr && entry->builder == nullptr) {
+    // the plans of the query depend on the values of some bind parameters
+    entry = cache->lookup(_vocbase, planCacheKey(entry->structuralParameters),
+                          _queryString, _queryStringLength);
+  }
+
+  if (entry == nullptr || entry->builder == nullptr) {
+    return nullptr;
+  }
+  return entry;
+}
+
+/// @brief create the plan template of the query and store it in the plan
+/// cache. returns a nullptr if the query's plan cannot be cached
+std::shared_ptr<PlanCacheEntry> Query::createPlanTemplate() {
+  std::unordered_set<std::string> valueParameters;
+  std::unordered_set<std::string> deferredNames;
+  for (auto const& it : _bindParameters.get()) {
+    if (!it.first.empty() && it.first[0] != '@') {
+      valueParameters.emplace(it.first);
+      if (PlanTemplate::isDeferrable(it.second.first)) {
+        deferredNames.emplace(it.first);
+      }
+    }
+  }
+
+  // first try to leave all deferrable values out of the plan. the values
+  // which turn out to be needed by the parser or the optimizer become
+  // structural, i.e. part of the cache key, and the plan is built again
+  std::shared_ptr<VPackBuilder> builder;
+  bool isModificationQuery = false;
+
+  for (int attempt = 0; builder == nullptr; ++attempt) {
+    DeferredParameters deferred;
+    deferred.names = deferredNames;
+    std::vector<std::string> folded;
+
+    try {
+      Query query(_contextOwnedByExterior, _vocbase, _queryString,
+                  _queryStringLength, _bindParameters.builder(), _options,
+                  _part);
+      builder = query.buildPlanTemplate(deferred, folded);
+      isModificationQuery = query._isModificationQuery;
+    } catch (...) {
+      if (deferredNames.empty()) {
+        // the query cannot be prepared. the error is reported by the
+        // regular preparation
+        return nullptr;
+      }
+      // the plan cannot be built without the values
+      deferredNames.clear();
+      continue;
+    }
+
+    if (builder == nullptr) {
+      // plan is not cacheable
+      return nullptr;
+    }
+
+    if (!folded.empty()) {
+      if (deferredNames.empty()) {
+        return nullptr;
+      }
+      builder.reset();
+      for (auto const& it : folded) {
+        deferredNames.erase(it);
+      }
+      if (attempt > 0) {
+        // give up on templating and cache the plan for these values only
+        deferredNames.clear();
+      }
+    }
+  }
+
+  std::vector<std::string> structuralParameters;
+  for (auto const& it : valueParameters) {
+    if (deferredNames.find(it) == deferredNames.end()) {
+      structuralParameters.emplace_back(it);
+    }
+  }
+  std::sort(structuralParameters.begin(), structuralParameters.end());
+
+  auto cache = PlanCache::instance();
+  auto entry = std::make_shared<PlanCacheEntry>(
+      std::string(_queryString, _queryStringLength), builder,
+      std::vector<std::string>(structuralParameters), isModificationQuery);
+
+  if (structuralParameters.empty()) {
+    cache->store(_vocbase, planCacheKey({}), entry);
+  } else {
+    // store a redirect to the plans for the structural values
+    cache->store(_vocbase, planCacheKey({}),
+                 std::make_shared<PlanCacheEntry>(
+                     std::string(_queryString, _queryStringLength), nullptr,
+                     std::vector<std::string>(structuralParameters),
+                     isModificationQuery));
+    cache->store(_vocbase, planCacheKey(structuralParameters), entry);
+  }
+
+  return entry;
+}
+
+/// @brief optimize the query with the deferred bind parameters left out
+/// of the plan
+std::shared_ptr<VPackBuilder> Query::buildPlanTemplate(
+    DeferredParameters& deferred, std::vector<std::string>& folded) {
+  std::unordered_set<std::string> const requested(deferred.names);
+
+  init();
+  enterState(QueryExecutionState::ValueType::PARSING);
+
+  std::unique_ptr<ExecutionPlan> plan(prepare(&deferred));
+
+  if (!_warnings.empty() || !_ast->root()->isCacheable()) {
+    return nullptr;
+  }
+
+  auto builder = plan->toVelocyPack(_ast.get(), true);
+
+  // a parameter node which does not make it into the plan may have been
+  // evaluated by the optimizer
+  std::unordered_map<std::string, size_t> nodes;
+  PlanTemplate::countParameterNodes(builder->slice(), nodes);
+
+  for (auto const& it : requested) {
+    if (deferred.names.find(it) == deferred.names.end() ||
+        nodes[it] != deferred.nodes[it]) {
+      folded.emplace_back(it);
+    }
+  }
+
+  return builder;
+}
+
+/// @brief copy a plan template, replacing its parameter nodes with the
+/// values of the query's bind parameters
+void Query::injectPlanTemplate(VPackSlice const& slice, VPackBuilder& builder) {
+  PlanTemplate::inject(
+      slice, builder, [this](std::string const& name, VPackBuilder& builder) {
+        auto& p = _bindParameters.get();
+        auto it = p.find(name);
+
+        if (it == p.end()) {
+          // cannot happen, as the bind parameter names are part of the key
+          THROW_ARANGO_EXCEPTION_PARAMS(
+              TRI_ERROR_QUERY_BIND_PARAMETER_MISSING, name.c_str());
+        }
+        _ast->nodeFromVPack((*it).second.first, true)
+            ->toVelocyPack(builder, true);
+      });
+}
+
 /// @brief execute an AQL query
 QueryResult Query::execute(QueryRegistry* registry) {
   LOG_TOPIC(DEBUG, Logger::QUERIES) << TRI_microtime() - _startTime << " "
@@ -582,6 +881,9 @@ QueryResult Query::execute(QueryRegistry* registry) {
                                     << " this: " << (uintptr_t) this;
   TRI_ASSERT(registry != nullptr);
 
+  // account the memory used by the query to the AQL arena
+  basics::MemoryArenaScope arenaScope(basics::MemoryArena::AQL);
+
   std::unique_ptr<AqlWorkStack> work;
 
   try {
@@ -622,8 +924,11 @@ QueryResult Query::execute(QueryRegistry* registry) {
 
     log();
 
+    // plans taken from the plan cache have no AST root, but only cacheable
+    // queries make it into the plan cache
     if (useQueryCache && (_isModificationQuery || !_warnings.empty() ||
-                          !_ast->root()->isCacheable())) {
+                          (_ast->root() != nullptr &&
+                           !_ast->root()->isCacheable()))) {
       useQueryCache = false;
     }
 
@@ -670,7 +975,8 @@ QueryResult Query::execute(QueryRegistry* registry) {
           // finally store the generated result in the query cache
           auto result = QueryCache::instance()->store(
               _vocbase, queryStringHash, _queryString, _queryStringLength,
-              resultBuilder, _trx->state()->collectionNames());
+              resultBuilder, _trx->state()->collectionNames(),
+              KeyDependencies(_plan.get()));
 
           if (result == nullptr) {
             THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
@@ -766,6 +1072,9 @@ QueryResultV8 Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry) {
                                     << " this: " << (uintptr_t) this;
   TRI_ASSERT(registry != nullptr);
 
+  // account the memory used by the query to the AQL arena
+  basics::MemoryArenaScope arenaScope(basics::MemoryArena::AQL);
+
   std::unique_ptr<AqlWorkStack> work;
 
   try {
@@ -786,8 +1095,8 @@ QueryResultV8 Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry) {
         result.context = std::make_shared<transaction::StandaloneContext>(_vocbase);
 
         v8::Handle<v8::Value> values =
-            TRI_VPackToV8(isolate, cacheEntry->_queryResult->slice(),
-                          result.context->getVPackOptions());
+            TRI_VPackToV8Lazy(isolate, cacheEntry->_queryResult->slice(),
+                              result.context->getVPackOptions());
         TRI_ASSERT(values->IsArray());
         result.result = v8::Handle<v8::Array>::Cast(values);
         result.cached = true;
@@ -808,8 +1117,11 @@ QueryResultV8 Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry) {
 
     log();
 
+    // plans taken from the plan cache have no AST root, but only cacheable
+    // queries make it into the plan cache
     if (useQueryCache && (_isModificationQuery || !_warnings.empty() ||
-                          !_ast->root()->isCacheable())) {
+                          (_ast->root() != nullptr &&
+                           !_ast->root()->isCacheable()))) {
       useQueryCache = false;
     }
 
@@ -841,7 +1153,7 @@ QueryResultV8 Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry) {
             AqlValue const& val = value->getValueReference(i, resultRegister);
 
             if (!val.isEmpty()) {
-              result.result->Set(j++, val.toV8(isolate, _trx));
+              result.result->Set(j++, val.toV8Lazy(isolate, _trx));
               val.toVelocyPack(_trx, *builder, true);
             }
           }
@@ -855,7 +1167,8 @@ QueryResultV8 Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry) {
           // finally store the generated result in the query cache
           QueryCache::instance()->store(_vocbase, queryStringHash, _queryString,
                                         _queryStringLength, builder,
-                                        _trx->state()->collectionNames());
+                                        _trx->state()->collectionNames(),
+                                        KeyDependencies(_plan.get()));
         }
       } else {
         // iterate over result and return it
@@ -871,7 +1184,7 @@ QueryResultV8 Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry) {
               AqlValue const& val = value->getValueReference(i, resultRegister);
 
               if (!val.isEmpty()) {
-                result.result->Set(j++, val.toV8(isolate, _trx));
+                result.result->Set(j++, val.toV8Lazy(isolate, _trx));
               }
 
               if (V8PlatformFeature::isOutOfMemory(isolate)) {
@@ -1161,6 +1474,30 @@ bool Query::getBooleanOption(char const* option, bool defaultValue) const {
   return value.getBool();
 }
 
+/// @brief return the read tick from the options. the tick can be given as
+/// a revision string (as returned in _rev) or as a number
+TRI_voc_rid_t Query::readTick() const {
+  if (_options == nullptr) {
+    return 0;
+  }
+
+  VPackSlice options = _options->slice();
+  if (!options.isObject()) {
+    return 0;
+  }
+
+  VPackSlice value = options.get("readTick");
+  if (value.isString()) {
+    bool isOld;
+    return TRI_StringToRid(value.copyString(), isOld, false);
+  }
+  if (value.isNumber()) {
+    return value.getNumber<TRI_voc_rid_t>();
+  }
+
+  return 0;
+}
+
 /// @brief return the included shards from the options
 std::unordered_set<std::string> Query::includedShards() const {
   std::unordered_set<std::string> result;
@@ -1267,6 +1604,16 @@ uint64_t Query::hash() const {
     return DontCache;
   }
 
+  // blend query hash with bind parameters
+  return hashWithoutBindParameters() ^ _bindParameters.hash();
+}
+
+/// @brief calculate a hash value for the query, without bind parameters
+uint64_t Query::hashWithoutBindParameters() const {
+  if (_queryString == nullptr) {
+    return DontCache;
+  }
+
   // hash the query string first
   uint64_t hash = arangodb::aql::QueryCache::instance()->hashQueryString(
       _queryString, _queryStringLength);
@@ -1292,12 +1639,49 @@ uint64_t Query::hash() const {
   if (_options != nullptr && _options->slice().isObject()) {
     options = _options->slice().get("optimizer");
   }
-  hash ^= options.hash();
+  return hash ^ options.hash();
+}
 
-  // blend query hash with bind parameters
-  return hash ^ _bindParameters.hash();
+/// @brief calculate the plan cache key of the query
+uint64_t Query::planCacheKey(
+    std::vector<std::string> const& structuralParameters) {
+  uint64_t hash = hashWithoutBindParameters();
+
+  auto& p = _bindParameters.get();
+  std::vector<std::string> names;
+  names.reserve(p.size());
+  for (auto const& it : p) {
+    names.emplace_back(it.first);
+  }
+  std::sort(names.begin(), names.end());
+
+  for (auto const& name : names) {
+    hash = fasthash64(name.c_str(), name.size(), hash);
+
+    VPackSlice value = p[name].first;
+
+    if ((!name.empty() && name[0] == '@') ||
+        !PlanTemplate::isDeferrable(value) ||
+        std::find(structuralParameters.begin(), structuralParameters.end(),
+                  name) != structuralParameters.end()) {
+      // the plan depends on the value
+      hash = value.normalizedHash(hash);
+    } else {
+      // the plan is optimized for the class of the value
+      hash = PlanTemplate::hashValueClass(value, hash);
+    }
+  }
+
+  if (!structuralParameters.empty()) {
+    // keep the key different from the key of the redirect
+    hash = fasthash64(TRI_CHAR_LENGTH_PAIR("structural"), hash);
+  }
+
+  return hash;
 }
 
+
+
 /// @brief whether or not the query cache can be used for the query
 bool Query::canUseQueryCache() const {
   if (_queryString == nullptr || _queryStringLength < 8) {
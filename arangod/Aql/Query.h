@@ -60,6 +60,7 @@ class Ast;
 class ExecutionEngine;
 class ExecutionPlan;
 class Executor;
+struct PlanCacheEntry;
 class Query;
 struct QueryProfile;
 class QueryRegistry;
@@ -158,6 +159,23 @@ class Query {
   /// @brief should we suppress the query result (useful for performance testing only)?
   bool silent() const { return getBooleanOption("silent", false); }
 
+  /// @brief should the optimized plan be looked up in and stored in the
+  /// plan cache?
+  bool usePlanCache() const { return getBooleanOption("usePlanCache", false); }
+
+  /// @brief whether or not the query modifies data
+  bool isModificationQuery() const { return _isModificationQuery; }
+
+  /// @brief may the query read from in-sync followers of the shards?
+  /// this is never allowed for data-modification queries
+  bool allowDirtyReads() const {
+    return !_isModificationQuery && getBooleanOption("allowDirtyReads", false);
+  }
+
+  /// @brief the revision of the client's last write, which followers
+  /// must have applied before they can serve dirty reads (0 = any)
+  TRI_voc_rid_t readTick() const;
+
   /// @brief maximum number of plans to produce
   size_t maxNumberOfPlans() const {
     size_t value = getNumericOption<size_t>("maxNumberOfPlans", 0);
@@ -313,11 +331,38 @@ class Query {
   /// @brief initializes the query
   void init();
   
+  /// @brief bind parameters which are left out of a plan template
+  struct DeferredParameters {
+    /// @brief names of the deferred parameters. parameters whose values
+    /// are needed to build the plan are removed
+    std::unordered_set<std::string> names;
+    /// @brief number of parameter nodes per deferred parameter in the AST
+    std::unordered_map<std::string, size_t> nodes;
+  };
+
   /// @brief prepare an AQL query, this is a preparation for execute, but
   /// execute calls it internally. The purpose of this separate method is
   /// to be able to only prepare a query from VelocyPack and then store it in the
   /// QueryRegistry.
-  ExecutionPlan* prepare();
+  ExecutionPlan* prepare(DeferredParameters* deferred = nullptr);
+
+  /// @brief look up the plan template of the query in the plan cache
+  std::shared_ptr<PlanCacheEntry> lookupPlanTemplate();
+
+  /// @brief create the plan template of the query and store it in the plan
+  /// cache. returns a nullptr if the query's plan cannot be cached
+  std::shared_ptr<PlanCacheEntry> createPlanTemplate();
+
+  /// @brief optimize the query with the deferred bind parameters left out
+  /// of the plan. returns a nullptr if the plan cannot be cached. deferred
+  /// parameters whose values made it into the plan are returned in folded
+  std::shared_ptr<arangodb::velocypack::Builder> buildPlanTemplate(
+      DeferredParameters& deferred, std::vector<std::string>& folded);
+
+  /// @brief copy a plan template, replacing its parameter nodes with the
+  /// values of the query's bind parameters
+  void injectPlanTemplate(arangodb::velocypack::Slice const&,
+                          arangodb::velocypack::Builder&);
 
   void setExecutionTime();
 
@@ -327,6 +372,14 @@ class Query {
   /// @brief calculate a hash value for the query and bind parameters
   uint64_t hash() const;
 
+  /// @brief calculate a hash value for the query, without bind parameters
+  uint64_t hashWithoutBindParameters() const;
+
+  /// @brief calculate the plan cache key of the query. the key contains the
+  /// names of all bind parameters, but only the values of collection
+  /// parameters and of the given structural parameters
+  uint64_t planCacheKey(std::vector<std::string> const& structuralParameters);
+
   /// @brief whether or not the query cache can be used for the query
   bool canUseQueryCache() const;
 
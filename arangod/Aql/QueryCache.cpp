@@ -47,11 +47,13 @@ static std::atomic<arangodb::aql::QueryCacheMode> Mode(CACHE_ON_DEMAND);
 /// @brief create a cache entry
 QueryCacheResultEntry::QueryCacheResultEntry(
     uint64_t hash, char const* queryString, size_t queryStringLength,
-    std::shared_ptr<VPackBuilder> queryResult, std::vector<std::string> const& collections)
+    std::shared_ptr<VPackBuilder> queryResult, std::vector<std::string> const& collections,
+    QueryCacheKeyDependencies const& keys)
     : _hash(hash),
       _queryString(queryString, queryStringLength),
       _queryResult(queryResult),
       _collections(collections),
+      _keys(keys),
       _prev(nullptr),
       _next(nullptr),
       _refCount(0),
@@ -86,6 +88,7 @@ void QueryCacheResultEntry::unuse() {
 QueryCacheDatabaseEntry::QueryCacheDatabaseEntry()
     : _entriesByHash(),
       _entriesByCollection(),
+      _entriesByKey(),
       _head(nullptr),
       _tail(nullptr),
       _numElements(0) {
@@ -101,6 +104,7 @@ QueryCacheDatabaseEntry::~QueryCacheDatabaseEntry() {
 
   _entriesByHash.clear();
   _entriesByCollection.clear();
+  _entriesByKey.clear();
 }
 
 /// @brief lookup a query result in the database-specific cache
@@ -137,56 +141,29 @@ void QueryCacheDatabaseEntry::store(uint64_t hash,
   // insert entry into the cache
   if (!_entriesByHash.emplace(hash, entry).second) {
     // remove previous entry
-    auto it = _entriesByHash.find(hash);
-    TRI_ASSERT(it != _entriesByHash.end());
-    auto previous = (*it).second;
-    unlink(previous);
-    _entriesByHash.erase(it);
-    tryDelete(previous);
+    remove(hash);
 
     // and insert again
     _entriesByHash.emplace(hash, entry);
   }
 
   try {
-    for (auto const& it : entry->_collections) {
-      auto it2 = _entriesByCollection.find(it);
-
-      if (it2 == _entriesByCollection.end()) {
-        // no entry found for collection. now create it
-        _entriesByCollection.emplace(it, std::unordered_set<uint64_t>{hash});
-      } else {
-        // there already was an entry for this collection
-        (*it2).second.emplace(hash);
-      }
-    }
+    registerDependencies(entry);
   } catch (...) {
     // rollback
-
-    // remove from collections
-    for (auto const& it : entry->_collections) {
-      auto it2 = _entriesByCollection.find(it);
-
-      if (it2 != _entriesByCollection.end()) {
-        (*it2).second.erase(hash);
-      }
-    }
+    unregisterDependencies(entry);
 
     // finally remove entry itself from hash table
     auto it = _entriesByHash.find(hash);
     TRI_ASSERT(it != _entriesByHash.end());
     auto previous = (*it).second;
     _entriesByHash.erase(it);
-    unlink(previous);
     tryDelete(previous);
     throw;
   }
 
   link(entry);
 
-  enforceMaxResults(MaxResults);
-
-  TRI_ASSERT(_numElements <= MaxResults);
   TRI_ASSERT(_head != nullptr);
   TRI_ASSERT(_tail != nullptr);
   TRI_ASSERT(_tail == entry);
@@ -207,27 +184,52 @@ void QueryCacheDatabaseEntry::invalidate(
 void QueryCacheDatabaseEntry::invalidate(std::string const& collection) {
   auto it = _entriesByCollection.find(collection);
 
-  if (it == _entriesByCollection.end()) {
-    return;
+  if (it != _entriesByCollection.end()) {
+    // copy the hashes, as removing entries modifies the set
+    std::unordered_set<uint64_t> hashes(std::move((*it).second));
+    _entriesByCollection.erase(it);
+    remove(hashes);
+  }
+
+  auto it2 = _entriesByKey.find(collection);
+
+  if (it2 != _entriesByKey.end()) {
+    std::unordered_set<uint64_t> hashes;
+    for (auto const& it3 : (*it2).second) {
+      hashes.insert(it3.second.begin(), it3.second.end());
+    }
+    _entriesByKey.erase(it2);
+    remove(hashes);
   }
+}
 
-  for (auto& it2 : (*it).second) {
-    auto it3 = _entriesByHash.find(it2);
+/// @brief invalidate all entries that depend on the whole collection or on
+/// one of the given keys in the database-specific cache
+void QueryCacheDatabaseEntry::invalidate(std::string const& collection,
+                                         std::vector<std::string> const& keys) {
+  auto it = _entriesByCollection.find(collection);
 
-    if (it3 != _entriesByHash.end()) {
-      // remove entry from the linked list
-      auto entry = (*it3).second;
-      unlink(entry);
+  if (it != _entriesByCollection.end()) {
+    std::unordered_set<uint64_t> hashes(std::move((*it).second));
+    _entriesByCollection.erase(it);
+    remove(hashes);
+  }
 
-      // erase it from hash table
-      _entriesByHash.erase(it3);
+  auto it2 = _entriesByKey.find(collection);
 
-      // delete the object itself
-      tryDelete(entry);
-    }
+  if (it2 == _entriesByKey.end()) {
+    return;
   }
 
-  _entriesByCollection.erase(it);
+  std::unordered_set<uint64_t> hashes;
+  for (auto const& key : keys) {
+    auto it3 = (*it2).second.find(key);
+
+    if (it3 != (*it2).second.end()) {
+      hashes.insert((*it3).second.begin(), (*it3).second.end());
+    }
+  }
+  remove(hashes);
 }
 
 /// @brief enforce maximum number of results
@@ -235,13 +237,8 @@ void QueryCacheDatabaseEntry::enforceMaxResults(size_t value) {
   while (_numElements > value) {
     // too many elements. now wipe the first element from the list
 
-    // copy old _head value as unlink() will change it...
-    auto head = _head;
-    unlink(head);
-    auto it = _entriesByHash.find(head->_hash);
-    TRI_ASSERT(it != _entriesByHash.end());
-    _entriesByHash.erase(it);
-    tryDelete(head);
+    TRI_ASSERT(_head != nullptr);
+    remove(_head->_hash);
   }
 }
 
@@ -295,8 +292,107 @@ void QueryCacheDatabaseEntry::link(QueryCacheResultEntry* e) {
   _tail = e;
 }
 
+/// @brief register the dependencies of a result entry
+void QueryCacheDatabaseEntry::registerDependencies(
+    QueryCacheResultEntry* entry) {
+  uint64_t const hash = entry->_hash;
+
+  for (auto const& it : entry->_collections) {
+    auto it2 = entry->_keys.find(it);
+
+    if (it2 == entry->_keys.end()) {
+      // result depends on the whole collection
+      _entriesByCollection[it].emplace(hash);
+    } else {
+      // result depends on some documents of the collection only
+      auto& byKey = _entriesByKey[it];
+      for (auto const& key : (*it2).second) {
+        byKey[key].emplace(hash);
+      }
+    }
+  }
+}
+
+/// @brief unregister the dependencies of a result entry
+void QueryCacheDatabaseEntry::unregisterDependencies(
+    QueryCacheResultEntry* entry) {
+  uint64_t const hash = entry->_hash;
+
+  for (auto const& it : entry->_collections) {
+    auto it2 = _entriesByCollection.find(it);
+
+    if (it2 != _entriesByCollection.end()) {
+      (*it2).second.erase(hash);
+      if ((*it2).second.empty()) {
+        _entriesByCollection.erase(it2);
+      }
+    }
+
+    auto it3 = entry->_keys.find(it);
+    auto it4 = _entriesByKey.find(it);
+
+    if (it3 == entry->_keys.end() || it4 == _entriesByKey.end()) {
+      continue;
+    }
+
+    for (auto const& key : (*it3).second) {
+      auto it5 = (*it4).second.find(key);
+
+      if (it5 != (*it4).second.end()) {
+        (*it5).second.erase(hash);
+        if ((*it5).second.empty()) {
+          (*it4).second.erase(it5);
+        }
+      }
+    }
+
+    if ((*it4).second.empty()) {
+      _entriesByKey.erase(it4);
+    }
+  }
+}
+
+/// @brief remove a result entry from the cache, including its dependencies
+void QueryCacheDatabaseEntry::remove(uint64_t hash) {
+  auto it = _entriesByHash.find(hash);
+
+  if (it == _entriesByHash.end()) {
+    return;
+  }
+
+  auto entry = (*it).second;
+  // remove entry from the linked list
+  unlink(entry);
+  // erase it from hash table
+  _entriesByHash.erase(it);
+  unregisterDependencies(entry);
+  // delete the object itself
+  tryDelete(entry);
+}
+
+/// @brief remove all result entries with the given hashes
+void QueryCacheDatabaseEntry::remove(
+    std::unordered_set<uint64_t> const& hashes) {
+  for (auto const& hash : hashes) {
+    remove(hash);
+  }
+}
+
+/// @brief whether or not some result entry depends on the collection
+bool QueryCacheDatabaseEntry::dependsOn(std::string const& collection) const {
+  return (_entriesByCollection.find(collection) != _entriesByCollection.end() ||
+          _entriesByKey.find(collection) != _entriesByKey.end());
+}
+
 /// @brief create the query cache
-QueryCache::QueryCache() : _propertiesLock(), _entriesLock(), _entries() {}
+QueryCache::QueryCache()
+    : _propertiesLock(),
+      _entriesLock(),
+      _entries(),
+      _partsLock(),
+      _partsByCollection() {
+  static_assert(NumberOfParts <= 32, "part masks must fit into 32 bits");
+}
 
 /// @brief destroy the query cache
 QueryCache::~QueryCache() { 
@@ -364,7 +460,7 @@ std::string QueryCache::modeString(QueryCacheMode mode) {
 QueryCacheResultEntry* QueryCache::lookup(TRI_vocbase_t* vocbase, uint64_t hash,
                                           char const* queryString,
                                           size_t queryStringLength) {
-  auto const part = getPart(vocbase);
+  auto const part = getPart(vocbase, hash);
   READ_LOCKER(readLocker, _entriesLock[part]);
 
   auto it = _entries[part].find(vocbase);
@@ -383,19 +479,18 @@ QueryCacheResultEntry* QueryCache::lookup(TRI_vocbase_t* vocbase, uint64_t hash,
 QueryCacheResultEntry* QueryCache::store(
     TRI_vocbase_t* vocbase, uint64_t hash, char const* queryString,
     size_t queryStringLength, std::shared_ptr<VPackBuilder> result,
-    std::vector<std::string> const& collections) {
-
-
+    std::vector<std::string> const& collections,
+    QueryCacheKeyDependencies const& keys) {
   if (!result->slice().isArray()) {
     return nullptr;
   }
 
   // get the right part of the cache to store the result in
-  auto const part = getPart(vocbase);
+  auto const part = getPart(vocbase, hash);
 
   // create the cache entry outside the lock
   auto entry = std::make_unique<QueryCacheResultEntry>(
-      hash, queryString, queryStringLength, result, collections);
+      hash, queryString, queryStringLength, result, collections, keys);
 
   WRITE_LOCKER(writeLocker, _entriesLock[part]);
 
@@ -409,66 +504,105 @@ QueryCacheResultEntry* QueryCache::store(
   }
 
   // store cache entry
+  registerPart(vocbase, collections, part);
   (*it).second->store(hash, entry.get());
+  (*it).second->enforceMaxResults(maxResultsPerPart(MaxResults));
   return entry.release();
 }
 
 /// @brief invalidate all queries for the given collections
 void QueryCache::invalidate(TRI_vocbase_t* vocbase,
                             std::vector<std::string> const& collections) {
-  auto const part = getPart(vocbase);
-  WRITE_LOCKER(writeLocker, _entriesLock[part]);
+  uint32_t const parts = partsForCollections(vocbase, collections);
 
-  auto it = _entries[part].find(vocbase);
+  for (unsigned int i = 0; i < NumberOfParts; ++i) {
+    if ((parts & (1U << i)) == 0) {
+      continue;
+    }
 
-  if (it == _entries[part].end()) {
-    return;
-  }
+    WRITE_LOCKER(writeLocker, _entriesLock[i]);
 
-  // invalidate while holding the lock
-  (*it).second->invalidate(collections);
+    auto it = _entries[i].find(vocbase);
+
+    if (it == _entries[i].end()) {
+      continue;
+    }
+
+    // invalidate while holding the lock
+    (*it).second->invalidate(collections);
+    unregisterPart(vocbase, collections, i, (*it).second);
+  }
 }
 
 /// @brief invalidate all queries for a particular collection
 void QueryCache::invalidate(TRI_vocbase_t* vocbase, std::string const& collection) {
-  auto const part = getPart(vocbase);
-  WRITE_LOCKER(writeLocker, _entriesLock[part]);
+  invalidate(vocbase, std::vector<std::string>{collection});
+}
 
-  auto it = _entries[part].find(vocbase);
+/// @brief invalidate all queries for a particular collection that depend
+/// on the whole collection or on one of the given document keys
+void QueryCache::invalidate(TRI_vocbase_t* vocbase, std::string const& collection,
+                            std::vector<std::string> const& keys) {
+  std::vector<std::string> const collections{collection};
+  uint32_t const parts = partsForCollections(vocbase, collections);
 
-  if (it == _entries[part].end()) {
-    return;
-  }
+  for (unsigned int i = 0; i < NumberOfParts; ++i) {
+    if ((parts & (1U << i)) == 0) {
+      continue;
+    }
+
+    WRITE_LOCKER(writeLocker, _entriesLock[i]);
+
+    auto it = _entries[i].find(vocbase);
+
+    if (it == _entries[i].end()) {
+      continue;
+    }
 
-  // invalidate while holding the lock
-  (*it).second->invalidate(collection);
+    // invalidate while holding the lock
+    (*it).second->invalidate(collection, keys);
+    unregisterPart(vocbase, collections, i, (*it).second);
+  }
 }
 
 /// @brief invalidate all queries for a particular database
 void QueryCache::invalidate(TRI_vocbase_t* vocbase) {
-  QueryCacheDatabaseEntry* databaseQueryCache = nullptr;
-
   {
-    auto const part = getPart(vocbase);
-    WRITE_LOCKER(writeLocker, _entriesLock[part]);
+    // forget the parts first, so that results stored meanwhile register
+    // their parts again
+    MUTEX_LOCKER(mutexLocker, _partsLock);
+    _partsByCollection.erase(vocbase);
+  }
+
+  for (unsigned int i = 0; i < NumberOfParts; ++i) {
+    QueryCacheDatabaseEntry* databaseQueryCache = nullptr;
+
+    {
+      WRITE_LOCKER(writeLocker, _entriesLock[i]);
+
+      auto it = _entries[i].find(vocbase);
 
-    auto it = _entries[part].find(vocbase);
+      if (it == _entries[i].end()) {
+        continue;
+      }
 
-    if (it == _entries[part].end()) {
-      return;
+      databaseQueryCache = (*it).second;
+      _entries[i].erase(it);
     }
 
-    databaseQueryCache = (*it).second;
-    _entries[part].erase(it);
+    // delete without holding the lock
+    TRI_ASSERT(databaseQueryCache != nullptr);
+    delete databaseQueryCache;
   }
-
-  // delete without holding the lock
-  TRI_ASSERT(databaseQueryCache != nullptr);
-  delete databaseQueryCache;
 }
 
 /// @brief invalidate all queries
 void QueryCache::invalidate() {
+  {
+    MUTEX_LOCKER(mutexLocker, _partsLock);
+    _partsByCollection.clear();
+  }
+
   for (unsigned int i = 0; i < NumberOfParts; ++i) {
     WRITE_LOCKER(writeLocker, _entriesLock[i]);
 
@@ -499,18 +633,94 @@ void QueryCache::enforceMaxResults(size_t value) {
     WRITE_LOCKER(writeLocker, _entriesLock[i]);
 
     for (auto& it : _entries[i]) {
-      it.second->enforceMaxResults(value);
+      it.second->enforceMaxResults(maxResultsPerPart(value));
     }
   }
 }
 
 /// @brief determine which lock to use for the cache entries
-unsigned int QueryCache::getPart(TRI_vocbase_t const* vocbase) const {
-  return static_cast<int>(
-      fasthash64(&vocbase, sizeof(TRI_vocbase_t const*), 0xf12345678abcdef) %
+/// results of the same database are spread over all parts by their query
+/// hashes, so concurrent lookups of different queries do not contend
+unsigned int QueryCache::getPart(TRI_vocbase_t const* vocbase,
+                                 uint64_t hash) const {
+  return static_cast<unsigned int>(
+      fasthash64(&vocbase, sizeof(TRI_vocbase_t const*), hash) %
       NumberOfParts);
 }
 
+/// @brief maximum number of results of a database in each cache part
+size_t QueryCache::maxResultsPerPart(size_t value) const {
+  return (std::max)(static_cast<size_t>(1),
+                    (value + NumberOfParts - 1) / NumberOfParts);
+}
+
+/// @brief return the parts that may contain results depending on one of
+/// the collections
+uint32_t QueryCache::partsForCollections(
+    TRI_vocbase_t* vocbase, std::vector<std::string> const& collections) {
+  MUTEX_LOCKER(mutexLocker, _partsLock);
+
+  auto it = _partsByCollection.find(vocbase);
+
+  if (it == _partsByCollection.end()) {
+    return 0;
+  }
+
+  uint32_t parts = 0;
+  for (auto const& collection : collections) {
+    auto it2 = (*it).second.find(collection);
+
+    if (it2 != (*it).second.end()) {
+      parts |= (*it2).second;
+    }
+  }
+  return parts;
+}
+
+/// @brief note that a part contains results depending on the collections
+/// note that the caller of this method must hold the part's write lock
+void QueryCache::registerPart(TRI_vocbase_t* vocbase,
+                              std::vector<std::string> const& collections,
+                              unsigned int part) {
+  MUTEX_LOCKER(mutexLocker, _partsLock);
+
+  auto& parts = _partsByCollection[vocbase];
+  for (auto const& collection : collections) {
+    parts[collection] |= (1U << part);
+  }
+}
+
+/// @brief forget about a part for the collections no result of the part
+/// depends on anymore
+/// note that the caller of this method must hold the part's write lock
+void QueryCache::unregisterPart(TRI_vocbase_t* vocbase,
+                                std::vector<std::string> const& collections,
+                                unsigned int part,
+                                QueryCacheDatabaseEntry const* entry) {
+  MUTEX_LOCKER(mutexLocker, _partsLock);
+
+  auto it = _partsByCollection.find(vocbase);
+
+  if (it == _partsByCollection.end()) {
+    return;
+  }
+
+  for (auto const& collection : collections) {
+    if (entry->dependsOn(collection)) {
+      continue;
+    }
+
+    auto it2 = (*it).second.find(collection);
+
+    if (it2 != (*it).second.end()) {
+      (*it2).second &= ~(1U << part);
+      if ((*it2).second == 0) {
+        (*it).second.erase(it2);
+      }
+    }
+  }
+}
+
 /// @brief invalidate all entries in the cache part
 /// note that the caller of this method must hold the write lock
 void QueryCache::invalidate(unsigned int part) {
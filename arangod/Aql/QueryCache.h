@@ -39,11 +39,17 @@ namespace aql {
 /// @brief cache mode
 enum QueryCacheMode { CACHE_ALWAYS_OFF, CACHE_ALWAYS_ON, CACHE_ON_DEMAND };
 
+/// @brief document keys a query result depends on, organized per collection.
+/// collections that are not contained are assumed to be used as a whole
+typedef std::unordered_map<std::string, std::vector<std::string>>
+    QueryCacheKeyDependencies;
+
 struct QueryCacheResultEntry {
   QueryCacheResultEntry() = delete;
 
   QueryCacheResultEntry(uint64_t, char const*, size_t, std::shared_ptr<arangodb::velocypack::Builder>,
-                        std::vector<std::string> const&);
+                        std::vector<std::string> const&,
+                        QueryCacheKeyDependencies const&);
 
   ~QueryCacheResultEntry() = default;
 
@@ -60,6 +66,7 @@ struct QueryCacheResultEntry {
   std::string const _queryString;
   std::shared_ptr<arangodb::velocypack::Builder> _queryResult;
   std::vector<std::string> const _collections;
+  QueryCacheKeyDependencies const _keys;
   QueryCacheResultEntry* _prev;
   QueryCacheResultEntry* _next;
   std::atomic<uint32_t> _refCount;
@@ -112,6 +119,10 @@ struct QueryCacheDatabaseEntry {
   /// cache
   void invalidate(std::string const&);
 
+  /// @brief invalidate all entries that depend on the whole collection or on
+  /// one of the given keys in the database-specific cache
+  void invalidate(std::string const&, std::vector<std::string> const&);
+
   /// @brief enforce maximum number of results
   void enforceMaxResults(size_t);
 
@@ -124,6 +135,21 @@ struct QueryCacheDatabaseEntry {
   /// @brief link the result entry to the end of the list
   void link(QueryCacheResultEntry*);
 
+  /// @brief register the dependencies of a result entry
+  void registerDependencies(QueryCacheResultEntry*);
+
+  /// @brief unregister the dependencies of a result entry
+  void unregisterDependencies(QueryCacheResultEntry*);
+
+  /// @brief remove a result entry from the cache, including its dependencies
+  void remove(uint64_t);
+
+  /// @brief remove all result entries with the given hashes
+  void remove(std::unordered_set<uint64_t> const&);
+
+  /// @brief whether or not some result entry depends on the collection
+  bool dependsOn(std::string const&) const;
+
   /// @brief hash table that maps query hashes to query results
   std::unordered_map<uint64_t, QueryCacheResultEntry*> _entriesByHash;
 
@@ -133,6 +159,13 @@ struct QueryCacheDatabaseEntry {
   std::unordered_map<std::string, std::unordered_set<uint64_t>>
       _entriesByCollection;
 
+  /// @brief hash table that contains all query results that only depend on
+  /// some documents of a collection. maps from collection names and document
+  /// keys to a set of query results as defined in _entriesByHash
+  std::unordered_map<std::string,
+                     std::unordered_map<std::string, std::unordered_set<uint64_t>>>
+      _entriesByKey;
+
   /// @brief beginning of linked list of result entries
   QueryCacheResultEntry* _head;
 
@@ -183,7 +216,8 @@ class QueryCache {
   /// query result!
   QueryCacheResultEntry* store(TRI_vocbase_t*, uint64_t, char const*, size_t,
                                std::shared_ptr<arangodb::velocypack::Builder>,
-                               std::vector<std::string> const&);
+                               std::vector<std::string> const&,
+                               QueryCacheKeyDependencies const& = QueryCacheKeyDependencies());
 
   /// @brief invalidate all queries for the given collections
   void invalidate(TRI_vocbase_t*, std::vector<std::string> const&);
@@ -191,6 +225,11 @@ class QueryCache {
   /// @brief invalidate all queries for a particular collection
   void invalidate(TRI_vocbase_t*, std::string const&);
 
+  /// @brief invalidate all queries for a particular collection that depend
+  /// on the whole collection or on one of the given document keys
+  void invalidate(TRI_vocbase_t*, std::string const&,
+                  std::vector<std::string> const&);
+
   /// @brief invalidate all queries for a particular database
   void invalidate(TRI_vocbase_t*);
 
@@ -207,7 +246,10 @@ class QueryCache {
   void enforceMaxResults(size_t);
 
   /// @brief determine which part of the cache to use for the cache entries
-  unsigned int getPart(TRI_vocbase_t const*) const;
+  unsigned int getPart(TRI_vocbase_t const*, uint64_t) const;
+
+  /// @brief maximum number of results of a database in each cache part
+  size_t maxResultsPerPart(size_t) const;
 
   /// @brief invalidate all entries in the cache part
   /// note that the caller of this method must hold the write lock
@@ -223,8 +265,25 @@ class QueryCache {
   void setMode(std::string const&);
 
  private:
-  /// @brief number of R/W locks for the query cache
-  static uint64_t const NumberOfParts = 8;
+  /// @brief return the parts that may contain results depending on one of
+  /// the collections
+  uint32_t partsForCollections(TRI_vocbase_t*, std::vector<std::string> const&);
+
+  /// @brief note that a part contains results depending on the collections
+  /// note that the caller of this method must hold the part's write lock
+  void registerPart(TRI_vocbase_t*, std::vector<std::string> const&,
+                    unsigned int);
+
+  /// @brief forget about a part for the collections no result of the part
+  /// depends on anymore
+  /// note that the caller of this method must hold the part's write lock
+  void unregisterPart(TRI_vocbase_t*, std::vector<std::string> const&,
+                      unsigned int, QueryCacheDatabaseEntry const*);
+
+ private:
+  /// @brief number of R/W locks for the query cache. the results of a
+  /// database are distributed over all parts by their query hashes
+  static uint64_t const NumberOfParts = 32;
 
   /// @brief protect mode changes with a mutex
   arangodb::Mutex _propertiesLock;
@@ -235,6 +294,16 @@ class QueryCache {
   /// @brief cached query entries, organized per database
   std::unordered_map<TRI_vocbase_t*, QueryCacheDatabaseEntry*>
       _entries[NumberOfParts];
+
+  /// @brief protects _partsByCollection
+  arangodb::Mutex _partsLock;
+
+  /// @brief bit masks of the parts that may contain results depending on a
+  /// collection, organized per database. invalidations only lock these
+  /// parts. a bit may be set for a part without such results, but never the
+  /// other way round
+  std::unordered_map<TRI_vocbase_t*, std::unordered_map<std::string, uint32_t>>
+      _partsByCollection;
 };
 }
 }
@@ -27,11 +27,13 @@
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionEngine.h"
 #include "Aql/Query.h"
+#include "Basics/MemoryArenas.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VPackStringBufferAdapter.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/tri-strings.h"
+#include "Cluster/FollowerInfo.h"
 #include "Logger/Logger.h"
 #include "Rest/HttpRequest.h"
 #include "Rest/HttpResponse.h"
@@ -40,7 +42,9 @@
 #include "Scheduler/SchedulerFeature.h"
 #include "Transaction/Methods.h"
 #include "Transaction/Context.h"
+#include "VocBase/LogicalCollection.h"
 #include "VocBase/ticks.h"
+#include "VocBase/vocbase.h"
 
 #include <velocypack/Dumper.h>
 #include <velocypack/velocypack-aliases.h>
@@ -68,6 +72,26 @@ size_t RestAqlHandler::queue() const { return JobQueue::AQL_QUEUE; }
 
 bool RestAqlHandler::isDirect() const { return false; }
 
+// checks if a dirty read on this follower has applied the client's last
+// write on every shard the query part reads. otherwise the coordinator has
+// to ask the leaders
+bool RestAqlHandler::canServeDirtyReads(Query* query) {
+  TRI_voc_rid_t readTick = query->readTick();
+  if (readTick == 0) {
+    return true;
+  }
+
+  std::vector<FollowerInfo const*> shards;
+  for (auto const& it : *query->collections()->collections()) {
+    LogicalCollection* collection = _vocbase->lookupCollection(it.first);
+    shards.emplace_back(collection == nullptr
+                            ? nullptr
+                            : collection->followers().get());
+  }
+
+  return FollowerInfo::canServeReads(shards, readTick);
+}
+
 // POST method for /_api/aql/instantiate (internal)
 // The body is a VelocyPack with attributes "plan" for the execution plan and
 // "options" for the options, all exactly as in AQL_EXECUTEJSON.
@@ -111,6 +135,12 @@ void RestAqlHandler::createQueryFromVelocyPack() {
     return;
   }
 
+  if (!canServeDirtyReads(query.get())) {
+    generateError(rest::ResponseCode::SERVICE_UNAVAILABLE,
+                  TRI_ERROR_CLUSTER_FOLLOWER_NOT_IN_SYNC);
+    return;
+  }
+
   // Now the query is ready to go, store it in the registry and return:
   double ttl = 600.0;
   bool found;
@@ -325,6 +355,12 @@ void RestAqlHandler::createQueryFromString() {
     return;
   }
 
+  if (!canServeDirtyReads(query.get())) {
+    generateError(rest::ResponseCode::SERVICE_UNAVAILABLE,
+                  TRI_ERROR_CLUSTER_FOLLOWER_NOT_IN_SYNC);
+    return;
+  }
+
   // Now the query is ready to go, store it in the registry and return:
   double ttl = 600.0;
   bool found;
@@ -575,6 +611,9 @@ RestStatus RestAqlHandler::execute() {
   // _request->fullUrl() << ": " << _request->body() << "\n\n";
   std::vector<std::string> const& suffixes = _request->suffixes();
 
+  // account the memory used by query snippets to the AQL arena
+  basics::MemoryArenaScope arenaScope(basics::MemoryArena::AQL);
+
   // extract the sub-request type
   rest::RequestType type = _request->requestType();
 
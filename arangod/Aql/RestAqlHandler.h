@@ -108,6 +108,9 @@ class RestAqlHandler : public RestVocbaseBaseHandler {
   void handleUseQuery(std::string const&, Query*,
                       arangodb::velocypack::Slice const);
 
+  // checks if all shards read by a query part can serve its dirty reads
+  bool canServeDirtyReads(Query*);
+
   // parseVelocyPackBody, returns a nullptr and produces an error
   // response if
   // parse was not successful.
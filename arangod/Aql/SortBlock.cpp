@@ -99,16 +99,22 @@ void SortBlock::doSorting() {
 
   // install the coords
   size_t count = 0;
+  std::vector<size_t> offsets;
+  offsets.reserve(_buffer.size());
 
   for (auto const& block : _buffer) {
+    offsets.emplace_back(coords.size());
     for (size_t i = 0; i < block->size(); i++) {
       coords.emplace_back(std::make_pair(count, i));
     }
     count++;
   }
 
+  std::vector<std::unique_ptr<basics::VelocyPackSortKeys>> sortKeys;
+  buildSortKeys(sum, sortKeys);
+
   // comparison function
-  OurLessThan ourLessThan(_trx, _buffer, _sortRegisters);
+  OurLessThan ourLessThan(_trx, _buffer, _sortRegisters, offsets, sortKeys);
 
   // sort coords
   if (_stable) {
@@ -171,6 +177,7 @@ void SortBlock::doSorting() {
               if (vCount == 0) {
                 // Was already stolen for another block
                 AqlValue b = a.clone();
+                countCopy(b);
                 try {
                   TRI_IF_FAILURE("SortBlock::doSortingCache") {
                     THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
@@ -241,12 +248,49 @@ void SortBlock::doSorting() {
   DEBUG_END_BLOCK();  
 }
 
+void SortBlock::buildSortKeys(
+    size_t count,
+    std::vector<std::unique_ptr<basics::VelocyPackSortKeys>>& sortKeys) const {
+  std::vector<VPackSlice> slices;
+  slices.reserve(count);
+
+  for (auto const& reg : _sortRegisters) {
+    slices.clear();
+    bool usable = true;
+    for (auto const& block : _buffer) {
+      for (size_t i = 0; i < block->size() && usable; i++) {
+        AqlValue const& value = block->getValueReference(i, reg.first);
+        if (value.isEmpty() || value.isRange() || value.isDocvec()) {
+          usable = false;
+        } else {
+          slices.emplace_back(value.slice());
+        }
+      }
+    }
+
+    auto keys = std::make_unique<basics::VelocyPackSortKeys>(true);
+    if (usable && keys->build(slices)) {
+      sortKeys.emplace_back(std::move(keys));
+    } else {
+      sortKeys.emplace_back(nullptr);
+    }
+  }
+}
+
 bool SortBlock::OurLessThan::operator()(std::pair<size_t, size_t> const& a,
                                         std::pair<size_t, size_t> const& b) const {
+  size_t i = 0;
   for (auto const& reg : _sortRegisters) {
-    int cmp = AqlValue::Compare(
-        _trx, _buffer[a.first]->getValueReference(a.second, reg.first),
-        _buffer[b.first]->getValueReference(b.second, reg.first), true);
+    auto const& keys = _sortKeys[i++];
+    int cmp;
+    if (keys != nullptr) {
+      cmp = keys->compare(_offsets[a.first] + a.second,
+                          _offsets[b.first] + b.second);
+    } else {
+      cmp = AqlValue::Compare(
+          _trx, _buffer[a.first]->getValueReference(a.second, reg.first),
+          _buffer[b.first]->getValueReference(b.second, reg.first), true);
+    }
 
     if (cmp < 0) {
       return reg.second;
@@ -27,6 +27,7 @@
 #include "Basics/Common.h"
 #include "Aql/ExecutionBlock.h"
 #include "Aql/SortNode.h"
+#include "Basics/VelocyPackSortKeys.h"
 
 namespace arangodb {
 namespace transaction {
@@ -59,10 +60,15 @@ class SortBlock final : public ExecutionBlock {
    public:
     OurLessThan(transaction::Methods* trx,
                 std::deque<AqlItemBlock*>& buffer,
-                std::vector<std::pair<RegisterId, bool>>& sortRegisters)
+                std::vector<std::pair<RegisterId, bool>>& sortRegisters,
+                std::vector<size_t> const& offsets,
+                std::vector<std::unique_ptr<basics::VelocyPackSortKeys>> const&
+                    sortKeys)
         : _trx(trx),
           _buffer(buffer),
-          _sortRegisters(sortRegisters) {}
+          _sortRegisters(sortRegisters),
+          _offsets(offsets),
+          _sortKeys(sortKeys) {}
 
     bool operator()(std::pair<size_t, size_t> const& a,
                     std::pair<size_t, size_t> const& b) const;
@@ -71,8 +77,19 @@ class SortBlock final : public ExecutionBlock {
     transaction::Methods* _trx;
     std::deque<AqlItemBlock*>& _buffer;
     std::vector<std::pair<RegisterId, bool>>& _sortRegisters;
+    /// @brief position of the first row of each block in the sort keys
+    std::vector<size_t> const& _offsets;
+    /// @brief precomputed keys per sort register, nullptr if the register
+    /// has to be compared with AqlValue::Compare
+    std::vector<std::unique_ptr<basics::VelocyPackSortKeys>> const& _sortKeys;
   };
 
+  /// @brief computes the sort keys for the registers which hold only
+  /// numbers or only strings
+  void buildSortKeys(
+      size_t count,
+      std::vector<std::unique_ptr<basics::VelocyPackSortKeys>>& sortKeys) const;
+
   /// @brief pairs, consisting of variable and sort direction
   /// (true = ascending | false = descending)
   std::vector<std::pair<RegisterId, bool>> _sortRegisters;
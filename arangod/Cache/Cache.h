@@ -65,6 +65,8 @@ class Cache : public std::enable_shared_from_this<Cache> {
 
  public:
   typedef FrequencyBuffer<uint8_t> StatBuffer;
+  typedef std::function<void(uint8_t const* key, uint32_t keySize)>
+      KeyCallback;
 
   static const uint64_t minSize;
   static const uint64_t minLogSize;
@@ -82,6 +84,16 @@ class Cache : public std::enable_shared_from_this<Cache> {
   virtual bool remove(void const* key, uint32_t keySize) = 0;
   virtual bool blacklist(void const* key, uint32_t keySize) = 0;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Calls the callback for the keys of up to limit cached values.
+  ///
+  /// Buckets which cannot be locked in a timely fashion or which are being
+  /// migrated are skipped, so this is a best-effort snapshot of the cache
+  /// contents. Returns the number of keys reported. The callback is invoked
+  /// while a bucket is locked and must not access the cache.
+  //////////////////////////////////////////////////////////////////////////////
+  virtual size_t enumerateKeys(KeyCallback const& callback, size_t limit) = 0;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Returns the total memory usage for this cache in bytes.
   //////////////////////////////////////////////////////////////////////////////
@@ -190,12 +202,59 @@ class Cache : public std::enable_shared_from_this<Cache> {
   bool freeMemory();
   bool migrate(std::shared_ptr<Table> newTable);
 
+  template <typename BucketType>
+  size_t enumerateBucketKeys(KeyCallback const& callback, size_t limit);
+
   virtual uint64_t freeMemoryFrom(uint32_t hash) = 0;
   virtual void migrateBucket(void* sourcePtr,
                              std::unique_ptr<Table::Subtable> targets,
                              std::shared_ptr<Table> newTable) = 0;
 };
 
+template <typename BucketType>
+size_t Cache::enumerateBucketKeys(KeyCallback const& callback, size_t limit) {
+  std::shared_ptr<Table> table;
+
+  if (!_state.lock(Cache::triesFast)) {
+    return 0;
+  }
+  bool ok = isOperational();
+  if (ok) {
+    startOperation();
+    table = _table;
+  }
+  _state.unlock();
+
+  if (!ok) {
+    return 0;
+  }
+
+  size_t found = 0;
+  for (uint64_t i = 0; i < table->size() && found < limit; i++) {
+    auto bucket = reinterpret_cast<BucketType*>(table->primaryBucket(i));
+    if (bucket == nullptr) {
+      // table was disabled
+      break;
+    }
+    if (!bucket->lock(Cache::triesFast)) {
+      continue;
+    }
+    if (!bucket->isMigrated()) {
+      for (size_t j = 0; j < BucketType::slotsData && found < limit; j++) {
+        CachedValue const* value = bucket->_cachedData[j];
+        if (value != nullptr) {
+          callback(value->key(), value->keySize);
+          found++;
+        }
+      }
+    }
+    bucket->unlock();
+  }
+
+  endOperation();
+  return found;
+}
+
 };  // end namespace cache
 };  // end namespace arangodb
 
@@ -22,10 +22,12 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "Cache/CachedValue.h"
+#include "Basics/MemoryArenas.h"
 
 #include <stdint.h>
 #include <cstring>
 
+using namespace arangodb::basics;
 using namespace arangodb::cache;
 
 uint8_t const* CachedValue::key() const {
@@ -68,7 +70,8 @@ void CachedValue::release() {
 bool CachedValue::isFreeable() { return (refCount.load() == 0); }
 
 CachedValue* CachedValue::copy() const {
-  uint8_t* buf = new uint8_t[size()];
+  uint8_t* buf = static_cast<uint8_t*>(
+      MemoryArenas::allocate(MemoryArena::CACHE, size()));
   memcpy(buf, this, size());
   CachedValue* value = reinterpret_cast<CachedValue*>(buf);
   value->refCount = 0;
@@ -81,7 +84,8 @@ CachedValue* CachedValue::construct(void const* k, uint32_t kSize,
     return nullptr;
   }
 
-  uint8_t* buf = new uint8_t[sizeof(CachedValue) + kSize + vSize];
+  uint8_t* buf = static_cast<uint8_t*>(MemoryArenas::allocate(
+      MemoryArena::CACHE, sizeof(CachedValue) + kSize + vSize));
   CachedValue* cv = reinterpret_cast<CachedValue*>(buf);
 
   cv->refCount = 0;
@@ -96,5 +100,5 @@ CachedValue* CachedValue::construct(void const* k, uint32_t kSize,
 }
 
 void CachedValue::operator delete(void* ptr) {
-  delete[] reinterpret_cast<uint8_t*>(ptr);
+  MemoryArenas::deallocate(ptr);
 }
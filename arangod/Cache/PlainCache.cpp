@@ -159,6 +159,10 @@ bool PlainCache::remove(void const* key, uint32_t keySize) {
 
 bool PlainCache::blacklist(void const* key, uint32_t keySize) { return false; }
 
+size_t PlainCache::enumerateKeys(KeyCallback const& callback, size_t limit) {
+  return enumerateBucketKeys<PlainBucket>(callback, limit);
+}
+
 uint64_t PlainCache::allocationSize(bool enableWindowedStats) {
   return sizeof(PlainCache) +
          (enableWindowedStats ? (sizeof(StatBuffer) +
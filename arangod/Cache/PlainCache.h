@@ -97,6 +97,11 @@ class PlainCache final : public Cache {
   //////////////////////////////////////////////////////////////////////////////
   bool blacklist(void const* key, uint32_t keySize);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Reports the keys of up to limit cached values.
+  //////////////////////////////////////////////////////////////////////////////
+  size_t enumerateKeys(KeyCallback const& callback, size_t limit);
+
  private:
   // friend class manager and tasks
   friend class FreeMemoryTask;
@@ -79,7 +79,8 @@ Table::Table(uint32_t logSize)
       _size(static_cast<uint64_t>(1) << _logSize),
       _shift(32 - _logSize),
       _mask((uint32_t)((_size - 1) << _shift)),
-      _buffer(new uint8_t[(_size * BUCKET_SIZE) + Table::padding]),
+      _buffer(static_cast<uint8_t*>(basics::MemoryArenas::allocate(
+          basics::MemoryArena::CACHE, (_size * BUCKET_SIZE) + Table::padding))),
       _buckets(reinterpret_cast<GenericBucket*>(
           reinterpret_cast<uint64_t>((_buffer.get() + 63)) &
           ~(static_cast<uint64_t>(0x3fU)))),
@@ -25,6 +25,7 @@
 #define ARANGODB_CACHE_TABLE_H
 
 #include "Basics/Common.h"
+#include "Basics/MemoryArenas.h"
 #include "Cache/Common.h"
 #include "Cache/State.h"
 
@@ -188,7 +189,7 @@ class Table : public std::enable_shared_from_this<Table> {
   uint64_t _size;
   uint32_t _shift;
   uint32_t _mask;
-  std::unique_ptr<uint8_t[]> _buffer;
+  std::unique_ptr<uint8_t, basics::MemoryArenas::Deleter> _buffer;
   GenericBucket* _buckets;
 
   std::shared_ptr<Table> _auxiliary;
@@ -197,6 +197,10 @@ bool TransactionalCache::blacklist(void const* key, uint32_t keySize) {
   return blacklisted;
 }
 
+size_t TransactionalCache::enumerateKeys(KeyCallback const& callback, size_t limit) {
+  return enumerateBucketKeys<TransactionalBucket>(callback, limit);
+}
+
 uint64_t TransactionalCache::allocationSize(bool enableWindowedStats) {
   return sizeof(TransactionalCache) +
          (enableWindowedStats ? (sizeof(StatBuffer) +
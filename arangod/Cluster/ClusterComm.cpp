@@ -24,6 +24,7 @@
 #include "ClusterComm.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/HybridLogicalClock.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/StringUtils.h"
 #include "Cluster/ClusterInfo.h"
 #include "Cluster/CollectionLockState.h"
@@ -71,7 +72,13 @@ void ClusterCommResult::setDestination(std::string const& dest,
   // state.
   if (dest.substr(0, 6) == "shard:") {
     shardID = dest.substr(6);
-    {
+    size_t const pos = shardID.find('@');
+    if (pos != std::string::npos) {
+      // a specific replica of the shard was requested, e.g. an in-sync
+      // follower for a read. this is used for dirty reads only
+      serverID = shardID.substr(pos + 1);
+      shardID = shardID.substr(0, pos);
+    } else {
       std::shared_ptr<std::vector<ServerID>> resp =
           ClusterInfo::instance()->getResponsibleServer(shardID);
       if (!resp->empty()) {
@@ -361,7 +368,9 @@ OperationID ClusterComm::getOperationID() { return TRI_NewTickServer(); }
 /// coordinator is doing, `destination` is a string that either starts
 /// with "shard:" followed by a shardID identifying the shard this
 /// request is sent to, actually, this is internally translated into a
-/// server ID. It is also possible to specify a DB server ID directly
+/// server ID. A specific replica of the shard can be addressed by
+/// appending "@" and its serverID to the shardID. It is also possible to
+/// specify a DB server ID directly
 /// here in the form of "server:" followed by a serverID. Furthermore,
 /// it is possible to specify the target endpoint directly using
 /// "tcp://..." or "ssl://..." endpoints, if `singleRequest` is true.
@@ -406,11 +415,21 @@ OperationID ClusterComm::asyncRequest(
   Callbacks callbacks;
   bool doLogConnectionErrors = logConnectionErrors();
 
+  // all answers of this coordinator transaction are collected here
+  // the registration is released again if the request cannot be sent
+  ClusterCommRegistry::Registration registration(_registry, coordTransactionID);
+  std::shared_ptr<TransactionResponses> trx = registration.transaction();
+
   if (callback) {
-    callbacks._onError = [callback, result, doLogConnectionErrors, this](int errorCode, std::unique_ptr<GeneralResponse> response) {
+    callbacks._onError = [callback, result, trx, doLogConnectionErrors, this](int errorCode, std::unique_ptr<GeneralResponse> response) {
+      bool registered;
       {
-        CONDITION_LOCKER(locker, somethingReceived);
-        responses.erase(result->operationID);
+        CONDITION_LOCKER(locker, trx->condition);
+        registered = (trx->operations.erase(result->operationID) > 0);
+        locker.broadcast();
+      }
+      if (registered) {
+        _registry.forgetResponse(result->operationID, result->coordTransactionID);
       }
       result->fromError(errorCode, std::move(response));
       if (result->status == CL_COMM_BACKEND_UNAVAILABLE) {
@@ -427,10 +446,15 @@ OperationID ClusterComm::asyncRequest(
       bool ret = ((*callback.get())(result.get()));
       TRI_ASSERT(ret == true);
     };
-    callbacks._onSuccess = [callback, result, this](std::unique_ptr<GeneralResponse> response) {
+    callbacks._onSuccess = [callback, result, trx, this](std::unique_ptr<GeneralResponse> response) {
+      bool registered;
       {
-        CONDITION_LOCKER(locker, somethingReceived);
-        responses.erase(result->operationID);
+        CONDITION_LOCKER(locker, trx->condition);
+        registered = (trx->operations.erase(result->operationID) > 0);
+        locker.broadcast();
+      }
+      if (registered) {
+        _registry.forgetResponse(result->operationID, result->coordTransactionID);
       }
       TRI_ASSERT(response.get() != nullptr);
       result->fromResponse(std::move(response));
@@ -438,8 +462,8 @@ OperationID ClusterComm::asyncRequest(
       TRI_ASSERT(ret == true);
     };
   } else {
-    callbacks._onError = [callback, result, doLogConnectionErrors, this](int errorCode, std::unique_ptr<GeneralResponse> response) {
-      CONDITION_LOCKER(locker, somethingReceived);
+    callbacks._onError = [result, trx, doLogConnectionErrors](int errorCode, std::unique_ptr<GeneralResponse> response) {
+      CONDITION_LOCKER(locker, trx->condition);
       result->fromError(errorCode, std::move(response));
       if (result->status == CL_COMM_BACKEND_UNAVAILABLE) {
         if (doLogConnectionErrors) {
@@ -452,23 +476,32 @@ OperationID ClusterComm::asyncRequest(
             << "' at endpoint '" << result->endpoint << "'";
         }
       }
-      somethingReceived.broadcast();
+      // only queue the answer if nobody has dropped the operation meanwhile
+      if (trx->operations.find(result->operationID) != trx->operations.end()) {
+        trx->completed.push_back(result->operationID);
+        locker.broadcast();
+      }
     };
-    callbacks._onSuccess = [result, this](std::unique_ptr<GeneralResponse> response) {
+    callbacks._onSuccess = [result, trx](std::unique_ptr<GeneralResponse> response) {
       TRI_ASSERT(response.get() != nullptr);
-      CONDITION_LOCKER(locker, somethingReceived);
+      CONDITION_LOCKER(locker, trx->condition);
       result->fromResponse(std::move(response));
-      somethingReceived.broadcast();
+      if (trx->operations.find(result->operationID) != trx->operations.end()) {
+        trx->completed.push_back(result->operationID);
+        locker.broadcast();
+      }
     };
   }
 
   TRI_ASSERT(request != nullptr);
-  CONDITION_LOCKER(locker, somethingReceived);
+  // the callbacks lock the transaction's condition as well, hence they cannot
+  // see the operation before it is fully registered
+  CONDITION_LOCKER(locker, trx->condition);
   auto ticketId = _communicator->addRequest(createCommunicatorDestination(result->endpoint, path),
                std::move(request), callbacks, opt);
 
   result->operationID = ticketId;
-  responses.emplace(ticketId, AsyncResponse{TRI_microtime(), result});
+  registration.done(ticketId, result);
   return ticketId;
 }
 
@@ -581,19 +614,24 @@ bool ClusterComm::match(ClientTransactionID const& clientTransactionID,
 ////////////////////////////////////////////////////////////////////////////////
 
 ClusterCommResult const ClusterComm::enquire(communicator::Ticket const ticketId) {
-  ResponseIterator i;
   AsyncResponse response;
 
   {
-    CONDITION_LOCKER(locker, somethingReceived);
+    ResponsePartition& partition = responsePartition(ticketId);
+    MUTEX_LOCKER(guard, partition.lock);
 
-    i = responses.find(ticketId);
-    if (i != responses.end()) {
+    auto i = partition.responses.find(ticketId);
+    if (i != partition.responses.end()) {
       response = i->second;
-      return *response.result.get();
     }
   }
 
+  if (response.result != nullptr) {
+    // the result is written by the communicator thread under this lock
+    CONDITION_LOCKER(locker, response.transaction->condition);
+    return *response.result.get();
+  }
+
   ClusterCommResult res;
   res.operationID = ticketId;
   // does res.coordTransactionID need to be set here too? 
@@ -620,42 +658,121 @@ ClusterCommResult const ClusterComm::wait(
     CoordTransactionID const coordTransactionID, communicator::Ticket const ticketId,
     ShardID const& shardID, ClusterCommTimeout timeout) {
 
-  ResponseIterator i;
-  AsyncResponse response;
-
   // tell scheduler that we are waiting:
   JobGuard guard{SchedulerFeature::SCHEDULER};
   guard.block();
 
-  CONDITION_LOCKER(locker, somethingReceived);
-  if (ticketId == 0) {
-    for (i = responses.begin(); i != responses.end(); i++) {
-      if (match(clientTransactionID, coordTransactionID, shardID, i->second.result.get())) {
+  std::shared_ptr<TransactionResponses> trx;
+  communicator::Ticket wanted = ticketId;
+
+  if (ticketId != 0) {
+    ResponsePartition& partition = responsePartition(ticketId);
+    MUTEX_LOCKER(locker, partition.lock);
+    auto i = partition.responses.find(ticketId);
+    if (i != partition.responses.end()) {
+      trx = i->second.transaction;
+    }
+  } else if (coordTransactionID != 0) {
+    trx = _registry.findTransaction(coordTransactionID);
+  } else {
+    // no transaction given, pick the first matching operation and wait for
+    // it. this is rare, so scanning all partitions is acceptable here
+    for (auto& partition : _registry.partitions) {
+      MUTEX_LOCKER(locker, partition.lock);
+      for (auto const& it : partition.responses) {
+        if (match(clientTransactionID, coordTransactionID, shardID,
+                  it.second.result.get())) {
+          wanted = it.first;
+          trx = it.second.transaction;
+          break;
+        }
+      }
+      if (trx != nullptr) {
         break;
       }
     }
-  } else {
-    i = responses.find(ticketId);
   }
-  if (i == responses.end()) {
+
+  ClusterCommResult res;
+  res.operationID = ticketId;
+  res.coordTransactionID = coordTransactionID;
+  res.status = CL_COMM_DROPPED;
+
+  if (trx == nullptr) {
     // Nothing known about this operation, return with failure:
-    ClusterCommResult res;
-    res.operationID = ticketId;
-    // does res.coordTransactionID need to be set here too? 
-    res.status = CL_COMM_DROPPED;
-    // tell Dispatcher that we are back in business
     return res;
   }
-  response = i->second;
 
-  ClusterCommOpStatus status = response.result->status;
+  double const endTime = (timeout > 0.0) ? TRI_microtime() + timeout : 0.0;
+  std::shared_ptr<ClusterCommResult> result;
+
+  {
+    CONDITION_LOCKER(locker, trx->condition);
+
+    while (true) {
+      if (wanted != 0) {
+        auto it = trx->operations.find(wanted);
+        if (it == trx->operations.end()) {
+          // dropped by somebody else in the meantime
+          break;
+        }
+        if (it->second->status != CL_COMM_SUBMITTED) {
+          result = it->second;
+          trx->operations.erase(it);
+          auto q = std::find(trx->completed.begin(), trx->completed.end(), wanted);
+          if (q != trx->completed.end()) {
+            trx->completed.erase(q);
+          }
+          break;
+        }
+      } else {
+        // take the first answer which has arrived for this transaction
+        for (auto q = trx->completed.begin(); q != trx->completed.end(); ++q) {
+          auto it = trx->operations.find(*q);
+          TRI_ASSERT(it != trx->operations.end());
+          if (match(clientTransactionID, coordTransactionID, shardID,
+                    it->second.get())) {
+            result = it->second;
+            trx->operations.erase(it);
+            trx->completed.erase(q);
+            break;
+          }
+        }
+        if (result != nullptr) {
+          break;
+        }
+        bool pending = false;
+        for (auto const& it : trx->operations) {
+          if (match(clientTransactionID, coordTransactionID, shardID,
+                    it.second.get())) {
+            pending = true;
+            break;
+          }
+        }
+        if (!pending) {
+          break;
+        }
+      }
+
+      if (endTime > 0.0) {
+        double const now = TRI_microtime();
+        if (now >= endTime) {
+          res.status = CL_COMM_TIMEOUT;
+          return res;
+        }
+        locker.wait(static_cast<uint64_t>((endTime - now) * 1000000.0) + 1);
+      } else {
+        locker.wait(100000);
+      }
+    }
+  }
 
-  while (status == CL_COMM_SUBMITTED) {
-    somethingReceived.wait(100000);
-    status = response.result->status;
+  if (result == nullptr) {
+    return res;
   }
-  responses.erase(i);
-  return *response.result.get();
+
+  _registry.forgetResponse(result->operationID, result->coordTransactionID);
+  return *result.get();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -727,6 +844,56 @@ void ClusterComm::drop(ClientTransactionID const& clientTransactionID,
       }
     }
   }
+  // Finally remove the matching asynchronous operations, answers arriving
+  // later for them are ignored:
+  std::vector<std::shared_ptr<TransactionResponses>> transactions;
+  if (operationID != 0) {
+    ResponsePartition& partition = responsePartition(operationID);
+    MUTEX_LOCKER(locker, partition.lock);
+    auto it = partition.responses.find(operationID);
+    if (it != partition.responses.end()) {
+      transactions.emplace_back(it->second.transaction);
+    }
+  }
+  if (coordTransactionID != 0) {
+    auto trx = _registry.findTransaction(coordTransactionID);
+    if (trx != nullptr) {
+      transactions.emplace_back(std::move(trx));
+    }
+  } else if (operationID == 0) {
+    for (auto& partition : _registry.partitions) {
+      MUTEX_LOCKER(locker, partition.lock);
+      for (auto const& it : partition.transactions) {
+        transactions.emplace_back(it.second);
+      }
+    }
+  }
+
+  for (auto const& trx : transactions) {
+    std::vector<std::shared_ptr<ClusterCommResult>> dropped;
+    {
+      CONDITION_LOCKER(locker, trx->condition);
+      for (auto it = trx->operations.begin(); it != trx->operations.end();) {
+        if ((0 != operationID && operationID == it->first) ||
+            match(clientTransactionID, coordTransactionID, shardID,
+                  it->second.get())) {
+          auto q = std::find(trx->completed.begin(), trx->completed.end(),
+                             it->first);
+          if (q != trx->completed.end()) {
+            trx->completed.erase(q);
+          }
+          dropped.emplace_back(it->second);
+          it = trx->operations.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      locker.broadcast();
+    }
+    for (auto const& result : dropped) {
+      _registry.forgetResponse(result->operationID, result->coordTransactionID);
+    }
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -982,6 +1149,70 @@ size_t ClusterComm::performRequests(std::vector<ClusterCommRequest>& requests,
   return nrGood;
 }
 
+namespace {
+//////////////////////////////////////////////////////////////////////////////
+/// @brief callback for a single request sent by performRequestsAsync. the
+/// callback for the last answer calls the completion function
+//////////////////////////////////////////////////////////////////////////////
+
+class PerformRequestsCallback final : public ClusterCommCallback {
+ public:
+  PerformRequestsCallback(
+      std::shared_ptr<std::vector<ClusterCommRequest>> requests, size_t index,
+      std::shared_ptr<std::atomic<size_t>> pending,
+      std::function<void(std::vector<ClusterCommRequest>&)> const& done)
+      : _requests(requests), _index(index), _pending(pending), _done(done) {}
+
+  bool operator()(ClusterCommResult* result) override final {
+    ClusterCommRequest& req = (*_requests)[_index];
+    req.result = *result;
+    req.done = true;
+
+    if (_pending->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      _done(*_requests);
+    }
+    return true;
+  }
+
+ private:
+  std::shared_ptr<std::vector<ClusterCommRequest>> _requests;
+  size_t const _index;
+  std::shared_ptr<std::atomic<size_t>> _pending;
+  std::function<void(std::vector<ClusterCommRequest>&)> _done;
+};
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief send requests without waiting for the answers, see header
+//////////////////////////////////////////////////////////////////////////////
+
+void ClusterComm::performRequestsAsync(
+    std::shared_ptr<std::vector<ClusterCommRequest>> requests,
+    ClusterCommTimeout timeout,
+    std::function<void(std::vector<ClusterCommRequest>&)> const& done) {
+  if (requests->empty()) {
+    done(*requests);
+    return;
+  }
+
+  CoordTransactionID coordinatorTransactionID = TRI_NewTickServer();
+  auto pending = std::make_shared<std::atomic<size_t>>(requests->size());
+
+  for (size_t i = 0; i < requests->size(); ++i) {
+    ClusterCommRequest& req = (*requests)[i];
+    if (req.headerFields.get() == nullptr) {
+      req.headerFields =
+          std::make_unique<std::unordered_map<std::string, std::string>>();
+    }
+
+    auto callback = std::make_shared<PerformRequestsCallback>(
+        requests, i, pending, done);
+    asyncRequest("", coordinatorTransactionID, req.destination,
+                 req.requestType, req.path, req.body, req.headerFields,
+                 callback, timeout, false, 2.0);
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @brief this is the fast path method for performRequests for the case
 /// of only a single request in the vector. In this case we can use a single
@@ -1128,17 +1359,102 @@ void ClusterComm::addAuthorization(std::unordered_map<std::string, std::string>*
 
 std::vector<communicator::Ticket> ClusterComm::activeServerTickets(std::vector<std::string> const& servers) {
   std::vector<communicator::Ticket> tickets;
-  CONDITION_LOCKER(locker, somethingReceived);
-  for (auto const& it: responses) {
-    for (auto const& server: servers) {
-      if (it.second.result && it.second.result->serverID == server) {
-        tickets.push_back(it.first);
+  for (auto& partition : _registry.partitions) {
+    MUTEX_LOCKER(locker, partition.lock);
+    for (auto const& it: partition.responses) {
+      for (auto const& server: servers) {
+        if (it.second.result && it.second.result->serverID == server) {
+          tickets.push_back(it.first);
+        }
       }
     }
   }
   return tickets;
 }
 
+std::shared_ptr<ClusterCommRegistry::TransactionResponses>
+ClusterCommRegistry::acquireTransaction(CoordTransactionID coordTransactionID) {
+  Partition& p = partition(coordTransactionID);
+  MUTEX_LOCKER(locker, p.lock);
+  auto& trx = p.transactions[coordTransactionID];
+  if (trx == nullptr) {
+    trx = std::make_shared<TransactionResponses>();
+  }
+  ++trx->registered;
+  return trx;
+}
+
+std::shared_ptr<ClusterCommRegistry::TransactionResponses>
+ClusterCommRegistry::findTransaction(CoordTransactionID coordTransactionID) {
+  Partition& p = partition(coordTransactionID);
+  MUTEX_LOCKER(locker, p.lock);
+  auto it = p.transactions.find(coordTransactionID);
+  if (it == p.transactions.end()) {
+    return nullptr;
+  }
+  return it->second;
+}
+
+void ClusterCommRegistry::releaseTransaction(
+    CoordTransactionID coordTransactionID) {
+  Partition& p = partition(coordTransactionID);
+  MUTEX_LOCKER(locker, p.lock);
+  auto it = p.transactions.find(coordTransactionID);
+  TRI_ASSERT(it != p.transactions.end());
+  if (it != p.transactions.end()) {
+    TRI_ASSERT(it->second->registered > 0);
+    if (--it->second->registered == 0) {
+      p.transactions.erase(it);
+    }
+  }
+}
+
+void ClusterCommRegistry::forgetResponse(communicator::Ticket ticketId,
+                                         CoordTransactionID coordTransactionID) {
+  {
+    Partition& p = partition(ticketId);
+    MUTEX_LOCKER(locker, p.lock);
+    p.responses.erase(ticketId);
+  }
+
+  releaseTransaction(coordTransactionID);
+}
+
+size_t ClusterCommRegistry::numberOfTransactions() {
+  size_t count = 0;
+  for (auto& p : partitions) {
+    MUTEX_LOCKER(locker, p.lock);
+    count += p.transactions.size();
+  }
+  return count;
+}
+
+size_t ClusterCommRegistry::numberOfResponses() {
+  size_t count = 0;
+  for (auto& p : partitions) {
+    MUTEX_LOCKER(locker, p.lock);
+    count += p.responses.size();
+  }
+  return count;
+}
+
+void ClusterCommRegistry::Registration::done(
+    communicator::Ticket ticketId,
+    std::shared_ptr<ClusterCommResult> const& result) {
+  TRI_ASSERT(!_done);
+  _transaction->operations.emplace(ticketId, result);
+  try {
+    Partition& p = _registry.partition(ticketId);
+    MUTEX_LOCKER(locker, p.lock);
+    p.responses.emplace(ticketId,
+                        AsyncResponse{TRI_microtime(), result, _transaction});
+  } catch (...) {
+    _transaction->operations.erase(ticketId);
+    throw;
+  }
+  _done = true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief ClusterComm main loop
 ////////////////////////////////////////////////////////////////////////////////
@@ -28,6 +28,7 @@
 
 #include "Agency/AgencyComm.h"
 #include "Basics/ConditionVariable.h"
+#include "Basics/Mutex.h"
 #include "Basics/ReadWriteLock.h"
 #include "Basics/Thread.h"
 #include "Cluster/ClusterInfo.h"
@@ -272,6 +273,11 @@ struct ClusterCommResult {
     if (errorCodes != headers.end()) {
       request->setHeader(StaticStrings::ErrorCodes, errorCodes->second);
     }
+    auto etag = headers.find(StaticStrings::Etag);
+    if (etag != headers.end()) {
+      // HEAD requests for documents are only answered with an ETag
+      request->setHeader(StaticStrings::Etag, etag->second);
+    }
     request->setHeader("x-arango-response-code",
                        GeneralResponse::responseString(answer_code));
     answer.reset(request);
@@ -367,6 +373,114 @@ struct ClusterCommRequest {
   }
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief registry of the outstanding asynchronous requests of ClusterComm,
+/// split into partitions with their own locks. An operation is found in the
+/// partition of its ticket, a transaction in the partition of its coordinator
+/// transaction id. Never lock two partitions at the same time, and never
+/// lock a transaction's condition while holding a partition lock.
+////////////////////////////////////////////////////////////////////////////////
+
+class ClusterCommRegistry {
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief outstanding asynchronous requests of one coordinator transaction.
+  /// Answers are queued in `completed` in the order in which they arrive, and
+  /// only the threads waiting on this transaction's condition are woken up.
+  /// `operations` and `completed` are protected by `condition`, `registered`
+  /// by the lock of the partition holding the transaction.
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct TransactionResponses {
+    arangodb::basics::ConditionVariable condition;
+    std::unordered_map<communicator::Ticket, std::shared_ptr<ClusterCommResult>>
+        operations;
+    std::deque<communicator::Ticket> completed;
+    size_t registered = 0;
+  };
+
+  struct AsyncResponse {
+    double timestamp;
+    std::shared_ptr<ClusterCommResult> result;
+    std::shared_ptr<TransactionResponses> transaction;
+  };
+
+  static constexpr size_t NumPartitions = 16;
+
+  struct Partition {
+    arangodb::Mutex lock;
+    std::unordered_map<communicator::Ticket, AsyncResponse> responses;
+    std::unordered_map<CoordTransactionID,
+                       std::shared_ptr<TransactionResponses>> transactions;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief registers an operation with its transaction while the request
+  /// is sent. Unless the operation is registered via `done`, the transaction
+  /// is released again when this goes out of scope, e.g. if sending the
+  /// request throws
+  //////////////////////////////////////////////////////////////////////////////
+
+  class Registration {
+   public:
+    Registration(ClusterCommRegistry& registry,
+                 CoordTransactionID coordTransactionID)
+        : _registry(registry),
+          _coordTransactionID(coordTransactionID),
+          _transaction(registry.acquireTransaction(coordTransactionID)),
+          _done(false) {}
+
+    Registration(Registration const&) = delete;
+    Registration& operator=(Registration const&) = delete;
+
+    ~Registration() {
+      if (!_done) {
+        _registry.releaseTransaction(_coordTransactionID);
+      }
+    }
+
+    std::shared_ptr<TransactionResponses> const& transaction() const {
+      return _transaction;
+    }
+
+    // registers the sent operation. the caller must hold the lock of the
+    // transaction's condition
+    void done(communicator::Ticket ticketId,
+              std::shared_ptr<ClusterCommResult> const& result);
+
+   private:
+    ClusterCommRegistry& _registry;
+    CoordTransactionID const _coordTransactionID;
+    std::shared_ptr<TransactionResponses> _transaction;
+    bool _done;
+  };
+
+  Partition& partition(uint64_t key) { return partitions[key % NumPartitions]; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief acquireTransaction registers one more operation with a
+  /// transaction, releaseTransaction unregisters it again. forgetResponse
+  /// removes an operation which was taken out of its transaction's
+  /// `operations` from the registry and releases the transaction
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::shared_ptr<TransactionResponses> acquireTransaction(
+      CoordTransactionID coordTransactionID);
+  std::shared_ptr<TransactionResponses> findTransaction(
+      CoordTransactionID coordTransactionID);
+  void releaseTransaction(CoordTransactionID coordTransactionID);
+  void forgetResponse(communicator::Ticket ticketId,
+                      CoordTransactionID coordTransactionID);
+
+  /// @brief number of transactions with registered operations
+  size_t numberOfTransactions();
+
+  /// @brief number of registered operations
+  size_t numberOfResponses();
+
+  Partition partitions[NumPartitions];
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief the class for the cluster communications library
 ////////////////////////////////////////////////////////////////////////////////
@@ -511,6 +625,20 @@ class ClusterComm {
                          ClusterCommTimeout timeout, size_t& nrDone,
                          arangodb::LogTopic const& logTopic);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief this method sends the given requests like performRequests, but
+  /// does not wait for the answers. Instead, `done` is called with the
+  /// requests from a communication thread as soon as every request has been
+  /// answered or has failed. This frees the calling thread for other work
+  /// in the meantime. Unlike performRequests, requests that cannot connect
+  /// are not retried.
+  //////////////////////////////////////////////////////////////////////////////
+
+  void performRequestsAsync(
+      std::shared_ptr<std::vector<ClusterCommRequest>> requests,
+      ClusterCommTimeout timeout,
+      std::function<void(std::vector<ClusterCommRequest>&)> const& done);
+
   std::shared_ptr<communicator::Communicator> communicator() {
     return _communicator;
   }
@@ -562,16 +690,22 @@ class ClusterComm {
   arangodb::basics::ConditionVariable somethingToSend;
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief received queue with lock and index
+  /// @brief registry of outstanding asynchronous requests
   //////////////////////////////////////////////////////////////////////////////
 
-  struct AsyncResponse {
-    double timestamp;
-    std::shared_ptr<ClusterCommResult> result;
-  };
+  typedef ClusterCommRegistry::TransactionResponses TransactionResponses;
+  typedef ClusterCommRegistry::AsyncResponse AsyncResponse;
+  typedef ClusterCommRegistry::Partition ResponsePartition;
 
-  typedef std::unordered_map<communicator::Ticket, AsyncResponse>::iterator ResponseIterator;
-  std::unordered_map<communicator::Ticket, AsyncResponse> responses;
+  ClusterCommRegistry _registry;
+
+  ResponsePartition& responsePartition(uint64_t key) {
+    return _registry.partition(key);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief received queue with lock and index
+  //////////////////////////////////////////////////////////////////////////////
 
   // Receiving answers:
   std::list<ClusterCommOperation*> received;
@@ -138,6 +138,10 @@ void ClusterFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
   options->addHiddenOption("--cluster.create-waits-for-sync-replication",
                      "active coordinator will wait for all replicas to create collection",
                      new BooleanParameter(&_createWaitsForSyncReplication));
+
+  options->addHiddenOption("--cluster.maintenance-threads",
+                     "maximal number of threads a DBserver uses to create, drop and update shards",
+                     new UInt32Parameter(&_maintenanceThreads));
 }
 
 void ClusterFeature::validateOptions(std::shared_ptr<ProgramOptions> options) {
@@ -184,6 +188,10 @@ void ClusterFeature::validateOptions(std::shared_ptr<ProgramOptions> options) {
     FATAL_ERROR_EXIT();
   }
 
+  if (_maintenanceThreads == 0) {
+    _maintenanceThreads = 1;
+  }
+
   if (!_myRole.empty()) {
     _requestedRole = ServerState::stringToRole(_myRole);
 
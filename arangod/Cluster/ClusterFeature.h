@@ -63,6 +63,7 @@ class ClusterFeature : public application_features::ApplicationFeature {
   std::string _coordinatorConfig;
   uint32_t _systemReplicationFactor = 2;
   bool _createWaitsForSyncReplication = true;
+  uint32_t _maintenanceThreads = 8;
 
  private:
   void reportRole(ServerState::RoleEnum);
@@ -78,6 +79,7 @@ class ClusterFeature : public application_features::ApplicationFeature {
 
   void setUnregisterOnShutdown(bool);
   bool createWaitsForSyncReplication() { return _createWaitsForSyncReplication; };
+  uint32_t maintenanceThreads() const { return _maintenanceThreads; }
 
   void stop() override final;
 
@@ -24,6 +24,7 @@
 
 #include "ClusterInfo.h"
 
+#include "Aql/PlanCache.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/MutexLocker.h"
 #include "Basics/ReadLocker.h"
@@ -575,6 +576,13 @@ void ClusterInfo::loadPlan() {
       }
       _planProt.doneVersion = storedVersion;
       _planProt.isValid = true;  // will never be reset to false
+      writeLocker.unlock();
+
+      if (swapCollections) {
+        // cached query plans may refer to indexes or shards that have
+        // changed with the new plan
+        arangodb::aql::PlanCache::instance()->invalidate();
+      }
     } else {
       LOG_TOPIC(ERR, Logger::CLUSTER) << "\"Plan\" is not an object in agency";
     }
@@ -31,6 +31,7 @@
 #include "Cluster/ClusterComm.h"
 #include "Cluster/ClusterInfo.h"
 #include "Indexes/Index.h"
+#include "Random/RandomGenerator.h"
 #include "Utils/CollectionNameResolver.h"
 #include "Utils/OperationOptions.h"
 #include "VocBase/LogicalCollection.h"
@@ -495,6 +496,141 @@ std::unordered_map<std::string, std::string> getForwardableRequestHeaders(
   return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the ClusterComm destination to read a shard from
+////////////////////////////////////////////////////////////////////////////////
+
+std::string shardReadDestination(ShardID const& shardId,
+                                 bool allowDirtyReads) {
+  if (allowDirtyReads) {
+    auto servers = ClusterInfo::instance()->getResponsibleServer(shardId);
+
+    if (servers->size() > 1) {
+      // spread the reads over the leader and all in-sync followers
+      uint32_t pos = RandomGenerator::interval(
+          static_cast<uint32_t>(servers->size() - 1));
+      if (pos > 0) {
+        return "shard:" + shardId + "@" + (*servers)[pos];
+      }
+    }
+  }
+
+  return "shard:" + shardId;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check whether a dirty read was rejected by a follower that has not
+/// yet applied the requested tick
+////////////////////////////////////////////////////////////////////////////////
+
+bool isFollowerNotInSync(ClusterCommResult const& result) {
+  if (result.status != CL_COMM_RECEIVED ||
+      result.answer_code != rest::ResponseCode::SERVICE_UNAVAILABLE ||
+      result.answer == nullptr) {
+    return false;
+  }
+
+  VPackSlice payload = result.answer->payload();
+  return payload.isObject() &&
+         VelocyPackHelper::getNumericValue<int>(
+             payload, StaticStrings::ErrorNum.c_str(), TRI_ERROR_NO_ERROR) ==
+             TRI_ERROR_CLUSTER_FOLLOWER_NOT_IN_SYNC;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief creates the requests to retry dirty reads that were rejected by
+/// lagging followers on the shard leaders
+////////////////////////////////////////////////////////////////////////////////
+
+std::vector<ClusterCommRequest> leaderRetriesForDirtyReads(
+    std::vector<ClusterCommRequest> const& requests,
+    std::unordered_map<std::string, std::string> const& headers,
+    std::vector<size_t>& positions) {
+  std::vector<ClusterCommRequest> retries;
+
+  for (size_t i = 0; i < requests.size(); ++i) {
+    auto const& req = requests[i];
+    if (!isFollowerNotInSync(req.result)) {
+      continue;
+    }
+
+    ClusterCommRequest retry("shard:" + req.result.shardID, req.requestType,
+                             req.path, req.body);
+    auto headersCopy =
+        std::make_unique<std::unordered_map<std::string, std::string>>(
+            headers);
+    retry.setHeaders(headersCopy);
+    retries.emplace_back(std::move(retry));
+    positions.emplace_back(i);
+  }
+
+  return retries;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the result body of a single document read from a DB server
+////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr<VPackBuilder> documentResultBody(
+    ClusterCommRequest const& req, std::string const& collname,
+    VPackSlice const search) {
+  TRI_ASSERT(req.result.answer != nullptr);
+
+  if (req.requestType != rest::RequestType::HEAD) {
+    return req.result.answer->toVelocyPackBuilderPtr();
+  }
+
+  VPackSlice key = search;
+  if (search.isObject()) {
+    key = search.get(StaticStrings::KeyString);
+  }
+
+  auto builder = std::make_shared<VPackBuilder>();
+  builder->openObject();
+  if (key.isString()) {
+    builder->add(StaticStrings::IdString,
+                 VPackValue(collname + "/" + key.copyString()));
+    builder->add(StaticStrings::KeyString, key);
+  }
+  bool found;
+  std::string rev = req.result.answer->header(StaticStrings::Etag, found);
+  if (found) {
+    // the ETag is sent in double quotes
+    if (rev.size() >= 2 && rev.front() == '"' && rev.back() == '"') {
+      rev = rev.substr(1, rev.size() - 2);
+    }
+    builder->add(StaticStrings::RevString, VPackValue(rev));
+  }
+  builder->close();
+  return builder;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief send dirty reads that were rejected by lagging followers to the
+/// shard leaders instead
+////////////////////////////////////////////////////////////////////////////////
+
+static void retryDirtyReadsOnLeaders(
+    std::shared_ptr<ClusterComm>& cc, std::vector<ClusterCommRequest>& requests,
+    std::unordered_map<std::string, std::string> const& headers) {
+  std::vector<size_t> positions;
+  std::vector<ClusterCommRequest> retries =
+      leaderRetriesForDirtyReads(requests, headers, positions);
+
+  if (retries.empty()) {
+    return;
+  }
+
+  size_t nrDone = 0;
+  cc->performRequests(retries, CL_DEFAULT_TIMEOUT, nrDone,
+                      Logger::COMMUNICATION);
+
+  for (size_t i = 0; i < retries.size(); ++i) {
+    requests[positions[i]].result = retries[i].result;
+    requests[positions[i]].done = retries[i].done;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief check if a list of attributes have the same values in two vpack
 /// documents
@@ -1296,6 +1432,14 @@ int getDocumentOnCoordinator(
 
     VPackBuilder reqBuilder;
 
+    // dirty reads may be served by in-sync followers, which need to know
+    // which writes the client must be able to observe
+    std::unordered_map<std::string, std::string> readHeaders;
+    if (options.allowDirtyReads && options.readTick != 0) {
+      readHeaders.emplace(StaticStrings::ReadTickHeader,
+                          TRI_RidToString(options.readTick));
+    }
+
     // Now prepare the requests:
     std::vector<ClusterCommRequest> requests;
     auto body = std::make_shared<std::string>();
@@ -1306,6 +1450,8 @@ int getDocumentOnCoordinator(
           headers->emplace("if-match",
                            slice.get(StaticStrings::RevString).copyString());
         }
+        headers->insert(readHeaders.begin(), readHeaders.end());
+        readHeaders = *headers;
 
         VPackSlice keySlice = slice;
         if (slice.isObject()) {
@@ -1314,7 +1460,7 @@ int getDocumentOnCoordinator(
 
         // We send to single endpoint
         requests.emplace_back(
-            "shard:" + it.first, reqType,
+            shardReadDestination(it.first, options.allowDirtyReads), reqType,
             baseUrl + StringUtils::urlEncode(it.first) + "/" +
                 StringUtils::urlEncode(keySlice.copyString()) +
                 optsUrlPart,
@@ -1330,8 +1476,14 @@ int getDocumentOnCoordinator(
         body = std::make_shared<std::string>(reqBuilder.slice().toJson());
         // We send to Babies endpoint
         requests.emplace_back(
-            "shard:" + it.first, reqType,
+            shardReadDestination(it.first, options.allowDirtyReads), reqType,
             baseUrl + StringUtils::urlEncode(it.first) + optsUrlPart, body);
+        if (!readHeaders.empty()) {
+          auto headersCopy =
+              std::make_unique<std::unordered_map<std::string, std::string>>(
+                  readHeaders);
+          requests.back().setHeaders(headersCopy);
+        }
       }
     }
 
@@ -1339,6 +1491,12 @@ int getDocumentOnCoordinator(
     size_t nrDone = 0;
     cc->performRequests(requests, CL_DEFAULT_TIMEOUT, nrDone, Logger::COMMUNICATION);
 
+    if (options.allowDirtyReads) {
+      // followers that have not yet applied the client's writes reject the
+      // read. ask the leaders in this case
+      retryDirtyReadsOnLeaders(cc, requests, readHeaders);
+    }
+
     // Now listen to the results:
     if (!useMultiple) {
       TRI_ASSERT(requests.size() == 1);
@@ -1353,7 +1511,7 @@ int getDocumentOnCoordinator(
       responseCode = res.answer_code;
       TRI_ASSERT(res.answer != nullptr);
 
-      auto parsedResult = res.answer->toVelocyPackBuilderPtr();
+      auto parsedResult = documentResultBody(req, collname, slice);
       resultBody.swap(parsedResult);
       return TRI_ERROR_NO_ERROR;
     }
@@ -1425,7 +1583,7 @@ int getDocumentOnCoordinator(
           nrok++;
           responseCode = res.answer_code;
           TRI_ASSERT(res.answer != nullptr);
-          auto parsedResult = res.answer->toVelocyPackBuilderPtr();
+          auto parsedResult = documentResultBody(req, collname, slice);
           resultBody.swap(parsedResult);
         }
       } else {
@@ -1470,6 +1628,124 @@ int getDocumentOnCoordinator(
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief process the answer of an asynchronous single document read. dirty
+/// reads rejected by lagging followers are sent to the shard leader once
+////////////////////////////////////////////////////////////////////////////////
+
+static void finishGetDocumentAsync(
+    std::vector<ClusterCommRequest>& requests,
+    std::unordered_map<std::string, std::string> const& headers,
+    std::string const& collname, std::shared_ptr<VPackBuilder> const& search,
+    bool mayRetry,
+    std::function<void(int, rest::ResponseCode,
+                       std::shared_ptr<VPackBuilder>)> const& callback) {
+  TRI_ASSERT(requests.size() == 1);
+  auto const& req = requests[0];
+
+  if (mayRetry && isFollowerNotInSync(req.result)) {
+    auto cc = ClusterComm::instance();
+    if (cc != nullptr) {
+      std::vector<size_t> positions;
+      auto retries = std::make_shared<std::vector<ClusterCommRequest>>(
+          leaderRetriesForDirtyReads(requests, headers, positions));
+      cc->performRequestsAsync(
+          retries, CL_DEFAULT_TIMEOUT,
+          [headers, collname, search,
+           callback](std::vector<ClusterCommRequest>& requests) {
+            finishGetDocumentAsync(requests, headers, collname, search,
+                                   false, callback);
+          });
+      return;
+    }
+  }
+
+  auto const& res = req.result;
+  int commError = handleGeneralCommErrors(&res);
+  if (commError != TRI_ERROR_NO_ERROR) {
+    callback(commError, rest::ResponseCode::SERVER_ERROR, nullptr);
+    return;
+  }
+
+  TRI_ASSERT(res.answer != nullptr);
+  callback(TRI_ERROR_NO_ERROR, res.answer_code,
+           documentResultBody(req, collname, search->slice()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get a single document in a coordinator without blocking
+////////////////////////////////////////////////////////////////////////////////
+
+bool getDocumentOnCoordinatorAsync(
+    std::string const& dbname, std::string const& collname,
+    VPackSlice const slice, OperationOptions const& options,
+    std::function<void(int, rest::ResponseCode,
+                       std::shared_ptr<VPackBuilder>)> const& callback) {
+  ClusterInfo* ci = ClusterInfo::instance();
+  auto cc = ClusterComm::instance();
+  if (cc == nullptr || slice.isArray()) {
+    // errors are reported by the synchronous variant
+    return false;
+  }
+
+  std::shared_ptr<LogicalCollection> collinfo;
+  try {
+    collinfo = ci->getCollection(dbname, collname);
+  } catch (...) {
+    return false;
+  }
+  TRI_ASSERT(collinfo != nullptr);
+
+  std::unordered_map<ShardID, std::vector<VPackValueLength>> shardMap;
+  std::vector<std::pair<ShardID, VPackValueLength>> reverseMapping;
+  if (distributeBabyOnShards(shardMap, ci, collinfo->cid_as_string(),
+                             collinfo, reverseMapping, slice,
+                             0) != TRI_ERROR_NO_ERROR) {
+    return false;
+  }
+  TRI_ASSERT(shardMap.size() == 1);
+  ShardID const& shardID = shardMap.begin()->first;
+
+  VPackSlice keySlice = slice;
+  if (slice.isObject()) {
+    keySlice = slice.get(StaticStrings::KeyString);
+  }
+
+  std::unordered_map<std::string, std::string> headers;
+  if (!options.ignoreRevs && slice.hasKey(StaticStrings::RevString)) {
+    headers.emplace("if-match",
+                    slice.get(StaticStrings::RevString).copyString());
+  }
+  if (options.allowDirtyReads && options.readTick != 0) {
+    headers.emplace(StaticStrings::ReadTickHeader,
+                    TRI_RidToString(options.readTick));
+  }
+
+  auto requests = std::make_shared<std::vector<ClusterCommRequest>>();
+  requests->emplace_back(
+      shardReadDestination(shardID, options.allowDirtyReads),
+      options.silent ? rest::RequestType::HEAD : rest::RequestType::GET,
+      "/_db/" + StringUtils::urlEncode(dbname) + "/_api/document/" +
+          StringUtils::urlEncode(shardID) + "/" +
+          StringUtils::urlEncode(keySlice.copyString()) +
+          "?ignoreRevs=" + (options.ignoreRevs ? "true" : "false"),
+      std::make_shared<std::string>());
+  auto headersCopy =
+      std::make_unique<std::unordered_map<std::string, std::string>>(headers);
+  requests->back().setHeaders(headersCopy);
+
+  bool mayRetry = options.allowDirtyReads;
+  auto search = std::make_shared<VPackBuilder>(VPackBuilder::clone(slice));
+  cc->performRequestsAsync(
+      requests, CL_DEFAULT_TIMEOUT,
+      [headers, collname, search, mayRetry,
+       callback](std::vector<ClusterCommRequest>& requests) {
+        finishGetDocumentAsync(requests, headers, collname, search, mayRetry,
+                               callback);
+      });
+  return true;
+}
+
 /// @brief fetch edges from TraverserEngines
 ///        Contacts all TraverserEngines placed
 ///        on the DBServers for the given list
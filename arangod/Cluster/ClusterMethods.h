@@ -30,6 +30,7 @@
 #include <velocypack/velocypack-aliases.h>
 
 #include "Agency/AgencyComm.h"
+#include "Cluster/ClusterComm.h"
 #include "Cluster/TraverserEngineRegistry.h"
 #include "Rest/HttpResponse.h"
 #include "VocBase/LogicalCollection.h"
@@ -52,6 +53,41 @@ struct OperationOptions;
 std::unordered_map<std::string, std::string> getForwardableRequestHeaders(
     GeneralRequest*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the ClusterComm destination to read a shard from. if dirty
+/// reads are allowed, the leader or one of the in-sync followers is picked
+////////////////////////////////////////////////////////////////////////////////
+
+std::string shardReadDestination(ShardID const& shardId, bool allowDirtyReads);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check whether a dirty read was rejected by a follower that has not
+/// yet applied the requested tick
+////////////////////////////////////////////////////////////////////////////////
+
+bool isFollowerNotInSync(ClusterCommResult const& result);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief creates the requests to retry dirty reads that were rejected by
+/// lagging followers on the shard leaders. the positions of the rejected
+/// requests are stored in `positions`
+////////////////////////////////////////////////////////////////////////////////
+
+std::vector<ClusterCommRequest> leaderRetriesForDirtyReads(
+    std::vector<ClusterCommRequest> const& requests,
+    std::unordered_map<std::string, std::string> const& headers,
+    std::vector<size_t>& positions);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the result body of a single document read from a DB server.
+/// HEAD requests are answered without a body, so the document's identity is
+/// built from the collection name, the key and the ETag header instead
+////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr<arangodb::velocypack::Builder> documentResultBody(
+    ClusterCommRequest const& req, std::string const& collname,
+    VPackSlice const search);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief check if a list of attributes have the same values in two vpack
 /// documents
@@ -116,6 +152,22 @@ int getDocumentOnCoordinator(
     std::unordered_map<int, size_t>& errorCounter,
     std::shared_ptr<arangodb::velocypack::Builder>& resultBody);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get a single document in a coordinator without blocking the
+/// calling thread. This only works if the responsible shard can be determined
+/// from the document's key alone. Otherwise false is returned, nothing is
+/// sent, and the caller has to use getDocumentOnCoordinator. If true is
+/// returned, `callback` is called from a ClusterComm thread with the error
+/// code, the response code and the body of the DB server's answer.
+////////////////////////////////////////////////////////////////////////////////
+
+bool getDocumentOnCoordinatorAsync(
+    std::string const& dbname, std::string const& collname,
+    VPackSlice const slice, OperationOptions const& options,
+    std::function<void(int, arangodb::rest::ResponseCode,
+                       std::shared_ptr<arangodb::velocypack::Builder>)> const&
+        callback);
+
 /// @brief fetch edges from TraverserEngines
 ///        Contacts all TraverserEngines placed
 ///        on the DBServers for the given list
@@ -23,8 +23,12 @@
 
 #include "DBServerAgencySync.h"
 
+#include "Basics/Exceptions.h"
 #include "Basics/MutexLocker.h"
+#include "Cluster/ClusterFeature.h"
 #include "Cluster/ClusterInfo.h"
+#include "Cluster/Maintenance.h"
+#include "Cluster/ServerState.h"
 #include "Cluster/HeartbeatThread.h"
 #include "Logger/Logger.h"
 #include "RestServer/DatabaseFeature.h"
@@ -39,6 +43,9 @@ using namespace arangodb;
 using namespace arangodb::application_features;
 using namespace arangodb::rest;
 
+/// @brief maximal number of keys changed in Current by one agency transaction
+static size_t const ReportBatchSize = 256;
+
 DBServerAgencySync::DBServerAgencySync(HeartbeatThread* heartbeat)
     : _heartbeat(heartbeat) {}
 
@@ -72,107 +79,151 @@ DBServerAgencySyncResult DBServerAgencySync::execute() {
   auto clusterInfo = ClusterInfo::instance();
   auto plan = clusterInfo->getPlan();
   auto current = clusterInfo->getCurrent();
+  std::string const serverId = ServerState::instance()->getId();
   
   VocbaseGuard guard(vocbase);
 
-  V8Context* context = V8DealerFeature::DEALER->enterContext(vocbase, true);
-
-  if (context == nullptr) {
-    LOG_TOPIC(INFO, arangodb::Logger::FIXME) << "DBServerAgencySync::execute no V8 context";
-    return result;
-  }
-
-  double now = TRI_microtime();
-  if (now - startTime > 5.0) {
-    LOG_TOPIC(INFO, arangodb::Logger::FIXME) << "DBServerAgencySync::execute took more than 5s to get free V8 context, starting handle-plan-change now";
-  }
-
-  TRI_DEFER(V8DealerFeature::DEALER->exitContext(context));
-
-  auto isolate = context->_isolate;
-  
   try {
-    v8::HandleScope scope(isolate);
-
-    // execute script inside the context
-    auto file = TRI_V8_ASCII_STRING("handle-plan-change");
-    auto content =
-        TRI_V8_ASCII_STRING("require('@arangodb/cluster').handlePlanChange");
-    
-    v8::TryCatch tryCatch;
-    v8::Handle<v8::Value> handlePlanChange = TRI_ExecuteJavaScriptString(
-        isolate, isolate->GetCurrentContext(), content, file, false);
-    
-    if (tryCatch.HasCaught()) {
-      TRI_LogV8Exception(isolate, &tryCatch);
-      return result;
-    }
+    // compare the Plan with what we have locally and apply the differences
+    VPackBuilder local;
+    maintenance::localState(local);
+    std::vector<maintenance::ActionDescription> actions =
+      maintenance::diffPlanLocal(plan->slice(), current->slice(),
+                                 local.slice(), serverId);
 
-    if (!handlePlanChange->IsFunction()) {
-      LOG_TOPIC(ERR, Logger::CLUSTER) << "handlePlanChange is not a function";
-      return result;
+    LOG_TOPIC(DEBUG, Logger::HEARTBEAT)
+      << "DBServerAgencySync::execute found " << actions.size()
+      << " maintenance actions";
+
+    ClusterFeature* cluster =
+      ApplicationServer::getFeature<ClusterFeature>("Cluster");
+    maintenance::MaintenanceErrors errors;
+    maintenance::executeActions(actions, cluster->maintenanceThreads(), errors);
+
+    // report the new local state in Current
+    if (!actions.empty()) {
+      local.clear();
+      maintenance::localState(local);
     }
+    VPackBuilder report;
+    maintenance::reportInCurrent(plan->slice(), current->slice(),
+                                 local.slice(), errors, serverId, report);
+    Result res = maintenance::sendReport(report.slice(), ReportBatchSize);
+
+    scheduleShardSynchronization(vocbase, actions);
 
-    v8::Handle<v8::Function> func =
-      v8::Handle<v8::Function>::Cast(handlePlanChange);
-    v8::Handle<v8::Value> args[2];
-    // Keep the shared_ptr to the builder while we run TRI_VPackToV8 on the
-    // slice(), just to be on the safe side:
-    auto builder = clusterInfo->getPlan();
-    args[0] = TRI_VPackToV8(isolate, builder->slice());
-    builder = clusterInfo->getCurrent();
-    args[1] = TRI_VPackToV8(isolate, builder->slice());
-    
-    v8::Handle<v8::Value> res =
-      func->Call(isolate->GetCurrentContext()->Global(), 2, args);
-    
-    if (tryCatch.HasCaught()) {
-      TRI_LogV8Exception(isolate, &tryCatch);
-      return result;
+    result.success = res.ok();
+    VPackSlice version = plan->slice().get("Version");
+    if (version.isNumber()) {
+      result.planVersion = version.getNumber<uint64_t>();
     }
-    
-    result.success = true;  // unless overwritten by actual result
-
-    if (res->IsObject()) {
-      v8::Handle<v8::Object> o = res->ToObject();
-
-      v8::Handle<v8::Array> names = o->GetOwnPropertyNames();
-      uint32_t const n = names->Length();
-      
-      for (uint32_t i = 0; i < n; ++i) {
-        v8::Handle<v8::Value> key = names->Get(i);
-        v8::String::Utf8Value str(key);
-
-        v8::Handle<v8::Value> value = o->Get(key);
-        
-        if (value->IsNumber()) {
-          if (strcmp(*str, "plan") == 0) {
-            result.planVersion =
-              static_cast<uint64_t>(value->ToUint32()->Value());
-          } else if (strcmp(*str, "current") == 0) {
-            result.currentVersion =
-              static_cast<uint64_t>(value->ToUint32()->Value());
-          }
-        } else if (value->IsBoolean() && strcmp(*str, "success")) {
-          result.success = TRI_ObjectToBoolean(value);
-        }
-      }
-    } else {
-      LOG_TOPIC(ERR, Logger::CLUSTER)
-        << "handlePlanChange returned a non-object";
-      return result;
+    version = current->slice().get("Version");
+    if (version.isNumber()) {
+      result.currentVersion = version.getNumber<uint64_t>();
     }
-    LOG_TOPIC(DEBUG, Logger::HEARTBEAT)
-      << "DBServerAgencySync::execute back from JS";
+
     // invalidate our local cache, even if an error occurred
     clusterInfo->flush();
+  } catch (basics::Exception const& ex) {
+    LOG_TOPIC(ERR, Logger::CLUSTER)
+      << "DBServerAgencySync::execute failed: " << ex.what();
+  } catch (std::exception const& ex) {
+    LOG_TOPIC(ERR, Logger::CLUSTER)
+      << "DBServerAgencySync::execute failed: " << ex.what();
   } catch (...) {
   }
 
-  now = TRI_microtime();
+  double now = TRI_microtime();
   if (now - startTime > 30) {
     LOG_TOPIC(WARN, Logger::HEARTBEAT) << "DBServerAgencySync::execute "
-      "took longer than 30s to execute handlePlanChange()";
+      "took longer than 30s";
   }
   return result;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief registers a V8 task for each follower shard which has to get in
+/// sync with its leader. The tasks have fixed ids, so a shard for which a
+/// synchronization is still pending is not scheduled a second time
+////////////////////////////////////////////////////////////////////////////////
+
+void DBServerAgencySync::scheduleShardSynchronization(
+    TRI_vocbase_t* vocbase,
+    std::vector<maintenance::ActionDescription> const& actions) {
+  VPackBuilder shards;
+  {
+    VPackArrayBuilder a(&shards);
+    for (auto const& action : actions) {
+      if (action.type !=
+          maintenance::ActionDescription::Type::SYNCHRONIZE_SHARD) {
+        continue;
+      }
+      VPackObjectBuilder o(&shards);
+      shards.add("database", VPackValue(action.database));
+      shards.add("shard", VPackValue(action.shard));
+      shards.add("planId", VPackValue(action.collection));
+      shards.add("leader", VPackValue(action.leader));
+    }
+  }
+  if (shards.slice().length() == 0) {
+    return;
+  }
+
+  V8Context* context = V8DealerFeature::DEALER->enterContext(vocbase, true);
+
+  if (context == nullptr) {
+    LOG_TOPIC(INFO, arangodb::Logger::FIXME) << "DBServerAgencySync::execute no V8 context to schedule shard synchronization";
+    return;
+  }
+
+  TRI_DEFER(V8DealerFeature::DEALER->exitContext(context));
+
+  auto isolate = context->_isolate;
+  v8::HandleScope scope(isolate);
+
+  // registering fails if a task with the same id is still pending, which is
+  // expected while the shard is being synchronized; other errors are logged
+  auto file = TRI_V8_ASCII_STRING("schedule-shard-synchronization");
+  auto content = TRI_V8_ASCII_STRING(
+    "(function (shards) {"
+    "  var internal = require('internal');"
+    "  shards.forEach(function (s) {"
+    "    var id = 'synchronizeOneShard_' + s.database + '_' + s.shard + '_' +"
+    "             s.planId + '_' + s.leader;"
+    "    try {"
+    "      internal.registerTask({ id: id, name: id, isSystem: true,"
+    "        params: s, offset: 0,"
+    "        command: 'require(\"@arangodb/cluster\").synchronizeOneShard('"
+    "               + 'params.database, params.shard, params.planId, params.leader);'"
+    "      });"
+    "    } catch (err) {"
+    "      if (err.errorNum !== internal.errors.ERROR_TASK_DUPLICATE_ID.code) {"
+    "        require('console').warn('cannot schedule synchronization of shard '"
+    "          + s.database + '/' + s.shard + ': ' + String(err));"
+    "      }"
+    "    }"
+    "  });"
+    "})");
+
+  v8::TryCatch tryCatch;
+  v8::Handle<v8::Value> schedule = TRI_ExecuteJavaScriptString(
+      isolate, isolate->GetCurrentContext(), content, file, false);
+
+  if (tryCatch.HasCaught()) {
+    TRI_LogV8Exception(isolate, &tryCatch);
+    return;
+  }
+
+  if (!schedule->IsFunction()) {
+    LOG_TOPIC(ERR, Logger::CLUSTER) << "shard synchronization is not a function";
+    return;
+  }
+
+  v8::Handle<v8::Value> args[1] = {TRI_VPackToV8(isolate, shards.slice())};
+  v8::Handle<v8::Function>::Cast(schedule)->Call(
+      isolate->GetCurrentContext()->Global(), 1, args);
+
+  if (tryCatch.HasCaught()) {
+    TRI_LogV8Exception(isolate, &tryCatch);
+  }
+}
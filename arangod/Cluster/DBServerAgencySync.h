@@ -26,8 +26,13 @@
 
 #include "Basics/Common.h"
 
+struct TRI_vocbase_t;
+
 namespace arangodb {
 class HeartbeatThread;
+namespace maintenance {
+struct ActionDescription;
+}
 
 struct DBServerAgencySyncResult {
   bool success;
@@ -56,6 +61,9 @@ class DBServerAgencySync {
  private:
   DBServerAgencySyncResult execute();
 
+  void scheduleShardSynchronization(
+      TRI_vocbase_t*, std::vector<maintenance::ActionDescription> const&);
+
  private:
   HeartbeatThread* _heartbeat;
 };
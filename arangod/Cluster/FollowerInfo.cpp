@@ -38,6 +38,41 @@ std::shared_ptr<std::vector<ServerID> const> FollowerInfo::get() {
   return _followers;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief register a document revision applied via synchronous replication
+////////////////////////////////////////////////////////////////////////////////
+
+void FollowerInfo::updateAppliedTick(TRI_voc_rid_t tick) {
+  TRI_voc_rid_t expected = _appliedTick.load(std::memory_order_relaxed);
+
+  // only increase the tick
+  while (expected < tick &&
+         !_appliedTick.compare_exchange_weak(expected, tick,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check if a read with the given revision can be served from all of
+/// the given shards
+////////////////////////////////////////////////////////////////////////////////
+
+bool FollowerInfo::canServeReads(std::vector<FollowerInfo const*> const& shards,
+                                 TRI_voc_rid_t readTick) {
+  if (readTick == 0) {
+    return true;
+  }
+
+  for (auto const& it : shards) {
+    if (it == nullptr || !it->canServeRead(readTick)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief change JSON under
 /// Current/Collection/<DB-name>/<Collection-ID>/<shard-ID>
@@ -38,11 +38,13 @@ class FollowerInfo {
   Mutex                                        _mutex;
   arangodb::LogicalCollection*                 _docColl;
   bool                                         _isLeader;
+  std::atomic<TRI_voc_rid_t>                   _appliedTick;
 
  public:
 
   explicit FollowerInfo(arangodb::LogicalCollection* d)
-    : _followers(new std::vector<ServerID>()), _docColl(d), _isLeader(false) { }
+    : _followers(new std::vector<ServerID>()), _docColl(d), _isLeader(false),
+      _appliedTick(0) { }
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief get information about current followers of a shard.
@@ -91,6 +93,40 @@ class FollowerInfo {
     _isLeader = b;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief highest document revision applied on this server as a follower
+  /// via synchronous replication
+  //////////////////////////////////////////////////////////////////////////////
+
+  TRI_voc_rid_t appliedTick() const {
+    return _appliedTick.load(std::memory_order_acquire);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief register a document revision applied via synchronous replication
+  //////////////////////////////////////////////////////////////////////////////
+
+  void updateAppliedTick(TRI_voc_rid_t tick);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief check if a read that must observe all writes up to the given
+  /// revision can be served here. leaders can serve all reads, followers
+  /// only if they have applied the revision
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool canServeRead(TRI_voc_rid_t readTick) const {
+    return _isLeader || readTick == 0 || appliedTick() >= readTick;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief check if a read with the given revision can be served from all
+  /// of the given shards. a nullptr stands for a shard this server does not
+  /// know (yet), which cannot serve dirty reads
+  //////////////////////////////////////////////////////////////////////////////
+
+  static bool canServeReads(std::vector<FollowerInfo const*> const& shards,
+                            TRI_voc_rid_t readTick);
+
 };
 }  // end namespace arangodb
 
@@ -0,0 +1,759 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Maintenance.h"
+
+#include "Agency/AgencyComm.h"
+#include "Basics/Exceptions.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/ReadLocker.h"
+#include "Basics/StringUtils.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Cluster/FollowerInfo.h"
+#include "Indexes/Index.h"
+#include "Logger/Logger.h"
+#include "RestServer/DatabaseFeature.h"
+#include "StorageEngine/PhysicalCollection.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/vocbase.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <thread>
+
+using namespace arangodb;
+using namespace arangodb::application_features;
+using namespace arangodb::maintenance;
+
+/// @brief collection properties which are compared between Plan and shards
+static std::vector<std::string> const ComparedProperties{
+    "waitForSync", "doCompact", "journalSize", "indexBuckets"};
+
+/// @brief plan attributes which are not passed on when creating a shard
+static std::unordered_set<std::string> const IgnoredShardProperties{
+    "id", "name", "shards", "indexes", "planId", "status", "statusString"};
+
+/// @brief follows `path` through nested objects, returns a none slice if
+/// any of the attributes is missing
+static VPackSlice lookup(VPackSlice slice,
+                         std::vector<std::string> const& path) {
+  for (auto const& key : path) {
+    if (!slice.isObject()) {
+      return VPackSlice::noneSlice();
+    }
+    slice = slice.get(key);
+  }
+  return slice;
+}
+
+static bool containsServer(VPackSlice servers, std::string const& serverId) {
+  if (servers.isArray()) {
+    for (auto const& server : VPackArrayIterator(servers)) {
+      if (server.isEqualString(serverId)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/// @brief indexes which are created together with every shard
+static bool isAutomaticIndex(VPackSlice index) {
+  VPackSlice type = index.get("type");
+  return type.isEqualString("primary") || type.isEqualString("edge");
+}
+
+static bool containsIndex(VPackSlice indexes, VPackSlice id) {
+  if (indexes.isArray()) {
+    for (auto const& index : VPackArrayIterator(indexes)) {
+      if (basics::VelocyPackHelper::compare(index.get("id"), id, false) == 0) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+static std::shared_ptr<VPackBuilder> copySlice(VPackSlice slice) {
+  auto builder = std::make_shared<VPackBuilder>();
+  builder->add(slice);
+  return builder;
+}
+
+char const* ActionDescription::typeName(Type type) {
+  switch (type) {
+    case Type::CREATE_DATABASE:
+      return "create database";
+    case Type::DROP_DATABASE:
+      return "drop database";
+    case Type::CREATE_SHARD:
+      return "create shard";
+    case Type::DROP_SHARD:
+      return "drop shard";
+    case Type::UPDATE_SHARD:
+      return "update shard";
+    case Type::ENSURE_INDEX:
+      return "ensure index";
+    case Type::DROP_INDEX:
+      return "drop index";
+    case Type::SYNCHRONIZE_SHARD:
+      return "synchronize shard";
+  }
+  return "unknown";
+}
+
+void maintenance::localState(VPackBuilder& local) {
+  DatabaseFeature* databaseFeature =
+      ApplicationServer::getFeature<DatabaseFeature>("Database");
+
+  VPackObjectBuilder databases(&local);
+  for (auto const& name : databaseFeature->getDatabaseNames()) {
+    TRI_vocbase_t* vocbase = databaseFeature->useDatabase(name);
+    if (vocbase == nullptr) {
+      // dropped in the meantime
+      continue;
+    }
+    TRI_DEFER(vocbase->release());
+
+    local.add(VPackValue(name));
+    VPackObjectBuilder shards(&local);
+    for (auto* collection : vocbase->collections(false)) {
+      local.add(VPackValue(collection->name()));
+      VPackObjectBuilder shard(&local);
+      local.add("planId", VPackValue(collection->planId_as_string()));
+      local.add("isLeader", VPackValue(collection->followers()->isLeader()));
+
+      local.add(VPackValue("followers"));
+      {
+        VPackArrayBuilder followers(&local);
+        for (auto const& follower : *collection->followers()->get()) {
+          local.add(VPackValue(follower));
+        }
+      }
+
+      // index definitions without the volatile selectivity estimates, such
+      // that they can be compared with Plan and Current
+      VPackBuilder indexes;
+      collection->getIndexesVPack(indexes, false, false);
+      local.add(VPackValue("indexes"));
+      {
+        VPackArrayBuilder list(&local);
+        for (auto const& index : VPackArrayIterator(indexes.slice())) {
+          VPackObjectBuilder entry(&local);
+          for (auto const& it : VPackObjectIterator(index)) {
+            if (!it.key.isEqualString("selectivityEstimate") &&
+                !it.key.isEqualString("figures")) {
+              local.add(it.key.copyString(), it.value);
+            }
+          }
+        }
+      }
+
+      VPackBuilder properties =
+          collection->toVelocyPackIgnore({"indexes", "path"}, false, false);
+      for (auto const& key : ComparedProperties) {
+        VPackSlice value = properties.slice().get(key);
+        if (!value.isNone()) {
+          local.add(key, value);
+        }
+      }
+    }
+  }
+}
+
+std::vector<ActionDescription> maintenance::diffPlanLocal(
+    VPackSlice plan, VPackSlice current, VPackSlice local,
+    std::string const& serverId) {
+  std::vector<ActionDescription> actions;
+
+  VPackSlice planDatabases = plan.get("Databases");
+  VPackSlice planCollections = plan.get("Collections");
+
+  // databases which are planned but do not exist locally
+  if (planDatabases.isObject()) {
+    for (auto const& db : VPackObjectIterator(planDatabases)) {
+      std::string name = db.key.copyString();
+      if (!local.hasKey(name)) {
+        actions.emplace_back(ActionDescription::Type::CREATE_DATABASE, name);
+        actions.back().properties = copySlice(db.value);
+      }
+    }
+  }
+
+  // shards planned on this server, "<database>/<shard>"
+  std::unordered_set<std::string> planned;
+
+  if (planCollections.isObject()) {
+    for (auto const& db : VPackObjectIterator(planCollections)) {
+      std::string dbName = db.key.copyString();
+      if (!db.value.isObject()) {
+        continue;
+      }
+      for (auto const& col : VPackObjectIterator(db.value)) {
+        std::string planId = col.key.copyString();
+        VPackSlice shards = col.value.get("shards");
+        if (!shards.isObject()) {
+          continue;
+        }
+        VPackSlice planIndexes = col.value.get("indexes");
+
+        for (auto const& shard : VPackObjectIterator(shards)) {
+          if (!containsServer(shard.value, serverId)) {
+            continue;
+          }
+          std::string shardName = shard.key.copyString();
+          planned.emplace(dbName + "/" + shardName);
+
+          std::string leader;
+          if (!shard.value[0].isEqualString(serverId)) {
+            leader = shard.value[0].copyString();
+          }
+          auto addAction = [&](ActionDescription::Type type) {
+            actions.emplace_back(type, dbName);
+            actions.back().collection = planId;
+            actions.back().shard = shardName;
+            actions.back().leader = leader;
+            return &actions.back();
+          };
+
+          VPackSlice localShard = lookup(local, {dbName, shardName});
+
+          if (localShard.isNone()) {
+            auto properties = std::make_shared<VPackBuilder>();
+            {
+              VPackObjectBuilder o(properties.get());
+              for (auto const& it : VPackObjectIterator(col.value)) {
+                if (IgnoredShardProperties.find(it.key.copyString()) ==
+                    IgnoredShardProperties.end()) {
+                  properties->add(it.key.copyString(), it.value);
+                }
+              }
+              properties->add("name", VPackValue(shardName));
+              properties->add("planId", VPackValue(planId));
+            }
+            addAction(ActionDescription::Type::CREATE_SHARD)->properties =
+                properties;
+          } else {
+            bool changed = (localShard.get("isLeader").isTrue() != leader.empty());
+            for (auto const& key : ComparedProperties) {
+              VPackSlice wanted = col.value.get(key);
+              VPackSlice have = localShard.get(key);
+              if (!wanted.isNone() && !have.isNone() &&
+                  basics::VelocyPackHelper::compare(wanted, have, false) != 0) {
+                changed = true;
+              }
+            }
+            if (changed) {
+              auto properties = std::make_shared<VPackBuilder>();
+              {
+                VPackObjectBuilder o(properties.get());
+                for (auto const& key : ComparedProperties) {
+                  VPackSlice wanted = col.value.get(key);
+                  if (!wanted.isNone()) {
+                    properties->add(key, wanted);
+                  }
+                }
+              }
+              addAction(ActionDescription::Type::UPDATE_SHARD)->properties =
+                  properties;
+            }
+
+            // indexes which are no longer planned
+            VPackSlice localIndexes = localShard.get("indexes");
+            if (localIndexes.isArray()) {
+              for (auto const& index : VPackArrayIterator(localIndexes)) {
+                if (!isAutomaticIndex(index) &&
+                    !containsIndex(planIndexes, index.get("id"))) {
+                  addAction(ActionDescription::Type::DROP_INDEX)->index =
+                      index.get("id").copyString();
+                }
+              }
+            }
+          }
+
+          // indexes which are planned but do not exist locally
+          if (planIndexes.isArray()) {
+            VPackSlice localIndexes = localShard.isNone()
+                                          ? VPackSlice::noneSlice()
+                                          : localShard.get("indexes");
+            for (auto const& index : VPackArrayIterator(planIndexes)) {
+              if (!isAutomaticIndex(index) &&
+                  !containsIndex(localIndexes, index.get("id"))) {
+                auto action = addAction(ActionDescription::Type::ENSURE_INDEX);
+                action->index = index.get("id").copyString();
+                action->properties = copySlice(index);
+              }
+            }
+          }
+
+          // followers which the leader does not list as in sync yet
+          if (!leader.empty() &&
+              !containsServer(lookup(current, {"Collections", dbName, planId,
+                                               shardName, "servers"}),
+                              serverId)) {
+            addAction(ActionDescription::Type::SYNCHRONIZE_SHARD);
+          }
+        }
+      }
+    }
+  }
+
+  // local shards which are not planned here anymore, and local databases
+  // which are not planned at all
+  std::vector<std::string> droppedDatabases;
+  for (auto const& db : VPackObjectIterator(local)) {
+    std::string dbName = db.key.copyString();
+    bool dropDatabase = dbName != TRI_VOC_SYSTEM_DATABASE &&
+                        planDatabases.isObject() &&
+                        !planDatabases.hasKey(dbName);
+    for (auto const& shard : VPackObjectIterator(db.value)) {
+      std::string shardName = shard.key.copyString();
+      // local system collections are not shards
+      if (shardName.empty() || shardName[0] == '_' || dropDatabase) {
+        continue;
+      }
+      if (planned.find(dbName + "/" + shardName) == planned.end()) {
+        actions.emplace_back(ActionDescription::Type::DROP_SHARD, dbName);
+        actions.back().collection = shard.value.get("planId").copyString();
+        actions.back().shard = shardName;
+      }
+    }
+    if (dropDatabase) {
+      droppedDatabases.emplace_back(dbName);
+    }
+  }
+  for (auto const& dbName : droppedDatabases) {
+    actions.emplace_back(ActionDescription::Type::DROP_DATABASE, dbName);
+  }
+
+  return actions;
+}
+
+/// @brief runs one shard action, the caller holds a usage of the database
+static Result executeShardAction(TRI_vocbase_t* vocbase,
+                                 ActionDescription const& action) {
+  typedef ActionDescription::Type Type;
+
+  if (action.type == Type::CREATE_SHARD) {
+    LogicalCollection* collection =
+        vocbase->createCollection(action.properties->slice());
+    TRI_ASSERT(collection != nullptr);
+    if (action.leader.empty()) {
+      collection->followers()->clear();
+    }
+    collection->followers()->setLeader(action.leader.empty());
+    return Result();
+  }
+
+  LogicalCollection* collection = vocbase->lookupCollection(action.shard);
+  if (collection == nullptr) {
+    return Result(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
+                  "shard '" + action.shard + "' not found");
+  }
+
+  if (action.type == Type::DROP_SHARD) {
+    return Result(vocbase->dropCollection(collection, true, -1.0));
+  }
+
+  READ_LOCKER(readLocker, vocbase->_inventoryLock);
+
+  SingleCollectionTransaction trx(transaction::StandaloneContext::Create(vocbase),
+                                  collection->cid(), AccessMode::Type::EXCLUSIVE);
+  Result res = trx.begin();
+  if (!res.ok()) {
+    return res;
+  }
+
+  switch (action.type) {
+    case Type::UPDATE_SHARD: {
+      if (action.properties->slice().length() > 0) {
+        bool doSync = ApplicationServer::getFeature<DatabaseFeature>("Database")
+                          ->forceSyncProperties();
+        res = collection->updateProperties(action.properties->slice(), doSync);
+        if (!res.ok()) {
+          return res;
+        }
+        collection->getPhysical()->persistProperties();
+      }
+      bool const leading = action.leader.empty();
+      if (leading && !collection->followers()->isLeader()) {
+        // we take over, the old followers have to get in sync with us again
+        collection->followers()->clear();
+      }
+      collection->followers()->setLeader(leading);
+      break;
+    }
+    case Type::ENSURE_INDEX: {
+      bool created = false;
+      auto idx =
+          collection->createIndex(&trx, action.properties->slice(), created);
+      if (idx == nullptr) {
+        return Result(TRI_errno());
+      }
+      break;
+    }
+    case Type::DROP_INDEX: {
+      TRI_idx_iid_t iid = basics::StringUtils::uint64(action.index);
+      auto idx = collection->lookupIndex(iid);
+      if (idx != nullptr && idx->canBeDropped() &&
+          !collection->dropIndex(iid)) {
+        return Result(TRI_ERROR_ARANGO_INDEX_NOT_FOUND);
+      }
+      break;
+    }
+    default: {
+      TRI_ASSERT(false);
+      return Result(TRI_ERROR_INTERNAL);
+    }
+  }
+
+  return trx.commit();
+}
+
+/// @brief runs one action and converts exceptions into a result
+static Result executeAction(ActionDescription const& action) {
+  DatabaseFeature* databaseFeature =
+      ApplicationServer::getFeature<DatabaseFeature>("Database");
+
+  LOG_TOPIC(DEBUG, Logger::CLUSTER)
+      << ActionDescription::typeName(action.type) << " " << action.database
+      << (action.shard.empty() ? "" : "/" + action.shard)
+      << (action.index.empty() ? "" : "/" + action.index);
+
+  try {
+    switch (action.type) {
+      case ActionDescription::Type::CREATE_DATABASE: {
+        TRI_voc_tick_t id = 0;
+        VPackSlice idSlice = action.properties->slice().get("id");
+        if (idSlice.isString()) {
+          id = basics::StringUtils::uint64(idSlice.copyString());
+        }
+        TRI_vocbase_t* vocbase = nullptr;
+        int res = databaseFeature->createDatabase(id, action.database, vocbase);
+        if (vocbase != nullptr) {
+          vocbase->release();
+        }
+        return Result(res);
+      }
+      case ActionDescription::Type::DROP_DATABASE: {
+        return Result(
+            databaseFeature->dropDatabase(action.database, false, true));
+      }
+      default: {
+        TRI_vocbase_t* vocbase = databaseFeature->useDatabase(action.database);
+        if (vocbase == nullptr) {
+          return Result(TRI_ERROR_ARANGO_DATABASE_NOT_FOUND);
+        }
+        TRI_DEFER(vocbase->release());
+        return executeShardAction(vocbase, action);
+      }
+    }
+  } catch (basics::Exception const& ex) {
+    return Result(ex.code(), ex.what());
+  } catch (std::exception const& ex) {
+    return Result(TRI_ERROR_INTERNAL, ex.what());
+  } catch (...) {
+    return Result(TRI_ERROR_INTERNAL);
+  }
+}
+
+void maintenance::executeActions(std::vector<ActionDescription> const& actions,
+                                 size_t parallelism, MaintenanceErrors& errors) {
+  typedef ActionDescription::Type Type;
+
+  Mutex errorsLock;
+  auto run = [&](ActionDescription const& action) -> bool {
+    Result res = executeAction(action);
+    if (res.ok()) {
+      return true;
+    }
+    LOG_TOPIC(ERR, Logger::CLUSTER)
+        << "failed to " << ActionDescription::typeName(action.type) << " "
+        << action.database << "/" << action.shard << ": "
+        << res.errorMessage();
+    std::string key = action.database;
+    if (action.isShardAction()) {
+      key += "/" + action.shard;
+    }
+    MUTEX_LOCKER(locker, errorsLock);
+    errors.emplace(key, res);
+    return false;
+  };
+
+  for (auto const& action : actions) {
+    if (action.type == Type::CREATE_DATABASE) {
+      run(action);
+    }
+  }
+
+  // group the shard actions by shard, keeping their order
+  std::vector<std::vector<ActionDescription const*>> groups;
+  std::unordered_map<std::string, size_t> groupByShard;
+  for (auto const& action : actions) {
+    if (!action.isShardAction() || action.type == Type::SYNCHRONIZE_SHARD) {
+      continue;
+    }
+    std::string key = action.database + "/" + action.shard;
+    auto it = groupByShard.find(key);
+    if (it == groupByShard.end()) {
+      it = groupByShard.emplace(key, groups.size()).first;
+      groups.emplace_back();
+    }
+    groups[it->second].emplace_back(&action);
+  }
+
+  std::atomic<size_t> next(0);
+  auto worker = [&]() {
+    size_t i;
+    while ((i = next.fetch_add(1)) < groups.size()) {
+      for (auto const* action : groups[i]) {
+        if (!run(*action)) {
+          // the remaining actions for this shard will be retried in the
+          // next round
+          break;
+        }
+      }
+    }
+  };
+
+  size_t numThreads = (std::min)(parallelism, groups.size());
+  if (numThreads <= 1) {
+    worker();
+  } else {
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; ++i) {
+      threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  for (auto const& action : actions) {
+    if (action.type == Type::DROP_DATABASE) {
+      run(action);
+    }
+  }
+}
+
+void maintenance::reportInCurrent(VPackSlice plan, VPackSlice current,
+                                  VPackSlice local,
+                                  MaintenanceErrors const& errors,
+                                  std::string const& serverId,
+                                  VPackBuilder& report) {
+  auto addIfChanged = [&](std::string const& key, VPackSlice have,
+                          VPackSlice wanted) {
+    if (have.isNone() ||
+        basics::VelocyPackHelper::compare(have, wanted, false) != 0) {
+      report.add(key, wanted);
+    }
+  };
+  auto addError = [](VPackBuilder& entry, Result const* error) {
+    entry.add("error", VPackValue(error != nullptr));
+    entry.add("errorNum",
+              VPackValue(error == nullptr ? 0 : error->errorNumber()));
+    entry.add("errorMessage",
+              VPackValue(error == nullptr ? "" : error->errorMessage()));
+  };
+
+  VPackObjectBuilder o(&report);
+
+  // databases
+  VPackSlice planDatabases = plan.get("Databases");
+  if (planDatabases.isObject()) {
+    for (auto const& db : VPackObjectIterator(planDatabases)) {
+      std::string dbName = db.key.copyString();
+      auto it = errors.find(dbName);
+      Result const* error = (it == errors.end()) ? nullptr : &it->second;
+      if (error == nullptr && !local.hasKey(dbName)) {
+        continue;
+      }
+      VPackBuilder entry;
+      {
+        VPackObjectBuilder e(&entry);
+        addError(entry, error);
+        VPackSlice id = db.value.get("id");
+        if (!id.isNone()) {
+          entry.add("id", id);
+        }
+        entry.add("name", VPackValue(dbName));
+      }
+      addIfChanged("Current/Databases/" + dbName + "/" + serverId,
+                   lookup(current, {"Databases", dbName, serverId}),
+                   entry.slice());
+    }
+  }
+
+  // entries of databases which are gone from the Plan
+  VPackSlice currentDatabases = current.get("Databases");
+  if (currentDatabases.isObject()) {
+    for (auto const& db : VPackObjectIterator(currentDatabases)) {
+      std::string dbName = db.key.copyString();
+      if (db.value.isObject() && db.value.hasKey(serverId) &&
+          (!planDatabases.isObject() || !planDatabases.hasKey(dbName))) {
+        report.add("Current/Databases/" + dbName + "/" + serverId,
+                   VPackSlice::nullSlice());
+      }
+    }
+  }
+
+  // shards led by this server
+  std::unordered_set<std::string> leading;
+  VPackSlice planCollections = plan.get("Collections");
+  if (planCollections.isObject()) {
+    for (auto const& db : VPackObjectIterator(planCollections)) {
+      std::string dbName = db.key.copyString();
+      if (!db.value.isObject()) {
+        continue;
+      }
+      for (auto const& col : VPackObjectIterator(db.value)) {
+        std::string planId = col.key.copyString();
+        VPackSlice shards = col.value.get("shards");
+        if (!shards.isObject()) {
+          continue;
+        }
+        for (auto const& shard : VPackObjectIterator(shards)) {
+          std::string shardName = shard.key.copyString();
+          if (!shard.value.isArray() || shard.value.length() == 0 ||
+              !shard.value[0].isEqualString(serverId)) {
+            continue;
+          }
+          leading.emplace(dbName + "/" + planId + "/" + shardName);
+
+          auto it = errors.find(dbName + "/" + shardName);
+          Result const* error = (it == errors.end()) ? nullptr : &it->second;
+          VPackSlice localShard = lookup(local, {dbName, shardName});
+          if (error == nullptr && localShard.isNone()) {
+            continue;
+          }
+
+          VPackBuilder entry;
+          {
+            VPackObjectBuilder e(&entry);
+            addError(entry, error);
+            entry.add(VPackValue("indexes"));
+            if (localShard.isNone()) {
+              VPackArrayBuilder a(&entry);
+            } else {
+              entry.add(localShard.get("indexes"));
+            }
+            entry.add(VPackValue("servers"));
+            {
+              VPackArrayBuilder a(&entry);
+              entry.add(VPackValue(serverId));
+              VPackSlice followers = localShard.isNone()
+                                         ? VPackSlice::noneSlice()
+                                         : localShard.get("followers");
+              if (followers.isArray()) {
+                for (auto const& follower : VPackArrayIterator(followers)) {
+                  entry.add(follower);
+                }
+              }
+            }
+          }
+          addIfChanged(
+              "Current/Collections/" + dbName + "/" + planId + "/" + shardName,
+              lookup(current, {"Collections", dbName, planId, shardName}),
+              entry.slice());
+        }
+      }
+    }
+  }
+
+  // entries of shards which we led and which are gone from the Plan
+  VPackSlice currentCollections = current.get("Collections");
+  if (currentCollections.isObject()) {
+    for (auto const& db : VPackObjectIterator(currentCollections)) {
+      std::string dbName = db.key.copyString();
+      if (!db.value.isObject()) {
+        continue;
+      }
+      for (auto const& col : VPackObjectIterator(db.value)) {
+        std::string planId = col.key.copyString();
+        if (!col.value.isObject()) {
+          continue;
+        }
+        for (auto const& shard : VPackObjectIterator(col.value)) {
+          std::string shardName = shard.key.copyString();
+          VPackSlice servers = shard.value.get("servers");
+          if (!servers.isArray() || servers.length() == 0 ||
+              !servers[0].isEqualString(serverId)) {
+            continue;
+          }
+          if (leading.find(dbName + "/" + planId + "/" + shardName) ==
+                  leading.end() &&
+              lookup(planCollections, {dbName, planId, "shards", shardName})
+                  .isNone()) {
+            report.add(
+                "Current/Collections/" + dbName + "/" + planId + "/" + shardName,
+                VPackSlice::nullSlice());
+          }
+        }
+      }
+    }
+  }
+}
+
+Result maintenance::sendReport(VPackSlice report, size_t batchSize) {
+  TRI_ASSERT(batchSize > 0);
+  AgencyComm ac;
+  std::vector<AgencyOperation> operations;
+  Result result;
+
+  auto flush = [&]() {
+    if (operations.empty()) {
+      return;
+    }
+    operations.push_back(AgencyOperation(
+        "Current/Version", AgencySimpleOperationType::INCREMENT_OP));
+    AgencyCommResult res =
+        ac.sendTransactionWithFailover(AgencyWriteTransaction(operations));
+    if (!res.successful()) {
+      LOG_TOPIC(ERR, Logger::CLUSTER)
+          << "could not report " << (operations.size() - 1)
+          << " changes in Current: " << res.errorMessage();
+      result.reset(TRI_ERROR_CLUSTER_COULD_NOT_REPORT_IN_CURRENT,
+                   res.errorMessage());
+    }
+    operations.clear();
+  };
+
+  for (auto const& it : VPackObjectIterator(report)) {
+    if (it.value.isNull()) {
+      operations.push_back(AgencyOperation(
+          it.key.copyString(), AgencySimpleOperationType::DELETE_OP));
+    } else {
+      operations.push_back(AgencyOperation(
+          it.key.copyString(), AgencyValueOperationType::SET, it.value));
+    }
+    if (operations.size() >= batchSize) {
+      flush();
+    }
+  }
+  flush();
+
+  return result;
+}
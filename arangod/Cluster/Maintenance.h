@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_CLUSTER_MAINTENANCE_H
+#define ARANGOD_CLUSTER_MAINTENANCE_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Result.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace maintenance {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a single step which brings the local databases and shards of a
+/// DBServer closer to the Plan. `database` is always set, `collection` is the
+/// plan id and `shard` the local name of a shard, `index` the id of an index.
+/// `properties` holds the database, shard or index definition to apply.
+/// For shards, `leader` is empty if this server is planned to lead the shard.
+////////////////////////////////////////////////////////////////////////////////
+
+struct ActionDescription {
+  enum class Type {
+    CREATE_DATABASE,
+    DROP_DATABASE,
+    CREATE_SHARD,
+    DROP_SHARD,
+    UPDATE_SHARD,
+    ENSURE_INDEX,
+    DROP_INDEX,
+    SYNCHRONIZE_SHARD
+  };
+
+  ActionDescription(Type t, std::string const& db) : type(t), database(db) {}
+
+  Type type;
+  std::string database;
+  std::string collection;
+  std::string shard;
+  std::string leader;
+  std::string index;
+  std::shared_ptr<velocypack::Builder> properties;
+
+  bool isShardAction() const {
+    return type != Type::CREATE_DATABASE && type != Type::DROP_DATABASE;
+  }
+
+  static char const* typeName(Type);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief errors of failed actions, keyed by "<database>/<shard>" for shard
+/// actions and by "<database>" for database actions
+////////////////////////////////////////////////////////////////////////////////
+
+typedef std::unordered_map<std::string, Result> MaintenanceErrors;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief describes the local databases and shards in the form
+///   { <database>: { <shard>: { planId, isLeader, followers, indexes,
+///                              <properties> } } }
+////////////////////////////////////////////////////////////////////////////////
+
+void localState(velocypack::Builder& local);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compares Plan and Current with the local state and returns the
+/// actions to bring the local state in line with the Plan. The actions for
+/// one shard are returned in the order in which they have to be executed.
+/// `plan` and `current` are the contents of `Plan` and `Current` in the
+/// agency, `local` is the result of `localState`
+////////////////////////////////////////////////////////////////////////////////
+
+std::vector<ActionDescription> diffPlanLocal(velocypack::Slice plan,
+                                             velocypack::Slice current,
+                                             velocypack::Slice local,
+                                             std::string const& serverId);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the actions except SYNCHRONIZE_SHARD. Databases are
+/// created first and dropped last, the shard actions in between run on up
+/// to `parallelism` threads, the actions for one shard are run in order
+/// by the same thread
+////////////////////////////////////////////////////////////////////////////////
+
+void executeActions(std::vector<ActionDescription> const& actions,
+                    size_t parallelism, MaintenanceErrors& errors);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief computes the changes to Current for the databases and the shards
+/// this server leads. The result is an object mapping agency keys below
+/// `Current` to their new values, `null` means the key is to be removed.
+/// Keys whose value in Current is already up to date are left out
+////////////////////////////////////////////////////////////////////////////////
+
+void reportInCurrent(velocypack::Slice plan, velocypack::Slice current,
+                     velocypack::Slice local, MaintenanceErrors const& errors,
+                     std::string const& serverId, velocypack::Builder& report);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief writes a report computed by `reportInCurrent` to the agency, in
+/// transactions of at most `batchSize` keys which each bump Current/Version
+////////////////////////////////////////////////////////////////////////////////
+
+Result sendReport(velocypack::Slice report, size_t batchSize);
+
+}  // namespace maintenance
+}  // namespace arangodb
+
+#endif
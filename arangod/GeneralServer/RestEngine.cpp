@@ -56,6 +56,8 @@ void RestEngine::appendRestStatus(std::shared_ptr<RestStatusElement> element) {
 // -----------------------------------------------------------------------------
 
 int RestEngine::run(std::shared_ptr<rest::RestHandler> handler, bool synchronous) {
+  _synchronous = synchronous;
+
   while (true) {
     int res = TRI_ERROR_NO_ERROR;
 
@@ -73,6 +75,10 @@ int RestEngine::run(std::shared_ptr<rest::RestHandler> handler, bool synchronous
 
       case State::RUN:
         res = handler->runEngine(synchronous);
+        if (res == SUSPENDED) {
+          // must not touch the engine anymore
+          return TRI_ERROR_NO_ERROR;
+        }
         if (res != TRI_ERROR_NO_ERROR) {
           handler->finalizeEngine();
         }
@@ -41,6 +41,10 @@ class RestEngine {
  public:
   enum class State { PREPARE, EXECUTE, RUN, FINALIZE, WAITING, DONE, FAILED };
 
+  // returned by RestHandler::runEngine if the engine has been handed over
+  // to a continuation, which may already run in another thread
+  static int const SUSPENDED = -1;
+
  public:
   RestEngine() {}
 
@@ -51,6 +55,10 @@ class RestEngine {
   int syncRun(std::shared_ptr<rest::RestHandler>);
 
   void setState(State state) { _state = state; }
+
+  // whether the engine is run by syncRun(), which cannot wait for
+  // continuations
+  bool synchronous() const { return _synchronous; }
   void appendRestStatus(std::shared_ptr<RestStatusElement>);
 
   void queue(std::function<void()> callback) {
@@ -70,6 +78,7 @@ class RestEngine {
 
  private:
   State _state = State::PREPARE;
+  bool _synchronous = false;
   std::vector<std::shared_ptr<RestStatusElement>> _elements;
 
   EventLoop _loop;
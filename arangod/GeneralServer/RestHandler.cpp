@@ -246,13 +246,18 @@ int RestHandler::runEngine(bool synchron) {
           if (!synchron) {
             _engine.setState(RestEngine::State::WAITING);
 
+            // the continuation is usually triggered from another thread,
+            // e.g. a ClusterComm callback. continue on the scheduler, so
+            // that the triggering thread is not blocked by the handler
             std::shared_ptr<RestHandler> self = shared_from_this();
             result->callWaitFor([self, this]() {
-              _engine.setState(RestEngine::State::RUN);
-              _engine.asyncRun(self);
+              _engine.queue([self, this]() {
+                _engine.setState(RestEngine::State::RUN);
+                _engine.asyncRun(self);
+              });
             });
 
-            return TRI_ERROR_NO_ERROR;
+            return RestEngine::SUSPENDED;
           }
 
           return TRI_ERROR_INTERNAL;
@@ -261,7 +266,7 @@ int RestHandler::runEngine(bool synchron) {
           if (!synchron) {
             std::shared_ptr<RestHandler> self = shared_from_this();
             _engine.queue([self, this]() { _engine.asyncRun(self); });
-            return TRI_ERROR_NO_ERROR;
+            return RestEngine::SUSPENDED;
           }
           break;
 
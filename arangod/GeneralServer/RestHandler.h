@@ -124,6 +124,10 @@ class RestHandler : public std::enable_shared_from_this<RestHandler> {
     _engine.init(loop);
   }
 
+  // handlers run synchronously, e.g. as parts of a batch request, must not
+  // return RestStatus::WAIT_FOR
+  bool executesSynchronously() const { return _engine.synchronous(); }
+
   int asyncRunEngine() { return _engine.asyncRun(shared_from_this()); }
   int syncRunEngine() {
     _storeResult = [](RestHandler*) {};
@@ -603,7 +603,7 @@ bool Index::canUseConditionPart(
         (other->type == arangodb::aql::NODE_TYPE_EXPANSION ||
          other->type == arangodb::aql::NODE_TYPE_ATTRIBUTE_ACCESS)) {
       // value IN a.b  OR  value IN a.b[*]
-      if (!access->isConstant()) {
+      if (!access->isConstantOrDeferred()) {
         return false;
       }
 
@@ -615,7 +615,7 @@ bool Index::canUseConditionPart(
     } else if (op->type == arangodb::aql::NODE_TYPE_OPERATOR_BINARY_IN &&
                access->type == arangodb::aql::NODE_TYPE_EXPANSION) {
       // value[*] IN a.b
-      if (!other->isConstant()) {
+      if (!other->isConstantOrDeferred()) {
         return false;
       }
 
@@ -626,7 +626,7 @@ bool Index::canUseConditionPart(
       */
     } else if (access->type == arangodb::aql::NODE_TYPE_ATTRIBUTE_ACCESS) {
       // a.b == value  OR  a.b IN values
-      if (!other->isConstant()) {
+      if (!other->isConstantOrDeferred()) {
         return false;
       }
 
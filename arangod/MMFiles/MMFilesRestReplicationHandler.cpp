@@ -24,6 +24,7 @@
 #include "MMFilesRestReplicationHandler.h"
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/ConditionLocker.h"
+#include "Basics/MemoryArenas.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/conversions.h"
@@ -79,6 +80,9 @@ MMFilesRestReplicationHandler::MMFilesRestReplicationHandler(
 MMFilesRestReplicationHandler::~MMFilesRestReplicationHandler() {}
 
 RestStatus MMFilesRestReplicationHandler::execute() {
+  // account the memory used by replication to its own arena
+  basics::MemoryArenaScope arenaScope(basics::MemoryArena::REPLICATION);
+
   // extract the request type
   auto const type = _request->requestType();
   auto const& suffixes = _request->suffixes();
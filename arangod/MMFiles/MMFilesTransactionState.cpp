@@ -33,6 +33,7 @@
 #include "MMFiles/MMFilesPersistentIndexFeature.h"
 #include "MMFiles/MMFilesTransactionCollection.h"
 #include "StorageEngine/TransactionCollection.h"
+#include "Transaction/Helpers.h"
 #include "Transaction/Methods.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/modes.h"
@@ -297,6 +298,10 @@ int MMFilesTransactionState::addOperation(TRI_voc_rid_t revisionId,
   TRI_ASSERT(fid > 0);
   TRI_ASSERT(position != nullptr);
 
+  // key of the modified document, used for query cache invalidation
+  StringRef const key =
+      transaction::helpers::extractKeyPart(VPackSlice(marker->vpack()));
+
   auto physical = static_cast<MMFilesCollection*>(collection->getPhysical());
   if (operation.type() == TRI_VOC_DOCUMENT_OPERATION_INSERT ||
       operation.type() == TRI_VOC_DOCUMENT_OPERATION_UPDATE ||
@@ -321,8 +326,7 @@ int MMFilesTransactionState::addOperation(TRI_voc_rid_t revisionId,
     }
     operation.handled();
 
-    arangodb::aql::QueryCache::instance()->invalidate(
-        _vocbase, collection->name());
+    invalidateQueryCache(collection->name(), key);
 
     physical->increaseUncollectedLogfileEntries(1);
   } else {
@@ -336,6 +340,7 @@ int MMFilesTransactionState::addOperation(TRI_voc_rid_t revisionId,
     }
       
     static_cast<MMFilesTransactionCollection*>(trxCollection)->addOperation(copy.get());
+    trxCollection->addModifiedKey(key);
     
     TRI_IF_FAILURE("TransactionOperationPushBack2") {
       copy.release();
@@ -347,8 +352,7 @@ int MMFilesTransactionState::addOperation(TRI_voc_rid_t revisionId,
     operation.swapped();
     _hasOperations = true;
     
-    arangodb::aql::QueryCache::instance()->invalidate(
-        _vocbase, collection->name());
+    invalidateQueryCache(collection->name(), key);
   }
 
   physical->setRevision(revisionId, false);
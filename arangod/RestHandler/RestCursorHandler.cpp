@@ -22,16 +22,19 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RestCursorHandler.h"
+#include "Aql/PlanCache.h"
 #include "Aql/Query.h"
 #include "Aql/QueryRegistry.h"
 #include "Basics/Exceptions.h"
 #include "Basics/MutexLocker.h"
 #include "Basics/StaticStrings.h"
+#include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Utils/Cursor.h"
 #include "Utils/CursorRepository.h"
 #include "Transaction/Context.h"
 
+#include <velocypack/Collection.h>
 #include <velocypack/Iterator.h>
 #include <velocypack/Value.h>
 #include <velocypack/velocypack-aliases.h>
@@ -88,8 +91,24 @@ void RestCursorHandler::processQuery(VPackSlice const& slice) {
     generateError(rest::ResponseCode::BAD, TRI_ERROR_QUERY_EMPTY);
     return;
   }
+  // a query is either given as a string, or as the id of a prepared
+  // statement. the prepared statement keeps its query string alive
+  std::shared_ptr<arangodb::aql::PreparedStatement> statement;
+  VPackSlice const statementSlice = slice.get("preparedStatement");
   VPackSlice const querySlice = slice.get("query");
-  if (!querySlice.isString()) {
+
+  if (statementSlice.isString()) {
+    statement = arangodb::aql::PlanCache::instance()->lookupStatement(
+        _vocbase,
+        arangodb::basics::StringUtils::uint64(statementSlice.copyString()));
+
+    if (statement == nullptr) {
+      generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_QUERY_NOT_FOUND,
+                    "cannot find prepared query '" +
+                        statementSlice.copyString() + "'");
+      return;
+    }
+  } else if (!querySlice.isString()) {
     generateError(rest::ResponseCode::BAD, TRI_ERROR_QUERY_EMPTY);
     return;
   }
@@ -103,6 +122,16 @@ void RestCursorHandler::processQuery(VPackSlice const& slice) {
     }
   }
 
+  if (statement != nullptr) {
+    Result res = statement->checkBindParameters(bindVars);
+
+    if (res.fail()) {
+      generateError(rest::ResponseCode::BAD, res.errorNumber(),
+                    res.errorMessage());
+      return;
+    }
+  }
+
   std::shared_ptr<VPackBuilder> bindVarsBuilder;
   if (!bindVars.isNone()) {
     bindVarsBuilder.reset(new VPackBuilder);
@@ -111,7 +140,21 @@ void RestCursorHandler::processQuery(VPackSlice const& slice) {
 
   auto options = std::make_shared<VPackBuilder>(buildOptions(slice));
   VPackValueLength l;
-  char const* queryString = querySlice.getString(l);
+  char const* queryString;
+
+  if (statement != nullptr) {
+    queryString = statement->queryString.c_str();
+    l = statement->queryString.size();
+    // executions of prepared statements always use the plan cache
+    VPackBuilder planCacheOptions;
+    planCacheOptions.openObject();
+    planCacheOptions.add("usePlanCache", VPackValue(true));
+    planCacheOptions.close();
+    options = std::make_shared<VPackBuilder>(VPackCollection::merge(
+        options->slice(), planCacheOptions.slice(), false));
+  } else {
+    queryString = querySlice.getString(l);
+  }
 
   arangodb::aql::Query query(false, _vocbase, queryString,
                              static_cast<size_t>(l), bindVarsBuilder, options,
@@ -343,6 +386,25 @@ VPackBuilder RestCursorHandler::buildOptions(VPackSlice const& slice) const {
     }
   }
 
+  // dirty reads can also be requested via headers, as for the document API
+  if (!opts.isObject() || !opts.hasKey("allowDirtyReads")) {
+    bool found;
+    std::string const& value =
+        _request->header(StaticStrings::AllowDirtyReadHeader, found);
+    if (found) {
+      options.add("allowDirtyReads",
+                  VPackValue(basics::StringUtils::boolean(value)));
+    }
+  }
+  if (!opts.isObject() || !opts.hasKey("readTick")) {
+    bool found;
+    std::string const& value =
+        _request->header(StaticStrings::ReadTickHeader, found);
+    if (found) {
+      options.add("readTick", VPackValue(value));
+    }
+  }
+
   VPackSlice ttl = slice.get("ttl");
   if (ttl.isNumber()) {
     options.add("ttl", ttl);
@@ -26,10 +26,14 @@
 #include "Basics/StringBuffer.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
+#include "Cluster/ClusterMethods.h"
+#include "Cluster/ServerState.h"
 #include "Rest/HttpRequest.h"
 #include "Transaction/Hints.h"
+#include "Transaction/Methods.h"
 #include "Transaction/StandaloneContext.h"
 #include "Utils/OperationOptions.h"
+#include "Utils/OperationResult.h"
 #include "Utils/SingleCollectionTransaction.h"
 #include "VocBase/vocbase.h"
 
@@ -53,9 +57,15 @@ RestStatus RestDocumentHandler::execute() {
       deleteDocument();
       break;
     case rest::RequestType::GET:
+      if (readsAsynchronously()) {
+        return readSingleDocumentCoordinator(true);
+      }
       readDocument();
       break;
     case rest::RequestType::HEAD:
+      if (readsAsynchronously()) {
+        return readSingleDocumentCoordinator(false);
+      }
       checkDocument();
       break;
     case rest::RequestType::POST:
@@ -74,6 +84,13 @@ RestStatus RestDocumentHandler::execute() {
   return RestStatus::DONE;
 }
 
+bool RestDocumentHandler::readsAsynchronously() const {
+  // the synchronous engine of batch parts cannot wait for the DB servers,
+  // these reads use the blocking transaction instead
+  return ServerState::instance()->isCoordinator() &&
+         _request->suffixes().size() == 2 && !executesSynchronously();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief was docuBlock REST_DOCUMENT_CREATE
 ////////////////////////////////////////////////////////////////////////////////
@@ -202,32 +219,12 @@ bool RestDocumentHandler::readSingleDocument(bool generateBody) {
   std::string const& collection = suffixes[0];
   std::string const& key = suffixes[1];
 
-  // check for an etag
-  bool isValidRevision;
-  TRI_voc_rid_t ifNoneRid = extractRevision("if-none-match", isValidRevision);
-  if (!isValidRevision) {
-    ifNoneRid =
-        UINT64_MAX;  // an impossible rev, so precondition failed will happen
-  }
-
   OperationOptions options;
-  options.ignoreRevs = true;
-
-  TRI_voc_rid_t ifRid = extractRevision("if-match", isValidRevision);
-  if (!isValidRevision) {
-    ifRid =
-        UINT64_MAX;  // an impossible rev, so precondition failed will happen
-  }
-
+  TRI_voc_rid_t ifRid;
+  TRI_voc_rid_t ifNoneRid;
   VPackBuilder builder;
-  {
-    VPackObjectBuilder guard(&builder);
-    builder.add(StaticStrings::KeyString, VPackValue(key));
-    if (ifRid != 0) {
-      options.ignoreRevs = false;
-      builder.add(StaticStrings::RevString, VPackValue(TRI_RidToString(ifRid)));
-    }
-  }
+  extractReadSingleDocument(key, generateBody, builder, options, ifRid,
+                            ifNoneRid);
   VPackSlice search = builder.slice();
 
   // find and load collection given by name or identifier
@@ -251,6 +248,120 @@ bool RestDocumentHandler::readSingleDocument(bool generateBody) {
 
   res = trx.finish(result.code);
 
+  return generateReadResult(collection, key, result, res, ifRid, ifNoneRid,
+                            generateBody,
+                            transactionContext->getVPackOptionsForDump());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reads a single document on a coordinator. the request to the
+/// responsible DB server is sent asynchronously, and the handler continues
+/// when the answer arrives, so that no scheduler thread is blocked meanwhile
+////////////////////////////////////////////////////////////////////////////////
+
+RestStatus RestDocumentHandler::readSingleDocumentCoordinator(
+    bool generateBody) {
+  std::vector<std::string> const& suffixes = _request->decodedSuffixes();
+
+  // split the document reference
+  std::string const collection = suffixes[0];
+  std::string const key = suffixes[1];
+
+  OperationOptions options;
+  TRI_voc_rid_t ifRid;
+  TRI_voc_rid_t ifNoneRid;
+  auto search = std::make_shared<VPackBuilder>();
+  extractReadSingleDocument(key, generateBody, *search, options, ifRid,
+                            ifNoneRid);
+
+  std::shared_ptr<RestHandler> self = shared_from_this();
+
+  return RestStatus::WAIT_FOR([self, this, collection, search,
+                               options](std::function<void()> next) {
+           _coordinatorResult.reset();
+           bool sent = getDocumentOnCoordinatorAsync(
+               _vocbase->name(), collection, search->slice(), options,
+               [self, this, next](int res, rest::ResponseCode responseCode,
+                                  std::shared_ptr<VPackBuilder> resultBody) {
+                 if (res == TRI_ERROR_NO_ERROR) {
+                   _coordinatorResult = std::make_shared<OperationResult>(
+                       transaction::Methods::clusterResultDocument(
+                           responseCode, resultBody,
+                           std::unordered_map<int, size_t>()));
+                 } else {
+                   _coordinatorResult = std::make_shared<OperationResult>(res);
+                 }
+                 next();
+               });
+
+           if (!sent) {
+             // the responsible shard cannot be determined from the key
+             // alone. use the transaction instead
+             next();
+           }
+         })
+      .then([this, collection, key, ifRid, ifNoneRid, generateBody]() {
+        if (_coordinatorResult == nullptr) {
+          readSingleDocument(generateBody);
+          return;
+        }
+
+        auto transactionContext(
+            transaction::StandaloneContext::Create(_vocbase));
+        generateReadResult(collection, key, *_coordinatorResult,
+                           Result(_coordinatorResult->code), ifRid,
+                           ifNoneRid, generateBody,
+                           transactionContext->getVPackOptionsForDump());
+      });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extracts the search value, the options and the expected revisions
+/// of a single document read
+////////////////////////////////////////////////////////////////////////////////
+
+void RestDocumentHandler::extractReadSingleDocument(
+    std::string const& key, bool generateBody, VPackBuilder& builder,
+    OperationOptions& options, TRI_voc_rid_t& ifRid,
+    TRI_voc_rid_t& ifNoneRid) {
+  // check for an etag
+  bool isValidRevision;
+  ifNoneRid = extractRevision("if-none-match", isValidRevision);
+  if (!isValidRevision) {
+    ifNoneRid =
+        UINT64_MAX;  // an impossible rev, so precondition failed will happen
+  }
+
+  options.ignoreRevs = true;
+  extractReadOptions(options);
+
+  // coordinators forward HEAD requests as HEAD, so the DB servers only send
+  // the revision. local reads still need the document for the ETag
+  options.silent = !generateBody && ServerState::instance()->isCoordinator();
+
+  ifRid = extractRevision("if-match", isValidRevision);
+  if (!isValidRevision) {
+    ifRid =
+        UINT64_MAX;  // an impossible rev, so precondition failed will happen
+  }
+
+  VPackObjectBuilder guard(&builder);
+  builder.add(StaticStrings::KeyString, VPackValue(key));
+  if (ifRid != 0) {
+    options.ignoreRevs = false;
+    builder.add(StaticStrings::RevString, VPackValue(TRI_RidToString(ifRid)));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief generates the response for a single document read
+////////////////////////////////////////////////////////////////////////////////
+
+bool RestDocumentHandler::generateReadResult(
+    std::string const& collection, std::string const& key,
+    OperationResult const& result, Result const& res, TRI_voc_rid_t ifRid,
+    TRI_voc_rid_t ifNoneRid, bool generateBody,
+    VPackOptions const* options) {
   if (!result.successful()) {
     if (result.code == TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND) {
       generateDocumentNotFound(collection, key);
@@ -277,8 +388,7 @@ bool RestDocumentHandler::readSingleDocument(bool generateBody) {
   }
 
   // use default options
-  generateDocument(result.slice(), generateBody,
-                   transactionContext->getVPackOptionsForDump());
+  generateDocument(result.slice(), generateBody, options);
   return true;
 }
 
@@ -604,6 +714,7 @@ bool RestDocumentHandler::readManyDocuments() {
   OperationOptions opOptions;
   opOptions.ignoreRevs =
       extractBooleanParameter(StaticStrings::IgnoreRevsString, true);
+  extractReadOptions(opOptions);
 
   auto transactionContext(transaction::StandaloneContext::Create(_vocbase));
   SingleCollectionTransaction trx(transactionContext, collectionName,
@@ -641,3 +752,23 @@ bool RestDocumentHandler::readManyDocuments() {
                    transactionContext->getVPackOptionsForDump());
   return true;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extracts the options for dirty reads from the request headers.
+/// the read tick is the revision of the client's last write, and followers
+/// will only serve the read if they have applied it
+////////////////////////////////////////////////////////////////////////////////
+
+void RestDocumentHandler::extractReadOptions(OperationOptions& options) {
+  bool found;
+  std::string const& allowDirtyRead =
+      _request->header(StaticStrings::AllowDirtyReadHeader, found);
+  options.allowDirtyReads = found && StringUtils::boolean(allowDirtyRead);
+
+  std::string const& readTick =
+      _request->header(StaticStrings::ReadTickHeader, found);
+  if (found && !readTick.empty()) {
+    bool isOld;
+    options.readTick = TRI_StringToRid(readTick, isOld, false);
+  }
+}
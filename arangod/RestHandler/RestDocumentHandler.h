@@ -28,6 +28,9 @@
 #include "RestHandler/RestVocbaseBaseHandler.h"
 
 namespace arangodb {
+struct OperationOptions;
+struct OperationResult;
+
 class RestDocumentHandler : public RestVocbaseBaseHandler {
  public:
   RestDocumentHandler(GeneralRequest*, GeneralResponse*);
@@ -54,6 +57,13 @@ class RestDocumentHandler : public RestVocbaseBaseHandler {
   // reads a single document
   bool readSingleDocument(bool generateBody);
 
+  // whether a GET or HEAD request is served by
+  // readSingleDocumentCoordinator()
+  bool readsAsynchronously() const;
+
+  // reads a single document on a coordinator without blocking the thread
+  RestStatus readSingleDocumentCoordinator(bool generateBody);
+
   // reads multiple documents
   bool readManyDocuments();
 
@@ -71,6 +81,30 @@ class RestDocumentHandler : public RestVocbaseBaseHandler {
 
   // deletes a document
   bool deleteDocument();
+
+  // extracts the options for dirty reads from the request headers
+  void extractReadOptions(OperationOptions&);
+
+ private:
+  // extracts search value, options and revisions of a single document read
+  void extractReadSingleDocument(std::string const& key, bool generateBody,
+                                 arangodb::velocypack::Builder& search,
+                                 OperationOptions& options,
+                                 TRI_voc_rid_t& ifRid,
+                                 TRI_voc_rid_t& ifNoneRid);
+
+  // generates the response for a single document read
+  bool generateReadResult(std::string const& collection,
+                          std::string const& key,
+                          OperationResult const& result, Result const& res,
+                          TRI_voc_rid_t ifRid, TRI_voc_rid_t ifNoneRid,
+                          bool generateBody,
+                          arangodb::velocypack::Options const* options);
+
+ private:
+  // result of a single document read on a coordinator, set by the
+  // ClusterComm callback before the handler continues
+  std::shared_ptr<OperationResult> _coordinatorResult;
 };
 }
 
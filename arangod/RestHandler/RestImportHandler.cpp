@@ -359,6 +359,7 @@ bool RestImportHandler::createFromJson(std::string const& type) {
   SingleCollectionTransaction trx(
       transaction::StandaloneContext::Create(_vocbase), collectionName,
       AccessMode::Type::WRITE);
+  trx.addHint(transaction::Hints::Hint::IMPORT);
 
   // .............................................................................
   // inside write transaction
@@ -565,6 +566,7 @@ bool RestImportHandler::createFromVPack(std::string const& type) {
   SingleCollectionTransaction trx(
       transaction::StandaloneContext::Create(_vocbase), collectionName,
       AccessMode::Type::WRITE);
+  trx.addHint(transaction::Hints::Hint::IMPORT);
 
   // .............................................................................
   // inside write transaction
@@ -739,6 +741,7 @@ bool RestImportHandler::createFromKeyValueList() {
   SingleCollectionTransaction trx(
       transaction::StandaloneContext::Create(_vocbase), collectionName,
       AccessMode::Type::WRITE);
+  trx.addHint(transaction::Hints::Hint::IMPORT);
 
   // .............................................................................
   // inside write transaction
@@ -90,6 +90,18 @@ class RestQueryHandler : public RestVocbaseBaseHandler {
   //////////////////////////////////////////////////////////////////////////////
 
   bool parseQuery();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief registers a prepared statement
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool prepareQuery();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief removes a prepared statement
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool deletePreparedQuery(std::string const& id);
 };
 }
 
@@ -692,6 +692,9 @@ int DatabaseFeature::dropDatabaseCoordinator(TRI_voc_tick_t id, bool force) {
       LOG_TOPIC(INFO, arangodb::Logger::FIXME) << "dropping coordinator database '" << vocbase->name() << "'";
       res = TRI_ERROR_NO_ERROR;
     }
+
+    // remove all plans and prepared statements of the database
+    arangodb::aql::PlanCache::instance()->drop(vocbase);
   } else {
     delete newLists;
   }
@@ -754,7 +757,7 @@ int DatabaseFeature::dropDatabase(std::string const& name, bool waitForDeletion,
     vocbase->setIsOwnAppsDirectory(removeAppsDirectory);
 
     // invalidate all entries for the database
-    arangodb::aql::PlanCache::instance()->invalidate(vocbase);
+    arangodb::aql::PlanCache::instance()->drop(vocbase);
     arangodb::aql::QueryCache::instance()->invalidate(vocbase);
 
     engine->prepareDropDatabase(vocbase, !engine->inRecovery(), res);
@@ -23,6 +23,7 @@
 #include "RocksDBBackgroundThread.h"
 #include "Basics/ConditionLocker.h"
 #include "RestServer/DatabaseFeature.h"
+#include "RocksDBEngine/RocksDBCacheWarmup.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBCounterManager.h"
 #include "RocksDBEngine/RocksDBEngine.h"
@@ -46,6 +47,7 @@ void RocksDBBackgroundThread::beginShutdown() {
 }
 
 void RocksDBBackgroundThread::run() {
+  double lastCacheSnapshot = TRI_microtime();
   while (!isStopping()) {
     {
       CONDITION_LOCKER(guard, _condition);
@@ -81,6 +83,18 @@ void RocksDBBackgroundThread::run() {
       _engine->determinePrunableWalFiles(minTick);
       // and then prune them when they expired
       _engine->pruneWalFiles();
+
+      // record the cached keys so they can be loaded after a restart.
+      // the caches are shut down before the engine, so we cannot rely on
+      // writing them on shutdown only
+      std::string const snapshotFile = _engine->cacheSnapshotFile();
+      double const now = TRI_microtime();
+      if (!snapshotFile.empty() &&
+          (force ||
+           now - lastCacheSnapshot >= _engine->cacheSnapshotInterval())) {
+        lastCacheSnapshot = now;
+        RocksDBCacheWarmup::writeSnapshot(snapshotFile);
+      }
     } catch (std::exception const& ex) {
       LOG_TOPIC(WARN, Logger::FIXME) << "caught exception in rocksdb background thread: " << ex.what();
     } catch (...) {
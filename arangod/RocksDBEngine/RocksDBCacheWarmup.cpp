@@ -0,0 +1,269 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBCacheWarmup.h"
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/ConditionLocker.h"
+#include "Basics/FileUtils.h"
+#include "Basics/StringUtils.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Logger/Logger.h"
+#include "RestServer/DatabaseFeature.h"
+#include "RocksDBEngine/RocksDBCollection.h"
+#include "RocksDBEngine/RocksDBEdgeIndex.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/vocbase.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+size_t const RocksDBCacheWarmup::SnapshotKeysPerCache = 100000;
+size_t const RocksDBCacheWarmup::EdgesPerChunk = 10000;
+
+RocksDBCacheWarmup::RocksDBCacheWarmup(std::string const& snapshotFile,
+                                       bool warmupEdges)
+    : Thread("RocksDBWarmup"),
+      _snapshotFile(snapshotFile),
+      _warmupEdges(warmupEdges) {}
+
+RocksDBCacheWarmup::~RocksDBCacheWarmup() { shutdown(); }
+
+void RocksDBCacheWarmup::beginShutdown() {
+  Thread::beginShutdown();
+
+  // wake up the thread that may be waiting for the server
+  CONDITION_LOCKER(guard, _condition);
+  guard.broadcast();
+}
+
+void RocksDBCacheWarmup::run() {
+  if (!waitForServer()) {
+    return;
+  }
+
+  try {
+    if (!_snapshotFile.empty()) {
+      loadSnapshot();
+    }
+    if (_warmupEdges && !isStopping()) {
+      warmupEdgeIndexes();
+    }
+  } catch (std::exception const& ex) {
+    LOG_TOPIC(WARN, Logger::ENGINES)
+        << "caught exception during cache warmup: " << ex.what();
+  } catch (...) {
+    LOG_TOPIC(WARN, Logger::ENGINES)
+        << "caught unknown exception during cache warmup";
+  }
+}
+
+bool RocksDBCacheWarmup::waitForServer() {
+  using application_features::ApplicationServer;
+  using application_features::ServerState;
+
+  // the databases are opened by features started after the engine
+  while (!isStopping()) {
+    if (ApplicationServer::server != nullptr &&
+        ApplicationServer::server->state() == ServerState::IN_WAIT) {
+      return DatabaseFeature::DATABASE != nullptr;
+    }
+    CONDITION_LOCKER(guard, _condition);
+    guard.wait(100 * 1000);
+  }
+  return false;
+}
+
+void RocksDBCacheWarmup::loadSnapshot() {
+  if (!basics::FileUtils::exists(_snapshotFile)) {
+    return;
+  }
+
+  std::shared_ptr<VPackBuilder> snapshot;
+  try {
+    snapshot = basics::VelocyPackHelper::velocyPackFromFile(_snapshotFile);
+  } catch (...) {
+    LOG_TOPIC(WARN, Logger::ENGINES)
+        << "ignoring unreadable cache snapshot '" << _snapshotFile << "'";
+    return;
+  }
+  if (!snapshot->slice().isArray()) {
+    return;
+  }
+
+  double start = TRI_microtime();
+  for (auto const& entry : VPackArrayIterator(snapshot->slice())) {
+    if (isStopping()) {
+      return;
+    }
+    std::string const dbName = basics::VelocyPackHelper::getStringValue(
+        entry, "database", "");
+    TRI_voc_cid_t cid = basics::StringUtils::uint64(
+        basics::VelocyPackHelper::getStringValue(entry, "collection", ""));
+    if (dbName.empty() || cid == 0) {
+      continue;
+    }
+
+    TRI_vocbase_t* vocbase = DatabaseFeature::DATABASE->useDatabase(dbName);
+    if (vocbase == nullptr) {
+      continue;
+    }
+    TRI_DEFER(vocbase->release());
+
+    LogicalCollection* collection = vocbase->lookupCollection(cid);
+    if (collection == nullptr) {
+      continue;
+    }
+
+    SingleCollectionTransaction trx(
+        transaction::StandaloneContext::Create(vocbase), cid,
+        AccessMode::Type::READ);
+    Result res = trx.begin();
+    if (!res.ok()) {
+      continue;
+    }
+
+    auto physical = static_cast<RocksDBCollection*>(collection->getPhysical());
+    VPackSlice documents = entry.get("documents");
+    if (documents.isArray()) {
+      physical->warmupCache(&trx, documents);
+    }
+
+    VPackSlice indexes = entry.get("indexes");
+    if (indexes.isArray()) {
+      for (auto const& it : VPackArrayIterator(indexes)) {
+        TRI_idx_iid_t iid = basics::StringUtils::uint64(
+            basics::VelocyPackHelper::getStringValue(it, "id", ""));
+        VPackSlice vertices = it.get("vertices");
+        auto idx = collection->getPhysical()->lookupIndex(iid);
+        if (idx != nullptr && vertices.isArray() &&
+            idx->type() == Index::TRI_IDX_TYPE_EDGE_INDEX) {
+          static_cast<RocksDBEdgeIndex*>(idx.get())
+              ->warmupVertices(&trx, vertices);
+        }
+      }
+    }
+    trx.finish(res);
+  }
+
+  LOG_TOPIC(DEBUG, Logger::ENGINES) << "loaded cache snapshot in "
+                                    << (TRI_microtime() - start) << " s";
+}
+
+void RocksDBCacheWarmup::warmupEdgeIndexes() {
+  std::vector<std::string> databases;
+  DatabaseFeature::DATABASE->enumerateDatabases(
+      [&databases](TRI_vocbase_t* vocbase) {
+        databases.emplace_back(vocbase->name());
+      });
+
+  double start = TRI_microtime();
+  for (auto const& dbName : databases) {
+    TRI_vocbase_t* vocbase = DatabaseFeature::DATABASE->useDatabase(dbName);
+    if (vocbase == nullptr) {
+      continue;
+    }
+    TRI_DEFER(vocbase->release());
+
+    for (auto collection : vocbase->collections(false)) {
+      if (collection->type() != TRI_COL_TYPE_EDGE) {
+        continue;
+      }
+      for (auto const& idx : collection->getPhysical()->getIndexes()) {
+        if (idx->type() != Index::TRI_IDX_TYPE_EDGE_INDEX) {
+          continue;
+        }
+        auto edgeIndex = static_cast<RocksDBEdgeIndex*>(idx.get());
+
+        // every chunk gets its own snapshot, so we neither pin old data
+        // nor block the collection for long
+        std::string next;
+        do {
+          if (isStopping()) {
+            return;
+          }
+          SingleCollectionTransaction trx(
+              transaction::StandaloneContext::Create(vocbase),
+              collection->cid(), AccessMode::Type::READ);
+          Result res = trx.begin();
+          if (!res.ok()) {
+            break;
+          }
+          next = edgeIndex->warmup(&trx, next, EdgesPerChunk);
+          trx.finish(res);
+        } while (!next.empty());
+      }
+    }
+  }
+
+  LOG_TOPIC(DEBUG, Logger::ENGINES) << "warmed up edge index caches in "
+                                    << (TRI_microtime() - start) << " s";
+}
+
+bool RocksDBCacheWarmup::writeSnapshot(std::string const& file) {
+  if (DatabaseFeature::DATABASE == nullptr) {
+    return false;
+  }
+
+  VPackBuilder builder;
+  size_t keys = 0;
+  builder.openArray();
+  DatabaseFeature::DATABASE->enumerateDatabases(
+      [&builder, &keys](TRI_vocbase_t* vocbase) {
+        for (auto collection : vocbase->collections(false)) {
+          auto physical =
+              static_cast<RocksDBCollection*>(collection->getPhysical());
+          builder.openObject();
+          builder.add("database", VPackValue(vocbase->name()));
+          builder.add("collection",
+                      VPackValue(std::to_string(collection->cid())));
+          builder.add("documents", VPackValue(VPackValueType::Array));
+          keys += physical->snapshotCache(builder, SnapshotKeysPerCache);
+          builder.close();
+          builder.add("indexes", VPackValue(VPackValueType::Array));
+          for (auto const& idx : physical->getIndexes()) {
+            if (idx->type() != Index::TRI_IDX_TYPE_EDGE_INDEX) {
+              continue;
+            }
+            builder.openObject();
+            builder.add("id", VPackValue(std::to_string(idx->id())));
+            builder.add("vertices", VPackValue(VPackValueType::Array));
+            keys += static_cast<RocksDBEdgeIndex*>(idx.get())
+                        ->snapshotCache(builder, SnapshotKeysPerCache);
+            builder.close();
+            builder.close();
+          }
+          builder.close();
+          builder.close();
+        }
+      });
+  builder.close();
+
+  if (keys == 0) {
+    return true;
+  }
+  return basics::VelocyPackHelper::velocyPackToFile(file, builder.slice(),
+                                                    false);
+}
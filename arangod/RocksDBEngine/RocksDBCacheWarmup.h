@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ENGINE_CACHE_WARMUP_H
+#define ARANGOD_ROCKSDB_ENGINE_CACHE_WARMUP_H 1
+
+#include "Basics/Common.h"
+#include "Basics/ConditionVariable.h"
+#include "Basics/Thread.h"
+
+namespace arangodb {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief fills the document and edge index caches after a restart. First
+/// the keys recorded in the cache snapshot file are loaded, then, if
+/// enabled, all edge indexes are streamed into their caches in chunks of
+/// one short read transaction each.
+///
+/// The snapshot file is an array with one entry per collection:
+///   { database, collection, documents: [ <revision id> ],
+///     indexes: [ { id, vertices: [ <vertex id> ] } ] }
+////////////////////////////////////////////////////////////////////////////////
+
+class RocksDBCacheWarmup final : public Thread {
+ public:
+  /// @brief maximum number of keys recorded per cache in a snapshot
+  static size_t const SnapshotKeysPerCache;
+
+  /// @brief number of edges read in one transaction during edge warmup
+  static size_t const EdgesPerChunk;
+
+  /// @brief `snapshotFile` is empty if no snapshot is to be loaded
+  RocksDBCacheWarmup(std::string const& snapshotFile, bool warmupEdges);
+  ~RocksDBCacheWarmup();
+
+  void beginShutdown() override;
+
+  /// @brief writes the keys currently held in the document and edge index
+  /// caches of all databases to `file`. Leaves an existing file alone if
+  /// there is nothing to record, e.g. because the caches are shut down
+  static bool writeSnapshot(std::string const& file);
+
+ protected:
+  void run() override;
+
+ private:
+  /// @brief waits until the server has started all features
+  bool waitForServer();
+
+  /// @brief prefills the caches from the snapshot file
+  void loadSnapshot();
+
+  /// @brief streams all edge indexes into their caches
+  void warmupEdgeIndexes();
+
+ private:
+  std::string const _snapshotFile;
+  bool const _warmupEdges;
+  arangodb::basics::ConditionVariable _condition;
+};
+}  // namespace arangodb
+
+#endif
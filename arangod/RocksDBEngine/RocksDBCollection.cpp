@@ -22,11 +22,14 @@
 
 #include "RocksDBCollection.h"
 #include "Aql/PlanCache.h"
+#include "Basics/LocalTaskQueue.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/Result.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/WriteLocker.h"
+#include "Basics/system-functions.h"
 #include "Cache/CacheManagerFeature.h"
 #include "Cache/Common.h"
 #include "Cache/Manager.h"
@@ -40,6 +43,7 @@
 #include "RocksDBEngine/RocksDBComparator.h"
 #include "RocksDBEngine/RocksDBCounterManager.h"
 #include "RocksDBEngine/RocksDBEngine.h"
+#include "RocksDBEngine/RocksDBIndex.h"
 #include "RocksDBEngine/RocksDBKey.h"
 #include "RocksDBEngine/RocksDBLogValue.h"
 #include "RocksDBEngine/RocksDBMethods.h"
@@ -48,6 +52,8 @@
 #include "RocksDBEngine/RocksDBTransactionCollection.h"
 #include "RocksDBEngine/RocksDBTransactionState.h"
 #include "RocksDBEngine/RocksDBValue.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/StorageEngine.h"
 #include "StorageEngine/TransactionState.h"
@@ -61,6 +67,8 @@
 #include "VocBase/ticks.h"
 #include "VocBase/voc-types.h"
 
+#include <cmath>
+
 #include <rocksdb/db.h>
 #include <rocksdb/utilities/transaction.h>
 #include <rocksdb/utilities/write_batch_with_index.h>
@@ -74,6 +82,119 @@ namespace {
 
 static std::string const Empty;
 
+/// @brief inserts after which the index estimates are recalculated in the
+/// background, provided they also make up half of the collection
+static constexpr uint64_t AutoEstimatesInsertThreshold = 100 * 1000;
+
+/// @brief scans one key range of a snapshot, calling the callback for each
+/// key until it returns false
+class RocksDBRangeScanTask : public basics::LocalTask {
+ public:
+  RocksDBRangeScanTask(std::shared_ptr<basics::LocalTaskQueue> queue,
+                       rocksdb::Snapshot const* snapshot,
+                       std::string const& lower, std::string const& upper,
+                       std::function<bool(rocksdb::Iterator*)> const& cb)
+      : LocalTask(queue),
+        _snapshot(snapshot),
+        _lower(lower),
+        _upper(upper),
+        _cb(cb) {}
+
+  void run() {
+    int res = scan(_snapshot, _lower, _upper, _cb);
+    if (res != TRI_ERROR_NO_ERROR) {
+      _queue->setStatus(res);
+    }
+
+    _queue->join();
+  }
+
+  static int scan(rocksdb::Snapshot const* snapshot, std::string const& lower,
+                  std::string const& upper,
+                  std::function<bool(rocksdb::Iterator*)> const& cb) {
+    try {
+      rocksdb::ReadOptions options;
+      options.snapshot = snapshot;
+      options.fill_cache = false;
+      options.total_order_seek = true;
+      rocksdb::Slice const end(upper);
+      options.iterate_upper_bound = &end;
+
+      std::unique_ptr<rocksdb::Iterator> it(
+          globalRocksDB()->NewIterator(options));
+      for (it->Seek(lower); it->Valid(); it->Next()) {
+        if (!cb(it.get())) {
+          break;
+        }
+      }
+      return convertStatus(it->status()).errorNumber();
+    } catch (basics::Exception const& ex) {
+      return ex.code();
+    } catch (...) {
+      return TRI_ERROR_INTERNAL;
+    }
+  }
+
+ private:
+  rocksdb::Snapshot const* _snapshot;
+  std::string const _lower;
+  std::string const _upper;
+  std::function<bool(rocksdb::Iterator*)> const _cb;
+};
+
+/// @brief number of key ranges which are scanned concurrently
+static size_t scanParallelism() {
+  return (std::max)(static_cast<size_t>(1),
+                    (std::min)(TRI_numberProcessors(), static_cast<size_t>(16)));
+}
+
+/// @brief scans the ranges between adjacent boundaries of a snapshot
+/// concurrently. The callback is called with the number of the range
+static int scanRanges(
+    rocksdb::Snapshot const* snapshot,
+    std::vector<std::string> const& boundaries,
+    std::function<bool(size_t, rocksdb::Iterator*)> const& cb) {
+  TRI_ASSERT(boundaries.size() >= 2);
+  size_t const n = boundaries.size() - 1;
+
+  if (n == 1 || SchedulerFeature::SCHEDULER == nullptr) {
+    for (size_t i = 0; i < n; ++i) {
+      int res = RocksDBRangeScanTask::scan(
+          snapshot, boundaries[i], boundaries[i + 1],
+          [&cb, i](rocksdb::Iterator* it) { return cb(i, it); });
+      if (res != TRI_ERROR_NO_ERROR) {
+        return res;
+      }
+    }
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  auto queue = std::make_shared<basics::LocalTaskQueue>(
+      SchedulerFeature::SCHEDULER->ioService());
+  for (size_t i = 0; i < n; ++i) {
+    queue->enqueue(std::make_shared<RocksDBRangeScanTask>(
+        queue, snapshot, boundaries[i], boundaries[i + 1],
+        [&cb, i](rocksdb::Iterator* it) { return cb(i, it); }));
+  }
+  queue->dispatchAndWait();
+  return queue->status();
+}
+
+/// @brief maximum number of blocks a sampled index is split into
+static constexpr size_t MaxSampleBlocks = 64;
+
+/// @brief number of entries read from each block of a sampled index
+static constexpr uint64_t SampleBlockSize = 256;
+
+/// @brief the estimator hashes read from one key range of an index
+struct EstimatorSample {
+  /// hashes with the number of adjacent entries sharing them. Entries
+  /// with equal values are adjacent in all indexes with an estimator
+  std::vector<std::pair<uint64_t, uint64_t>> runs;
+  uint64_t entries = 0;
+  bool complete = true;
+};
+
 }  // namespace
 
 RocksDBCollection::RocksDBCollection(LogicalCollection* collection,
@@ -83,6 +204,8 @@ RocksDBCollection::RocksDBCollection(LogicalCollection* collection,
       _numberDocuments(0),
       _revisionId(0),
       _needToPersistIndexEstimates(false),
+      _insertsSinceEstimates(0),
+      _estimatesScheduled(false),
       _hasGeoIndex(false),
       _cache(nullptr),
       _cachePresent(false),
@@ -101,6 +224,8 @@ RocksDBCollection::RocksDBCollection(LogicalCollection* collection,
       _numberDocuments(0),
       _revisionId(0),
       _needToPersistIndexEstimates(false),
+      _insertsSinceEstimates(0),
+      _estimatesScheduled(false),
       _hasGeoIndex(false),
       _cache(nullptr),
       _cachePresent(false),
@@ -903,7 +1028,8 @@ int RocksDBCollection::insert(arangodb::transaction::Methods* trx,
     // report document and key size
     RocksDBOperationResult result = state->addOperation(
         _logicalCollection->cid(), revisionId,
-        TRI_VOC_DOCUMENT_OPERATION_INSERT, newSlice.byteSize(), res.keySize());
+        TRI_VOC_DOCUMENT_OPERATION_INSERT, newSlice.byteSize(), res.keySize(),
+        transaction::helpers::extractKeyPart(newSlice));
 
     // transaction size limit reached -- fail
     if (result.fail()) {
@@ -1002,7 +1128,8 @@ int RocksDBCollection::update(arangodb::transaction::Methods* trx,
     // report document and key size
     RocksDBOperationResult result = state->addOperation(_logicalCollection->cid(), revisionId,
                                  TRI_VOC_DOCUMENT_OPERATION_UPDATE,
-                                 newDoc.byteSize(), res.keySize());
+                                 newDoc.byteSize(), res.keySize(),
+                                 transaction::helpers::extractKeyPart(newDoc));
 
     // transaction size limit reached -- fail
     if (result.fail()) {
@@ -1097,7 +1224,8 @@ int RocksDBCollection::replace(
     RocksDBOperationResult result = state->addOperation(_logicalCollection->cid(), revisionId,
                                  TRI_VOC_DOCUMENT_OPERATION_REPLACE,
                                  newDoc.byteSize(),
-                                 opResult.keySize());
+                                 opResult.keySize(),
+                                 transaction::helpers::extractKeyPart(newDoc));
 
     // transaction size limit reached -- fail
     if (result.fail()) {
@@ -1170,7 +1298,7 @@ int RocksDBCollection::remove(arangodb::transaction::Methods* trx,
     // report key size
     res = state->addOperation(_logicalCollection->cid(), revisionId,
                               TRI_VOC_DOCUMENT_OPERATION_REMOVE, 0,
-                              res.keySize());
+                              res.keySize(), StringRef(key));
     // transaction size limit reached -- fail
     if (res.fail()) {
       THROW_ARANGO_EXCEPTION(res);
@@ -1416,40 +1544,11 @@ RocksDBOperationResult RocksDBCollection::insertDocument(
     return res;
   }
 
-  RocksDBOperationResult innerRes;
-  READ_LOCKER(guard, _indexesLock);
-  for (std::shared_ptr<Index> const& idx : _indexes) {
-    innerRes.reset(idx->insert(trx, revisionId, doc, false));
-
-    // in case of no-memory, return immediately
-    if (innerRes.is(TRI_ERROR_OUT_OF_MEMORY)) {
-      return innerRes;
-    }
-
-    if (innerRes.fail()) {
-      // "prefer" unique constraint violated over other errors
-      if (innerRes.is(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED) ||
-          res.ok()) {
-        res = innerRes;
-      }
-    }
-  }
-
-  if (res.ok()) {
-    if (_logicalCollection->waitForSync()) {
-      waitForSync = true;  // output parameter (by ref)
-    }
-
-    // LOG_TOPIC(ERR, Logger::DEVEL)
-    //    << std::boolalpha << "waitForSync during insert: " << waitForSync;
-
-    if (waitForSync) {
-      trx->state()->waitForSync(true);
-    }
-    _needToPersistIndexEstimates = true;
-  }
-
-  return res;
+  return modifyIndexes(trx, res,
+                       [&](RocksDBIndex* idx) {
+                         return idx->insert(trx, revisionId, doc, false);
+                       },
+                       waitForSync);
 }
 
 RocksDBOperationResult RocksDBCollection::removeDocument(
@@ -1539,13 +1638,75 @@ RocksDBOperationResult RocksDBCollection::updateDocument(
   TRI_ASSERT(trx->state()->isRunning());
   TRI_ASSERT(!ServerState::instance()->isCoordinator());
 
-  RocksDBOperationResult res =
-      removeDocument(trx, oldRevisionId, oldDoc, true, waitForSync);
-  if (res.fail()) {
+  TRI_ASSERT(_objectId != 0);
+
+  RocksDBMethods* mthd = rocksutils::toRocksMethods(trx);
+
+  RocksDBKey oldKey(RocksDBKey::Document(_objectId, oldRevisionId));
+  blackListKey(oldKey.string().data(),
+               static_cast<uint32_t>(oldKey.string().size()));
+
+  RocksDBOperationResult res = mthd->Delete(oldKey);
+  if (!res.ok()) {
+    return res;
+  }
+
+  RocksDBKey newKey(RocksDBKey::Document(_objectId, newRevisionId));
+  RocksDBValue value(RocksDBValue::Document(newDoc));
+  blackListKey(newKey.string().data(),
+               static_cast<uint32_t>(newKey.string().size()));
+
+  res = mthd->Put(newKey, value.string());
+  if (!res.ok()) {
+    // set keysize that is passed up to the crud operations
+    res.keySize(newKey.string().size());
     return res;
   }
 
-  res = insertDocument(trx, newRevisionId, newDoc, waitForSync);
+  // every index decides on its own whether its entries have to be
+  // replaced, secondary indexes skip unchanged attribute values
+  return modifyIndexes(trx, res,
+                       [&](RocksDBIndex* idx) {
+                         return idx->update(trx, oldRevisionId, oldDoc,
+                                            newRevisionId, newDoc);
+                       },
+                       waitForSync);
+}
+
+RocksDBOperationResult RocksDBCollection::modifyIndexes(
+    transaction::Methods* trx, RocksDBOperationResult res,
+    std::function<int(RocksDBIndex*)> const& modify,
+    bool& waitForSync) const {
+  RocksDBOperationResult innerRes;
+  READ_LOCKER(guard, _indexesLock);
+  for (std::shared_ptr<Index> const& idx : _indexes) {
+    innerRes.reset(modify(static_cast<RocksDBIndex*>(idx.get())));
+
+    // in case of no-memory, return immediately
+    if (innerRes.is(TRI_ERROR_OUT_OF_MEMORY)) {
+      return innerRes;
+    }
+
+    if (innerRes.fail()) {
+      // "prefer" unique constraint violated over other errors
+      if (innerRes.is(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED) ||
+          res.ok()) {
+        res = innerRes;
+      }
+    }
+  }
+
+  if (res.ok()) {
+    if (_logicalCollection->waitForSync()) {
+      waitForSync = true;  // output parameter (by ref)
+    }
+
+    if (waitForSync) {
+      trx->state()->waitForSync(true);
+    }
+    _needToPersistIndexEstimates = true;
+  }
+
   return res;
 }
 
@@ -1607,6 +1768,55 @@ arangodb::Result RocksDBCollection::lookupRevisionVPack(
   return res;
 }
 
+size_t RocksDBCollection::snapshotCache(VPackBuilder& revisions,
+                                        size_t limit) const {
+  if (!useCache()) {
+    TRI_ASSERT(revisions.isOpenArray());
+    return 0;
+  }
+  return snapshotCache(_cache.get(), revisions, limit);
+}
+
+void RocksDBCollection::warmupCache(transaction::Methods* trx,
+                                    VPackSlice revisions) {
+  TRI_ASSERT(revisions.isArray());
+  if (!useCache()) {
+    return;
+  }
+
+  ManagedDocumentResult mdr;
+  // fills the cache as a side effect, documents removed since the
+  // snapshot was taken are simply not found
+  warmupCache(revisions, [this, trx, &mdr](TRI_voc_rid_t revisionId) {
+    lookupRevisionVPack(revisionId, trx, mdr, true);
+  });
+}
+
+size_t RocksDBCollection::snapshotCache(cache::Cache* cache,
+                                        VPackBuilder& revisions,
+                                        size_t limit) {
+  TRI_ASSERT(revisions.isOpenArray());
+  if (cache == nullptr) {
+    return 0;
+  }
+  return cache->enumerateKeys(
+      [&revisions](uint8_t const* key, uint32_t keySize) {
+        rocksdb::Slice slice(reinterpret_cast<char const*>(key), keySize);
+        revisions.add(VPackValue(RocksDBKey::revisionId(slice)));
+      },
+      limit);
+}
+
+void RocksDBCollection::warmupCache(
+    VPackSlice revisions, std::function<void(TRI_voc_rid_t)> const& lookup) {
+  TRI_ASSERT(revisions.isArray());
+  for (auto const& rev : VPackArrayIterator(revisions)) {
+    if (rev.isNumber()) {
+      lookup(rev.getNumber<TRI_voc_rid_t>());
+    }
+  }
+}
+
 void RocksDBCollection::setRevision(TRI_voc_rid_t revisionId) {
   _revisionId = revisionId;
 }
@@ -1722,28 +1932,60 @@ int RocksDBCollection::unlockRead() {
 
 // rescans the collection to update document count
 uint64_t RocksDBCollection::recalculateCounts() {
-  // start transaction to get a collection lock
+  rocksdb::TransactionDB* db = globalRocksDB();
+  rocksdb::Snapshot const* snapshot = nullptr;
+  uint64_t numberDocuments = 0;
+  {
+    // the collection lock is only held while taking a snapshot that
+    // matches the current count
+    arangodb::SingleCollectionTransaction trx(
+        arangodb::transaction::StandaloneContext::Create(
+            _logicalCollection->vocbase()),
+        _logicalCollection->cid(), AccessMode::Type::EXCLUSIVE);
+    auto res = trx.begin();
+    if (res.fail()) {
+      THROW_ARANGO_EXCEPTION(res);
+    }
+    snapshot = db->GetSnapshot();
+    numberDocuments = _numberDocuments;
+    trx.commit();
+  }
+  TRI_DEFER(db->ReleaseSnapshot(snapshot));
+
+  // count documents
+  auto documentBounds = RocksDBKeyBounds::CollectionDocuments(_objectId);
+  std::vector<std::string> boundaries =
+      splitKeyRange(db, documentBounds, scanParallelism());
+  std::vector<uint64_t> counts(boundaries.size() - 1, 0);
+  int res = scanRanges(snapshot, boundaries,
+                       [&counts](size_t range, rocksdb::Iterator*) {
+                         ++counts[range];
+                         return true;
+                       });
+  if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+  uint64_t counted = 0;
+  for (uint64_t count : counts) {
+    counted += count;
+  }
+
+  // writes committed since the snapshot are already contained in the count
   arangodb::SingleCollectionTransaction trx(
       arangodb::transaction::StandaloneContext::Create(
           _logicalCollection->vocbase()),
       _logicalCollection->cid(), AccessMode::Type::EXCLUSIVE);
-  auto res = trx.begin();
-  if (res.fail()) {
-    THROW_ARANGO_EXCEPTION(res);
+  auto result = trx.begin();
+  if (result.fail()) {
+    THROW_ARANGO_EXCEPTION(result);
   }
-      
-  rocksdb::ReadOptions readOptions;
-  readOptions.fill_cache = false;
-
-  // count documents
-  auto documentBounds = RocksDBKeyBounds::CollectionDocuments(_objectId);
-  _numberDocuments = rocksutils::countKeyRange(
-      globalRocksDB(), readOptions, documentBounds);
+  adjustNumberDocuments(static_cast<int64_t>(counted) -
+                        static_cast<int64_t>(numberDocuments));
 
   // update counter manager value
-  res = globalRocksEngine()->counterManager()->setAbsoluteCounter(
+  result = globalRocksEngine()->counterManager()->setAbsoluteCounter(
       _objectId, _numberDocuments);
-  if (res.ok()) {
+  if (result.ok()) {
     // in case of fail the counter has never been written and hence does not
     // need correction. The value is not changed and does not need to be synced
     globalRocksEngine()->counterManager()->sync(true);
@@ -1836,9 +2078,221 @@ void RocksDBCollection::deserializeIndexEstimates(RocksDBCounterManager* mgr) {
   }
 }
 
-void RocksDBCollection::recalculateIndexEstimates() {
-  auto idxs = getIndexes();
-  recalculateIndexEstimates(idxs);
+void RocksDBCollection::recalculateIndexEstimates(uint64_t sampleSize,
+                                                  VPackBuilder& report) {
+  TRI_ASSERT(report.isOpenArray());
+
+  // concurrent rebuilds would reset each other's buffered updates
+  CONDITIONAL_MUTEX_LOCKER(locker, _estimatesLock, sampleSize == 0);
+
+  rocksdb::TransactionDB* db = globalRocksDB();
+  rocksdb::Snapshot const* snapshot = nullptr;
+  // indexes with an estimator. when rebuilding, their estimators record the
+  // writes made after the snapshot
+  std::vector<std::shared_ptr<Index>> indexes;
+  TRI_DEFER(if (sampleSize == 0) {
+    for (auto const& it : indexes) {
+      auto idx = static_cast<RocksDBIndex*>(it.get());
+      idx->estimator()->discardBufferedUpdates();
+    }
+  });
+  if (sampleSize == 0) {
+    // the estimators are rebuilt from the snapshot. the collection lock is
+    // only held while taking it, so that the estimators match its content
+    // and record all later writes
+    arangodb::SingleCollectionTransaction trx(
+        arangodb::transaction::StandaloneContext::Create(
+            _logicalCollection->vocbase()),
+        _logicalCollection->cid(), AccessMode::Type::EXCLUSIVE);
+    auto res = trx.begin();
+    if (res.fail()) {
+      THROW_ARANGO_EXCEPTION(res);
+    }
+    snapshot = db->GetSnapshot();
+    for (auto const& it : getIndexes()) {
+      auto estimator = static_cast<RocksDBIndex*>(it.get())->estimator();
+      if (estimator != nullptr) {
+        estimator->bufferUpdates();
+        indexes.emplace_back(it);
+      }
+    }
+    trx.commit();
+  } else {
+    // a sample is only reported and leaves the estimators alone
+    snapshot = db->GetSnapshot();
+    for (auto const& it : getIndexes()) {
+      if (static_cast<RocksDBIndex*>(it.get())->estimator() != nullptr) {
+        indexes.emplace_back(it);
+      }
+    }
+  }
+  TRI_DEFER(db->ReleaseSnapshot(snapshot));
+
+  size_t const parallelism = scanParallelism();
+  for (auto const& it : indexes) {
+    auto idx = static_cast<RocksDBIndex*>(it.get());
+    RocksDBCuckooIndexEstimator<uint64_t>* estimator = idx->estimator();
+
+    // a sample reads the start of many blocks, which are delimited by SST
+    // file boundaries, so that it covers the whole key range of the index
+    size_t parts = parallelism;
+    if (sampleSize != 0) {
+      parts = (std::max)(parts, (std::min)(MaxSampleBlocks,
+                                           static_cast<size_t>(
+                                               sampleSize / SampleBlockSize)));
+    }
+    std::vector<std::string> boundaries =
+        splitKeyRange(db, idx->getBounds(), parts);
+    size_t const ranges = boundaries.size() - 1;
+    // every range contributes the same share of the sample
+    uint64_t const limit =
+        (sampleSize == 0) ? 0 : (sampleSize + ranges - 1) / ranges;
+
+    std::vector<EstimatorSample> samples(ranges);
+    int r = scanRanges(
+        snapshot, boundaries, [&](size_t range, rocksdb::Iterator* iter) {
+          EstimatorSample& sample = samples[range];
+          if (limit != 0 && sample.entries == limit) {
+            sample.complete = false;
+            return false;
+          }
+          uint64_t hash = idx->estimatorHash(iter->key());
+          if (sample.runs.empty() || sample.runs.back().first != hash) {
+            sample.runs.emplace_back(hash, 1);
+          } else {
+            ++sample.runs.back().second;
+          }
+          ++sample.entries;
+          return true;
+        });
+    if (r != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION(r);
+    }
+
+    uint64_t entries = 0;
+    uint64_t distinct = 0;
+    bool complete = true;
+    std::vector<double> selectivities;
+    for (auto const& sample : samples) {
+      entries += sample.entries;
+      distinct += sample.runs.size();
+      complete = complete && sample.complete;
+      if (sample.entries > 0) {
+        selectivities.emplace_back(static_cast<double>(sample.runs.size()) /
+                                   sample.entries);
+      }
+    }
+
+    double const estimate =
+        (entries == 0) ? 1.0 : static_cast<double>(distinct) / entries;
+    double lowerBound = estimate;
+    double upperBound = estimate;
+    // a sample within a single block has no spread to derive bounds from
+    bool const bounded = complete || selectivities.size() > 1;
+    if (!complete && bounded) {
+      // the blocks are independent samples of the selectivity
+      double const k = static_cast<double>(selectivities.size());
+      double mean = 0.0;
+      for (double selectivity : selectivities) {
+        mean += selectivity;
+      }
+      mean /= k;
+      double variance = 0.0;
+      for (double selectivity : selectivities) {
+        variance += (selectivity - mean) * (selectivity - mean);
+      }
+      variance /= k - 1.0;
+      double const margin = 1.96 * std::sqrt(variance / k);
+      lowerBound = (std::max)(0.0, estimate - margin);
+      upperBound = (std::min)(1.0, estimate + margin);
+    }
+
+    if (sampleSize == 0) {
+      TRI_ASSERT(complete);
+      RocksDBCuckooIndexEstimator<uint64_t> rebuilt(
+          RocksDBIndex::ESTIMATOR_SIZE);
+      for (auto const& sample : samples) {
+        for (auto const& run : sample.runs) {
+          for (uint64_t i = 0; i < run.second; ++i) {
+            rebuilt.insert(run.first);
+          }
+        }
+      }
+      // writes since the snapshot are replayed on the rebuilt estimator
+      estimator->replaceWith(rebuilt);
+    }
+
+    report.openObject();
+    report.add("id", VPackValue(std::to_string(idx->id())));
+    report.add("type", VPackValue(idx->oldtypeName()));
+    report.add("sampled", VPackValue(!complete));
+    report.add("entries", VPackValue(entries));
+    report.add("ranges", VPackValue(ranges));
+    report.add("selectivityEstimate", VPackValue(estimate));
+    if (bounded) {
+      report.add("lowerBound", VPackValue(lowerBound));
+      report.add("upperBound", VPackValue(upperBound));
+    } else {
+      report.add("lowerBound", VPackValue(VPackValueType::Null));
+      report.add("upperBound", VPackValue(VPackValueType::Null));
+    }
+    report.close();
+  }
+
+  if (sampleSize == 0) {
+    _needToPersistIndexEstimates = true;
+    _insertsSinceEstimates = 0;
+  }
+}
+
+void RocksDBCollection::trackInserts(uint64_t numInserts) {
+  uint64_t inserts = _insertsSinceEstimates.fetch_add(numInserts) + numInserts;
+  if (inserts < AutoEstimatesInsertThreshold ||
+      inserts * 2 < _numberDocuments ||
+      SchedulerFeature::SCHEDULER == nullptr) {
+    return;
+  }
+  bool expected = false;
+  if (!_estimatesScheduled.compare_exchange_strong(expected, true)) {
+    // already scheduled
+    return;
+  }
+
+  TRI_voc_tick_t databaseId = _logicalCollection->vocbase()->id();
+  TRI_voc_cid_t cid = _logicalCollection->cid();
+  SchedulerFeature::SCHEDULER->post([databaseId, cid]() {
+    // the collection may have been dropped in the meantime
+    TRI_vocbase_t* vocbase =
+        DatabaseFeature::DATABASE->useDatabase(databaseId);
+    if (vocbase == nullptr) {
+      return;
+    }
+    TRI_DEFER(vocbase->release());
+
+    TRI_vocbase_col_status_e status;
+    LogicalCollection* collection = vocbase->useCollection(cid, status);
+    if (collection == nullptr) {
+      return;
+    }
+    TRI_DEFER(vocbase->releaseCollection(collection));
+
+    auto physical = static_cast<RocksDBCollection*>(collection->getPhysical());
+    try {
+      VPackBuilder report;
+      report.openArray();
+      physical->recalculateIndexEstimates(0, report);
+      report.close();
+      LOG_TOPIC(DEBUG, Logger::ENGINES)
+          << "recalculated index estimates of collection '"
+          << collection->name() << "' after bulk load: "
+          << report.slice().toJson();
+    } catch (std::exception const& ex) {
+      LOG_TOPIC(WARN, Logger::ENGINES)
+          << "recalculating index estimates of collection '"
+          << collection->name() << "' failed: " << ex.what();
+    }
+    physical->_estimatesScheduled = false;
+  });
 }
 
 void RocksDBCollection::recalculateIndexEstimates(
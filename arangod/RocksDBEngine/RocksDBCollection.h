@@ -25,6 +25,7 @@
 #define ARANGOD_ROCKSDB_ENGINE_ROCKSDB_COLLECTION_H 1
 
 #include "Basics/Common.h"
+#include "Basics/Mutex.h"
 #include "Basics/ReadWriteLock.h"
 #include "Indexes/IndexLookupContext.h"
 #include "RocksDBEngine/RocksDBCommon.h"
@@ -43,6 +44,7 @@ namespace cache {
 class LogicalCollection;
 class ManagedDocumentResult;
 class Result;
+class RocksDBIndex;
 class RocksDBPrimaryIndex;
 class RocksDBVPackIndex;
 struct RocksDBToken;
@@ -183,7 +185,8 @@ class RocksDBCollection final : public PhysicalCollection {
   int lockRead(double timeout = 0.0);
   int unlockRead();
 
-  /// recalculte counts for collection in case of failure
+  /// recalculte counts for collection in case of failure. Writers are only
+  /// blocked while a snapshot is taken, the snapshot is counted concurrently
   uint64_t recalculateCounts();
 
   /// trigger rocksdb compaction for documentDB and indexes
@@ -195,7 +198,39 @@ class RocksDBCollection final : public PhysicalCollection {
   Result serializeIndexEstimates(rocksdb::Transaction*) const;
   void deserializeIndexEstimates(arangodb::RocksDBCounterManager* mgr);
 
-  void recalculateIndexEstimates();
+  /// @brief recalculates the selectivity estimates of all indexes from a
+  /// snapshot, scanning key ranges of each index concurrently. Writers are
+  /// only blocked while the snapshot is taken, their later writes are
+  /// replayed on the rebuilt estimators, one rebuild at a time. If
+  /// `sampleSize` is not 0, at most about that many entries are read per
+  /// index from the start of blocks between SST file boundaries, and the
+  /// estimators are left unchanged. Adds the estimate and its 95% confidence
+  /// interval for each index to the open array `report`. The bounds are
+  /// null if the sample came from a single block
+  void recalculateIndexEstimates(uint64_t sampleSize,
+                                 velocypack::Builder& report);
+
+  /// @brief counts the inserts of a committed import or restore. Schedules
+  /// a background recalculation of the index estimates once they have grown
+  /// the collection substantially since the last one
+  void trackInserts(uint64_t numInserts);
+
+  /// @brief adds the revision ids of the documents currently in the cache
+  /// to an open array, at most `limit` of them. Returns the number added
+  size_t snapshotCache(velocypack::Builder& revisions, size_t limit) const;
+
+  /// @brief loads the documents with the given revision ids into the cache
+  void warmupCache(transaction::Methods*, velocypack::Slice revisions);
+
+  /// @brief adds the revision ids of the documents in a document cache to
+  /// an open array, at most `limit` of them. Returns the number added
+  static size_t snapshotCache(cache::Cache*, velocypack::Builder& revisions,
+                              size_t limit);
+
+  /// @brief calls `lookup` for each revision id of a cache snapshot. Other
+  /// values are skipped
+  static void warmupCache(velocypack::Slice revisions,
+                          std::function<void(TRI_voc_rid_t)> const& lookup);
 
  private:
   /// @brief return engine-specific figures
@@ -230,6 +265,13 @@ class RocksDBCollection final : public PhysicalCollection {
       arangodb::velocypack::Slice const& oldDoc, TRI_voc_rid_t newRevisionId,
       arangodb::velocypack::Slice const& newDoc, bool& waitForSync) const;
 
+  /// @brief applies the index part of an insert or update to all indexes
+  /// once the document itself has been written with result res
+  arangodb::RocksDBOperationResult modifyIndexes(
+      arangodb::transaction::Methods* trx, RocksDBOperationResult res,
+      std::function<int(RocksDBIndex*)> const& modify,
+      bool& waitForSync) const;
+
   arangodb::Result lookupRevisionVPack(TRI_voc_rid_t, transaction::Methods*,
                                        arangodb::ManagedDocumentResult&,
                                        bool withCache) const;
@@ -249,6 +291,11 @@ class RocksDBCollection final : public PhysicalCollection {
   std::atomic<uint64_t> _numberDocuments;
   std::atomic<TRI_voc_rid_t> _revisionId;
   mutable std::atomic<bool> _needToPersistIndexEstimates;
+  /// inserts since the index estimates were last recalculated
+  std::atomic<uint64_t> _insertsSinceEstimates;
+  std::atomic<bool> _estimatesScheduled;
+  /// serializes the rebuilds of the index estimators
+  Mutex _estimatesLock;
 
   /// upgrade write locks to exclusive locks if this flag is set
   bool _hasGeoIndex;
@@ -21,11 +21,11 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RocksDBEngine/RocksDBCollectionExport.h"
-#include "Basics/WriteLocker.h"
 #include "RocksDBEngine/RocksDBCollection.h"
-#include "StorageEngine/EngineSelectorFeature.h"
+#include "RocksDBEngine/RocksDBCommon.h"
+#include "RocksDBEngine/RocksDBEngine.h"
+#include "RocksDBEngine/RocksDBValue.h"
 #include "StorageEngine/PhysicalCollection.h"
-#include "StorageEngine/StorageEngine.h"
 #include "Transaction/Hints.h"
 #include "Transaction/StandaloneContext.h"
 #include "Utils/CollectionGuard.h"
@@ -33,6 +33,8 @@
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/vocbase.h"
 
+#include <rocksdb/utilities/transaction_db.h>
+
 using namespace arangodb;
 
 RocksDBCollectionExport::RocksDBCollectionExport(
@@ -41,7 +43,12 @@ RocksDBCollectionExport::RocksDBCollectionExport(
     : _collection(nullptr),
       _name(name),
       _resolver(vocbase),
-      _restrictions(restrictions) {
+      _restrictions(restrictions),
+      _bounds(RocksDBKeyBounds::Empty()),
+      _snapshot(nullptr),
+      _count(0),
+      _remaining(0),
+      _hasNext(false) {
   // prevent the collection from being unloaded while the export is ongoing
   // this may throw
   _guard.reset(new arangodb::CollectionGuard(vocbase, _name.c_str(), false));
@@ -50,9 +57,17 @@ RocksDBCollectionExport::RocksDBCollectionExport(
   TRI_ASSERT(_collection != nullptr);
 }
 
-RocksDBCollectionExport::~RocksDBCollectionExport() {}
+RocksDBCollectionExport::~RocksDBCollectionExport() {
+  // the iterator must go before the snapshot it reads from
+  _iterator.reset();
+  if (_snapshot != nullptr) {
+    rocksutils::globalRocksDB()->ReleaseSnapshot(_snapshot);
+    _snapshot = nullptr;
+  }
+}
 
 void RocksDBCollectionExport::run(size_t limit) {
+  rocksdb::TransactionDB* db = rocksutils::globalRocksDB();
 
   {
     SingleCollectionTransaction trx(
@@ -67,39 +82,54 @@ void RocksDBCollectionExport::run(size_t limit) {
       THROW_ARANGO_EXCEPTION(res);
     }
 
-    size_t maxDocuments = _collection->numberDocuments(&trx);
-    if (limit > 0 && limit < maxDocuments) {
-      maxDocuments = limit;
-    } else {
-      limit = maxDocuments;
+    _count = _collection->numberDocuments(&trx);
+    if (limit > 0 && limit < _count) {
+      _count = limit;
     }
 
-    _vpack.reserve(limit);
-
-    ManagedDocumentResult mmdr;
-    trx.invokeOnAllElements(
-        _collection->name(),
-        [this, &limit, &trx, &mmdr](DocumentIdentifierToken const& token) {
-          if (limit == 0) {
-            return false;
-          }
-          if (_collection->readDocument(&trx, token, mmdr)) {
-            _vpack.emplace_back(VPackSlice(mmdr.vpack()));
-            --limit;
-          }
-          return true;
-        });
+    // the snapshot pins the documents for the lifetime of the export, the
+    // batches are read from it on demand
+    _snapshot = db->GetSnapshot();
 
     trx.finish(res.errorNumber());
   }
 
+  auto physical =
+      static_cast<RocksDBCollection*>(_collection->getPhysical());
+  _bounds = RocksDBKeyBounds::CollectionDocuments(physical->objectId());
+
+  rocksdb::ReadOptions options;
+  options.snapshot = _snapshot;
+  // a full scan should not evict the hot data from the block cache
+  options.fill_cache = false;
+  _iterator.reset(db->NewIterator(options));
+  _iterator->Seek(_bounds.start());
+
+  _remaining = (limit > 0) ? limit : std::numeric_limits<size_t>::max();
+  updateHasNext();
+
   // delete guard right now as we're about to return
   // if we would continue holding the guard's collection lock and return,
   // and the export object gets later freed in a different thread, then all
-  // would be lost. so we'll release the lock here and rely on the cleanup
-  // thread not unloading the collection (as we've acquired a document ditch
-  // for the collection already - this will prevent unloading of the
-  // collection's
-  // datafiles etc.)
+  // would be lost. so we'll release the lock here and rely on the snapshot
+  // for keeping the documents readable even if the collection is dropped
   _guard.reset();
 }
+
+VPackSlice RocksDBCollectionExport::current() const {
+  TRI_ASSERT(_hasNext);
+  return RocksDBValue::data(_iterator->value());
+}
+
+void RocksDBCollectionExport::next() {
+  TRI_ASSERT(_hasNext);
+  _iterator->Next();
+  --_remaining;
+  updateHasNext();
+}
+
+void RocksDBCollectionExport::updateHasNext() {
+  _hasNext = _remaining > 0 && _iterator->Valid() &&
+             rocksutils::globalRocksEngine()->cmp()->Compare(
+                 _iterator->key(), _bounds.end()) < 0;
+}
@@ -25,18 +25,28 @@
 #define ARANGOD_ROCKSDB_ROCKSDB_COLLECTION_EXPORT_H 1
 
 #include "Basics/Common.h"
+#include "RocksDBEngine/RocksDBKeyBounds.h"
 #include "Utils/CollectionNameResolver.h"
-#include "VocBase/ManagedDocumentResult.h"
 #include "VocBase/voc-types.h"
 
-#include <velocypack/SliceContainer.h>
+#include <velocypack/Slice.h>
 
 struct TRI_vocbase_t;
 
+namespace rocksdb {
+class Iterator;
+class Snapshot;
+}
+
 namespace arangodb {
 
 class CollectionGuard;
-class RocksDBDocumentDitch;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief streams the documents of a collection from a RocksDB snapshot. The
+/// snapshot is taken in run() and kept until the export is destroyed, so
+/// the documents are read batch by batch instead of being copied up front
+////////////////////////////////////////////////////////////////////////////////
 
 class RocksDBCollectionExport {
   friend class RocksDBExportCursor;
@@ -63,13 +73,30 @@ class RocksDBCollectionExport {
  public:
   void run(size_t);
 
+  /// @brief whether there is a current document
+  bool hasNext() const { return _hasNext; }
+
+  /// @brief the current document, valid until next() is called
+  velocypack::Slice current() const;
+
+  /// @brief move on to the next document
+  void next();
+
+ private:
+  void updateHasNext();
+
  private:
   std::unique_ptr<arangodb::CollectionGuard> _guard;
   LogicalCollection* _collection;
   std::string const _name;
   arangodb::CollectionNameResolver _resolver;
   Restrictions _restrictions;
-  std::vector<velocypack::SliceContainer> _vpack;
+  RocksDBKeyBounds _bounds;
+  rocksdb::Snapshot const* _snapshot;
+  std::unique_ptr<rocksdb::Iterator> _iterator;
+  size_t _count;
+  size_t _remaining;
+  bool _hasNext;
 };
 }
 
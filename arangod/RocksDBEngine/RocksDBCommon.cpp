@@ -37,6 +37,7 @@
 
 #include <rocksdb/comparator.h>
 #include <rocksdb/convenience.h>
+#include <rocksdb/metadata.h>
 #include <rocksdb/utilities/transaction_db.h>
 #include <velocypack/Iterator.h>
 
@@ -179,6 +180,50 @@ std::size_t countKeyRange(rocksdb::DB* db, rocksdb::ReadOptions const& opts,
   return count;
 }
 
+std::vector<std::string> splitKeyRange(rocksdb::DB* db,
+                                       RocksDBKeyBounds const& bounds,
+                                       size_t parts) {
+  rocksdb::Comparator const* cmp = db->GetOptions().comparator;
+  rocksdb::Slice const lower(bounds.start());
+  rocksdb::Slice const upper(bounds.end());
+
+  std::vector<std::string> keys;
+  if (parts > 1) {
+    std::vector<rocksdb::LiveFileMetaData> files;
+    db->GetLiveFilesMetaData(&files);
+    for (auto const& file : files) {
+      rocksdb::Slice smallest(file.smallestkey);
+      if (cmp->Compare(smallest, lower) > 0 &&
+          cmp->Compare(smallest, upper) < 0) {
+        keys.emplace_back(file.smallestkey);
+      }
+    }
+    // files of different levels overlap, which does not matter here
+    std::sort(keys.begin(), keys.end(),
+              [cmp](std::string const& lhs, std::string const& rhs) {
+                return cmp->Compare(lhs, rhs) < 0;
+              });
+    keys.erase(std::unique(keys.begin(), keys.end(),
+                           [cmp](std::string const& lhs,
+                                 std::string const& rhs) {
+                             return cmp->Compare(lhs, rhs) == 0;
+                           }),
+               keys.end());
+  }
+
+  std::vector<std::string> result;
+  result.emplace_back(lower.data(), lower.size());
+  if (keys.size() < parts) {
+    result.insert(result.end(), keys.begin(), keys.end());
+  } else {
+    for (size_t i = 1; i < parts; ++i) {
+      result.emplace_back(keys[i * keys.size() / parts]);
+    }
+  }
+  result.emplace_back(upper.data(), upper.size());
+  return result;
+}
+
 /// @brief helper method to remove large ranges of data
 /// Should mainly be used to implement the drop() call
 Result removeLargeRange(rocksdb::TransactionDB* db,
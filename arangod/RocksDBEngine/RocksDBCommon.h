@@ -108,6 +108,14 @@ std::pair<TRI_voc_tick_t, TRI_voc_cid_t> mapObjectToCollection(uint64_t);
 std::size_t countKeyRange(rocksdb::DB*, rocksdb::ReadOptions const&,
                           RocksDBKeyBounds const&);
 
+/// @brief splits the key range of `bounds` into at most `parts` adjacent
+/// ranges, so that they can be scanned concurrently. The boundaries are taken
+/// from the smallest keys of the SST files within the range, so the ranges
+/// are of roughly similar size. Returns the boundaries, beginning with the
+/// start and ending with the end of `bounds`
+std::vector<std::string> splitKeyRange(rocksdb::DB*, RocksDBKeyBounds const&,
+                                       size_t parts);
+
 /// @brief helper method to remove large ranges of data
 /// Should mainly be used to implement the drop() call
 Result removeLargeRange(rocksdb::TransactionDB* db,
@@ -260,6 +260,9 @@ class RocksDBCuckooIndexEstimator {
 
     {
       WRITE_LOCKER(guard, _bucketLock);
+      if (_bufferedUpdates != nullptr) {
+        _bufferedUpdates->emplace_back(k, true);
+      }
       Slot slot = findSlotCuckoo(pos1, pos2, fingerprint);
       if (slot.isEmpty()) {
         // Free slot insert ourself.
@@ -295,6 +298,9 @@ class RocksDBCuckooIndexEstimator {
     bool found = false;
     {
       WRITE_LOCKER(guard, _bucketLock);
+      if (_bufferedUpdates != nullptr) {
+        _bufferedUpdates->emplace_back(k, false);
+      }
       _nrTotal--;
       Slot slot = findSlotNoCuckoo(pos1, pos2, fingerprint, found);
       if (found) {
@@ -320,6 +326,48 @@ class RocksDBCuckooIndexEstimator {
   
   uint64_t capacity() const { return _size * SlotsPerBucket; }
 
+  /// @brief starts recording inserts and removals, so that they can be
+  /// replayed on an estimator rebuilt from a snapshot taken afterwards
+  void bufferUpdates() {
+    WRITE_LOCKER(locker, _bucketLock);
+    _bufferedUpdates.reset(new std::vector<std::pair<Key, bool>>());
+  }
+
+  /// @brief stops recording inserts and removals and drops the recorded ones
+  void discardBufferedUpdates() {
+    WRITE_LOCKER(locker, _bucketLock);
+    _bufferedUpdates.reset();
+  }
+
+  /// @brief replaces the content with that of `other`, after replaying the
+  /// inserts and removals recorded since `bufferUpdates()` on it. `other`
+  /// must not be used concurrently and is left with the old content
+  void replaceWith(RocksDBCuckooIndexEstimator& other) {
+    WRITE_LOCKER(locker, _bucketLock);
+    if (_bufferedUpdates != nullptr) {
+      for (auto const& it : *_bufferedUpdates) {
+        if (it.second) {
+          other.insert(it.first);
+        } else {
+          other.remove(it.first);
+        }
+      }
+      _bufferedUpdates.reset();
+    }
+
+    std::swap(_logSize, other._logSize);
+    std::swap(_size, other._size);
+    std::swap(_niceSize, other._niceSize);
+    std::swap(_sizeMask, other._sizeMask);
+    std::swap(_sizeShift, other._sizeShift);
+    std::swap(_allocSize, other._allocSize);
+    std::swap(_base, other._base);
+    std::swap(_allocBase, other._allocBase);
+    std::swap(_nrUsed, other._nrUsed);
+    std::swap(_nrCuckood, other._nrCuckood);
+    std::swap(_nrTotal, other._nrTotal);
+  }
+
   // not thread safe. called only during tests 
   uint64_t nrUsed() const { return _nrUsed; }
 
@@ -616,6 +664,10 @@ class RocksDBCuckooIndexEstimator {
   HashShort _hasherShort;    // Instance to compute the second hash function
 
   arangodb::basics::ReadWriteLock mutable _bucketLock;
+
+  /// @brief inserts (true) and removals (false) while a replacement of the
+  /// content is built, nullptr otherwise
+  std::unique_ptr<std::vector<std::pair<Key, bool>>> _bufferedUpdates;
 };
 
 }  // namespace arangodb
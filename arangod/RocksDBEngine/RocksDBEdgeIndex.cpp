@@ -59,6 +59,17 @@
 using namespace arangodb;
 using namespace arangodb::basics;
 
+/// @brief edge lists with more entries are stored in the cache in pages of
+/// this many entries
+static constexpr size_t CacheValueSizeLimit = 1000;
+
+/// @brief edge lists with more entries are not stored in the cache
+static constexpr size_t CachePagedValueSizeLimit = 1000 * CacheValueSizeLimit;
+
+/// @brief number of times an edge list too large for a single cache entry
+/// must have been read from RocksDB before it is stored in pages
+static constexpr uint8_t CachePagedAdmissionThreshold = 2;
+
 RocksDBEdgeIndexIterator::RocksDBEdgeIndexIterator(
     LogicalCollection* collection, transaction::Methods* trx,
     ManagedDocumentResult* mmdr, arangodb::RocksDBEdgeIndex const* index,
@@ -67,14 +78,15 @@ RocksDBEdgeIndexIterator::RocksDBEdgeIndexIterator(
       _keys(keys.get()),
       _keysIterator(_keys->slice()),
       _index(index),
-      _iterator(rocksutils::toRocksMethods(trx)->NewIterator()),
+      _iterator(rocksutils::toRocksMethods(trx),
+                RocksDBKeyBounds::EdgeIndex(0)),
       _arrayIterator(VPackSlice::emptyArraySlice()),
-      _bounds(RocksDBKeyBounds::EdgeIndex(0)),
       _doUpdateBounds(true),
       _doUpdateArrayIterator(true),
       _useCache(useCache),
       _cache(cache),
-      _cacheValueSize(0) {
+      _cacheValueSize(0),
+      _cachePaged(false) {
   keys.release();  // now we have ownership for _keys
   TRI_ASSERT(_keys->slice().isArray());
 }
@@ -87,8 +99,9 @@ RocksDBEdgeIndexIterator::~RocksDBEdgeIndexIterator() {
 }
 
 void RocksDBEdgeIndexIterator::updateBounds(StringRef fromTo) {
-  _bounds = RocksDBKeyBounds::EdgeIndexVertex(_index->_objectId, fromTo);
-  _iterator->Seek(_bounds.start());
+  _iterator.setBounds(
+      RocksDBKeyBounds::EdgeIndexVertex(_index->_objectId, fromTo));
+  _iterator.seekToFirst();
 }
 
 StringRef getFromToFromIterator(arangodb::velocypack::ArrayIterator const& it) {
@@ -109,8 +122,6 @@ bool RocksDBEdgeIndexIterator::next(TokenCallback const& cb, size_t limit) {
     return false;
   }
 
-  std::size_t cacheValueSizeLimit = 1000;
-
   // acquire RocksDB collection
   RocksDBToken token;
   auto iterateCachedValues = [this, &cb, &limit, &token]() {
@@ -128,6 +139,7 @@ bool RocksDBEdgeIndexIterator::next(TokenCallback const& cb, size_t limit) {
 
     // reset cache iterator before handling next from/to
     _arrayBuffer.clear();
+    _pagedValueBuilder.clear();
     _arrayIterator = VPackArrayIterator(VPackSlice::emptyArraySlice());
     return false;
   };
@@ -143,22 +155,32 @@ bool RocksDBEdgeIndexIterator::next(TokenCallback const& cb, size_t limit) {
       foundInCache = f.found();
       if (foundInCache) {
         VPackSlice cachedPrimaryKeys(f.value()->value());
-        TRI_ASSERT(cachedPrimaryKeys.isArray());
 
         // update arraySlice (and copy Buffer if required)
         // the finding should be small otherwise we need to release it sooner
-        if (cachedPrimaryKeys.length() <=
-            std::min(static_cast<size_t>(40), limit)) {
+        if (cachedPrimaryKeys.isObject()) {
+          // a large edge list stored in pages, collect them
+          foundInCache = RocksDBEdgeIndex::readCachedPages(
+              _cache, fromTo, cachedPrimaryKeys, _pagedValueBuilder);
+          if (foundInCache) {
+            _arraySlice = _pagedValueBuilder.slice();
+          }
+          f.release();
+        } else if (cachedPrimaryKeys.length() <=
+                   std::min(static_cast<size_t>(40), limit)) {
+          TRI_ASSERT(cachedPrimaryKeys.isArray());
           _arraySlice = cachedPrimaryKeys;  // do not copy
         } else {
           // copy data if there are more documents than the batch size limit
           // allows
+          TRI_ASSERT(cachedPrimaryKeys.isArray());
           _arrayBuffer.append(cachedPrimaryKeys.start(),
                               cachedPrimaryKeys.byteSize());
           _arraySlice = VPackSlice(_arrayBuffer.data());
           f.release();  // release finding so the cache can be operated on
         }
-
+      }
+      if (foundInCache) {
         // update cache value iterator
         _arrayIterator = VPackArrayIterator(_arraySlice);
 
@@ -196,19 +218,25 @@ bool RocksDBEdgeIndexIterator::next(TokenCallback const& cb, size_t limit) {
         _doUpdateBounds = true;
       }
 
-      auto const end = _bounds.end();
-
-      while (_iterator->Valid() &&
-             (_index->_cmp->Compare(_iterator->key(), end) < 0)) {
+      while (_iterator.valid()) {
         StringRef edgeKey = RocksDBKey::primaryKey(_iterator->key());
 
         // lookup real document
         bool continueWithNextBatch = lookupDocumentAndUseCb(edgeKey, cb, limit, token);
         // build cache value for from/to
         if (_useCache) {
-          if (_cacheValueSize <= cacheValueSizeLimit) {
+          if (_cacheValueSize == CacheValueSizeLimit && !_cachePaged) {
+            // too large for a single cache entry. only keep on collecting
+            // if the edge list is requested often enough
+            _cachePaged = _index->admitCachePages(fromTo);
+          }
+          if (_cacheValueSize < CacheValueSizeLimit ||
+              (_cachePaged && _cacheValueSize < CachePagedValueSizeLimit)) {
             _cacheValueBuilder.add(VPackValue(token.revisionId()));
             ++_cacheValueSize;
+          } else {
+            // the edge list will not be cached
+            _cacheValueSize = CachePagedValueSizeLimit + 1;
           }
         }
 
@@ -219,22 +247,18 @@ bool RocksDBEdgeIndexIterator::next(TokenCallback const& cb, size_t limit) {
         }
       }
 
-      // insert cache values that are beyond the cacheValueSizeLimit
-      if (_useCache && _cacheValueSize <= cacheValueSizeLimit) {
+      // insert cache values that are within the size limits
+      if (_useCache && (_cacheValueSize <= CacheValueSizeLimit ||
+                        (_cachePaged &&
+                         _cacheValueSize <= CachePagedValueSizeLimit))) {
         _cacheValueBuilder.close();
-        auto entry = cache::CachedValue::construct(
-            fromTo.data(), static_cast<uint32_t>(fromTo.size()),
-            _cacheValueBuilder.slice().start(),
-            static_cast<uint64_t>(_cacheValueBuilder.slice().byteSize()));
-        bool cached = _cache->insert(entry);
-        if (!cached) {
-          delete entry;
-        }
+        _index->cacheEdgeList(fromTo, _cacheValueBuilder.slice());
       }
 
       // prepare for next key
       _cacheValueBuilder.clear();
       _cacheValueSize = 0;
+      _cachePaged = false;
     }                      // not found in cache
     _keysIterator.next();  // handle next key
   }
@@ -264,7 +288,10 @@ void RocksDBEdgeIndexIterator::reset() {
   _doUpdateBounds = true;
   _doUpdateArrayIterator = true;
   _cacheValueBuilder.clear();
+  _cacheValueSize = 0;
+  _cachePaged = false;
   _arrayBuffer.clear();
+  _pagedValueBuilder.clear();
   _arraySlice = VPackSlice::emptyArraySlice();
   _arrayIterator = VPackArrayIterator(_arraySlice);
   _keysIterator.reset();
@@ -291,7 +318,12 @@ RocksDBEdgeIndex::RocksDBEdgeIndex(TRI_idx_iid_t iid,
                    !ServerState::instance()->isCoordinator() /*useCache*/
                    ),
       _directionAttr(attr),
-      _estimator(nullptr) {
+      _estimator(nullptr),
+      _pageGeneration(0),
+      _pagedReads(0) {
+  for (auto& it : _pagedFrequency) {
+    it.store(0, std::memory_order_relaxed);
+  }
   if (!ServerState::instance()->isCoordinator()) {
     // We activate the estimator only on DBServers
     _estimator = std::make_unique<RocksDBCuckooIndexEstimator<uint64_t>>(
@@ -357,7 +389,7 @@ int RocksDBEdgeIndex::insert(transaction::Methods* trx,
   RocksDBKey key =
       RocksDBKey::EdgeIndexValue(_objectId, fromToRef, StringRef(primaryKey));
   // blacklist key in cache
-  blackListKey(fromToRef);
+  invalidateEdgeList(fromToRef);
 
   // acquire rocksdb transaction
   RocksDBMethods* mthd = rocksutils::toRocksMethods(trx);
@@ -389,7 +421,7 @@ int RocksDBEdgeIndex::remove(transaction::Methods* trx,
       RocksDBKey::EdgeIndexValue(_objectId, fromToRef, StringRef(primaryKey));
 
   // blacklist key in cache
-  blackListKey(fromToRef);
+  invalidateEdgeList(fromToRef);
 
   // acquire rocksdb transaction
   RocksDBMethods* mthd = rocksutils::toRocksMethods(trx);
@@ -410,6 +442,24 @@ int RocksDBEdgeIndex::removeRaw(RocksDBMethods*, TRI_voc_rid_t,
   THROW_ARANGO_EXCEPTION(TRI_ERROR_NOT_IMPLEMENTED);
 }
 
+int RocksDBEdgeIndex::update(transaction::Methods* trx,
+                             TRI_voc_rid_t oldRevisionId,
+                             VPackSlice const& oldDoc,
+                             TRI_voc_rid_t newRevisionId,
+                             VPackSlice const& newDoc) {
+  if (hasSameIndexedValues(oldDoc, newDoc)) {
+    // the index entry only refers to the document key and stays valid, but
+    // the cached edge list holds revision ids
+    VPackSlice fromTo = newDoc.get(_directionAttr);
+    TRI_ASSERT(fromTo.isString());
+    StringRef fromToRef(fromTo);
+    invalidateEdgeList(fromToRef);
+    return TRI_ERROR_NO_ERROR;
+  }
+  return RocksDBIndex::update(trx, oldRevisionId, oldDoc, newRevisionId,
+                              newDoc);
+}
+
 void RocksDBEdgeIndex::batchInsert(
     transaction::Methods* trx,
     std::vector<std::pair<TRI_voc_rid_t, VPackSlice>> const& documents,
@@ -423,7 +473,7 @@ void RocksDBEdgeIndex::batchInsert(
     RocksDBKey key =
         RocksDBKey::EdgeIndexValue(_objectId, fromToRef, StringRef(primaryKey));
 
-    blackListKey(fromToRef);
+    invalidateEdgeList(fromToRef);
     Result r = mthd->Put(rocksdb::Slice(key.string()), rocksdb::Slice(),
                          rocksutils::index);
     if (!r.ok()) {
@@ -648,6 +698,324 @@ void RocksDBEdgeIndex::recalculateEstimates() {
   });
 }
 
+std::string RocksDBEdgeIndex::warmup(transaction::Methods* trx,
+                                     std::string const& startVertex,
+                                     size_t maxEdges) {
+  if (!useCache()) {
+    return "";
+  }
+
+  RocksDBKeyBounds bounds = RocksDBKeyBounds::EdgeIndex(_objectId);
+  rocksdb::Slice const end = bounds.end();
+
+  // the default read options only allow iterating within one prefix,
+  // but we want to visit all vertices of the index
+  rocksdb::ReadOptions options = rocksutils::toRocksMethods(trx)->readOptions();
+  options.total_order_seek = true;
+  options.prefix_same_as_start = false;
+  options.fill_cache = false;
+  std::unique_ptr<rocksdb::Iterator> it =
+      rocksutils::toRocksMethods(trx)->NewIterator(options);
+
+  if (startVertex.empty()) {
+    it->Seek(bounds.start());
+  } else {
+    RocksDBKeyBounds vertexBounds =
+        RocksDBKeyBounds::EdgeIndexVertex(_objectId, StringRef(startVertex));
+    it->Seek(vertexBounds.start());
+  }
+
+  VPackBuilder builder;
+  size_t edges = 0;
+  while (it->Valid() && _cmp->Compare(it->key(), end) < 0) {
+    if (edges >= maxEdges) {
+      return RocksDBKey::vertexId(it->key()).toString();
+    }
+    edges += warmupVertex(trx, it.get(), end, builder, false);
+  }
+  return "";
+}
+
+void RocksDBEdgeIndex::warmupVertices(transaction::Methods* trx,
+                                      VPackSlice vertices) {
+  TRI_ASSERT(vertices.isArray());
+  if (!useCache()) {
+    return;
+  }
+
+  std::unique_ptr<rocksdb::Iterator> it =
+      rocksutils::toRocksMethods(trx)->NewIterator();
+  VPackBuilder builder;
+  for (auto const& vertex : VPackArrayIterator(vertices)) {
+    if (!vertex.isString()) {
+      continue;
+    }
+    StringRef fromTo(vertex);
+    auto f = _cache->find(fromTo.data(), static_cast<uint32_t>(fromTo.size()));
+    if (f.found()) {
+      continue;
+    }
+    RocksDBKeyBounds bounds =
+        RocksDBKeyBounds::EdgeIndexVertex(_objectId, fromTo);
+    it->Seek(bounds.start());
+    if (it->Valid() && _cmp->Compare(it->key(), bounds.end()) < 0) {
+      // the vertex was cached before, so large edge lists are admitted
+      warmupVertex(trx, it.get(), bounds.end(), builder, true);
+    }
+  }
+}
+
+size_t RocksDBEdgeIndex::warmupVertex(transaction::Methods* trx,
+                                      rocksdb::Iterator* it,
+                                      rocksdb::Slice const& end,
+                                      VPackBuilder& builder,
+                                      bool allowPages) {
+  TRI_ASSERT(it->Valid());
+  // the vertex id points into the iterator's key, so copy it
+  std::string const fromTo = RocksDBKey::vertexId(it->key()).toString();
+  auto rocksColl = toRocksDBCollection(_collection);
+
+  size_t const maxEdges =
+      allowPages ? CachePagedValueSizeLimit : CacheValueSizeLimit;
+
+  builder.clear();
+  builder.openArray();
+  size_t edges = 0;
+  RocksDBToken token;
+  while (it->Valid() && _cmp->Compare(it->key(), end) < 0 &&
+         RocksDBKey::vertexId(it->key()) == fromTo) {
+    if (edges < maxEdges) {
+      StringRef edgeKey = RocksDBKey::primaryKey(it->key());
+      if (rocksColl->lookupDocumentToken(trx, edgeKey, token).ok()) {
+        builder.add(VPackValue(token.revisionId()));
+      }
+    }
+    ++edges;
+    it->Next();
+  }
+  builder.close();
+
+  if (edges <= maxEdges) {
+    cacheEdgeList(StringRef(fromTo), builder.slice());
+  }
+  return edges;
+}
+
+size_t RocksDBEdgeIndex::snapshotCache(VPackBuilder& vertices,
+                                       size_t limit) const {
+  TRI_ASSERT(vertices.isOpenArray());
+  if (!useCache()) {
+    return 0;
+  }
+  return _cache->enumerateKeys(
+      [&vertices](uint8_t const* key, uint32_t keySize) {
+        if (std::memchr(key, '\0', keySize) != nullptr) {
+          // a page of a large edge list, it is reloaded with its vertex
+          return;
+        }
+        vertices.add(VPackValuePair(reinterpret_cast<char const*>(key),
+                                    keySize, VPackValueType::String));
+      },
+      limit);
+}
+
+/// @brief the cache key of a page of an edge list. vertex ids cannot contain
+/// NUL bytes, so page keys never collide with the key of a vertex
+static std::string cachePageKey(StringRef fromTo, uint64_t generation,
+                                uint64_t page) {
+  std::string key;
+  key.reserve(fromTo.size() + 1 + 2 * sizeof(uint64_t));
+  key.append(fromTo.data(), fromTo.size());
+  key.push_back('\0');
+  key.append(reinterpret_cast<char const*>(&generation), sizeof(uint64_t));
+  key.append(reinterpret_cast<char const*>(&page), sizeof(uint64_t));
+  return key;
+}
+
+/// @brief inserts a single value into the cache
+static bool insertIntoCache(cache::Cache* cache, char const* key,
+                            size_t keySize, VPackSlice value) {
+  auto entry = cache::CachedValue::construct(
+      key, static_cast<uint32_t>(keySize), value.start(),
+      static_cast<uint64_t>(value.byteSize()));
+  if (entry == nullptr) {
+    return false;
+  }
+  bool cached = cache->insert(entry);
+  if (!cached) {
+    delete entry;
+  }
+  return cached;
+}
+
+/// @brief removes a single value from the cache
+static void removeFromCache(cache::Cache* cache, char const* key,
+                            size_t keySize) {
+  // removal only fails if the bucket cannot be locked
+  while (!cache->remove(key, static_cast<uint32_t>(keySize))) {
+    if (cache->isShutdown()) {
+      break;
+    }
+  }
+}
+
+bool RocksDBEdgeIndex::admitCachePages(StringRef fromTo) const {
+  return admitCachePages(_pagedFrequency.data(), _pagedFrequency.size(),
+                         _pagedReads, fromTo);
+}
+
+bool RocksDBEdgeIndex::admitCachePages(std::atomic<uint8_t>* frequency,
+                                       size_t counters,
+                                       std::atomic<uint64_t>& reads,
+                                       StringRef fromTo) {
+  TRI_ASSERT(counters > 0 && (counters & (counters - 1)) == 0);
+  std::hash<StringRef> hasher;
+  auto& counter = frequency[hasher(fromTo) & (counters - 1)];
+  // the counters are only approximate, lost updates do not matter
+  uint8_t count = counter.load(std::memory_order_relaxed);
+  if (count < UINT8_MAX) {
+    counter.store(++count, std::memory_order_relaxed);
+  }
+
+  // halve all counters from time to time, so that edge lists which were
+  // popular a while ago are not admitted forever
+  if (++reads % (8 * counters) == 0) {
+    for (size_t i = 0; i < counters; ++i) {
+      frequency[i].store(frequency[i].load(std::memory_order_relaxed) / 2,
+                         std::memory_order_relaxed);
+    }
+  }
+  return count >= CachePagedAdmissionThreshold;
+}
+
+void RocksDBEdgeIndex::cacheEdgeList(StringRef fromTo,
+                                     VPackSlice revisions) const {
+  // only paged lists need a generation of their own
+  uint64_t const generation =
+      revisions.length() > CacheValueSizeLimit ? ++_pageGeneration : 0;
+  cacheEdgeList(_cache.get(), fromTo, revisions, generation);
+}
+
+void RocksDBEdgeIndex::invalidateEdgeList(StringRef fromTo) {
+  if (useCache()) {
+    // a blacklisted vertex entry no longer references its pages
+    removeCachedPages(_cache.get(), fromTo);
+    blackListKey(fromTo);
+  }
+}
+
+bool RocksDBEdgeIndex::cacheEdgeList(cache::Cache* cache, StringRef fromTo,
+                                     VPackSlice revisions,
+                                     uint64_t generation) {
+  TRI_ASSERT(revisions.isArray());
+  // the pages of a list cached before would not be referenced anymore
+  removeCachedPages(cache, fromTo);
+
+  VPackValueLength const n = revisions.length();
+  if (n <= CacheValueSizeLimit) {
+    return insertIntoCache(cache, fromTo.data(), fromTo.size(), revisions);
+  }
+
+  // a single edge list must not take over the cache
+  if (n > CachePagedValueSizeLimit ||
+      revisions.byteSize() > cache->usageLimit() / 4) {
+    return false;
+  }
+
+  // every version of a paged list gets its own page keys, so a reader never
+  // mixes pages of different versions
+  std::vector<std::string> keys;
+  auto removePages = [cache, &keys]() {
+    for (auto const& key : keys) {
+      removeFromCache(cache, key.data(), key.size());
+    }
+  };
+
+  VPackBuilder page;
+  VPackArrayIterator it(revisions);
+  while (it.valid()) {
+    page.clear();
+    page.openArray();
+    for (size_t i = 0; i < CacheValueSizeLimit && it.valid(); ++i) {
+      page.add(it.value());
+      it.next();
+    }
+    page.close();
+
+    keys.emplace_back(cachePageKey(fromTo, generation, keys.size()));
+    if (!insertIntoCache(cache, keys.back().data(), keys.back().size(),
+                         page.slice())) {
+      // without the entry for the vertex the pages are never read
+      keys.pop_back();
+      removePages();
+      return false;
+    }
+  }
+
+  // the entry for the vertex is inserted last, so a reader finding it may
+  // expect all pages to be present unless they were evicted since
+  VPackBuilder entry;
+  entry.openObject();
+  entry.add("generation", VPackValue(generation));
+  entry.add("pages", VPackValue(static_cast<uint64_t>(keys.size())));
+  entry.close();
+  if (!insertIntoCache(cache, fromTo.data(), fromTo.size(), entry.slice())) {
+    // e.g. the vertex was blacklisted by a concurrent write
+    removePages();
+    return false;
+  }
+  return true;
+}
+
+bool RocksDBEdgeIndex::readCachedPages(cache::Cache* cache, StringRef fromTo,
+                                       VPackSlice entry,
+                                       VPackBuilder& revisions) {
+  TRI_ASSERT(entry.isObject());
+  uint64_t const generation = entry.get("generation").getUInt();
+  uint64_t const pages = entry.get("pages").getUInt();
+
+  revisions.clear();
+  revisions.openArray();
+  for (uint64_t i = 0; i < pages; ++i) {
+    std::string const key = cachePageKey(fromTo, generation, i);
+    auto f = cache->find(key.data(), static_cast<uint32_t>(key.size()));
+    if (!f.found()) {
+      // page was evicted, the edge list has to be read from RocksDB
+      revisions.clear();
+      return false;
+    }
+    for (auto const& it : VPackArrayIterator(VPackSlice(f.value()->value()))) {
+      revisions.add(it);
+    }
+  }
+  revisions.close();
+  return true;
+}
+
+void RocksDBEdgeIndex::removeCachedPages(cache::Cache* cache,
+                                         StringRef fromTo) {
+  uint64_t generation = 0;
+  uint64_t pages = 0;
+  {
+    auto f = cache->find(fromTo.data(), static_cast<uint32_t>(fromTo.size()));
+    if (!f.found()) {
+      return;
+    }
+    VPackSlice entry(f.value()->value());
+    if (!entry.isObject()) {
+      // a small edge list without pages
+      return;
+    }
+    generation = entry.get("generation").getUInt();
+    pages = entry.get("pages").getUInt();
+  }
+
+  for (uint64_t i = 0; i < pages; ++i) {
+    std::string const key = cachePageKey(fromTo, generation, i);
+    removeFromCache(cache, key.data(), key.size());
+  }
+}
+
 Result RocksDBEdgeIndex::postprocessRemove(transaction::Methods* trx,
                                            rocksdb::Slice const& key,
                                            rocksdb::Slice const& value) {
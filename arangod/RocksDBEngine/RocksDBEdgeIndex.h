@@ -31,6 +31,7 @@
 #include "RocksDBEngine/RocksDBIndex.h"
 #include "RocksDBEngine/RocksDBKey.h"
 #include "RocksDBEngine/RocksDBKeyBounds.h"
+#include "RocksDBEngine/RocksDBMethods.h"
 #include "RocksDBEngine/RocksDBToken.h"
 #include "VocBase/voc-types.h"
 #include "VocBase/vocbase.h"
@@ -38,6 +39,8 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/Slice.h>
 
+#include <array>
+
 namespace rocksdb {
 class TransactionDB;
 class Iterator;
@@ -68,18 +71,22 @@ class RocksDBEdgeIndexIterator final : public IndexIterator {
   RocksDBEdgeIndex const* _index;
   
   //the following 2 values are required for correct batch handling
-  std::unique_ptr<rocksdb::Iterator> _iterator; //iterator position in rocksdb
+  RocksDBRangeIterator _iterator; //iterator position in rocksdb
   VPackSlice _arraySlice;
   VPackBuffer<uint8_t> _arrayBuffer;
   velocypack::ArrayIterator _arrayIterator; //position in cache for multiple batches
 
-  RocksDBKeyBounds _bounds;
   bool _doUpdateBounds;
   bool _doUpdateArrayIterator;
   bool _useCache;
   cache::Cache* _cache;
   VPackBuilder _cacheValueBuilder;
   std::size_t _cacheValueSize;
+  /// @brief whether the edge list being read is collected for the cache
+  /// even though it is too large for a single cache entry
+  bool _cachePaged;
+  /// @brief the pages of a large cached edge list
+  VPackBuilder _pagedValueBuilder;
 };
 
 class RocksDBEdgeIndex final : public RocksDBIndex {
@@ -127,6 +134,11 @@ class RocksDBEdgeIndex final : public RocksDBIndex {
   int removeRaw(RocksDBMethods*, TRI_voc_rid_t,
                 arangodb::velocypack::Slice const&) override;
 
+  int update(transaction::Methods*, TRI_voc_rid_t oldRevisionId,
+             arangodb::velocypack::Slice const& oldDoc,
+             TRI_voc_rid_t newRevisionId,
+             arangodb::velocypack::Slice const& newDoc) override;
+
   Result postprocessRemove(transaction::Methods* trx,
                            rocksdb::Slice const& key,
                            rocksdb::Slice const& value) override;
@@ -165,6 +177,54 @@ class RocksDBEdgeIndex final : public RocksDBIndex {
 
   void recalculateEstimates() override;
 
+  RocksDBCuckooIndexEstimator<uint64_t>* estimator() const override {
+    return _estimator.get();
+  }
+
+  uint64_t estimatorHash(rocksdb::Slice const& key) const override {
+    return HashForKey(key);
+  }
+
+  /// @brief streams the edge lists of the index into the cache, beginning
+  /// at `startVertex` (empty for the first vertex). Stops after the vertex
+  /// in which `maxEdges` edges were exceeded and returns the vertex to
+  /// continue with, or an empty string if the whole index was read.
+  std::string warmup(transaction::Methods*, std::string const& startVertex,
+                     size_t maxEdges);
+
+  /// @brief loads the edge lists of the given vertices into the cache
+  void warmupVertices(transaction::Methods*, velocypack::Slice vertices);
+
+  /// @brief adds the vertices currently in the cache to an open array,
+  /// at most `limit` of them. Returns the number of vertices added
+  size_t snapshotCache(velocypack::Builder& vertices, size_t limit) const;
+
+
+  /// @brief stores the revision ids of the edges of a vertex in `cache`.
+  /// Large edge lists are split into pages with keys of `generation`, which
+  /// are referenced by the cache entry of the vertex. Returns false if the
+  /// list was not cached, no pages of it are left in the cache then
+  static bool cacheEdgeList(cache::Cache* cache, StringRef fromTo,
+                            velocypack::Slice revisions, uint64_t generation);
+
+  /// @brief collects the pages of a large cached edge list into an array.
+  /// Returns false if a page is no longer in the cache
+  static bool readCachedPages(cache::Cache* cache, StringRef fromTo,
+                              velocypack::Slice entry,
+                              velocypack::Builder& revisions);
+
+  /// @brief counts a read of the edge list of `fromTo` from RocksDB in one of
+  /// the `counters` approximate counters of `frequency`, a power of two.
+  /// All counters are halved after 8 reads per counter, which `reads` keeps
+  /// track of. Returns whether the list is read often enough to be cached
+  /// in pages
+  static bool admitCachePages(std::atomic<uint8_t>* frequency, size_t counters,
+                              std::atomic<uint64_t>& reads, StringRef fromTo);
+
+  /// @brief removes the pages of a large cached edge list from `cache`.
+  /// The pages are only found through the entry of the vertex, so this must
+  /// happen before the vertex is removed or blacklisted
+  static void removeCachedPages(cache::Cache* cache, StringRef fromTo);
 
  private:
   /// @brief create the iterator
@@ -180,6 +240,26 @@ class RocksDBEdgeIndex final : public RocksDBIndex {
   void handleValNode(VPackBuilder* keys,
                      arangodb::aql::AstNode const* valNode) const;
 
+  /// @brief reads the edges of the vertex the iterator points to and caches
+  /// them if the list is small enough. Large lists are only cached in pages
+  /// if `allowPages` is set. Leaves the iterator at the next vertex and
+  /// returns the number of edges read
+  size_t warmupVertex(transaction::Methods*, rocksdb::Iterator* it,
+                      rocksdb::Slice const& end, VPackBuilder& builder,
+                      bool allowPages);
+
+  /// @brief counts a read of an edge list too large for a single cache entry
+  /// from RocksDB, and returns whether it is read often enough to be cached
+  /// in pages
+  bool admitCachePages(StringRef fromTo) const;
+
+  /// @brief stores the revision ids of the edges of a vertex in the cache
+  void cacheEdgeList(StringRef fromTo, velocypack::Slice revisions) const;
+
+  /// @brief removes the cached edge list of a vertex and keeps it from being
+  /// cached again until the current cache transactions are finished
+  void invalidateEdgeList(StringRef fromTo);
+
   std::string _directionAttr;
 
   /// @brief A fixed size library to estimate the selectivity of the index.
@@ -187,6 +267,13 @@ class RocksDBEdgeIndex final : public RocksDBIndex {
   /// On removal we have to remove it in the estimator as well.
   std::unique_ptr<RocksDBCuckooIndexEstimator<uint64_t>> _estimator;
 
+  /// @brief version of paged edge lists, part of the keys of their pages
+  mutable std::atomic<uint64_t> _pageGeneration;
+
+  /// @brief approximate number of reads of large edge lists from RocksDB,
+  /// by hash of the vertex
+  mutable std::array<std::atomic<uint8_t>, 1024> _pagedFrequency;
+  mutable std::atomic<uint64_t> _pagedReads;
 };
 }  // namespace arangodb
 
@@ -44,6 +44,7 @@
 #include "RestServer/ViewTypesFeature.h"
 #include "RocksDBEngine/RocksDBAqlFunctions.h"
 #include "RocksDBEngine/RocksDBBackgroundThread.h"
+#include "RocksDBEngine/RocksDBCacheWarmup.h"
 #include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBComparator.h"
@@ -65,6 +66,7 @@
 #include "RocksDBEngine/RocksDBV8Functions.h"
 #include "RocksDBEngine/RocksDBValue.h"
 #include "RocksDBEngine/RocksDBView.h"
+#include "RocksDBEngine/RocksDBWalSyncer.h"
 #include "VocBase/replication-applier.h"
 #include "VocBase/ticks.h"
 
@@ -100,6 +102,9 @@ RocksDBEngine::RocksDBEngine(application_features::ApplicationServer* server)
       _intermediateTransactionCommitSize(32 * 1024 * 1024),
       _intermediateTransactionCommitCount(100000),
       _intermediateTransactionCommitEnabled(false),
+      _groupCommit(true),
+      _warmupEdgeCaches(false),
+      _cacheSnapshotInterval(0.0),
       _pruneWaitTime(10.0) {
   // inherits order from StorageEngine but requires RocksDBOption that are used
   // to configure this Engine and the MMFiles PesistentIndexFeature
@@ -138,6 +143,22 @@ void RocksDBEngine::collectOptions(
       "--rocksdb.intermediate-transaction", "enable intermediate transactions",
       new BooleanParameter(&_intermediateTransactionCommitEnabled));
 
+  options->addHiddenOption(
+      "--rocksdb.group-commit",
+      "let concurrent transactions with waitForSync share WAL syncs",
+      new BooleanParameter(&_groupCommit));
+
+  options->addOption("--rocksdb.warmup-edge-caches",
+                     "load all edge indexes into their caches in the "
+                     "background after startup",
+                     new BooleanParameter(&_warmupEdgeCaches));
+
+  options->addOption("--rocksdb.cache-snapshot-interval",
+                     "interval (in seconds) for recording the keys held in "
+                     "the document and edge caches, which are loaded again "
+                     "after a restart (0 = disable)",
+                     new DoubleParameter(&_cacheSnapshotInterval));
+
   options->addOption("--rocksdb.wal-file-timeout",
                      "timeout after which unused WAL files are deleted",
                      new DoubleParameter(&_pruneWaitTime));
@@ -272,6 +293,15 @@ void RocksDBEngine::start() {
   _counterManager.reset(new RocksDBCounterManager(_db));
   _replicationManager.reset(new RocksDBReplicationManager());
 
+#ifndef _WIN32
+  // SyncWAL always reports "not implemented" on Windows
+  if (_groupCommit) {
+    _walSyncer.reset(new RocksDBWalSyncer(
+        [this]() { return _db->GetBaseDB()->SyncWAL(); },
+        [this]() { return _db->GetLatestSequenceNumber(); }));
+  }
+#endif
+
   _backgroundThread.reset(
       new RocksDBBackgroundThread(this, counter_sync_seconds));
   if (!_backgroundThread->start()) {
@@ -280,6 +310,16 @@ void RocksDBEngine::start() {
     TRI_ASSERT(false);
   }
 
+  if (_warmupEdgeCaches || _cacheSnapshotInterval > 0.0) {
+    _cacheWarmup.reset(
+        new RocksDBCacheWarmup(cacheSnapshotFile(), _warmupEdgeCaches));
+    if (!_cacheWarmup->start()) {
+      LOG_TOPIC(ERR, Logger::ENGINES)
+          << "could not start rocksdb cache warmup";
+      _cacheWarmup.reset();
+    }
+  }
+
   if (!systemDatabaseExists()) {
     addSystemDatabase();
   }
@@ -290,6 +330,14 @@ void RocksDBEngine::stop() {
     return;
   }
   replicationManager()->dropAll();
+
+  if (_cacheWarmup) {
+    _cacheWarmup->beginShutdown();
+    while (_cacheWarmup->isRunning()) {
+      usleep(10000);
+    }
+    _cacheWarmup.reset();
+  }
     
   if (_backgroundThread) {
     // stop the press
@@ -945,6 +993,13 @@ std::pair<TRI_voc_tick_t, TRI_voc_cid_t> RocksDBEngine::mapObjectToCollection(
   return it->second;
 }
 
+std::string RocksDBEngine::cacheSnapshotFile() const {
+  if (_cacheSnapshotInterval <= 0.0) {
+    return "";
+  }
+  return basics::FileUtils::buildFilename(_basePath, "CACHE-SNAPSHOT.json");
+}
+
 arangodb::Result RocksDBEngine::syncWal() {
 #ifdef _WIN32
   // SyncWAL always reports "not implemented" on Windows
@@ -40,10 +40,12 @@ namespace arangodb {
 class PhysicalCollection;
 class PhysicalView;
 class RocksDBBackgroundThread;
+class RocksDBCacheWarmup;
 class RocksDBComparator;
 class RocksDBCounterManager;
 class RocksDBReplicationManager;
 class RocksDBLogValue;
+class RocksDBWalSyncer;
 class TransactionCollection;
 class TransactionState;
 
@@ -234,6 +236,13 @@ class RocksDBEngine final : public StorageEngine {
   static std::string const FeatureName;
   RocksDBCounterManager* counterManager() const;
   RocksDBReplicationManager* replicationManager() const;
+  /// @brief group commit for transactions with waitForSync, nullptr if
+  /// such transactions sync the WAL on their own
+  RocksDBWalSyncer* walSyncer() const { return _walSyncer.get(); }
+  /// @brief file the cached keys are recorded in, empty if disabled
+  std::string cacheSnapshotFile() const;
+  /// @brief interval for recording the cached keys in seconds
+  double cacheSnapshotInterval() const { return _cacheSnapshotInterval; }
   arangodb::Result syncWal();
 
  private:
@@ -254,6 +263,10 @@ class RocksDBEngine final : public StorageEngine {
   std::unique_ptr<RocksDBCounterManager> _counterManager;
   /// Background thread handling garbage collection etc
   std::unique_ptr<RocksDBBackgroundThread> _backgroundThread;
+  /// shares WAL syncs between concurrently committing transactions
+  std::unique_ptr<RocksDBWalSyncer> _walSyncer;
+  /// fills the caches after startup
+  std::unique_ptr<RocksDBCacheWarmup> _cacheWarmup;
   uint64_t _maxTransactionSize;  // maximum allowed size for a transaction
   uint64_t _intermediateTransactionCommitSize;   // maximum size for a
                                                  // transaction before a
@@ -263,6 +276,9 @@ class RocksDBEngine final : public StorageEngine {
                                                  // for intermediate commit
   bool _intermediateTransactionCommitEnabled;    // allow usage of intermediate
                                                  // commits
+  bool _groupCommit;  // share WAL syncs between transactions with waitForSync
+  bool _warmupEdgeCaches;  // stream edge indexes into their caches on startup
+  double _cacheSnapshotInterval;  // record the cached keys every n seconds
 
   mutable basics::ReadWriteLock _collectionMapLock;
   std::unordered_map<uint64_t, std::pair<TRI_voc_tick_t, TRI_voc_cid_t>>
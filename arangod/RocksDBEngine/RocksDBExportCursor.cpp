@@ -41,7 +41,7 @@ RocksDBExportCursor::RocksDBExportCursor(TRI_vocbase_t* vocbase, CursorId id,
     : Cursor(id, batchSize, nullptr, ttl, hasCount),
       _vocbaseGuard(vocbase),
       _ex(ex),
-      _size(ex->_vpack.size()) {}
+      _size(ex->_count) {}
 
 RocksDBExportCursor::~RocksDBExportCursor() { delete _ex; }
 
@@ -54,7 +54,7 @@ bool RocksDBExportCursor::hasNext() {
     return false;
   }
 
-  return (_position < _size);
+  return _ex->hasNext();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -120,7 +120,7 @@ void RocksDBExportCursor::dump(VPackBuilder& builder) {
         break;
       }
 
-      VPackSlice const slice(_ex->_vpack.at(_position++).slice());
+      VPackSlice const slice(_ex->current());
       builder.openObject();
       // Copy over shaped values
       for (auto const& entry : VPackObjectIterator(slice)) {
@@ -141,6 +141,10 @@ void RocksDBExportCursor::dump(VPackBuilder& builder) {
         }
       }
       builder.close();
+
+      // the slice points into the iterator and is invalid from here on
+      _ex->next();
+      ++_position;
     }
     builder.close();  // close Array
 
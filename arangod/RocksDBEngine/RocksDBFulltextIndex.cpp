@@ -292,6 +292,19 @@ int RocksDBFulltextIndex::removeRaw(RocksDBMethods* batch,
   return TRI_ERROR_NO_ERROR;
 }
 
+int RocksDBFulltextIndex::update(transaction::Methods* trx,
+                                 TRI_voc_rid_t oldRevisionId,
+                                 VPackSlice const& oldDoc,
+                                 TRI_voc_rid_t newRevisionId,
+                                 VPackSlice const& newDoc) {
+  if (hasSameIndexedValues(oldDoc, newDoc)) {
+    // the index only refers to the document key, so there is nothing to do
+    return TRI_ERROR_NO_ERROR;
+  }
+  return RocksDBIndex::update(trx, oldRevisionId, oldDoc, newRevisionId,
+                              newDoc);
+}
+
 int RocksDBFulltextIndex::cleanup() {
   rocksdb::TransactionDB* db = rocksutils::globalRocksDB();
   rocksdb::CompactRangeOptions opts;
@@ -510,18 +523,14 @@ Result RocksDBFulltextIndex::applyQueryToken(transaction::Methods* trx,
                                              std::set<std::string>& resultSet) {
   RocksDBMethods *mthds = rocksutils::toRocksMethods(trx);
 
-  // why can't I have an assignment operator when I want one
-  RocksDBKeyBounds bounds = MakeBounds(_objectId, token);
-  std::unique_ptr<rocksdb::Iterator> iter = mthds->NewIterator();
-  iter->Seek(bounds.start());
+  RocksDBRangeIterator iter(mthds, MakeBounds(_objectId, token));
+  iter.seekToFirst();
   
   // set is used to performa an intersection with the result set
   std::set<std::string> intersect;
 
-  // TODO: set options.iterate_upper_bound and remove compare?
   // apply left to right logic, merging all current results with ALL previous
-  auto const end = bounds.end();
-  while (iter->Valid() && _cmp->Compare(iter->key(), end) < 0) {
+  while (iter.valid()) {
     rocksdb::Status s = iter->status();
     if (!s.ok()) {
       return rocksutils::convertStatus(s);
@@ -118,6 +118,11 @@ class RocksDBFulltextIndex final : public RocksDBIndex {
   int removeRaw(RocksDBMethods*, TRI_voc_rid_t,
                 arangodb::velocypack::Slice const&) override;
 
+  int update(transaction::Methods*, TRI_voc_rid_t oldRevisionId,
+             arangodb::velocypack::Slice const& oldDoc,
+             TRI_voc_rid_t newRevisionId,
+             arangodb::velocypack::Slice const& newDoc) override;
+
   //  TRI_fts_index_t* internals() { return _fulltextIndex; }
 
   static TRI_voc_rid_t fromDocumentIdentifierToken(
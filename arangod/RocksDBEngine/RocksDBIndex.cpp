@@ -186,6 +186,37 @@ void RocksDBIndex::recalculateEstimates() {
   return;
 }
 
+int RocksDBIndex::update(transaction::Methods* trx,
+                         TRI_voc_rid_t oldRevisionId, VPackSlice const& oldDoc,
+                         TRI_voc_rid_t newRevisionId,
+                         VPackSlice const& newDoc) {
+  int res = remove(trx, oldRevisionId, oldDoc, false);
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+  return insert(trx, newRevisionId, newDoc, false);
+}
+
+bool RocksDBIndex::hasSameIndexedValues(
+    std::vector<std::vector<arangodb::basics::AttributeName>> const& fields,
+    VPackSlice const& oldDoc, VPackSlice const& newDoc) {
+  std::vector<std::string> path;
+  for (auto const& field : fields) {
+    path.clear();
+    for (auto const& attribute : field) {
+      path.emplace_back(attribute.name);
+      if (attribute.shouldExpand) {
+        // the whole array is indexed
+        break;
+      }
+    }
+    if (!oldDoc.get(path).equals(newDoc.get(path))) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void RocksDBIndex::truncate(transaction::Methods* trx) {
   RocksDBMethods *mthds = rocksutils::toRocksMethods(trx);
   RocksDBKeyBounds indexBounds = getBounds();
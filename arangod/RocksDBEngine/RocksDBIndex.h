@@ -27,6 +27,7 @@
 #include "Basics/AttributeNameParser.h"
 #include "Basics/Common.h"
 #include "Indexes/Index.h"
+#include "RocksDBEngine/RocksDBCuckooIndexEstimator.h"
 #include "RocksDBEngine/RocksDBKeyBounds.h"
 #include <rocksdb/status.h>
 
@@ -41,7 +42,7 @@ class RocksDBMethods;
 
 class RocksDBIndex : public Index {
 
- protected:
+ public:
    // This is the number of distinct elements the index estimator can reliably store
    // This correlates directly with the memmory of the estimator:
    // memmory == ESTIMATOR_SIZE * 6 bytes
@@ -90,6 +91,21 @@ class RocksDBIndex : public Index {
   virtual int removeRaw(RocksDBMethods*, TRI_voc_rid_t,
                         arangodb::velocypack::Slice const&) = 0;
 
+  /// replaces the index elements of the old revision of a document with
+  /// the ones of the new revision. Indexes which do not depend on the
+  /// revision id may skip the work if the indexed values are unchanged
+  virtual int update(transaction::Methods*, TRI_voc_rid_t oldRevisionId,
+                     arangodb::velocypack::Slice const& oldDoc,
+                     TRI_voc_rid_t newRevisionId,
+                     arangodb::velocypack::Slice const& newDoc);
+
+  /// whether the given attributes have binary equal values in both
+  /// documents, i.e. whether an index on them needs no update
+  static bool hasSameIndexedValues(
+      std::vector<std::vector<arangodb::basics::AttributeName>> const& fields,
+      arangodb::velocypack::Slice const& oldDoc,
+      arangodb::velocypack::Slice const& newDoc);
+
   void createCache();
   void disableCache();
 
@@ -99,6 +115,18 @@ class RocksDBIndex : public Index {
 
   virtual void recalculateEstimates();
 
+  /// @brief the selectivity estimator of the index, nullptr if the index
+  /// does not keep one
+  virtual RocksDBCuckooIndexEstimator<uint64_t>* estimator() const {
+    return nullptr;
+  }
+
+  /// @brief hashes an index entry the same way as it is fed into the
+  /// estimator. Only called if `estimator()` is not nullptr
+  virtual uint64_t estimatorHash(rocksdb::Slice const& key) const { return 0; }
+
+  RocksDBKeyBounds getBounds() const;
+
  protected:
   // Will be called during truncate to allow the index to update selectivity
   // estimates, blacklist keys, etc.
@@ -111,7 +139,12 @@ class RocksDBIndex : public Index {
     blackListKey(ref.data(), ref.size());
   };
 
-  RocksDBKeyBounds getBounds() const;
+  /// whether all indexed attributes have binary equal values in both
+  /// documents. Compares the whole array for attributes with expansion
+  bool hasSameIndexedValues(arangodb::velocypack::Slice const& oldDoc,
+                            arangodb::velocypack::Slice const& newDoc) const {
+    return hasSameIndexedValues(_fields, oldDoc, newDoc);
+  }
 
  protected:
   uint64_t _objectId;
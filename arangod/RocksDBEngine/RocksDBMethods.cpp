@@ -21,11 +21,17 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RocksDBMethods.h"
+#include "Basics/FileUtils.h"
+#include "Basics/files.h"
+#include "Logger/Logger.h"
 #include "RocksDBEngine/RocksDBCommon.h"
+#include "RocksDBEngine/RocksDBEngine.h"
 #include "RocksDBEngine/RocksDBTransactionState.h"
+#include "VocBase/ticks.h"
 
 #include <rocksdb/db.h>
 #include <rocksdb/options.h>
+#include <rocksdb/sst_file_writer.h>
 #include <rocksdb/status.h>
 #include <rocksdb/utilities/optimistic_transaction_db.h>
 #include <rocksdb/utilities/transaction.h>
@@ -73,6 +79,80 @@ std::unique_ptr<rocksdb::Iterator> RocksDBMethods::NewIterator() {
   return this->NewIterator(this->readOptions());
 }
 
+/// at most this many unused iterators are kept per transaction
+static size_t const MaxPooledIterators = 8;
+
+RocksDBMethods::PooledIterator RocksDBMethods::acquireIterator(bool bounded) {
+  if (bounded && !_iteratorPool.empty()) {
+    PooledIterator pooled = std::move(_iteratorPool.back());
+    _iteratorPool.pop_back();
+    return pooled;
+  }
+
+  PooledIterator pooled;
+  pooled.epoch = _iteratorEpoch;
+  rocksdb::ReadOptions options = this->readOptions();
+  if (bounded) {
+    // the iterator keeps the pointer, the bound itself is changed on reuse
+    pooled.upperBound.reset(new rocksdb::Slice());
+    options.iterate_upper_bound = pooled.upperBound.get();
+  }
+  pooled.iterator = this->NewIterator(options);
+  return pooled;
+}
+
+void RocksDBMethods::releaseIterator(PooledIterator&& pooled) {
+  if (pooled.upperBound != nullptr && pooled.epoch == _iteratorEpoch &&
+      !hasPendingWrites() && _iteratorPool.size() < MaxPooledIterators) {
+    _iteratorPool.emplace_back(std::move(pooled));
+  }
+}
+
+// ================= RocksDBRangeIterator ==================
+
+RocksDBRangeIterator::RocksDBRangeIterator(RocksDBMethods* methods,
+                                           RocksDBKeyBounds const& bounds,
+                                           bool reverse)
+    : RocksDBRangeIterator(methods, bounds, reverse,
+                           rocksutils::globalRocksEngine()->cmp()) {}
+
+RocksDBRangeIterator::RocksDBRangeIterator(RocksDBMethods* methods,
+                                           RocksDBKeyBounds const& bounds,
+                                           bool reverse,
+                                           rocksdb::Comparator const* cmp)
+    : _methods(methods),
+      _bounds(bounds),
+      _pooled(methods->acquireIterator(!reverse)),
+      _iterator(_pooled.iterator.get()),
+      _cmp(cmp),
+      _checkStart(reverse),
+      _checkEnd(reverse || methods->hasPendingWrites()) {
+  if (_pooled.upperBound != nullptr) {
+    *_pooled.upperBound = _bounds.end();
+  }
+}
+
+RocksDBRangeIterator::~RocksDBRangeIterator() {
+  _methods->releaseIterator(std::move(_pooled));
+}
+
+void RocksDBRangeIterator::setBounds(RocksDBKeyBounds const& bounds) {
+  _bounds = bounds;
+  if (_pooled.upperBound != nullptr) {
+    *_pooled.upperBound = _bounds.end();
+  }
+}
+
+bool RocksDBRangeIterator::valid() const {
+  if (!_iterator->Valid()) {
+    return false;
+  }
+  if (_checkStart && _cmp->Compare(_iterator->key(), _bounds.start()) < 0) {
+    return false;
+  }
+  return !_checkEnd || _cmp->Compare(_iterator->key(), _bounds.end()) < 0;
+}
+
 // =================== RocksDBReadOnlyMethods ====================
 
 RocksDBReadOnlyMethods::RocksDBReadOnlyMethods(RocksDBTransactionState* state)
@@ -197,3 +277,155 @@ std::unique_ptr<rocksdb::Iterator> RocksDBBatchedMethods::NewIterator(
   return std::unique_ptr<rocksdb::Iterator>(
       _wb->NewIteratorWithBase(_db->NewIterator(ro)));
 }
+
+// =================== RocksDBSstFileMethods ====================
+
+bool RocksDBSstFileMethods::KeyComparator::operator()(
+    std::string const& lhs, std::string const& rhs) const {
+  return cmp->Compare(lhs, rhs) < 0;
+}
+
+RocksDBSstFileMethods::RocksDBSstFileMethods(RocksDBTransactionState* state)
+    : RocksDBSstFileMethods(state, rocksutils::globalRocksDB()) {}
+
+RocksDBSstFileMethods::RocksDBSstFileMethods(RocksDBTransactionState* state,
+                                             rocksdb::DB* db)
+    : RocksDBMethods(state),
+      _db(db),
+      _data(KeyComparator{db->GetOptions().comparator}) {}
+
+RocksDBSstFileMethods::~RocksDBSstFileMethods() { discard(); }
+
+bool RocksDBSstFileMethods::Exists(RocksDBKey const& key) {
+  if (_data.find(key.string()) != _data.end()) {
+    return true;
+  }
+  std::string val;  // do not care about value
+  rocksdb::Status s = _db->Get(_state->_rocksReadOptions, key.string(), &val);
+  return !s.IsNotFound();
+}
+
+arangodb::Result RocksDBSstFileMethods::Get(RocksDBKey const& key,
+                                            std::string* val) {
+  auto it = _data.find(key.string());
+  if (it != _data.end()) {
+    *val = it->second;
+    return arangodb::Result();
+  }
+  rocksdb::Status s = _db->Get(_state->_rocksReadOptions, key.string(), val);
+  return s.ok() ? arangodb::Result() : rocksutils::convertStatus(s);
+}
+
+arangodb::Result RocksDBSstFileMethods::Put(RocksDBKey const& key,
+                                            rocksdb::Slice const& val,
+                                            rocksutils::StatusHint) {
+  // the previous value cannot be restored by a rollback
+  bool exists = (_data.find(key.string()) != _data.end());
+  if (!exists) {
+    // the file is ingested on top of the latest data, not of a snapshot
+    std::string val;  // do not care about value
+    rocksdb::Status s = _db->Get(rocksdb::ReadOptions(), key.string(), &val);
+    if (!s.ok() && !s.IsNotFound()) {
+      return rocksutils::convertStatus(s);
+    }
+    exists = s.ok();
+  }
+  if (exists) {
+    return arangodb::Result(TRI_ERROR_NOT_IMPLEMENTED,
+                            "bulk loads cannot overwrite data");
+  }
+  _data.emplace(key.string(), val.ToString());
+  _added.emplace_back(key.string());
+  return arangodb::Result();
+}
+
+arangodb::Result RocksDBSstFileMethods::Delete(RocksDBKey const&) {
+  return arangodb::Result(TRI_ERROR_NOT_IMPLEMENTED,
+                          "bulk loads cannot remove data");
+}
+
+std::unique_ptr<rocksdb::Iterator> RocksDBSstFileMethods::NewIterator(
+    rocksdb::ReadOptions const& opts) {
+  return std::unique_ptr<rocksdb::Iterator>(_db->NewIterator(opts));
+}
+
+void RocksDBSstFileMethods::SetSavePoint() {
+  _savePoints.emplace_back(_added.size());
+}
+
+arangodb::Result RocksDBSstFileMethods::RollbackToSavePoint() {
+  if (_savePoints.empty()) {
+    return arangodb::Result(TRI_ERROR_INTERNAL, "no savepoint set");
+  }
+  size_t position = _savePoints.back();
+  _savePoints.pop_back();
+  while (_added.size() > position) {
+    _data.erase(_added.back());
+    _added.pop_back();
+  }
+  return arangodb::Result();
+}
+
+arangodb::Result RocksDBSstFileMethods::prepare() {
+  TRI_ASSERT(_savePoints.empty());
+  TRI_ASSERT(_path.empty());
+  if (_data.empty()) {
+    return arangodb::Result();
+  }
+
+  // the file is moved into the database directory by the ingestion, its
+  // name does not clash with the names of RocksDB's own files
+  std::string path = basics::FileUtils::buildFilename(
+      _db->GetName(), "bulkload-" + std::to_string(TRI_NewTickServer()) + ".sst");
+
+  rocksdb::Options options = _db->GetOptions();
+  rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), options,
+                                options.comparator);
+  rocksdb::Status s = writer.Open(path);
+  for (auto it = _data.begin(); s.ok() && it != _data.end(); ++it) {
+    s = writer.Add(it->first, it->second);
+  }
+  if (s.ok()) {
+    s = writer.Finish();
+  }
+
+  if (!s.ok()) {
+    TRI_UnlinkFile(path.c_str());
+    LOG_TOPIC(WARN, Logger::ENGINES)
+        << "writing bulk load file '" << path << "' failed: " << s.ToString();
+    return rocksutils::convertStatus(s);
+  }
+
+  _path = std::move(path);
+  _data.clear();
+  _added.clear();
+  return arangodb::Result();
+}
+
+arangodb::Result RocksDBSstFileMethods::ingest() {
+  TRI_ASSERT(_data.empty());
+  if (_path.empty()) {
+    return arangodb::Result();
+  }
+
+  rocksdb::IngestExternalFileOptions ingestOptions;
+  ingestOptions.move_files = true;
+  rocksdb::Status s = _db->IngestExternalFile({_path}, ingestOptions);
+  if (!s.ok()) {
+    LOG_TOPIC(WARN, Logger::ENGINES)
+        << "ingesting bulk load file '" << _path
+        << "' failed: " << s.ToString();
+    discard();
+    return rocksutils::convertStatus(s);
+  }
+
+  _path.clear();
+  return arangodb::Result();
+}
+
+void RocksDBSstFileMethods::discard() {
+  if (!_path.empty()) {
+    TRI_UnlinkFile(_path.c_str());
+    _path.clear();
+  }
+}
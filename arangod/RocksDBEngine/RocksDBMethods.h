@@ -25,6 +25,9 @@
 
 #include "Basics/Result.h"
 #include "RocksDBCommon.h"
+#include "RocksDBKeyBounds.h"
+
+#include <map>
 
 namespace rocksdb {
 class Transaction;
@@ -64,7 +67,7 @@ class RocksDBMethods {
   explicit RocksDBMethods(RocksDBTransactionState* state) : _state(state) {}
   virtual ~RocksDBMethods() {}
 
-  rocksdb::ReadOptions const& readOptions();
+  virtual rocksdb::ReadOptions const& readOptions();
 
   virtual bool Exists(RocksDBKey const&) = 0;
   virtual arangodb::Result Get(RocksDBKey const&, std::string*) = 0;
@@ -81,8 +84,86 @@ class RocksDBMethods {
   virtual void SetSavePoint() = 0;
   virtual arangodb::Result RollbackToSavePoint() = 0;
 
+  /// whether iterators may return keys written by the transaction itself.
+  /// These are not limited by `iterate_upper_bound`
+  virtual bool hasPendingWrites() const { return false; }
+
+  /// iterator with the read options of the transaction and an
+  /// `iterate_upper_bound` which can be changed, if it is bounded
+  struct PooledIterator {
+    /// nullptr if the iterator has no upper bound
+    std::unique_ptr<rocksdb::Slice> upperBound;
+    std::unique_ptr<rocksdb::Iterator> iterator;
+    /// iterators from before the last clearIteratorPool() are not reused
+    uint64_t epoch = 0;
+  };
+
+  /// takes a bounded iterator from the pool, or creates one. Unbounded
+  /// iterators are always created
+  PooledIterator acquireIterator(bool bounded = true);
+  /// gives an iterator back to the pool. Iterators over pending writes are
+  /// invalidated by further writes, so they are not reused, and neither are
+  /// unbounded iterators
+  void releaseIterator(PooledIterator&&);
+  /// destroys the pooled iterators, must be called before the rocksdb
+  /// transaction or the snapshot goes away
+  void clearIteratorPool() {
+    _iteratorPool.clear();
+    ++_iteratorEpoch;
+  }
+
  protected:
   RocksDBTransactionState* _state;
+
+ private:
+  std::vector<PooledIterator> _iteratorPool;
+  uint64_t _iteratorEpoch = 0;
+};
+
+/// iterator over the keys of a RocksDBKeyBounds range. For forward iteration
+/// `iterate_upper_bound` is set to the end of the range, so that RocksDB stops
+/// there instead of reading the following keys and tombstones, and skips the
+/// files and blocks beyond it. Keys written by the transaction itself are not
+/// limited by it and are checked against the end with the comparator.
+/// RocksDB 5.1 has no lower bound and SeekForPrev ignores the upper bound,
+/// so reverse iterators are not bounded and check both ends of the range
+/// with the comparator. The underlying iterator is taken from a pool of the
+/// transaction and given back on destruction, so it must not outlive the
+/// transaction
+class RocksDBRangeIterator {
+ public:
+  RocksDBRangeIterator(RocksDBMethods*, RocksDBKeyBounds const&,
+                       bool reverse = false);
+  RocksDBRangeIterator(RocksDBMethods*, RocksDBKeyBounds const&, bool reverse,
+                       rocksdb::Comparator const*);
+  ~RocksDBRangeIterator();
+
+  RocksDBRangeIterator(RocksDBRangeIterator const&) = delete;
+  RocksDBRangeIterator& operator=(RocksDBRangeIterator const&) = delete;
+
+  RocksDBKeyBounds const& bounds() const { return _bounds; }
+
+  /// switches to another range, the iterator must be positioned afterwards
+  void setBounds(RocksDBKeyBounds const&);
+
+  /// positions the iterator at the first key of the range
+  void seekToFirst() { _iterator->Seek(_bounds.start()); }
+  /// positions the iterator at the last key of the range
+  void seekToLast() { _iterator->SeekForPrev(_bounds.end()); }
+
+  /// whether the iterator points to a key within the range
+  bool valid() const;
+
+  rocksdb::Iterator* operator->() const { return _iterator; }
+
+ private:
+  RocksDBMethods* _methods;
+  RocksDBKeyBounds _bounds;
+  RocksDBMethods::PooledIterator _pooled;
+  rocksdb::Iterator* _iterator;
+  rocksdb::Comparator const* _cmp;
+  bool const _checkStart;
+  bool const _checkEnd;
 };
 
 // only implements GET and NewIterator
@@ -145,6 +226,8 @@ class RocksDBTrxMethods : public RocksDBMethods {
   std::unique_ptr<rocksdb::Iterator> NewIterator(
       rocksdb::ReadOptions const&) override;
 
+  bool hasPendingWrites() const override { return true; }
+
   void SetSavePoint() override;
   arangodb::Result RollbackToSavePoint() override;
 };
@@ -164,6 +247,8 @@ class RocksDBBatchedMethods : public RocksDBMethods {
   std::unique_ptr<rocksdb::Iterator> NewIterator(
       rocksdb::ReadOptions const&) override;
 
+  bool hasPendingWrites() const override { return true; }
+
   void SetSavePoint() override {}
   arangodb::Result RollbackToSavePoint() override { return arangodb::Result(); }
 
@@ -172,6 +257,60 @@ class RocksDBBatchedMethods : public RocksDBMethods {
   rocksdb::WriteBatchWithIndex* _wb;
 };
 
+/// collects the writes of a bulk load in memory, ordered like the database,
+/// and ingests them into RocksDB as an SST file. The data bypasses the WAL
+/// and the memtables and is not seen by WAL tailing. Only supports inserts
+/// of new keys
+class RocksDBSstFileMethods : public RocksDBMethods {
+ public:
+  explicit RocksDBSstFileMethods(RocksDBTransactionState*);
+  /// collects the writes for `db`, which must use the comparator the keys
+  /// are ordered with
+  RocksDBSstFileMethods(RocksDBTransactionState*, rocksdb::DB* db);
+  /// removes a file which was prepared but not ingested
+  ~RocksDBSstFileMethods();
+
+  bool Exists(RocksDBKey const&) override;
+  arangodb::Result Get(RocksDBKey const& key, std::string* val) override;
+  /// fails for keys which were already put or are in the database. Keys
+  /// written to the database before the ingestion are overwritten by it
+  arangodb::Result Put(
+      RocksDBKey const& key, rocksdb::Slice const& val,
+      rocksutils::StatusHint hint = rocksutils::StatusHint::none) override;
+  arangodb::Result Delete(RocksDBKey const& key) override;
+  /// does not see the writes collected so far
+  std::unique_ptr<rocksdb::Iterator> NewIterator(
+      rocksdb::ReadOptions const&) override;
+
+  void SetSavePoint() override;
+  arangodb::Result RollbackToSavePoint() override;
+
+  /// writes the collected data to an SST file, which is ingested later.
+  /// Fails if the file cannot be written, nothing is ingested then
+  arangodb::Result prepare();
+
+  /// ingests the file written by `prepare()`, so that the data becomes
+  /// visible. The data is not written to the WAL
+  arangodb::Result ingest();
+
+  /// removes the file written by `prepare()` without ingesting it
+  void discard();
+
+ private:
+  struct KeyComparator {
+    rocksdb::Comparator const* cmp;
+    bool operator()(std::string const& lhs, std::string const& rhs) const;
+  };
+
+  rocksdb::DB* _db;
+  std::map<std::string, std::string, KeyComparator> _data;
+  /// the file written by `prepare()`, empty if there is none
+  std::string _path;
+  /// keys in the order they were added, to roll back to a savepoint
+  std::vector<std::string> _added;
+  std::vector<size_t> _savePoints;
+};
+
 }  // namespace arangodb
 
 #endif
@@ -118,9 +118,8 @@ RocksDBAllIndexIterator::RocksDBAllIndexIterator(
     ManagedDocumentResult* mmdr, RocksDBPrimaryIndex const* index, bool reverse)
     : IndexIterator(collection, trx, mmdr, index),
       _reverse(reverse),
-      _iterator(rocksutils::toRocksMethods(trx)->NewIterator()),
-      _bounds(RocksDBKeyBounds::PrimaryIndex(index->objectId()))
-       {
+      _iterator(rocksutils::toRocksMethods(trx),
+                RocksDBKeyBounds::PrimaryIndex(index->objectId()), reverse) {
   // acquire rocksdb transaction
   RocksDBTransactionState* state = rocksutils::toRocksTransactionState(trx);
   TRI_ASSERT(state != nullptr);
@@ -131,16 +130,16 @@ RocksDBAllIndexIterator::RocksDBAllIndexIterator(
   TRI_ASSERT(options.prefix_same_as_start);
 
   if (reverse) {
-    _iterator->SeekForPrev(_bounds.end());
+    _iterator.seekToLast();
   } else {
-    _iterator->Seek(_bounds.start());
+    _iterator.seekToFirst();
   }
 }
 
 bool RocksDBAllIndexIterator::next(TokenCallback const& cb, size_t limit) {
   TRI_ASSERT(_trx->state()->isRunning());
 
-  if (limit == 0 || !_iterator->Valid()) {
+  if (limit == 0 || !_iterator.valid()) {
     // No limit no data, or we are actually done. The last call should have
     // returned false
     TRI_ASSERT(limit > 0);  // Someone called with limit == 0. Api broken
@@ -159,7 +158,7 @@ bool RocksDBAllIndexIterator::next(TokenCallback const& cb, size_t limit) {
       _iterator->Next();
     }
 
-    if (!_iterator->Valid()) {
+    if (!_iterator.valid()) {
       return false;
     }
   }
@@ -172,7 +171,7 @@ bool RocksDBAllIndexIterator::nextWithKey(TokenKeyCallback const& cb,
                                           size_t limit) {
   TRI_ASSERT(_trx->state()->isRunning());
 
-  if (limit == 0 || !_iterator->Valid()) {
+  if (limit == 0 || !_iterator.valid()) {
     // No limit no data, or we are actually done. The last call should have
     // returned false
     TRI_ASSERT(limit > 0);  // Someone called with limit == 0. Api broken
@@ -190,7 +189,7 @@ bool RocksDBAllIndexIterator::nextWithKey(TokenKeyCallback const& cb,
     } else {
       _iterator->Next();
     }
-    if (!_iterator->Valid()) {
+    if (!_iterator.valid()) {
       return false;
     }
   }
@@ -200,7 +199,7 @@ bool RocksDBAllIndexIterator::nextWithKey(TokenKeyCallback const& cb,
 void RocksDBAllIndexIterator::seek(StringRef const& key) {
   TRI_ASSERT(_trx->state()->isRunning());
   // don't want to get the index pointer just for this
-  uint64_t objectId = _bounds.objectId();
+  uint64_t objectId = _iterator.bounds().objectId();
   RocksDBKey val = RocksDBKey::PrimaryIndexValue(objectId, key);
   if (_reverse) {
     _iterator->SeekForPrev(val.string());
@@ -213,9 +212,9 @@ void RocksDBAllIndexIterator::reset() {
   TRI_ASSERT(_trx->state()->isRunning());
 
   if (_reverse) {
-    _iterator->SeekForPrev(_bounds.end());
+    _iterator.seekToLast();
   } else {
-    _iterator->Seek(_bounds.start());
+    _iterator.seekToFirst();
   }
 }
 
@@ -225,9 +224,9 @@ RocksDBAnyIndexIterator::RocksDBAnyIndexIterator(
     LogicalCollection* collection, transaction::Methods* trx,
     ManagedDocumentResult* mmdr, RocksDBPrimaryIndex const* index)
     : IndexIterator(collection, trx, mmdr, index),
-      _cmp(index->_cmp),
-      _iterator(rocksutils::toRocksMethods(trx)->NewIterator()),
-      _bounds(RocksDBKeyBounds::PrimaryIndex(index->objectId())),
+      // positioned backwards as well, so both ends of the range are checked
+      _iterator(rocksutils::toRocksMethods(trx),
+                RocksDBKeyBounds::PrimaryIndex(index->objectId()), true),
       _total(0),
       _returned(0) {
   // acquire rocksdb transaction
@@ -242,19 +241,19 @@ RocksDBAnyIndexIterator::RocksDBAnyIndexIterator(
   // uint64_t goal = off;
   if (_total > 0) {
     if (off <= _total / 2) {
-      _iterator->Seek(_bounds.start());
-      while (_iterator->Valid() && off-- > 0) {
+      _iterator.seekToFirst();
+      while (_iterator.valid() && off-- > 0) {
         _iterator->Next();
       }
     } else {
       off = _total - (off + 1);
-      _iterator->SeekForPrev(_bounds.end());
-      while (_iterator->Valid() && off-- > 0) {
+      _iterator.seekToLast();
+      while (_iterator.valid() && off-- > 0) {
         _iterator->Prev();
       }
     }
-    if (!_iterator->Valid()) {
-      _iterator->Seek(_bounds.start());
+    if (!_iterator.valid()) {
+      _iterator.seekToFirst();
     }
   }
 }
@@ -262,7 +261,7 @@ RocksDBAnyIndexIterator::RocksDBAnyIndexIterator(
 bool RocksDBAnyIndexIterator::next(TokenCallback const& cb, size_t limit) {
   TRI_ASSERT(_trx->state()->isRunning());
 
-  if (limit == 0 || !_iterator->Valid()) {
+  if (limit == 0 || !_iterator.valid()) {
     // No limit no data, or we are actually done. The last call should have
     // returned false
     TRI_ASSERT(limit > 0);  // Someone called with limit == 0. Api broken
@@ -276,9 +275,9 @@ bool RocksDBAnyIndexIterator::next(TokenCallback const& cb, size_t limit) {
     --limit;
     _returned++;
     _iterator->Next();
-    if (!_iterator->Valid()) {
+    if (!_iterator.valid()) {
       if (_returned < _total) {
-        _iterator->Seek(_bounds.start());
+        _iterator.seekToFirst();
         continue;
       }
       return false;
@@ -287,7 +286,7 @@ bool RocksDBAnyIndexIterator::next(TokenCallback const& cb, size_t limit) {
   return true;
 }
 
-void RocksDBAnyIndexIterator::reset() { _iterator->Seek(_bounds.start()); }
+void RocksDBAnyIndexIterator::reset() { _iterator.seekToFirst(); }
 
 // ================ PrimaryIndex ================
 
@@ -30,6 +30,7 @@
 #include "Random/RandomGenerator.h"
 #include "RocksDBEngine/RocksDBIndex.h"
 #include "RocksDBEngine/RocksDBKeyBounds.h"
+#include "RocksDBEngine/RocksDBMethods.h"
 #include "RocksDBEngine/RocksDBToken.h"
 #include "VocBase/voc-types.h"
 #include "VocBase/vocbase.h"
@@ -94,8 +95,7 @@ class RocksDBAllIndexIterator final : public IndexIterator {
 
  private:
   bool const _reverse;
-  std::unique_ptr<rocksdb::Iterator> _iterator;
-  RocksDBKeyBounds const _bounds;
+  RocksDBRangeIterator _iterator;
 };
 
 class RocksDBAnyIndexIterator final : public IndexIterator {
@@ -114,13 +114,10 @@ class RocksDBAnyIndexIterator final : public IndexIterator {
   void reset() override;
 
  private:
-  bool outOfRange() const;
   static uint64_t newOffset(LogicalCollection* collection,
                             transaction::Methods* trx);
 
-  RocksDBComparator const* _cmp;
-  std::unique_ptr<rocksdb::Iterator> _iterator;
-  RocksDBKeyBounds const _bounds;
+  RocksDBRangeIterator _iterator;
   uint64_t _total;
   uint64_t _returned;
 };
@@ -399,13 +399,14 @@ void RocksDBReplicationContext::release() {
 }
 
 void RocksDBReplicationContext::releaseDumpingResources() {
+  // the iterator belongs to the transaction, so it must go first
+  if (_iter.get() != nullptr) {
+    _iter.reset();
+  }
   if (_trx.get() != nullptr) {
     _trx->abort();
     _trx.reset();
   }
-  if (_iter.get() != nullptr) {
-    _iter.reset();
-  }
   _collection = nullptr;
   _guard.reset();
 }
@@ -24,7 +24,15 @@
 #include "RocksDBEngine/RocksDBRestExportHandler.h"
 #include "Basics/Exceptions.h"
 #include "Basics/MutexLocker.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
+#include "Cluster/ClusterComm.h"
+#include "Cluster/ClusterInfo.h"
+#include "Cluster/ClusterMethods.h"
+#include "Cluster/ServerState.h"
+#include "Rest/HttpRequest.h"
+#include "Rest/HttpResponse.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBEngine.h"
 #include "RocksDBEngine/RocksDBExportCursor.h"
@@ -40,6 +48,7 @@
 #include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb;
+using namespace arangodb::basics;
 using namespace arangodb::rest;
 
 RocksDBRestExportHandler::RocksDBRestExportHandler(GeneralRequest* request,
@@ -47,16 +56,30 @@ RocksDBRestExportHandler::RocksDBRestExportHandler(GeneralRequest* request,
     : RestVocbaseBaseHandler(request, response), _restrictions() {}
 
 RestStatus RocksDBRestExportHandler::execute() {
+  // extract the sub-request type
+  auto const type = _request->requestType();
+
   if (ServerState::instance()->isCoordinator()) {
+    // the shards are exported directly from their leaders, the coordinator
+    // only tells where they are and passes the requests on
+    if (!_request->value("DBserver").empty()) {
+      forwardToDBServer();
+      return RestStatus::DONE;
+    }
+
+    if (type == rest::RequestType::GET) {
+      listShards();
+      return RestStatus::DONE;
+    }
+
     generateError(rest::ResponseCode::NOT_IMPLEMENTED,
                   TRI_ERROR_CLUSTER_UNSUPPORTED,
-                  "'/_api/export' is not yet supported in a cluster");
+                  "'/_api/export' exports single shards in a cluster, use "
+                  "GET /_api/export?collection=<identifier> to list them "
+                  "and pass 'DBserver' to export each of them");
     return RestStatus::DONE;
   }
 
-  // extract the sub-request type
-  auto const type = _request->requestType();
-
   if (type == rest::RequestType::POST) {
     createCursor();
     return RestStatus::DONE;
@@ -269,6 +292,7 @@ void RocksDBRestExportHandler::createCursor() {
 
     _response->setContentType(rest::ContentType::JSON);
     generateResult(rest::ResponseCode::CREATED, builder.slice());
+    compressResponse();
 
     cursors->release(c);
   } catch (...) {
@@ -320,6 +344,7 @@ void RocksDBRestExportHandler::modifyCursor() {
 
     _response->setContentType(rest::ContentType::JSON);
     generateResult(rest::ResponseCode::OK, builder.slice());
+    compressResponse();
 
     cursors->release(cursor);
   } catch (...) {
@@ -361,3 +386,159 @@ void RocksDBRestExportHandler::deleteCursor() {
 
   generateResult(rest::ResponseCode::ACCEPTED, result.slice());
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compresses the response body if the client accepts it
+////////////////////////////////////////////////////////////////////////////////
+
+void RocksDBRestExportHandler::compressResponse() {
+  bool found;
+  std::string const& encoding =
+      _request->header(StaticStrings::AcceptEncoding, found);
+
+  if (!found || encoding.find("deflate") == std::string::npos) {
+    return;
+  }
+
+  HttpResponse* httpResponse = dynamic_cast<HttpResponse*>(_response.get());
+
+  if (httpResponse == nullptr) {
+    // VelocyStream responses are not compressed
+    return;
+  }
+
+  // the body stays uncompressed if this fails
+  httpResponse->deflate();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the shards of a collection with the servers to export
+/// them from
+////////////////////////////////////////////////////////////////////////////////
+
+void RocksDBRestExportHandler::listShards() {
+  std::vector<std::string> const& suffixes = _request->suffixes();
+
+  if (!suffixes.empty()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "expecting GET /_api/export?collection=<identifier>");
+    return;
+  }
+
+  bool found;
+  std::string const& name = _request->value("collection", found);
+
+  if (!found || name.empty()) {
+    generateError(rest::ResponseCode::BAD,
+                  TRI_ERROR_ARANGO_COLLECTION_PARAMETER_MISSING,
+                  "'collection' is missing, expecting "
+                  "/_api/export?collection=<identifier>");
+    return;
+  }
+
+  ClusterInfo* ci = ClusterInfo::instance();
+  std::shared_ptr<LogicalCollection> collection;
+  try {
+    collection = ci->getCollection(_request->databaseName(), name);
+  } catch (...) {
+    generateError(rest::ResponseCode::NOT_FOUND,
+                  TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND);
+    return;
+  }
+  TRI_ASSERT(collection != nullptr);
+
+  VPackBuilder result;
+  result.openObject();
+  result.add("error", VPackValue(false));
+  result.add("code", VPackValue(static_cast<int>(rest::ResponseCode::OK)));
+  result.add("shards", VPackValue(VPackValueType::Object));
+  for (auto const& shard : *collection->shardIds()) {
+    auto servers = ci->getResponsibleServer(shard.first);
+    if (servers->empty()) {
+      generateError(rest::ResponseCode::SERVICE_UNAVAILABLE,
+                    TRI_ERROR_CLUSTER_BACKEND_UNAVAILABLE,
+                    "no responsible server for shard '" + shard.first + "'");
+      return;
+    }
+    result.add(shard.first, VPackValue(servers->at(0)));
+  }
+  result.close();
+  result.close();
+
+  generateResult(rest::ResponseCode::OK, result.slice());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief passes an export request on to the DBServer named in the
+/// "DBserver" parameter and returns its response unchanged
+////////////////////////////////////////////////////////////////////////////////
+
+void RocksDBRestExportHandler::forwardToDBServer() {
+  HttpRequest* httpRequest = dynamic_cast<HttpRequest*>(_request.get());
+  if (httpRequest == nullptr) {
+    generateError(rest::ResponseCode::NOT_IMPLEMENTED,
+                  TRI_ERROR_CLUSTER_UNSUPPORTED,
+                  "exporting shards is only supported via HTTP");
+    return;
+  }
+
+  ServerID const DBserver = _request->value("DBserver");
+  std::string const& dbname = _request->databaseName();
+
+  auto headers = std::make_shared<std::unordered_map<std::string, std::string>>(
+      arangodb::getForwardableRequestHeaders(_request.get()));
+  std::string params;
+
+  for (auto const& i : _request->values()) {
+    if (i.first != "DBserver") {
+      params.push_back(params.empty() ? '?' : '&');
+      params.append(StringUtils::urlEncode(i.first));
+      params.push_back('=');
+      params.append(StringUtils::urlEncode(i.second));
+    }
+  }
+
+  auto cc = ClusterComm::instance();
+  if (cc == nullptr) {
+    // nullptr happens only during controlled shutdown
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_SHUTTING_DOWN,
+                  "shutting down server");
+    return;
+  }
+
+  std::unique_ptr<ClusterCommResult> res = cc->syncRequest(
+      "", TRI_NewTickServer(), "server:" + DBserver, _request->requestType(),
+      "/_db/" + StringUtils::urlEncode(dbname) + _request->requestPath() +
+          params,
+      httpRequest->body(), *headers, 300.0);
+
+  if (res->status == CL_COMM_TIMEOUT) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_CLUSTER_TIMEOUT,
+                  "timeout within cluster");
+    return;
+  }
+  if (res->status == CL_COMM_BACKEND_UNAVAILABLE) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_CLUSTER_CONNECTION_LOST,
+                  "lost connection within cluster");
+    return;
+  }
+  // in case of CL_COMM_ERROR the DBServer reported a proper HTTP error,
+  // which is passed on like a regular response
+  TRI_ASSERT(res->result != nullptr && res->result->isComplete());
+
+  bool dummy;
+  resetResponse(
+      static_cast<rest::ResponseCode>(res->result->getHttpReturnCode()));
+  _response->setContentType(
+      res->result->getHeaderField(StaticStrings::ContentTypeHeader, dummy));
+
+  // a compressed body is passed on as is, together with its
+  // Content-Encoding header
+  HttpResponse* httpResponse = dynamic_cast<HttpResponse*>(_response.get());
+  TRI_ASSERT(httpResponse != nullptr);
+  httpResponse->body().swap(&(res->result->getBody()));
+
+  for (auto const& it : res->result->getHeaderFields()) {
+    _response->setHeader(it.first, it.second);
+  }
+}
@@ -63,6 +63,24 @@ class RocksDBRestExportHandler : public RestVocbaseBaseHandler {
 
   void deleteCursor();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief compress the response body if the client accepts deflate
+  //////////////////////////////////////////////////////////////////////////////
+
+  void compressResponse();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief list the shards of a collection and their leaders (coordinator)
+  //////////////////////////////////////////////////////////////////////////////
+
+  void listShards();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief pass a request on to the DBServer of a shard (coordinator)
+  //////////////////////////////////////////////////////////////////////////////
+
+  void forwardToDBServer();
+
  private:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief restrictions for export
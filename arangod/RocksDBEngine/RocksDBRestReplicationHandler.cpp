@@ -25,6 +25,7 @@
 #include "RocksDBRestReplicationHandler.h"
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/ConditionLocker.h"
+#include "Basics/MemoryArenas.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/VPackStringBufferAdapter.h"
 #include "Basics/VelocyPackHelper.h"
@@ -34,6 +35,7 @@
 #include "Cluster/ClusterFeature.h"
 #include "Cluster/ClusterMethods.h"
 #include "Cluster/FollowerInfo.h"
+#include "Cluster/ServerState.h"
 #include "GeneralServer/GeneralServer.h"
 #include "Indexes/Index.h"
 #include "Logger/Logger.h"
@@ -90,6 +92,9 @@ RocksDBRestReplicationHandler::RocksDBRestReplicationHandler(
 RocksDBRestReplicationHandler::~RocksDBRestReplicationHandler() {}
 
 RestStatus RocksDBRestReplicationHandler::execute() {
+  // account the memory used by replication to its own arena
+  basics::MemoryArenaScope arenaScope(basics::MemoryArena::REPLICATION);
+
   // extract the request type
   auto const type = _request->requestType();
   auto const& suffixes = _request->suffixes();
@@ -1035,9 +1040,25 @@ void RocksDBRestReplicationHandler::handleCommandRestoreData() {
     force = StringUtils::boolean(value3);
   }
 
+  // bulk loads bypass the WAL, so followers would not see the data
+  bool bulkLoad = false;
+  std::string const& value4 = _request->value("bulkLoad");
+
+  if (!value4.empty() && !ServerState::instance()->isRunningInCluster()) {
+    bulkLoad = StringUtils::boolean(value4);
+  }
+
+  if (bulkLoad && !_vocbase->getReplicationClients().empty()) {
+    // the replication clients of the database tail the WAL as well
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "bulk loads are not replicated, but the database has "
+                  "replication clients");
+    return;
+  }
+
   std::string errorMsg;
 
-  int res = processRestoreData(colName, recycleIds, force, errorMsg);
+  int res = processRestoreData(colName, recycleIds, force, bulkLoad, errorMsg);
 
   if (res != TRI_ERROR_NO_ERROR) {
     if (errorMsg.empty()) {
@@ -2808,7 +2829,7 @@ int RocksDBRestReplicationHandler::processRestoreIndexesCoordinator(
 
 int RocksDBRestReplicationHandler::processRestoreDataBatch(
     transaction::Methods& trx, std::string const& collectionName,
-    bool useRevision, bool force, std::string& errorMsg) {
+    bool useRevision, bool force, bool bulkLoad, std::string& errorMsg) {
   std::string const invalidMsg =
       "received invalid JSON data for collection " + collectionName;
 
@@ -2899,6 +2920,11 @@ int RocksDBRestReplicationHandler::processRestoreDataBatch(
     }
   }
 
+  if (bulkLoad && oldBuilder.slice().length() > 0) {
+    errorMsg = "bulk loads cannot remove documents";
+    return TRI_ERROR_NOT_IMPLEMENTED;
+  }
+
   // Note that we ignore individual errors here, as long as the main
   // operation did not fail. In particular, we intentionally ignore
   // individual "DOCUMENT NOT FOUND" errors, because they can happen!
@@ -2994,6 +3020,10 @@ int RocksDBRestReplicationHandler::processRestoreDataBatch(
       itResult.next();
     }
   }
+  if (bulkLoad && replBuilder.slice().length() > 0) {
+    errorMsg = "bulk loads cannot replace documents";
+    return TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED;
+  }
   try {
     OperationOptions options;
     options.silent = true;
@@ -3018,12 +3048,18 @@ int RocksDBRestReplicationHandler::processRestoreDataBatch(
 ////////////////////////////////////////////////////////////////////////////////
 
 int RocksDBRestReplicationHandler::processRestoreData(
-    std::string const& colName, bool useRevision, bool force,
+    std::string const& colName, bool useRevision, bool force, bool bulkLoad,
     std::string& errorMsg) {
+  // the keys written by a bulk load are not locked, so it must not run
+  // concurrently with other writers
   SingleCollectionTransaction trx(
       transaction::StandaloneContext::Create(_vocbase), colName,
-      AccessMode::Type::WRITE);
+      bulkLoad ? AccessMode::Type::EXCLUSIVE : AccessMode::Type::WRITE);
   trx.addHint(transaction::Hints::Hint::RECOVERY);  // to turn off waitForSync!
+  trx.addHint(transaction::Hints::Hint::IMPORT);
+  if (bulkLoad) {
+    trx.addHint(transaction::Hints::Hint::BULK_LOAD);
+  }
 
   Result res = trx.begin();
 
@@ -3034,7 +3070,8 @@ int RocksDBRestReplicationHandler::processRestoreData(
   }
 
   int resCode =
-      processRestoreDataBatch(trx, colName, useRevision, force, errorMsg);
+      processRestoreDataBatch(trx, colName, useRevision, force, bulkLoad,
+                              errorMsg);
   res.reset(resCode, errorMsg);
   res = trx.finish(res);
 
@@ -285,13 +285,13 @@ class RocksDBRestReplicationHandler : public RestVocbaseBaseHandler {
   //////////////////////////////////////////////////////////////////////////////
 
   int processRestoreDataBatch(transaction::Methods&, std::string const&, bool,
-                              bool, std::string&);
+                              bool, bool, std::string&);
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief restores the data of a collection TODO MOVE
   //////////////////////////////////////////////////////////////////////////////
 
-  int processRestoreData(std::string const&, bool, bool, std::string&);
+  int processRestoreData(std::string const&, bool, bool, bool, std::string&);
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief determine chunk size from request
@@ -24,6 +24,7 @@
 #include "RocksDBTransactionState.h"
 #include "Aql/QueryCache.h"
 #include "Basics/Exceptions.h"
+#include "Basics/MemoryArenas.h"
 #include "Cache/CacheManagerFeature.h"
 #include "Cache/Manager.h"
 #include "Cache/Transaction.h"
@@ -36,6 +37,7 @@
 #include "RocksDBEngine/RocksDBLogValue.h"
 #include "RocksDBEngine/RocksDBMethods.h"
 #include "RocksDBEngine/RocksDBTransactionCollection.h"
+#include "RocksDBEngine/RocksDBWalSyncer.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/StorageEngine.h"
 #include "StorageEngine/TransactionCollection.h"
@@ -78,6 +80,9 @@ RocksDBTransactionState::RocksDBTransactionState(
 
 /// @brief free a transaction container
 RocksDBTransactionState::~RocksDBTransactionState() {
+  if (_rocksMethods != nullptr) {
+    _rocksMethods->clearIteratorPool();
+  }
   if (_cacheTx != nullptr) {
     // note: endTransaction() will delete _cacheTrx!
     CacheManagerFeature::MANAGER->endTransaction(_cacheTx);
@@ -155,7 +160,12 @@ Result RocksDBTransactionState::beginTransaction(transaction::Hints hints) {
       } else {
         _rocksReadOptions.snapshot = _rocksTransaction->GetSnapshot();
       }
-      _rocksMethods.reset(new RocksDBTrxMethods(this));
+      if (hasHint(transaction::Hints::Hint::BULK_LOAD)) {
+        // the rocksdb transaction only carries the log markers
+        _rocksMethods.reset(new RocksDBSstFileMethods(this));
+      } else {
+        _rocksMethods.reset(new RocksDBTrxMethods(this));
+      }
     }
 
   } else {
@@ -186,17 +196,41 @@ void RocksDBTransactionState::createTransaction() {
 
 arangodb::Result RocksDBTransactionState::internalCommit() {
   TRI_ASSERT(_rocksTransaction != nullptr);
+  // iterators of the rocksdb transaction must be gone before it commits
+  _rocksMethods->clearIteratorPool();
   
   arangodb::Result result;
-  if (_rocksTransaction->GetNumKeys() > 0) {
+  RocksDBWalSyncer* syncer = nullptr;
+  rocksdb::SequenceNumber latestSeq = 0;
+  bool const bulkLoad = hasHint(transaction::Hints::Hint::BULK_LOAD);
+
+  if (bulkLoad) {
+    // documents and index entries are written to an SST file now, but only
+    // ingested after the transaction has committed. a failed commit leaves
+    // no data behind
+    result = static_cast<RocksDBSstFileMethods*>(_rocksMethods.get())->prepare();
+    if (!result.ok()) {
+      return result;
+    }
+  }
+
+  if (_rocksTransaction->GetNumKeys() > 0 || (bulkLoad && hasOperations())) {
     // set wait for sync flag if required
     if (waitForSync()) {
-      _rocksWriteOptions.sync = true;
-      _rocksTransaction->SetWriteOptions(_rocksWriteOptions);
+      syncer = static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE)
+                   ->walSyncer();
+      if (syncer == nullptr) {
+        _rocksWriteOptions.sync = true;
+        _rocksTransaction->SetWriteOptions(_rocksWriteOptions);
+      }
     }
     
     // double t1 = TRI_microtime();
-    result = rocksutils::convertStatus(_rocksTransaction->Commit());
+    {
+      // memtable inserts happen in the committing thread
+      basics::MemoryArenaScope arenaScope(basics::MemoryArena::ROCKSDB);
+      result = rocksutils::convertStatus(_rocksTransaction->Commit());
+    }
     // double t2 = TRI_microtime();
     // if (t2 - t1 > 0.25) {
     //   LOG_TOPIC(ERR, Logger::FIXME)
@@ -206,8 +240,13 @@ arangodb::Result RocksDBTransactionState::internalCommit() {
     //       << ", NUMREMOVES: " << _numRemoves
     //       << ", TRANSACTIONSIZE: " << _transactionSize;
     // }
-    rocksdb::SequenceNumber latestSeq =
-    rocksutils::globalRocksDB()->GetLatestSequenceNumber();
+    if (result.ok() && bulkLoad) {
+      // only the markers of the transaction are committed so far. if the
+      // data cannot be ingested, it is not counted either
+      result =
+          static_cast<RocksDBSstFileMethods*>(_rocksMethods.get())->ingest();
+    }
+    latestSeq = rocksutils::globalRocksDB()->GetLatestSequenceNumber();
     if (!result.ok()) {
       return result;
     }
@@ -230,6 +269,11 @@ arangodb::Result RocksDBTransactionState::internalCommit() {
                                                                   trxCollection->collection()->getPhysical());
         coll->adjustNumberDocuments(adjustment);
         coll->setRevision(collection->revision());
+        if (collection->numInserts() != 0 &&
+            hasHint(transaction::Hints::Hint::IMPORT)) {
+          // bulk loads may change the selectivity of the indexes
+          coll->trackInserts(collection->numInserts());
+        }
         RocksDBEngine* engine =
         static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE);
         
@@ -243,6 +287,14 @@ arangodb::Result RocksDBTransactionState::internalCommit() {
       // initial documents is adjusted and numInserts / removes is set to 0
       collection->commitCounts();
     }
+
+    if (bulkLoad && result.ok()) {
+      // the ingested data is not in the WAL, so recovery cannot restore
+      // the counters and index estimates for it. persist them right away
+      static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE)
+          ->counterManager()
+          ->sync(true);
+    }
   } else {
     // don't write anything if the transaction is empty
     result = rocksutils::convertStatus(_rocksTransaction->Rollback());
@@ -255,6 +307,12 @@ arangodb::Result RocksDBTransactionState::internalCommit() {
   }
   
   _rocksTransaction.reset();
+
+  if (syncer != nullptr && result.ok()) {
+    // the commit is written to the WAL, but not synced yet. share the sync
+    // with the transactions committing concurrently
+    result = syncer->waitForSync(latestSeq);
+  }
   return result;
 }
 
@@ -295,6 +353,7 @@ Result RocksDBTransactionState::abortTransaction(
 
   if (_nestingLevel == 0) {
     if (_rocksTransaction != nullptr) {
+      _rocksMethods->clearIteratorPool();
       rocksdb::Status status = _rocksTransaction->Rollback();
       result = rocksutils::convertStatus(status);
 
@@ -392,7 +451,7 @@ void RocksDBTransactionState::prepareOperation(
 RocksDBOperationResult RocksDBTransactionState::addOperation(
     TRI_voc_cid_t cid, TRI_voc_rid_t revisionId,
     TRI_voc_document_operation_e operationType, uint64_t operationSize,
-    uint64_t keySize) {
+    uint64_t keySize, StringRef const& key) {
   RocksDBOperationResult res;
 
   size_t currentSize = _rocksTransaction->GetWriteBatch()->GetWriteBatch()->GetDataSize();
@@ -417,12 +476,11 @@ RocksDBOperationResult RocksDBTransactionState::addOperation(
 
   // should not fail or fail with exception
   collection->addOperation(operationType, operationSize, revisionId);
+  collection->addModifiedKey(key);
 
-  // clear the query cache for this collection
-  if (arangodb::aql::QueryCache::instance()->mayBeActive()) {
-    arangodb::aql::QueryCache::instance()->invalidate(
-        _vocbase, collection->collectionName());
-  }
+  // clear the query cache for this document. if no key is given, the
+  // query cache is cleared for the whole collection
+  invalidateQueryCache(collection->collectionName(), key);
 
   switch (operationType) {
     case TRI_VOC_DOCUMENT_OPERATION_UNKNOWN:
@@ -63,6 +63,7 @@ class RocksDBTransactionState final : public TransactionState {
   friend class RocksDBGlobalMethods;
   friend class RocksDBTrxMethods;
   friend class RocksDBBatchedMethods;
+  friend class RocksDBSstFileMethods;
   
  public:
   explicit RocksDBTransactionState(TRI_vocbase_t* vocbase,
@@ -104,7 +105,7 @@ class RocksDBTransactionState final : public TransactionState {
   RocksDBOperationResult addOperation(
       TRI_voc_cid_t collectionId, TRI_voc_rid_t revisionId,
       TRI_voc_document_operation_e operationType, uint64_t operationSize,
-      uint64_t keySize);
+      uint64_t keySize, StringRef const& key = StringRef());
 
   RocksDBMethods* rocksdbMethods();
 
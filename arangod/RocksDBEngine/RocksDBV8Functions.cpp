@@ -162,6 +162,43 @@ static void JS_EstimateCollectionSize(
   TRI_V8_TRY_CATCH_END
 }
 
+/// recalculates the index selectivity estimates of the collection. With a
+/// sample size, at most about that many entries are read per index and the
+/// estimates are only reported, the estimators used by the optimizer keep
+/// their values
+static void JS_RecalculateIndexEstimates(
+    v8::FunctionCallbackInfo<v8::Value> const& args) {
+  TRI_V8_TRY_CATCH_BEGIN(isolate);
+  v8::HandleScope scope(isolate);
+
+  arangodb::LogicalCollection* collection =
+      TRI_UnwrapClass<arangodb::LogicalCollection>(args.Holder(),
+                                                   WRP_VOCBASE_COL_TYPE);
+
+  if (collection == nullptr) {
+    TRI_V8_THROW_EXCEPTION_INTERNAL("cannot extract collection");
+  }
+
+  if (args.Length() > 1) {
+    TRI_V8_THROW_EXCEPTION_USAGE("recalculateIndexEstimates(<sampleSize>)");
+  }
+
+  uint64_t sampleSize = 0;
+  if (args.Length() > 0 && !args[0]->IsUndefined()) {
+    sampleSize = TRI_ObjectToUInt64(args[0], true);
+  }
+
+  RocksDBCollection* physical = toRocksDBCollection(collection);
+  VPackBuilder builder;
+  builder.openArray();
+  physical->recalculateIndexEstimates(sampleSize, builder);
+  builder.close();
+
+  v8::Handle<v8::Value> result = TRI_VPackToV8(isolate, builder.slice());
+  TRI_V8_RETURN(result);
+  TRI_V8_TRY_CATCH_END
+}
+
 void RocksDBV8Functions::registerResources() {
   ISOLATE;
   v8::HandleScope scope(isolate);
@@ -175,6 +212,9 @@ void RocksDBV8Functions::registerResources() {
   
   TRI_AddMethodVocbase(isolate, rt, TRI_V8_ASCII_STRING("recalculateCount"),
                        JS_RecalculateCounts, true);
+  TRI_AddMethodVocbase(isolate, rt,
+                       TRI_V8_ASCII_STRING("recalculateIndexEstimates"),
+                       JS_RecalculateIndexEstimates, true);
   TRI_AddMethodVocbase(isolate, rt, TRI_V8_ASCII_STRING("compact"),
                        JS_CompactCollection);
   TRI_AddMethodVocbase(isolate, rt, TRI_V8_ASCII_STRING("estimatedSize"),
@@ -86,26 +86,17 @@ RocksDBVPackIndexIterator::RocksDBVPackIndexIterator(
     : IndexIterator(collection, trx, mmdr, index),
       _index(index),
       _primaryIndex(primaryIndex),
-      _cmp(index->_cmp),
       _reverse(reverse),
-      _bounds(index->_unique ? RocksDBKeyBounds::UniqueIndexRange(
-                                   index->objectId(), left, right)
-                             : RocksDBKeyBounds::IndexRange(index->objectId(),
-                                                            left, right)) {
-  RocksDBMethods* mthds = rocksutils::toRocksMethods(trx);
-  rocksdb::ReadOptions options = mthds->readOptions();
-  if (!reverse) {
-    // we need to have a pointer to a slice for the upper bound
-    // so we need to assign the slice to an instance variable here
-    _upperBound = _bounds.end();
-    options.iterate_upper_bound = &_upperBound;
-  }
-
-  _iterator = mthds->NewIterator(options);
+      _iterator(rocksutils::toRocksMethods(trx),
+                index->_unique ? RocksDBKeyBounds::UniqueIndexRange(
+                                     index->objectId(), left, right)
+                               : RocksDBKeyBounds::IndexRange(
+                                     index->objectId(), left, right),
+                reverse) {
   if (reverse) {
-    _iterator->SeekForPrev(_bounds.end());
+    _iterator.seekToLast();
   } else {
-    _iterator->Seek(_bounds.start());
+    _iterator.seekToFirst();
   }
 }
 
@@ -114,23 +105,16 @@ void RocksDBVPackIndexIterator::reset() {
   TRI_ASSERT(_trx->state()->isRunning());
 
   if (_reverse) {
-    _iterator->SeekForPrev(_bounds.end());
+    _iterator.seekToLast();
   } else {
-    _iterator->Seek(_bounds.start());
+    _iterator.seekToFirst();
   }
 }
 
-bool RocksDBVPackIndexIterator::outOfRange() const {
-  TRI_ASSERT(_trx->state()->isRunning());
-  TRI_ASSERT(_reverse);
-
-  return (_cmp->Compare(_iterator->key(), _bounds.start()) < 0);
-}
-
 bool RocksDBVPackIndexIterator::next(TokenCallback const& cb, size_t limit) {
   TRI_ASSERT(_trx->state()->isRunning());
 
-  if (limit == 0 || !_iterator->Valid() || (_reverse && outOfRange())) {
+  if (limit == 0 || !_iterator.valid()) {
     // No limit no data, or we are actually done. The last call should have
     // returned false
     TRI_ASSERT(limit > 0);  // Someone called with limit == 0. Api broken
@@ -152,7 +136,7 @@ bool RocksDBVPackIndexIterator::next(TokenCallback const& cb, size_t limit) {
       _iterator->Next();
     }
 
-    if (!_iterator->Valid() || (_reverse && outOfRange())) {
+    if (!_iterator.valid()) {
       return false;
     }
   }
@@ -681,6 +665,19 @@ int RocksDBVPackIndex::removeRaw(RocksDBMethods* writeBatch,
   return TRI_ERROR_NO_ERROR;
 }
 
+int RocksDBVPackIndex::update(transaction::Methods* trx,
+                              TRI_voc_rid_t oldRevisionId,
+                              VPackSlice const& oldDoc,
+                              TRI_voc_rid_t newRevisionId,
+                              VPackSlice const& newDoc) {
+  if (hasSameIndexedValues(oldDoc, newDoc)) {
+    // the index only refers to the document key, so there is nothing to do
+    return TRI_ERROR_NO_ERROR;
+  }
+  return RocksDBIndex::update(trx, oldRevisionId, oldDoc, newRevisionId,
+                              newDoc);
+}
+
 /// @brief called when the index is dropped
 int RocksDBVPackIndex::drop() {
   // First drop the cache all indexes can work without it.
@@ -1026,6 +1023,18 @@ bool RocksDBVPackIndex::supportsFilterCondition(
     values = 1;
   }
 
+  if (attributesCoveredByEquality == _fields.size() && !unique() &&
+      _estimator != nullptr &&
+      isVertexCentric(_fields, _collection->type())) {
+    // edge lookups, e.g. in traversals, are costed by the estimate of the
+    // edge index. a combined index such as one on ["_from", "type"] is
+    // costed the same way, so it wins when it is more selective
+    if (vertexCentricCosts(_estimator->computeEstimate(), _fields.size(),
+                           values, estimatedItems, estimatedCost)) {
+      return true;
+    }
+  }
+
   if (attributesCoveredByEquality == _fields.size() && unique()) {
     // index is unique and condition covers all attributes by equality
     if (estimatedItems >= values) {
@@ -1058,6 +1067,33 @@ bool RocksDBVPackIndex::supportsFilterCondition(
   return false;
 }
 
+bool RocksDBVPackIndex::isVertexCentric(
+    std::vector<std::vector<arangodb::basics::AttributeName>> const& fields,
+    TRI_col_type_e collectionType) {
+  if (collectionType != TRI_COL_TYPE_EDGE || fields.empty() ||
+      fields[0].size() != 1 || fields[0][0].shouldExpand) {
+    return false;
+  }
+  std::string const& name = fields[0][0].name;
+  return name == StaticStrings::FromString || name == StaticStrings::ToString;
+}
+
+bool RocksDBVPackIndex::vertexCentricCosts(double estimate, size_t numFields,
+                                           size_t values,
+                                           size_t& estimatedItems,
+                                           double& estimatedCost) {
+  if (estimate <= 0.0) {
+    return false;
+  }
+  estimatedItems =
+      (std::max)(static_cast<size_t>(1.0 / estimate), static_cast<size_t>(1)) *
+      values;
+  // the more attributes are covered by an index, the more accurate it
+  // is considered to be
+  estimatedCost = static_cast<double>(estimatedItems) - numFields * 0.01;
+  return true;
+}
+
 bool RocksDBVPackIndex::supportsSortCondition(
     arangodb::aql::SortCondition const* sortCondition,
     arangodb::aql::Variable const* reference, size_t itemsInIndex,
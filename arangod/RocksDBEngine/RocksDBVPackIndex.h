@@ -33,6 +33,7 @@
 #include "RocksDBEngine/RocksDBIndex.h"
 #include "RocksDBEngine/RocksDBKey.h"
 #include "RocksDBEngine/RocksDBKeyBounds.h"
+#include "RocksDBEngine/RocksDBMethods.h"
 #include "RocksDBEngine/RocksDBValue.h"
 #include "VocBase/voc-types.h"
 #include "VocBase/vocbase.h"
@@ -88,15 +89,10 @@ class RocksDBVPackIndexIterator final : public IndexIterator {
   void reset() override;
 
  private:
-  bool outOfRange() const;
-
   arangodb::RocksDBVPackIndex const* _index;
   arangodb::RocksDBPrimaryIndex* _primaryIndex;
-  arangodb::RocksDBComparator const* _cmp;
-  std::unique_ptr<rocksdb::Iterator> _iterator;
   bool const _reverse;
-  RocksDBKeyBounds _bounds;
-  rocksdb::Slice _upperBound; // used for iterate_upper_bound
+  RocksDBRangeIterator _iterator;
 };
 
 class RocksDBVPackIndex : public RocksDBIndex {
@@ -147,6 +143,11 @@ class RocksDBVPackIndex : public RocksDBIndex {
   int removeRaw(RocksDBMethods*, TRI_voc_rid_t,
                 arangodb::velocypack::Slice const&) override;
 
+  int update(transaction::Methods*, TRI_voc_rid_t oldRevisionId,
+             arangodb::velocypack::Slice const& oldDoc,
+             TRI_voc_rid_t newRevisionId,
+             arangodb::velocypack::Slice const& newDoc) override;
+
   int drop() override;
 
   /// @brief attempts to locate an entry in the index
@@ -162,6 +163,20 @@ class RocksDBVPackIndex : public RocksDBIndex {
                                arangodb::aql::Variable const*, size_t, size_t&,
                                double&) const override;
 
+  /// @brief whether an index with the given attributes is a vertex-centric
+  /// index, i.e. an index on an edge collection starting with _from or _to
+  static bool isVertexCentric(
+      std::vector<std::vector<arangodb::basics::AttributeName>> const& fields,
+      TRI_col_type_e collectionType);
+
+  /// @brief calculates the costs of an equality lookup on all attributes of
+  /// a vertex-centric index from its selectivity estimate, in the same way
+  /// as the costs of the edge index, so the optimizer can compare the two.
+  /// Returns false if there is no usable estimate
+  static bool vertexCentricCosts(double estimate, size_t numFields,
+                                 size_t values, size_t& estimatedItems,
+                                 double& estimatedCost);
+
   bool supportsSortCondition(arangodb::aql::SortCondition const*,
                              arangodb::aql::Variable const*, size_t, double&,
                              size_t&) const override;
@@ -183,6 +198,14 @@ class RocksDBVPackIndex : public RocksDBIndex {
 
   void recalculateEstimates() override;
 
+  RocksDBCuckooIndexEstimator<uint64_t>* estimator() const override {
+    return _estimator.get();
+  }
+
+  uint64_t estimatorHash(rocksdb::Slice const& key) const override {
+    return HashForKey(key);
+  }
+
 protected:
  Result postprocessRemove(transaction::Methods* trx, rocksdb::Slice const& key,
                           rocksdb::Slice const& value) override;
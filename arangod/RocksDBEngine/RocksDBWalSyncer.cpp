@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBWalSyncer.h"
+#include "Basics/ConditionLocker.h"
+#include "RocksDBEngine/RocksDBCommon.h"
+
+using namespace arangodb;
+
+RocksDBWalSyncer::RocksDBWalSyncer(SyncFunction const& sync,
+                                   SequenceFunction const& latest)
+    : _sync(sync),
+      _latest(latest),
+      _syncing(false),
+      _synced(0),
+      _numberSyncs(0),
+      _numberWaits(0) {}
+
+RocksDBWalSyncer::~RocksDBWalSyncer() {}
+
+Result RocksDBWalSyncer::waitForSync(rocksdb::SequenceNumber seq) {
+  CONDITION_LOCKER(guard, _condition);
+  ++_numberWaits;
+
+  while (_synced < seq) {
+    if (_syncing) {
+      // the running sync may or may not cover us. wait for it and check again
+      guard.wait();
+      continue;
+    }
+
+    // we are the leader of the next sync. everything up to the current
+    // sequence number has been written to the WAL, which includes our commit
+    _syncing = true;
+    rocksdb::SequenceNumber target = _latest();
+    TRI_ASSERT(target >= seq);
+
+    // let other committers queue up while we sync
+    guard.unlock();
+    rocksdb::Status status;
+    try {
+      status = _sync();
+    } catch (...) {
+      guard.lock();
+      _syncing = false;
+      guard.broadcast();
+      throw;
+    }
+    guard.lock();
+
+    _syncing = false;
+    ++_numberSyncs;
+    if (status.ok() && target > _synced) {
+      _synced = target;
+    }
+    guard.broadcast();
+
+    if (!status.ok()) {
+      // the waiters will try again
+      return rocksutils::convertStatus(status);
+    }
+  }
+
+  return Result();
+}
+
+uint64_t RocksDBWalSyncer::numberSyncs() const {
+  CONDITION_LOCKER(guard, _condition);
+  return _numberSyncs;
+}
+
+uint64_t RocksDBWalSyncer::numberWaits() const {
+  CONDITION_LOCKER(guard, _condition);
+  return _numberWaits;
+}
@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ENGINE_ROCKSDB_WAL_SYNCER_H
+#define ARANGOD_ROCKSDB_ENGINE_ROCKSDB_WAL_SYNCER_H 1
+
+#include "Basics/Common.h"
+#include "Basics/ConditionVariable.h"
+#include "Basics/Result.h"
+
+#include <rocksdb/status.h>
+#include <rocksdb/types.h>
+
+namespace arangodb {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief group commit for transactions with waitForSync. such transactions
+/// are committed without syncing, and then wait here until the WAL has been
+/// synced up to their sequence number. the first waiter syncs the WAL for
+/// everyone that committed before it started, committers arriving while a
+/// sync is running are covered by the next sync. so concurrent commits share
+/// one fsync instead of paying for one each
+////////////////////////////////////////////////////////////////////////////////
+
+class RocksDBWalSyncer {
+ public:
+  typedef std::function<rocksdb::Status()> SyncFunction;
+  typedef std::function<rocksdb::SequenceNumber()> SequenceFunction;
+
+  RocksDBWalSyncer(SyncFunction const& sync, SequenceFunction const& latest);
+  ~RocksDBWalSyncer();
+
+  RocksDBWalSyncer(RocksDBWalSyncer const&) = delete;
+  RocksDBWalSyncer& operator=(RocksDBWalSyncer const&) = delete;
+
+ public:
+  /// @brief returns when the WAL is synced up to and including `seq`
+  Result waitForSync(rocksdb::SequenceNumber seq);
+
+  /// @brief number of WAL syncs done
+  uint64_t numberSyncs() const;
+
+  /// @brief number of commits which waited for a sync
+  uint64_t numberWaits() const;
+
+ private:
+  SyncFunction const _sync;
+  SequenceFunction const _latest;
+
+  mutable basics::ConditionVariable _condition;
+  /// @brief whether a sync is in progress
+  bool _syncing;
+  /// @brief the WAL is synced up to this sequence number
+  rocksdb::SequenceNumber _synced;
+
+  uint64_t _numberSyncs;
+  uint64_t _numberWaits;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -25,8 +25,28 @@
 
 using namespace arangodb;
 
+/// @brief maximum number of modified keys tracked per collection. if a
+/// transaction modifies more documents, query cache results for the
+/// collection are invalidated as a whole
+size_t const TransactionCollection::MaxModifiedKeys = 1024;
+
 std::string TransactionCollection::collectionName() const {
   TRI_ASSERT(_collection != nullptr);
   return _collection->name();
 }
 
+/// @brief register the key of a document modified by the transaction
+void TransactionCollection::addModifiedKey(StringRef const& key) {
+  if (_modifiedKeysOverflow) {
+    return;
+  }
+
+  if (key.empty() || _modifiedKeys.size() >= MaxModifiedKeys) {
+    _modifiedKeysOverflow = true;
+    _modifiedKeys.clear();
+    return;
+  }
+
+  _modifiedKeys.emplace_back(key.toString());
+}
+
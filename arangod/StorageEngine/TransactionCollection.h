@@ -25,6 +25,7 @@
 #define ARANGOD_STORAGE_ENGINE_TRANSACTION_COLLECTION_H 1
 
 #include "Basics/Common.h"
+#include "Basics/StringRef.h"
 #include "VocBase/AccessMode.h"
 #include "VocBase/voc-types.h"
                                 
@@ -43,7 +44,10 @@ class TransactionCollection {
   TransactionCollection& operator=(TransactionCollection const&) = delete;
 
   TransactionCollection(TransactionState* trx, TRI_voc_cid_t cid)
-      : _transaction(trx), _cid(cid), _collection(nullptr) {}
+      : _transaction(trx),
+        _cid(cid),
+        _collection(nullptr),
+        _modifiedKeysOverflow(false) {}
   
   virtual ~TransactionCollection() {}
   
@@ -55,6 +59,22 @@ class TransactionCollection {
 
   std::string collectionName() const;
 
+  /// @brief register the key of a document modified by the transaction.
+  /// an empty key means that the collection was modified as a whole
+  void addModifiedKey(StringRef const& key);
+
+  /// @brief keys of the documents modified by the transaction. only
+  /// meaningful if modifiedKeysComplete() returns true
+  std::vector<std::string> const& modifiedKeys() const {
+    return _modifiedKeys;
+  }
+
+  /// @brief whether or not all modifications of the transaction are
+  /// covered by modifiedKeys()
+  bool modifiedKeysComplete() const {
+    return !_modifiedKeysOverflow && !_modifiedKeys.empty();
+  }
+
   /// @brief request a main-level lock for a collection
   virtual int lock() = 0;
  
@@ -85,6 +105,13 @@ class TransactionCollection {
   TransactionState* _transaction;  // the transaction state
   TRI_voc_cid_t const _cid;        // collection id
   LogicalCollection* _collection;  // vocbase collection pointer
+
+ private:
+  /// @brief maximum number of modified keys tracked per collection
+  static size_t const MaxModifiedKeys;
+
+  std::vector<std::string> _modifiedKeys;  // keys of modified documents
+  bool _modifiedKeysOverflow;              // too many keys modified
 };
 
 }
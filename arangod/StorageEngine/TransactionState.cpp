@@ -266,8 +266,17 @@ void TransactionState::clearQueryCache() {
   try {
     std::vector<std::string> collections;
     for (auto& trxCollection : _collections) {
-      if (trxCollection->hasOperations()) {
+      if (!trxCollection->hasOperations()) {
         // we're only interested in collections that may have been modified
+        continue;
+      }
+
+      if (trxCollection->modifiedKeysComplete()) {
+        // only invalidate the results that depend on the modified documents
+        arangodb::aql::QueryCache::instance()->invalidate(
+            _vocbase, trxCollection->collectionName(),
+            trxCollection->modifiedKeys());
+      } else {
         collections.emplace_back(trxCollection->collectionName());
       }
     }
@@ -282,6 +291,23 @@ void TransactionState::clearQueryCache() {
   }
 }
 
+/// @brief clear the query cache for a single modified document
+void TransactionState::invalidateQueryCache(std::string const& collection,
+                                            StringRef const& key) {
+  auto queryCache = arangodb::aql::QueryCache::instance();
+
+  if (!queryCache->mayBeActive()) {
+    return;
+  }
+
+  if (key.empty()) {
+    queryCache->invalidate(_vocbase, collection);
+  } else {
+    queryCache->invalidate(_vocbase, collection,
+                           std::vector<std::string>{key.toString()});
+  }
+}
+
 /// @brief update the status of a transaction
 void TransactionState::updateStatus(transaction::Status status) {
   TRI_ASSERT(_status == transaction::Status::CREATED ||
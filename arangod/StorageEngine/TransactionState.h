@@ -50,6 +50,7 @@ namespace arangodb {
 namespace transaction {
 class Methods;
 }
+class StringRef;
 class TransactionCollection;
 
 /// @brief transaction type
@@ -157,6 +158,11 @@ class TransactionState {
   /// the transaction
   void clearQueryCache();
 
+  /// @brief clear the query cache for a single modified document. an empty
+  /// key clears the query cache for the whole collection
+  void invalidateQueryCache(std::string const& collection,
+                            StringRef const& key);
+
  protected:
   TRI_vocbase_t* _vocbase;            // vocbase
   TRI_voc_tid_t _id;                  // local trx id
@@ -48,7 +48,9 @@ class Hints {
     RECOVERY = 512,
     NO_DLD = 1024, // disable deadlock detection
     INTERMEDIATE_COMMIT = 2048, // allow intermediate commits
-    READ_WRITES = 4096 // do not use snapshot
+    READ_WRITES = 4096, // do not use snapshot
+    BULK_LOAD = 8192, // write data files directly, bypassing the WAL
+    IMPORT = 16384 // bulk import or restore of documents
   };
 
   Hints() : _value(0) {}
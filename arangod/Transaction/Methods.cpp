@@ -137,6 +137,31 @@ static OperationResult emptyResult(bool waitForSync) {
   return OperationResult(resultBuilder.steal(), nullptr, "", TRI_ERROR_NO_ERROR,
                          waitForSync, errorCounter);
 }
+
+/// @brief register the revisions of documents that were applied on a follower
+/// via synchronous replication, so the follower can serve dirty reads
+static void updateAppliedTick(LogicalCollection* collection,
+                              VPackSlice result) {
+  TRI_voc_rid_t tick = 0;
+
+  auto updateOne = [&tick](VPackSlice doc) {
+    if (doc.isObject() && !doc.hasKey(StaticStrings::Error)) {
+      tick = (std::max)(tick, TRI_ExtractRevisionId(doc));
+    }
+  };
+
+  if (result.isArray()) {
+    for (auto const& doc : VPackArrayIterator(result)) {
+      updateOne(doc);
+    }
+  } else {
+    updateOne(result);
+  }
+
+  if (tick > 0) {
+    collection->followers()->updateAppliedTick(tick);
+  }
+}
 }  // namespace
 
 /// @brief Get the field names of the used index
@@ -1061,7 +1086,7 @@ Result transaction::Methods::documentFastPathLocal(
 OperationResult transaction::Methods::clusterResultDocument(
     rest::ResponseCode const& responseCode,
     std::shared_ptr<VPackBuilder> const& resultBody,
-    std::unordered_map<int, size_t> const& errorCounter) const {
+    std::unordered_map<int, size_t> const& errorCounter) {
   switch (responseCode) {
     case rest::ResponseCode::OK:
     case rest::ResponseCode::PRECONDITION_FAILED:
@@ -1208,6 +1233,12 @@ OperationResult transaction::Methods::documentLocal(
   TRI_voc_cid_t cid = addCollectionAtRuntime(collectionName);
   LogicalCollection* collection = documentCollection(trxCollection(cid));
 
+  if (_state->isDBServer() &&
+      !collection->followers()->canServeRead(options.readTick)) {
+    // a dirty read was sent to a follower that is lagging behind
+    return OperationResult(TRI_ERROR_CLUSTER_FOLLOWER_NOT_IN_SYNC);
+  }
+
   if (!options.silent) {
     pinData(cid);  // will throw when it fails
   }
@@ -1418,6 +1449,10 @@ OperationResult transaction::Methods::insertLocal(
     EngineSelectorFeature::ENGINE->waitForSync(maxTick);
   }
 
+  if (res == TRI_ERROR_NO_ERROR && options.isRestore && _state->isDBServer()) {
+    updateAppliedTick(collection, resultBuilder.slice());
+  }
+
   // Now see whether or not we have to do synchronous replication:
   std::shared_ptr<std::vector<ServerID> const> followers;
   bool doingSynchronousReplication = false;
@@ -1729,6 +1764,10 @@ OperationResult transaction::Methods::modifyLocal(
     EngineSelectorFeature::ENGINE->waitForSync(maxTick);
   }
 
+  if (res.ok() && options.isRestore && _state->isDBServer()) {
+    updateAppliedTick(collection, resultBuilder.slice());
+  }
+
   // Now see whether or not we have to do synchronous replication:
   std::shared_ptr<std::vector<ServerID> const> followers;
   bool doingSynchronousReplication = false;
@@ -381,6 +381,12 @@ class Methods {
   /// @brief return the collection name resolver
   CollectionNameResolver const* resolver() const;
 
+  /// @brief Helper create a Cluster Communication document
+  static OperationResult clusterResultDocument(
+      rest::ResponseCode const& responseCode,
+      std::shared_ptr<arangodb::velocypack::Builder> const& resultBody,
+      std::unordered_map<int, size_t> const& errorCounter);
+
  private:
   
   /// @brief build a VPack object with _id, _key and _rev and possibly
@@ -481,12 +487,6 @@ class Methods {
 
  private:
 
-/// @brief Helper create a Cluster Communication document
-  OperationResult clusterResultDocument(
-      rest::ResponseCode const& responseCode,
-      std::shared_ptr<arangodb::velocypack::Builder> const& resultBody,
-      std::unordered_map<int, size_t> const& errorCounter) const;
-
 /// @brief Helper create a Cluster Communication insert
   OperationResult clusterResultInsert(
       rest::ResponseCode const& responseCode,
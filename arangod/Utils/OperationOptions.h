@@ -32,7 +32,8 @@ struct OperationOptions {
   OperationOptions() 
       : recoveryData(nullptr), waitForSync(false), keepNull(true),
         mergeObjects(true), silent(false), ignoreRevs(true),
-        returnOld(false), returnNew(false), isRestore(false) {}
+        returnOld(false), returnNew(false), isRestore(false),
+        allowDirtyReads(false), readTick(0) {}
 
   // original marker, set by an engine's recovery procedure only!
   void* recoveryData;
@@ -61,6 +62,13 @@ struct OperationOptions {
   // for insert operations: use _key value even when this is normally prohibited for the end user
   // this option is there to ensure _key values once set can be restored by replicated and arangorestore
   bool isRestore;
+
+  // for read operations in the cluster: allow reading from in-sync followers
+  bool allowDirtyReads;
+
+  // for read operations in the cluster: a follower must have applied all
+  // writes up to this revision to serve the read. 0 means no restriction
+  uint64_t readTick;
 };
 
 }
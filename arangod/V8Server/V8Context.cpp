@@ -23,6 +23,7 @@
 
 #include "V8Context.h"
 
+#include "Basics/MemoryArenas.h"
 #include "Basics/MutexLocker.h"
 #include "Logger/Logger.h"
 #include "V8/v8-globals.h"
@@ -50,7 +51,8 @@ std::string const GlobalContextMethods::CodeWarmupExports =
 V8Context::V8Context(size_t id)
     : _id(id), _isolate(nullptr), _locker(nullptr), 
       _numExecutions(0), _creationStamp(TRI_microtime()), 
-      _lastGcStamp(0.0), _hasActiveExternals(0) {}
+      _lastGcStamp(0.0), _hasActiveExternals(0),
+      _previousArena(basics::MemoryArenas::NoArena) {}
 
 double V8Context::age() const {
   return TRI_microtime() - _creationStamp;
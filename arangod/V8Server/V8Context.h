@@ -125,6 +125,9 @@ class V8Context {
   double _lastGcStamp;
   bool _hasActiveExternals;
 
+  /// @brief the jemalloc arena of the thread that entered the context
+  unsigned _previousArena;
+
   Mutex _globalMethodsLock;
   std::vector<GlobalContextMethods::MethodType> _globalMethods;
 
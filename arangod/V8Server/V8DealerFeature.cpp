@@ -31,6 +31,7 @@
 #include "Basics/ArangoGlobalContext.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/FileUtils.h"
+#include "Basics/MemoryArenas.h"
 #include "Basics/StringUtils.h"
 #include "Basics/TimedAction.h"
 #include "Basics/WorkMonitor.h"
@@ -523,6 +524,10 @@ void V8DealerFeature::enterContextInternal(TRI_vocbase_t* vocbase,
   TRI_ASSERT(context->_locker == nullptr);
   context->_locker = new v8::Locker(isolate);
 
+  // account memory allocated while running JavaScript to the V8 arena
+  context->_previousArena =
+      basics::MemoryArenas::bindThread(basics::MemoryArena::V8);
+
   isolate->Enter();
   {
     v8::HandleScope scope(isolate);
@@ -825,6 +830,9 @@ void V8DealerFeature::exitContextInternal(V8Context* context) {
 
   isolate->Exit();
 
+  basics::MemoryArenas::restoreThread(context->_previousArena);
+  context->_previousArena = basics::MemoryArenas::NoArena;
+
   delete context->_locker;
   context->_locker = nullptr;
 
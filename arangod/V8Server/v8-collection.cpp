@@ -349,7 +349,7 @@ static void ExistsVocbaseVPack(
     TRI_V8_THROW_EXCEPTION(res);
   }
 
-  v8::Handle<v8::Value> result = TRI_VPackToV8(isolate, opResult.slice(),
+  v8::Handle<v8::Value> result = TRI_VPackToV8Lazy(isolate, opResult.slice(),
       transactionContext->getVPackOptions());
 
   TRI_V8_RETURN(result);
@@ -439,7 +439,7 @@ static void DocumentVocbaseCol(
     TRI_V8_THROW_EXCEPTION(res);
   }
   
-  v8::Handle<v8::Value> result = TRI_VPackToV8(isolate, opResult.slice(),
+  v8::Handle<v8::Value> result = TRI_VPackToV8Lazy(isolate, opResult.slice(),
       transactionContext->getVPackOptions());
   
   TRI_V8_RETURN(result);
@@ -515,7 +515,7 @@ static void DocumentVocbase(
     TRI_V8_THROW_EXCEPTION(res);
   }
 
-  v8::Handle<v8::Value> result = TRI_VPackToV8(isolate, opResult.slice(),
+  v8::Handle<v8::Value> result = TRI_VPackToV8Lazy(isolate, opResult.slice(),
       transactionContext->getVPackOptions());
 
   TRI_V8_RETURN(result);
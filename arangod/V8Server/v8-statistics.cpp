@@ -24,6 +24,7 @@
 #include "v8-statistics.h"
 
 #include "Basics/Exceptions.h"
+#include "Basics/MemoryArenas.h"
 #include "Basics/StringUtils.h"
 #include "Basics/process-utils.h"
 #include "Rest/GeneralRequest.h"
@@ -34,6 +35,10 @@
 #include "V8/v8-conv.h"
 #include "V8/v8-globals.h"
 #include "V8/v8-utils.h"
+#include "V8/v8-vpack.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb;
 using namespace arangodb::basics;
@@ -107,6 +112,12 @@ static void JS_ServerStatistics(
   result->Set(TRI_V8_ASCII_STRING("physicalMemory"),
               v8::Number::New(isolate, (double)TRI_PhysicalMemory));
 
+  // allocator statistics, per subsystem if jemalloc arenas are in use
+  VPackBuilder memory;
+  MemoryArenas::toVelocyPack(memory);
+  result->Set(TRI_V8_ASCII_STRING("memory"),
+              TRI_VPackToV8(isolate, memory.slice()));
+
   TRI_V8_RETURN(result);
   TRI_V8_TRY_CATCH_END
 }
@@ -958,7 +958,11 @@ std::shared_ptr<Index> LogicalCollection::lookupIndex(
 std::shared_ptr<Index> LogicalCollection::createIndex(transaction::Methods* trx,
                                                       VPackSlice const& info,
                                                       bool& created) {
-  return _physical->createIndex(trx, info, created);
+  auto idx = _physical->createIndex(trx, info, created);
+  if (created) {
+    arangodb::aql::PlanCache::instance()->invalidate(_vocbase);
+  }
+  return idx;
 }
 
 /// @brief drops an index, including index file removal and replication
@@ -24,6 +24,7 @@
 
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/FileUtils.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/OpenFilesTracker.h"
 #include "Basics/StringUtils.h"
 #include "Logger/Logger.h"
@@ -36,6 +37,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/property_tree/detail/xml_parser_utils.hpp>
 #include <regex>
+#include <thread>
 
 using namespace arangodb;
 using namespace arangodb::basics;
@@ -53,6 +55,8 @@ ExportFeature::ExportFeature(application_features::ApplicationServer* server,
       _csvFieldOptions(),
       _csvFields(),
       _xgmmlLabelOnly(false),
+      _threads(2),
+      _compressTransfer(false),
       _outputDirectory(),
       _overwrite(false),
       _progress(true),
@@ -99,9 +103,19 @@ void ExportFeature::collectOptions(
                      new BooleanParameter(&_progress));
 
   options->addOption("--fields",
-                     "comma separated list of fileds to export into a csv file",
+                     "comma separated list of fields to export into a csv "
+                     "file, restricts the exported attributes for the other "
+                     "collection export types",
                      new StringParameter(&_csvFieldOptions));
 
+  options->addOption("--threads",
+                     "number of shards of a collection exported in parallel",
+                     new UInt32Parameter(&_threads));
+
+  options->addOption("--compress-transfer",
+                     "compress the data transferred from the server",
+                     new BooleanParameter(&_compressTransfer));
+
   std::unordered_set<std::string> exports = {"csv", "json", "jsonl", "xgmml",
                                              "xml"};
   options->addOption(
@@ -150,15 +164,20 @@ void ExportFeature::validateOptions(
     FATAL_ERROR_EXIT();
   }
 
-  if (_typeExport == "csv") {
-    if (_csvFieldOptions.empty()) {
-      LOG_TOPIC(FATAL, Logger::CONFIG)
-          << "expecting at least one field definition";
-      FATAL_ERROR_EXIT();
-    }
+  if (_typeExport == "csv" && _csvFieldOptions.empty()) {
+    LOG_TOPIC(FATAL, Logger::CONFIG)
+        << "expecting at least one field definition";
+    FATAL_ERROR_EXIT();
+  }
 
+  if (!_csvFieldOptions.empty()) {
     boost::split(_csvFields, _csvFieldOptions, boost::is_any_of(","));
   }
+
+  if (_threads == 0) {
+    LOG_TOPIC(WARN, Logger::CONFIG) << "capping --threads value to 1";
+    _threads = 1;
+  }
 }
 
 void ExportFeature::prepare() {
@@ -209,14 +228,11 @@ void ExportFeature::prepare() {
   }
 }
 
-void ExportFeature::start() {
+std::unique_ptr<SimpleHttpClient> ExportFeature::createHttpClient() {
   ClientFeature* client =
       application_features::ApplicationServer::getFeature<ClientFeature>(
           "Client");
 
-  int ret = EXIT_SUCCESS;
-  *_result = ret;
-
   std::unique_ptr<SimpleHttpClient> httpClient;
 
   try {
@@ -229,6 +245,20 @@ void ExportFeature::start() {
 
   httpClient->setLocationRewriter(static_cast<void*>(client), &rewriteLocation);
   httpClient->setUserNamePassword("/", client->username(), client->password());
+  httpClient->setSupportDeflate(_compressTransfer);
+
+  return httpClient;
+}
+
+void ExportFeature::start() {
+  ClientFeature* client =
+      application_features::ApplicationServer::getFeature<ClientFeature>(
+          "Client");
+
+  int ret = EXIT_SUCCESS;
+  *_result = ret;
+
+  std::unique_ptr<SimpleHttpClient> httpClient = createHttpClient();
 
   // must stay here in order to establish the connection
   httpClient->getServerVersion();
@@ -304,19 +334,7 @@ void ExportFeature::collectionExport(SimpleHttpClient* httpClient) {
       TRI_UnlinkFile(fileName.c_str());
     }
 
-    std::string const url = "_api/cursor";
-
-    VPackBuilder post;
-    post.openObject();
-    post.add("query", VPackValue("FOR doc IN @@collection RETURN doc"));
-    post.add("bindVars", VPackValue(VPackValueType::Object));
-    post.add("@collection", VPackValue(collection));
-    post.close();
-    post.close();
-
-    std::shared_ptr<VPackBuilder> parsedBody =
-        httpCall(httpClient, url, rest::RequestType::POST, post.toJson());
-    VPackSlice body = parsedBody->slice();
+    std::vector<ExportStream> streams = exportStreams(httpClient, collection);
 
     int fd =
         TRI_TRACKED_CREATE_FILE(fileName.c_str(), O_CREAT | O_EXCL | O_RDWR | TRI_O_CLOEXEC,
@@ -357,15 +375,54 @@ void ExportFeature::collectionExport(SimpleHttpClient* httpClient) {
       writeToFile(fd, firstLine, fileName);
     }
 
-    writeCollectionBatch(fd, VPackArrayIterator(body.get("result")), fileName);
+    // every thread takes the next stream until all are done. the first
+    // thread reuses the existing connection
+    size_t const numThreads =
+        (std::min)(static_cast<size_t>(_threads), streams.size());
+    std::vector<std::unique_ptr<SimpleHttpClient>> clients;
+    for (size_t i = 1; i < numThreads; ++i) {
+      clients.emplace_back(createHttpClient());
+    }
 
-    while (body.hasKey("id")) {
-      std::string const url = "/_api/cursor/" + body.get("id").copyString();
-      parsedBody = httpCall(httpClient, url, rest::RequestType::PUT);
-      body = parsedBody->slice();
+    std::atomic<size_t> nextStream(0);
+    Mutex errorLock;
+    std::string error;
 
-      writeCollectionBatch(fd, VPackArrayIterator(body.get("result")),
-                           fileName);
+    auto work = [&](SimpleHttpClient* client) {
+      try {
+        while (true) {
+          size_t i = nextStream++;
+          if (i >= streams.size()) {
+            break;
+          }
+          {
+            MUTEX_LOCKER(locker, errorLock);
+            if (!error.empty()) {
+              break;
+            }
+          }
+          exportStream(client, streams[i], fd, fileName);
+        }
+      } catch (std::exception const& ex) {
+        MUTEX_LOCKER(locker, errorLock);
+        if (error.empty()) {
+          error = ex.what();
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(clients.size());
+    for (auto& client : clients) {
+      threads.emplace_back(work, client.get());
+    }
+    work(httpClient);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    if (!error.empty()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, error);
     }
 
     if (_typeExport == "json") {
@@ -378,33 +435,151 @@ void ExportFeature::collectionExport(SimpleHttpClient* httpClient) {
   }
 }
 
-void ExportFeature::writeCollectionBatch(int fd, VPackArrayIterator it,
-                                         std::string const& fileName) {
-  std::string line;
-  line.reserve(1024);
+std::vector<ExportFeature::ExportStream> ExportFeature::exportStreams(
+    SimpleHttpClient* httpClient, std::string const& collection) {
+  std::vector<ExportStream> streams;
 
+  // a coordinator answers with the shards of the collection and their
+  // leaders, a single server does not support listing
+  std::string const url =
+      "/_api/export?collection=" + StringUtils::urlEncode(collection);
+  std::unique_ptr<SimpleHttpResult> response(
+      httpClient->request(rest::RequestType::GET, url, nullptr, 0));
+  _httpRequestsDone++;
+
+  if (response == nullptr || !response->isComplete()) {
+    std::string errorMsg =
+        "got invalid response from server: " + httpClient->getErrorMessage();
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, errorMsg);
+  }
+
+  int const code = response->getHttpReturnCode();
+
+  if (code == 404) {
+    LOG_TOPIC(FATAL, Logger::CONFIG) << "Collection " << collection
+                                     << " not found.";
+    FATAL_ERROR_EXIT();
+  }
+
+  if (code == 200) {
+    std::shared_ptr<VPackBuilder> parsedBody = response->getBodyVelocyPack();
+    VPackSlice shards = parsedBody->slice().get("shards");
+
+    if (shards.isObject()) {
+      for (auto const& it : VPackObjectIterator(shards)) {
+        streams.emplace_back(
+            ExportStream{it.key.copyString(), it.value.copyString(), false});
+      }
+      if (_progress) {
+        std::cout << "# Exporting " << streams.size() << " shard(s) using "
+                  << (std::min)(static_cast<size_t>(_threads), streams.size())
+                  << " thread(s)" << std::endl;
+      }
+      return streams;
+    }
+  }
+
+  // 405 is returned by a single server offering /_api/export, anything else
+  // means the export API is not available for this collection
+  streams.emplace_back(ExportStream{collection, "", code != 405});
+  return streams;
+}
+
+void ExportFeature::exportStream(SimpleHttpClient* httpClient,
+                                 ExportStream const& stream, int fd,
+                                 std::string const& fileName) {
+  std::string url;
+  std::string suffix;
+  VPackBuilder post;
+
+  if (stream.useCursor) {
+    url = "_api/cursor";
+    post.openObject();
+    if (_csvFields.empty()) {
+      post.add("query", VPackValue("FOR doc IN @@collection RETURN doc"));
+    } else {
+      post.add("query", VPackValue("FOR doc IN @@collection RETURN "
+                                   "KEEP(doc, @fields)"));
+    }
+    post.add("bindVars", VPackValue(VPackValueType::Object));
+    post.add("@collection", VPackValue(stream.collection));
+    if (!_csvFields.empty()) {
+      post.add("fields", VPackValue(VPackValueType::Array));
+      for (auto const& field : _csvFields) {
+        post.add(VPackValue(field));
+      }
+      if (_typeExport == "xml") {
+        post.add(VPackValue("_key"));
+      }
+      post.close();
+    }
+    post.close();
+    post.close();
+  } else {
+    url = "/_api/export?collection=" +
+          StringUtils::urlEncode(stream.collection);
+    if (!stream.server.empty()) {
+      suffix = "?DBserver=" + StringUtils::urlEncode(stream.server);
+      url += "&DBserver=" + StringUtils::urlEncode(stream.server);
+    }
+
+    post.openObject();
+    post.add("batchSize", VPackValue(1000));
+    if (!_csvFields.empty()) {
+      // only transfer the attributes which are written
+      post.add("restrict", VPackValue(VPackValueType::Object));
+      post.add("type", VPackValue("include"));
+      post.add("fields", VPackValue(VPackValueType::Array));
+      for (auto const& field : _csvFields) {
+        post.add(VPackValue(field));
+      }
+      if (_typeExport == "xml") {
+        post.add(VPackValue("_key"));
+      }
+      post.close();
+      post.close();
+    }
+    post.close();
+  }
+
+  std::shared_ptr<VPackBuilder> parsedBody =
+      httpCall(httpClient, url, rest::RequestType::POST, post.toJson());
+  VPackSlice body = parsedBody->slice();
+
+  // format every batch on this thread and only write it under the lock
+  std::string chunk;
+  writeCollectionBatch(chunk, VPackArrayIterator(body.get("result")));
+  writeChunk(fd, chunk, fileName);
+
+  while (body.hasKey("id")) {
+    std::string const url =
+        (stream.useCursor ? "/_api/cursor/" : "/_api/export/") +
+        body.get("id").copyString() + suffix;
+    parsedBody = httpCall(httpClient, url, rest::RequestType::PUT);
+    body = parsedBody->slice();
+
+    chunk.clear();
+    writeCollectionBatch(chunk, VPackArrayIterator(body.get("result")));
+    writeChunk(fd, chunk, fileName);
+  }
+}
+
+void ExportFeature::writeCollectionBatch(std::string& chunk,
+                                         VPackArrayIterator it) {
   if (_typeExport == "jsonl") {
     for (auto const& doc : it) {
-      line.clear();
-      line += doc.toJson();
-      line.push_back('\n');
-      writeToFile(fd, line, fileName);
+      chunk += doc.toJson();
+      chunk.push_back('\n');
     }
   } else if (_typeExport == "json") {
+    // every document is preceded by a separator, writeChunk drops the
+    // first one of the file
     for (auto const& doc : it) {
-      line.clear();
-      if (!_firstLine) {
-        line.append(",\n  ", 4);
-      } else {
-        line.append("\n  ", 3);
-        _firstLine = false;
-      }
-      line += doc.toJson();
-      writeToFile(fd, line, fileName);
+      chunk.append(",\n  ", 4);
+      chunk += doc.toJson();
     }
   } else if (_typeExport == "csv") {
     for (auto const& doc : it) {
-      line.clear();
       bool isFirstValue = true;
 
       for (auto const& key : _csvFields) {
@@ -413,7 +588,7 @@ void ExportFeature::writeCollectionBatch(int fd, VPackArrayIterator it,
         if (isFirstValue) {
           isFirstValue = false;
         } else {
-          line.append(",");
+          chunk.append(",");
         }
 
         if (doc.hasKey(key)) {
@@ -437,28 +612,41 @@ void ExportFeature::writeCollectionBatch(int fd, VPackArrayIterator it,
             value.append("\"");
           }
         }
-        line.append(value);
+        chunk.append(value);
       }
-      line.append("\n");
-      writeToFile(fd, line, fileName);
+      chunk.append("\n");
     }
   } else if (_typeExport == "xml") {
     for (auto const& doc : it) {
-      line.clear();
-      line.append("<doc key=\"");
-      line.append(encode_char_entities(doc.get("_key").copyString()));
-      line.append("\">\n");
-      writeToFile(fd, line, fileName);
+      chunk.append("<doc key=\"");
+      chunk.append(encode_char_entities(doc.get("_key").copyString()));
+      chunk.append("\">\n");
       for (auto const& att : VPackObjectIterator(doc)) {
-        xgmmlWriteOneAtt(fd, fileName, att.value, att.key.copyString(), 2);
+        xgmmlWriteOneAtt(chunk, att.value, att.key.copyString(), 2);
       }
-      line.clear();
-      line.append("</doc>\n");
-      writeToFile(fd, line, fileName);
+      chunk.append("</doc>\n");
     }
   }
 }
 
+void ExportFeature::writeChunk(int fd, std::string const& chunk,
+                               std::string const& fileName) {
+  if (chunk.empty()) {
+    return;
+  }
+
+  MUTEX_LOCKER(locker, _writeLock);
+
+  if (_typeExport == "json" && _firstLine) {
+    // drop the leading comma of the first document
+    _firstLine = false;
+    writeToFile(fd, chunk.substr(1), fileName);
+    return;
+  }
+
+  writeToFile(fd, chunk, fileName);
+}
+
 void ExportFeature::writeToFile(int fd, std::string const& line,
                                 std::string const& fileName) {
   if (!TRI_WritePointer(fd, line.c_str(), line.size())) {
@@ -638,7 +826,7 @@ void ExportFeature::writeGraphBatch(int fd, VPackArrayIterator it,
 
   for (auto const& doc : it) {
     if (doc.hasKey("_from")) {
-      xmlTag =
+      xmlTag +=
           "<edge label=\"" +
           encode_char_entities(doc.hasKey(_xgmmlLabelAttribute) &&
                                        doc.get(_xgmmlLabelAttribute).isString()
@@ -647,55 +835,49 @@ void ExportFeature::writeGraphBatch(int fd, VPackArrayIterator it,
           "\" source=\"" + encode_char_entities(doc.get("_from").copyString()) +
           "\" target=\"" + encode_char_entities(doc.get("_to").copyString()) +
           "\"";
-      writeToFile(fd, xmlTag, fileName);
       if (!_xgmmlLabelOnly) {
-        xmlTag = ">\n";
-        writeToFile(fd, xmlTag, fileName);
+        xmlTag += ">\n";
 
         for (auto const& it : VPackObjectIterator(doc)) {
-          xgmmlWriteOneAtt(fd, fileName, it.value, it.key.copyString());
+          xgmmlWriteOneAtt(xmlTag, it.value, it.key.copyString());
         }
 
-        xmlTag = "</edge>\n";
-        writeToFile(fd, xmlTag, fileName);
+        xmlTag += "</edge>\n";
 
       } else {
-        xmlTag = " />\n";
-        writeToFile(fd, xmlTag, fileName);
+        xmlTag += " />\n";
       }
 
     } else {
-      xmlTag =
+      xmlTag +=
           "<node label=\"" +
           encode_char_entities(doc.hasKey(_xgmmlLabelAttribute) &&
                                        doc.get(_xgmmlLabelAttribute).isString()
                                    ? doc.get(_xgmmlLabelAttribute).copyString()
                                    : "Default-Label") +
           "\" id=\"" + encode_char_entities(doc.get("_id").copyString()) + "\"";
-      writeToFile(fd, xmlTag, fileName);
       if (!_xgmmlLabelOnly) {
-        xmlTag = ">\n";
-        writeToFile(fd, xmlTag, fileName);
+        xmlTag += ">\n";
 
         for (auto const& it : VPackObjectIterator(doc)) {
-          xgmmlWriteOneAtt(fd, fileName, it.value, it.key.copyString());
+          xgmmlWriteOneAtt(xmlTag, it.value, it.key.copyString());
         }
 
-        xmlTag = "</node>\n";
-        writeToFile(fd, xmlTag, fileName);
+        xmlTag += "</node>\n";
 
       } else {
-        xmlTag = " />\n";
-        writeToFile(fd, xmlTag, fileName);
+        xmlTag += " />\n";
       }
     }
   }
+
+  // the whole batch is written at once
+  writeToFile(fd, xmlTag, fileName);
 }
 
-void ExportFeature::xgmmlWriteOneAtt(int fd, std::string const& fileName,
-                                     VPackSlice const& slice,
+void ExportFeature::xgmmlWriteOneAtt(std::string& out, VPackSlice const& slice,
                                      std::string const& name, int deep) {
-  std::string value, type, xmlTag;
+  std::string value, type;
 
   if (deep == 0 && (name == "_id" || name == "_key" || name == "_rev" ||
                     name == "_from" || name == "_to")) {
@@ -720,48 +902,39 @@ void ExportFeature::xgmmlWriteOneAtt(int fd, std::string const& fileName,
 
   } else if (slice.isArray() || slice.isObject()) {
     if (0 < deep) {
-      if (_skippedDeepNested == 0) {
+      if (_skippedDeepNested++ == 0) {
         std::cout << "Warning: skip deep nested objects / arrays" << std::endl;
       }
-      _skippedDeepNested++;
       return;
     }
 
   } else {
-    xmlTag = "  <att name=\"" + encode_char_entities(name) +
-             "\" type=\"string\" value=\"" +
-             encode_char_entities(slice.toString()) + "\"/>\n";
-    writeToFile(fd, xmlTag, fileName);
+    out += "  <att name=\"" + encode_char_entities(name) +
+           "\" type=\"string\" value=\"" +
+           encode_char_entities(slice.toString()) + "\"/>\n";
     return;
   }
 
   if (!type.empty()) {
-    xmlTag = "  <att name=\"" + encode_char_entities(name) + "\" type=\"" +
-             type + "\" value=\"" + encode_char_entities(value) + "\"/>\n";
-    writeToFile(fd, xmlTag, fileName);
+    out += "  <att name=\"" + encode_char_entities(name) + "\" type=\"" +
+           type + "\" value=\"" + encode_char_entities(value) + "\"/>\n";
 
   } else if (slice.isArray()) {
-    xmlTag =
-        "  <att name=\"" + encode_char_entities(name) + "\" type=\"list\">\n";
-    writeToFile(fd, xmlTag, fileName);
+    out += "  <att name=\"" + encode_char_entities(name) + "\" type=\"list\">\n";
 
     for (auto const& val : VPackArrayIterator(slice)) {
-      xgmmlWriteOneAtt(fd, fileName, val, name, deep + 1);
+      xgmmlWriteOneAtt(out, val, name, deep + 1);
     }
 
-    xmlTag = "  </att>\n";
-    writeToFile(fd, xmlTag, fileName);
+    out += "  </att>\n";
 
   } else if (slice.isObject()) {
-    xmlTag =
-        "  <att name=\"" + encode_char_entities(name) + "\" type=\"list\">\n";
-    writeToFile(fd, xmlTag, fileName);
+    out += "  <att name=\"" + encode_char_entities(name) + "\" type=\"list\">\n";
 
     for (auto const& it : VPackObjectIterator(slice)) {
-      xgmmlWriteOneAtt(fd, fileName, it.value, it.key.copyString(), deep + 1);
+      xgmmlWriteOneAtt(out, it.value, it.key.copyString(), deep + 1);
     }
 
-    xmlTag = "  </att>\n";
-    writeToFile(fd, xmlTag, fileName);
+    out += "  </att>\n";
   }
 }
@@ -24,6 +24,7 @@
 #define ARANGODB_EXPORT_EXPORT_FEATURE_H 1
 
 #include "ApplicationFeatures/ApplicationFeature.h"
+#include "Basics/Mutex.h"
 #include "V8Client/ArangoClientHelper.h"
 #include "lib/Rest/CommonDefines.h"
 #include <velocypack/Iterator.h>
@@ -50,12 +51,25 @@ class ExportFeature final : public application_features::ApplicationFeature,
   void start() override final;
 
  private:
+  // a part of a collection which is read by a single thread. in a cluster
+  // this is a shard, read from its leader via the coordinator
+  struct ExportStream {
+    std::string collection;
+    std::string server;
+    // the server does not offer /_api/export, use an AQL cursor instead
+    bool useCursor;
+  };
+
+  std::unique_ptr<httpclient::SimpleHttpClient> createHttpClient();
   void collectionExport(httpclient::SimpleHttpClient* httpClient);
-  void writeCollectionBatch(int fd, VPackArrayIterator it, std::string const& fileName);
+  std::vector<ExportStream> exportStreams(httpclient::SimpleHttpClient* httpClient, std::string const& collection);
+  void exportStream(httpclient::SimpleHttpClient* httpClient, ExportStream const& stream, int fd, std::string const& fileName);
+  void writeCollectionBatch(std::string& chunk, VPackArrayIterator it);
   void graphExport(httpclient::SimpleHttpClient* httpClient);
   void writeGraphBatch(int fd, VPackArrayIterator it, std::string const& fileName);
-  void xgmmlWriteOneAtt(int fd, std::string const& fileName, VPackSlice const& slice, std::string const& name, int deep = 0);
+  void xgmmlWriteOneAtt(std::string& out, VPackSlice const& slice, std::string const& name, int deep = 0);
 
+  void writeChunk(int fd, std::string const& chunk, std::string const& fileName);
   void writeToFile(int fd, std::string const& string, std::string const& fileName);
   std::shared_ptr<VPackBuilder> httpCall(httpclient::SimpleHttpClient* httpClient, std::string const& url, arangodb::rest::RequestType, std::string postBody = "");
 
@@ -67,14 +81,19 @@ class ExportFeature final : public application_features::ApplicationFeature,
   std::string _csvFieldOptions;
   std::vector<std::string> _csvFields;
   bool        _xgmmlLabelOnly;
+  uint32_t _threads;
+  bool _compressTransfer;
 
   std::string _outputDirectory;
   bool _overwrite;
   bool _progress;
 
+  // protects _firstLine and the output file, which are shared by the
+  // threads exporting the shards of a collection
+  Mutex _writeLock;
   bool _firstLine;
-  uint64_t _skippedDeepNested;
-  uint64_t _httpRequestsDone;
+  std::atomic<uint64_t> _skippedDeepNested;
+  std::atomic<uint64_t> _httpRequestsDone;
   std::string _currentCollection;
   std::string _currentGraph;
 
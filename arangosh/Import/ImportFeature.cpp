@@ -58,6 +58,7 @@ ImportFeature::ImportFeature(application_features::ApplicationServer* server,
       _progress(true),
       _onDuplicateAction("error"),
       _rowsToSkip(0),
+      _threads(2),
       _result(result) {
   requiresElevatedPrivileges(false);
   setOptional(false);
@@ -136,6 +137,11 @@ void ImportFeature::collectOptions(
   options->addOption("--progress", "show progress",
                      new BooleanParameter(&_progress));
 
+  options->addOption("--threads",
+                     "number of connections converting and sending data in "
+                     "parallel (csv and tsv only)",
+                     new UInt32Parameter(&_threads));
+
   std::unordered_set<std::string> actions = {"error", "update", "replace",
                                              "ignore"};
   std::vector<std::string> actionsVector(actions.begin(), actions.end());
@@ -176,6 +182,11 @@ void ImportFeature::validateOptions(
     _chunkSize = MaxBatchSize;
   }
 
+  if (_threads == 0) {
+    LOG_TOPIC(WARN, arangodb::Logger::FIXME) << "capping --threads value to 1";
+    _threads = 1;
+  }
+
   for (auto const& it : _translations) {
     auto parts = StringUtils::split(it, "=");
     if (parts.size() != 2) {
@@ -265,6 +276,7 @@ void ImportFeature::start() {
   } 
   if (_typeImport == "csv" || _typeImport == "tsv") {
     std::cout << "separator:              " << _separator << std::endl;
+    std::cout << "threads:                " << _threads << std::endl;
   }
 
   std::cout << "connect timeout:        " << client->connectionTimeout() << std::endl;
@@ -352,6 +364,17 @@ void ImportFeature::start() {
     ih.setProgress(true);
   }
 
+  // additional connections for parallel csv and tsv imports
+  ih.setThreads(_threads, [client]() {
+    std::unique_ptr<SimpleHttpClient> httpClient = client->createHttpClient();
+    httpClient->setLocationRewriter(static_cast<void*>(client),
+                                    &rewriteLocation);
+    httpClient->setUserNamePassword("/", client->username(),
+                                    client->password());
+    httpClient->getServerVersion();
+    return httpClient;
+  });
+
   if (_onDuplicateAction != "error" && _onDuplicateAction != "update" &&
       _onDuplicateAction != "replace" && _onDuplicateAction != "ignore") {
     LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
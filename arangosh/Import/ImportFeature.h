@@ -63,6 +63,7 @@ class ImportFeature final : public application_features::ApplicationFeature,
   bool _progress;
   std::string _onDuplicateAction;
   uint64_t _rowsToSkip;
+  uint32_t _threads;
   
   int* _result;
 };
@@ -24,8 +24,12 @@
 
 #include "ImportHelper.h"
 
+#include "Basics/ConditionLocker.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/OpenFilesTracker.h"
+#include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
+#include "Basics/csv.h"
 #include "Basics/files.h"
 #include "Logger/Logger.h"
 #include "Basics/tri-strings.h"
@@ -39,6 +43,8 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <thread>
+
 using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::httpclient;
@@ -123,6 +129,36 @@ static bool IsDecimal(char const* field, size_t fieldLength) {
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief replaces the position of a document in a batch, which the server
+/// puts in front of its error details, by the input row of the document
+////////////////////////////////////////////////////////////////////////////////
+
+static std::string TranslatePosition(std::string const& detail,
+                                     std::vector<size_t> const& rows) {
+  static std::string const prefix("at position ");
+
+  if (detail.compare(0, prefix.size(), prefix) != 0) {
+    return detail;
+  }
+
+  size_t end = prefix.size();
+  while (end < detail.size() && detail[end] >= '0' && detail[end] <= '9') {
+    ++end;
+  }
+  if (end == prefix.size() || end >= detail.size() || detail[end] != ':') {
+    return detail;
+  }
+
+  uint64_t position =
+      StringUtils::uint64(detail.data() + prefix.size(), end - prefix.size());
+  if (position >= rows.size()) {
+    return detail;
+  }
+
+  return prefix + StringUtils::itoa(rows[position]) + detail.substr(end);
+}
+
 namespace arangodb {
 namespace import {
 
@@ -149,19 +185,21 @@ ImportHelper::ImportHelper(httpclient::SimpleHttpClient* client,
       _overwrite(false),
       _progress(false),
       _firstChunk(true),
+      _threads(1),
       _numberLines(0),
       _numberCreated(0),
       _numberErrors(0),
       _numberUpdated(0),
       _numberIgnored(0),
-      _rowsRead(0),
-      _rowOffset(0),
       _rowsToSkip(0),
       _keyColumn(-1),
+      _csvSeparator(','),
+      _csvQuote('"'),
+      _csvUseQuote(true),
       _onDuplicateAction("error"),
       _collectionName(),
-      _lineBuffer(TRI_UNKNOWN_MEM_ZONE),
-      _outputBuffer(TRI_UNKNOWN_MEM_ZONE) {
+      _outputBuffer(TRI_UNKNOWN_MEM_ZONE),
+      _queueDone(false) {
   _hasError = false;
 }
 
@@ -169,17 +207,24 @@ ImportHelper::~ImportHelper() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief imports a delimited file
+///
+/// the input is cut into blocks of complete rows, which are converted into
+/// arrays of documents and sent to the server by up to `_threads` threads.
+/// the first block is sent before the threads are started, so the target
+/// collection is created and truncated only once
 ////////////////////////////////////////////////////////////////////////////////
 
 bool ImportHelper::importDelimited(std::string const& collectionName,
                                    std::string const& fileName,
                                    DelimitedImportType typeImport) {
   _collectionName = collectionName;
-  _firstLine = "";
   _outputBuffer.clear();
-  _lineBuffer.clear();
   _errorMessage = "";
   _hasError = false;
+  _csvHeader.clear();
+  _keyColumn = -1;
+  _queue.clear();
+  _queueDone = false;
 
   // read and convert
   int fd;
@@ -218,59 +263,152 @@ bool ImportHelper::importDelimited(std::string const& collectionName,
     return false;
   }
 
-  TRI_csv_parser_t parser;
-
-  TRI_InitCsvParser(&parser, TRI_UNKNOWN_MEM_ZONE, ProcessCsvBegin,
-                    ProcessCsvAdd, ProcessCsvEnd, nullptr);
-
-  TRI_SetSeparatorCsvParser(&parser, separator[0]);
-  TRI_UseBackslashCsvParser(&parser, _useBackslash);
+  _csvSeparator = separator[0];
+  TRI_Free(TRI_UNKNOWN_MEM_ZONE, separator);
 
   // in csv, we'll use the quote char if set
   // in tsv, we do not use the quote char
   if (typeImport == ImportHelper::CSV && _quote.size() > 0) {
-    TRI_SetQuoteCsvParser(&parser, _quote[0], true);
+    _csvQuote = _quote[0];
+    _csvUseQuote = true;
   } else {
-    TRI_SetQuoteCsvParser(&parser, '\0', false);
+    _csvQuote = '\0';
+    _csvUseQuote = false;
   }
-  parser._dataAdd = this;
-  _rowOffset = 0;
-  _rowsRead = 0;
 
-  char buffer[32768];
+  std::vector<std::unique_ptr<SimpleHttpClient>> clients;
+  std::vector<std::thread> threads;
 
-  while (!_hasError) {
-    ssize_t n = TRI_READ(fd, buffer, sizeof(buffer));
+  auto startThreads = [&]() {
+    threads.emplace_back(&ImportHelper::csvWorker, this, _client);
 
-    if (n < 0) {
-      TRI_Free(TRI_UNKNOWN_MEM_ZONE, separator);
-      TRI_DestroyCsvParser(&parser);
-      if (fd != STDIN_FILENO) {
-        TRI_TRACKED_CLOSE_FILE(fd);
+    for (size_t i = 1; i < _threads && _clientFactory; ++i) {
+      std::unique_ptr<SimpleHttpClient> client;
+      try {
+        client = _clientFactory();
+      } catch (...) {
       }
-      _errorMessage = TRI_LAST_ERROR_STR;
-      return false;
-    } else if (n == 0) {
-      // we have read the entire file
-      // now have the CSV parser parse an additional new line so it
-      // will definitely process the last line of the input data if
-      // it did not end with a newline
-      TRI_ParseCsvString(&parser, "\n", 1);
-      break;
+
+      if (client == nullptr || !client->isConnected()) {
+        LOG_TOPIC(WARN, arangodb::Logger::FIXME)
+            << "unable to open additional connection, continuing with "
+            << threads.size() << " thread(s)";
+        break;
+      }
+      clients.emplace_back(std::move(client));
+      threads.emplace_back(&ImportHelper::csvWorker, this,
+                           clients.back().get());
     }
+  };
 
-    totalRead += static_cast<int64_t>(n);
-    reportProgress(totalLength, totalRead, nextProgress);
+  std::string pending;
+  size_t row = 0;
+  size_t rowsToSkip = _rowsToSkip;
+  bool headerRead = false;
+  bool eof = false;
+
+  char buffer[32768];
 
-    TRI_ParseCsvString(&parser, buffer, n);
+  try {
+    while (!_hasError) {
+      ssize_t n = TRI_READ(fd, buffer, sizeof(buffer));
+
+      if (n < 0) {
+        setError(TRI_LAST_ERROR_STR);
+        break;
+      } else if (n == 0) {
+        // we have read the entire file
+        eof = true;
+      } else {
+        totalRead += static_cast<int64_t>(n);
+        reportProgress(totalLength, totalRead, nextProgress);
+
+        pending.append(buffer, n);
+      }
+
+      if (!headerRead) {
+        // skip the requested number of rows, then read the header row
+        size_t rows = 0;
+        size_t length = TRI_CompleteRowsCsv(
+            pending.data(), pending.size(), _csvSeparator, _csvQuote,
+            _csvUseQuote, _useBackslash, eof, rowsToSkip, &rows);
+        pending.erase(0, length);
+        rowsToSkip -= rows;
+        row += rows;
+
+        if (rowsToSkip == 0) {
+          rows = 0;
+          length = TRI_CompleteRowsCsv(pending.data(), pending.size(),
+                                       _csvSeparator, _csvQuote, _csvUseQuote,
+                                       _useBackslash, eof, 1, &rows);
+          if (rows > 0) {
+            if (!readCsvHeader(pending.substr(0, length))) {
+              break;
+            }
+            pending.erase(0, length);
+            row += rows;
+            headerRead = true;
+          }
+        }
+
+        if (!headerRead) {
+          if (eof) {
+            break;
+          }
+          continue;
+        }
+      }
+
+      if (pending.size() < _maxUploadSize && !eof) {
+        continue;
+      }
+
+      size_t rows = 0;
+      size_t length = TRI_CompleteRowsCsv(
+          pending.data(), pending.size(), _csvSeparator, _csvQuote,
+          _csvUseQuote, _useBackslash, eof, SIZE_MAX, &rows);
+
+      if (length > 0) {
+        CsvBlock block{pending.substr(0, length), row};
+        pending.erase(0, length);
+        row += rows;
+
+        if (eof && block.data.back() != '\n' && block.data.back() != '\r') {
+          // the parser only reports the last row if it is terminated
+          block.data.push_back('\n');
+        }
+
+        if (_firstChunk) {
+          sendCsvBlock(_client, block);
+        } else {
+          if (threads.empty()) {
+            startThreads();
+          }
+          queueCsvBlock(std::move(block));
+        }
+      }
+
+      if (eof) {
+        break;
+      }
+    }
+  } catch (std::exception const& ex) {
+    setError(ex.what());
+  } catch (...) {
+    setError("caught unknown exception");
   }
 
-  if (_outputBuffer.length() > 0) {
-    sendCsvBuffer();
+  {
+    CONDITION_LOCKER(guard, _queueCondition);
+    _queueDone = true;
+    guard.broadcast();
   }
 
-  TRI_DestroyCsvParser(&parser);
-  TRI_Free(TRI_UNKNOWN_MEM_ZONE, separator);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  _numberLines += row;
 
   if (fd != STDIN_FILENO) {
     TRI_TRACKED_CLOSE_FILE(fd);
@@ -284,7 +422,6 @@ bool ImportHelper::importJson(std::string const& collectionName,
                               std::string const& fileName,
                               bool assumeLinewise) {
   _collectionName = collectionName;
-  _firstLine = "";
   _outputBuffer.clear();
   _errorMessage = "";
   _hasError = false;
@@ -448,83 +585,148 @@ std::string ImportHelper::getCollectionUrlPart() const {
   return std::string("collection=" + StringUtils::urlEncode(_collectionName));
 }
 
+
+namespace {
+
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief start a new csv line
+/// @brief the fields of all rows of a block, as reported by the CSV parser.
+/// the field values point into the parser's buffer, which is not moved
+/// while a block is parsed
 ////////////////////////////////////////////////////////////////////////////////
 
-void ImportHelper::ProcessCsvBegin(TRI_csv_parser_t* parser, size_t row) {
-  static_cast<ImportHelper*>(parser->_dataAdd)->beginLine(row);
-}
-
-void ImportHelper::beginLine(size_t row) {
-  if (_lineBuffer.length() > 0) {
-    // error
-    ++_numberErrors;
-    _lineBuffer.clear();
+struct CsvField {
+  char const* value;
+  size_t length;
+  bool escaped;
+};
+
+struct CsvRows {
+  std::vector<CsvField> fields;
+  // first field and number of each complete row
+  std::vector<std::pair<size_t, size_t>> rows;
+  size_t rowStart = 0;
+  size_t corrupted = 0;
+  bool open = false;
+};
+
+void ProcessCsvBegin(TRI_csv_parser_t* parser, size_t) {
+  auto csvRows = static_cast<CsvRows*>(parser->_dataBegin);
+
+  if (csvRows->open) {
+    // the previous row was not finished
+    ++csvRows->corrupted;
+    csvRows->fields.resize(csvRows->rowStart);
   }
+  csvRows->open = true;
+  csvRows->rowStart = csvRows->fields.size();
+}
 
-  ++_numberLines;
+void ProcessCsvAdd(TRI_csv_parser_t* parser, char const* field,
+                   size_t fieldLength, size_t, size_t, bool escaped) {
+  auto csvRows = static_cast<CsvRows*>(parser->_dataBegin);
+  csvRows->fields.emplace_back(CsvField{field, fieldLength, escaped});
+}
 
-  if (row > 0 + _rowsToSkip) {
-    _lineBuffer.appendChar('\n');
-  }
-  _lineBuffer.appendChar('[');
+void ProcessCsvEnd(TRI_csv_parser_t* parser, char const* field,
+                   size_t fieldLength, size_t row, size_t, bool escaped) {
+  auto csvRows = static_cast<CsvRows*>(parser->_dataBegin);
+  csvRows->fields.emplace_back(CsvField{field, fieldLength, escaped});
+  csvRows->rows.emplace_back(csvRows->rowStart, row);
+  csvRows->open = false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief adds a new CSV field
+/// @brief parses a block of complete rows
 ////////////////////////////////////////////////////////////////////////////////
 
-void ImportHelper::ProcessCsvAdd(TRI_csv_parser_t* parser, char const* field,
-                                 size_t fieldLength, size_t row, size_t column,
-                                 bool escaped) {
-  auto importHelper = static_cast<ImportHelper*>(parser->_dataAdd);
+void ParseCsv(std::string const& data, char separator, char quote,
+              bool useQuote, bool useBackslash, CsvRows& csvRows,
+              TRI_csv_parser_t& parser) {
+  TRI_InitCsvParser(&parser, TRI_UNKNOWN_MEM_ZONE, ProcessCsvBegin,
+                    ProcessCsvAdd, ProcessCsvEnd, nullptr);
+  TRI_SetSeparatorCsvParser(&parser, separator);
+  TRI_UseBackslashCsvParser(&parser, useBackslash);
+  TRI_SetQuoteCsvParser(&parser, quote, useQuote);
+  parser._dataBegin = &csvRows;
 
-  if (importHelper->getRowsRead() < importHelper->getRowsToSkip()) {
-    return;
+  TRI_ParseCsvString(&parser, data.data(), data.size());
+
+  if (csvRows.open) {
+    ++csvRows.corrupted;
+    csvRows.fields.resize(csvRows.rowStart);
+    csvRows.open = false;
   }
-    
-  importHelper->addField(field, fieldLength, row, column, escaped);
 }
 
-void ImportHelper::addField(char const* field, size_t fieldLength, size_t row,
-                            size_t column, bool escaped) {
-  if (column > 0) {
-    _lineBuffer.appendChar(',');
-  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reads the header row, which contains the attribute names
+////////////////////////////////////////////////////////////////////////////////
+
+bool ImportHelper::readCsvHeader(std::string const& row) {
+  CsvRows csvRows;
+  TRI_csv_parser_t parser;
+  ParseCsv(row + "\n", _csvSeparator, _csvQuote, _csvUseQuote, _useBackslash,
+           csvRows, parser);
+
+  if (!csvRows.rows.empty()) {
+    size_t last = (csvRows.rows.size() > 1) ? csvRows.rows[1].first
+                                            : csvRows.fields.size();
+    for (size_t i = csvRows.rows[0].first; i < last; ++i) {
+      std::string name(csvRows.fields[i].value, csvRows.fields[i].length);
+
+      // translate field
+      auto it = _translations.find(name);
+      if (it != _translations.end()) {
+        name = (*it).second;
+      }
 
-  if (row == _rowsToSkip && fieldLength > 0) {
-    // translate field
-    auto it = _translations.find(std::string(field, fieldLength));
-    if (it != _translations.end()) {
-      field = (*it).second.c_str();
-      fieldLength = (*it).second.size();
+      if (_keyColumn == -1 && name == StaticStrings::KeyString) {
+        _keyColumn = static_cast<int64_t>(_csvHeader.size());
+      }
+      _csvHeader.emplace_back(std::move(name));
     }
   }
 
-  if (_keyColumn == -1 && row == _rowsToSkip && fieldLength == 4 && memcmp(field, "_key", 4) == 0) {
-    _keyColumn = column;
+  TRI_DestroyCsvParser(&parser);
+
+  if (_csvHeader.empty() ||
+      (_csvHeader.size() == 1 && _csvHeader[0].empty())) {
+    setError("no attribute names found in first line of input");
+    return false;
   }
+  return true;
+}
 
-  if (row == _rowsToSkip || escaped || _keyColumn == static_cast<decltype(_keyColumn)>(column)) {
-    // head line or escaped value
-    _lineBuffer.appendJsonEncoded(field, fieldLength);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief adds the value of a CSV field
+////////////////////////////////////////////////////////////////////////////////
+
+void ImportHelper::addField(VPackBuilder& builder, char const* field,
+                            size_t fieldLength, size_t column,
+                            bool escaped) const {
+  if (fieldLength == 0 || *field == '\0') {
+    // empty values are left out, as the server does with null values
     return;
   }
 
-  if (*field == '\0' || fieldLength == 0) {
-    // do nothing
-    _lineBuffer.appendText(TRI_CHAR_LENGTH_PAIR("null"));
+  std::string const& name = _csvHeader[column];
+
+  if (escaped || _keyColumn == static_cast<decltype(_keyColumn)>(column)) {
+    // escaped value
+    builder.add(name, VPackValuePair(field, fieldLength, VPackValueType::String));
     return;
   }
 
   // check for literals null, false and true
-  if (fieldLength == 4 &&
-      (memcmp(field, "true", 4) == 0 || memcmp(field, "null", 4) == 0)) {
-    _lineBuffer.appendText(field, fieldLength);
+  if (fieldLength == 4 && memcmp(field, "null", 4) == 0) {
+    return;
+  } else if (fieldLength == 4 && memcmp(field, "true", 4) == 0) {
+    builder.add(name, VPackValue(true));
     return;
   } else if (fieldLength == 5 && memcmp(field, "false", 5) == 0) {
-    _lineBuffer.appendText(field, fieldLength);
+    builder.add(name, VPackValue(false));
     return;
   }
 
@@ -542,10 +744,10 @@ void ImportHelper::addField(char const* field, size_t fieldLength, size_t row,
         }
 
         int64_t num = StringUtils::int64(field, fieldLength);
-        _lineBuffer.appendInteger(num);
+        builder.add(name, VPackValue(num));
+        return;
       } catch (...) {
         // conversion failed
-        _lineBuffer.appendJsonEncoded(field, fieldLength);
       }
     } else if (IsDecimal(field, fieldLength)) {
       // double value
@@ -557,7 +759,7 @@ void ImportHelper::addField(char const* field, size_t fieldLength, size_t row,
         if (pos == fieldLength) {
           bool failed = (num != num || num == HUGE_VAL || num == -HUGE_VAL);
           if (!failed) {
-            _lineBuffer.appendDecimal(num);
+            builder.add(name, VPackValue(num));
             return;
           }
         }
@@ -567,81 +769,130 @@ void ImportHelper::addField(char const* field, size_t fieldLength, size_t row,
         // conversion failed
         // fall-through to appending the number as a string
       }
+    }
+  }
 
-      _lineBuffer.appendChar('"');
-      _lineBuffer.appendText(field, fieldLength);
-      _lineBuffer.appendChar('"');
-    } else {
-      _lineBuffer.appendJsonEncoded(field, fieldLength);
+  // numeric values are not converted without --convert
+  builder.add(name, VPackValuePair(field, fieldLength, VPackValueType::String));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts a block of CSV rows into an array of documents. the row
+/// of each document is added to rows
+////////////////////////////////////////////////////////////////////////////////
+
+void ImportHelper::convertCsvBlock(CsvBlock& block, VPackBuilder& builder,
+                                   std::vector<size_t>& rows) {
+  CsvRows csvRows;
+  TRI_csv_parser_t parser;
+  ParseCsv(block.data, _csvSeparator, _csvQuote, _csvUseQuote, _useBackslash,
+           csvRows, parser);
+
+  size_t errors = csvRows.corrupted;
+
+  builder.openArray();
+  for (size_t i = 0; i < csvRows.rows.size(); ++i) {
+    size_t first = csvRows.rows[i].first;
+    size_t last = (i + 1 < csvRows.rows.size()) ? csvRows.rows[i + 1].first
+                                                : csvRows.fields.size();
+    size_t count = last - first;
+
+    if (count == 1 && *csvRows.fields[first].value == '\0') {
+      // ignore empty line
+      continue;
     }
-  } else {
-    if (IsInteger(field, fieldLength) || IsDecimal(field, fieldLength)) {
-      // numeric value. don't convert
-      _lineBuffer.appendChar('"');
-      _lineBuffer.appendText(field, fieldLength);
-      _lineBuffer.appendChar('"');
-    } else {
-      // non-numeric value
-      _lineBuffer.appendJsonEncoded(field, fieldLength);
+
+    if (count != _csvHeader.size()) {
+      LOG_TOPIC(WARN, arangodb::Logger::FIXME)
+          << "at position " << (block.firstRow + csvRows.rows[i].second)
+          << ": wrong number of values (got " << count << ", expected "
+          << _csvHeader.size() << ")";
+      ++errors;
+      continue;
     }
+
+    builder.openObject();
+    for (size_t column = 0; column < count; ++column) {
+      CsvField const& field = csvRows.fields[first + column];
+      addField(builder, field.value, field.length, column, field.escaped);
+    }
+    builder.close();
+    rows.emplace_back(block.firstRow + csvRows.rows[i].second);
+  }
+  builder.close();
+
+  TRI_DestroyCsvParser(&parser);
+
+  if (errors > 0) {
+    MUTEX_LOCKER(locker, _resultLock);
+    _numberErrors += errors;
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief ends a CSV line
+/// @brief converts a block of CSV rows and sends it to the server
 ////////////////////////////////////////////////////////////////////////////////
 
-void ImportHelper::ProcessCsvEnd(TRI_csv_parser_t* parser, char const* field,
-                                 size_t fieldLength, size_t row, size_t column,
-                                 bool escaped) {
-  auto importHelper = static_cast<ImportHelper*>(parser->_dataAdd);
-  
-  if (importHelper->getRowsRead() < importHelper->getRowsToSkip()) {
-    importHelper->incRowsRead();
-    return;
+void ImportHelper::sendCsvBlock(SimpleHttpClient* client, CsvBlock& block) {
+  VPackBuilder builder;
+  std::vector<size_t> rows;
+  convertCsvBlock(block, builder, rows);
+
+  if (builder.slice().length() > 0) {
+    sendVPackBuffer(client, builder, rows);
   }
-    
-  importHelper->addLastField(field, fieldLength, row, column, escaped);
-  importHelper->incRowsRead();
 }
 
-void ImportHelper::addLastField(char const* field, size_t fieldLength,
-                                size_t row, size_t column, bool escaped) {
-  if (column == 0 && *field == '\0') {
-    // ignore empty line
-    _lineBuffer.reset();
-    return;
+////////////////////////////////////////////////////////////////////////////////
+/// @brief hands a block over to the threads, waiting while too many blocks
+/// are queued already
+////////////////////////////////////////////////////////////////////////////////
+
+void ImportHelper::queueCsvBlock(CsvBlock&& block) {
+  CONDITION_LOCKER(guard, _queueCondition);
+
+  while (_queue.size() >= 2 * _threads && !_hasError) {
+    guard.wait();
   }
 
-  addField(field, fieldLength, row, column, escaped);
+  _queue.emplace_back(std::move(block));
+  guard.broadcast();
+}
 
-  _lineBuffer.appendChar(']');
+////////////////////////////////////////////////////////////////////////////////
+/// @brief thread which converts and sends queued blocks
+////////////////////////////////////////////////////////////////////////////////
 
-  if (row == _rowsToSkip) {
-    // save the first line
-    _firstLine = _lineBuffer.c_str();
-  } else if (row > _rowsToSkip && _firstLine.empty()) {
-    // error
-    ++_numberErrors;
-    _lineBuffer.reset();
-    return;
-  }
+void ImportHelper::csvWorker(SimpleHttpClient* client) {
+  while (true) {
+    CsvBlock block;
+    {
+      CONDITION_LOCKER(guard, _queueCondition);
 
-  // read a complete line
+      while (_queue.empty() && !_queueDone && !_hasError) {
+        guard.wait();
+      }
 
-  if (_lineBuffer.length() > 0) {
-    _outputBuffer.appendText(_lineBuffer);
-    _lineBuffer.reset();
-  } else {
-    ++_numberErrors;
-  }
+      if (_queue.empty() || _hasError) {
+        return;
+      }
 
-  if (_outputBuffer.length() > _maxUploadSize) {
-    sendCsvBuffer();
-    _outputBuffer.appendText(_firstLine);
+      block = std::move(_queue.front());
+      _queue.pop_front();
+      guard.broadcast();
+    }
+
+    try {
+      sendCsvBlock(client, block);
+    } catch (std::exception const& ex) {
+      setError(ex.what());
+    } catch (...) {
+      setError("caught unknown exception");
+    }
   }
 }
 
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief check if we must create the target collection, and create it if
 /// required
@@ -685,18 +936,25 @@ bool ImportHelper::checkCreateCollection() {
   return false;
 }
 
-void ImportHelper::sendCsvBuffer() {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sends an array of documents in VelocyPack format. rows contains
+/// the input row of each document, for the error details of the server
+////////////////////////////////////////////////////////////////////////////////
+
+void ImportHelper::sendVPackBuffer(SimpleHttpClient* client,
+                                   VPackBuilder const& builder,
+                                   std::vector<size_t> const& rows) {
   if (_hasError) {
     return;
   }
-  
+
   if (!checkCreateCollection()) {
     return;
   }
 
-  std::unordered_map<std::string, std::string> headerFields;
-  std::string url("/_api/import?" + getCollectionUrlPart() + "&line=" +
-                  StringUtils::itoa(_rowOffset) + "&details=true&onDuplicate=" +
+  std::string url("/_api/import?" + getCollectionUrlPart() +
+                  "&type=array&details=true&onDuplicate=" +
                   StringUtils::urlEncode(_onDuplicateAction));
 
   if (!_fromCollectionPrefix.empty()) {
@@ -705,20 +963,24 @@ void ImportHelper::sendCsvBuffer() {
   if (!_toCollectionPrefix.empty()) {
     url += "&toPrefix=" + StringUtils::urlEncode(_toCollectionPrefix);
   }
-  if (_firstChunk && _overwrite) {
-    url += "&overwrite=true";
+  if (_firstChunk) {
+    // the threads are only started after the first chunk
+    if (_overwrite) {
+      url += "&overwrite=true";
+    }
+    _firstChunk = false;
   }
 
-  _firstChunk = false;
-
-  std::unique_ptr<SimpleHttpResult> result(_client->request(
-      rest::RequestType::POST, url, _outputBuffer.c_str(),
-      _outputBuffer.length(), headerFields));
+  std::unordered_map<std::string, std::string> headerFields;
+  headerFields.emplace(StaticStrings::ContentTypeHeader,
+                       StaticStrings::MimeTypeVPack);
 
-  handleResult(result.get());
+  VPackSlice const slice = builder.slice();
+  std::unique_ptr<SimpleHttpResult> result(client->request(
+      rest::RequestType::POST, url, slice.startAs<char>(), slice.byteSize(),
+      headerFields));
 
-  _outputBuffer.reset();
-  _rowOffset = _rowsRead;
+  handleResult(result.get(), &rows);
 }
 
 void ImportHelper::sendJsonBuffer(char const* str, size_t len, bool isObject) {
@@ -759,7 +1021,8 @@ void ImportHelper::sendJsonBuffer(char const* str, size_t len, bool isObject) {
   handleResult(result.get());
 }
 
-void ImportHelper::handleResult(SimpleHttpResult* result) {
+void ImportHelper::handleResult(SimpleHttpResult* result,
+                                std::vector<size_t> const* rows) {
   if (result == nullptr) {
     return;
   }
@@ -779,7 +1042,10 @@ void ImportHelper::handleResult(SimpleHttpResult* result) {
   if (details.isArray()) {
     for (VPackSlice const& detail : VPackArrayIterator(details)) {
       if (detail.isString()) {
-        LOG_TOPIC(WARN, arangodb::Logger::FIXME) << "" << detail.copyString();
+        LOG_TOPIC(WARN, arangodb::Logger::FIXME)
+            << "" << (rows == nullptr
+                          ? detail.copyString()
+                          : TranslatePosition(detail.copyString(), *rows));
       }
     }
   }
@@ -787,15 +1053,13 @@ void ImportHelper::handleResult(SimpleHttpResult* result) {
   // get the "error" flag. This returns a pointer, not a copy
   if (arangodb::basics::VelocyPackHelper::getBooleanValue(body, "error",
                                                           false)) {
-    _hasError = true;
-
     // get the error message
     VPackSlice const errorMessage = body.get("errorMessage");
-    if (errorMessage.isString()) {
-      _errorMessage = errorMessage.copyString();
-    }
+    setError(errorMessage.isString() ? errorMessage.copyString() : "");
   }
 
+  MUTEX_LOCKER(locker, _resultLock);
+
   // look up the "created" flag
   _numberCreated += arangodb::basics::VelocyPackHelper::getNumericValue<size_t>(
       body, "created", 0);
@@ -812,5 +1076,22 @@ void ImportHelper::handleResult(SimpleHttpResult* result) {
   _numberIgnored += arangodb::basics::VelocyPackHelper::getNumericValue<size_t>(
       body, "ignored", 0);
 }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief registers an error, which stops the import
+////////////////////////////////////////////////////////////////////////////////
+
+void ImportHelper::setError(std::string const& message) {
+  {
+    MUTEX_LOCKER(locker, _resultLock);
+    if (!_hasError && !message.empty()) {
+      _errorMessage = message;
+    }
+    _hasError = true;
+  }
+
+  // wake up the reader and the threads
+  CONDITION_LOCKER(guard, _queueCondition);
+  guard.broadcast();
+}
 }
 }
@@ -27,9 +27,12 @@
 
 #include "Basics/Common.h"
 
-#include "Basics/csv.h"
+#include "Basics/ConditionVariable.h"
+#include "Basics/Mutex.h"
 #include "Basics/StringBuffer.h"
 
+#include <deque>
+
 #ifdef _WIN32
 #include "Basics/win-utils.h"
 #endif
@@ -39,6 +42,9 @@ namespace httpclient {
 class SimpleHttpClient;
 class SimpleHttpResult;
 }
+namespace velocypack {
+class Builder;
+}
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -56,6 +62,13 @@ class ImportHelper {
 
   enum DelimitedImportType { CSV = 0, TSV };
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief creates an additional connection to the server
+  //////////////////////////////////////////////////////////////////////////////
+
+  typedef std::function<std::unique_ptr<httpclient::SimpleHttpClient>()>
+      ClientFactory;
+
  private:
   ImportHelper(ImportHelper const&) = delete;
   ImportHelper& operator=(ImportHelper const&) = delete;
@@ -174,6 +187,16 @@ class ImportHelper {
 
   void setProgress(bool value) { _progress = value; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set the number of threads which convert and send delimited
+  /// data, each using its own connection created by the factory
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setThreads(size_t threads, ClientFactory const& factory) {
+    _threads = threads;
+    _clientFactory = factory;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief get the number of lines read (meaningful for CSV only)
   //////////////////////////////////////////////////////////////////////////////
@@ -204,18 +227,6 @@ class ImportHelper {
 
   size_t getNumberIgnored() const { return _numberIgnored; }
 
-  //////////////////////////////////////////////////////////////////////////////
-  /// @brief increase the row counter
-  //////////////////////////////////////////////////////////////////////////////
-
-  void incRowsRead() { ++_rowsRead; }
-  
-  //////////////////////////////////////////////////////////////////////////////
-  /// @brief get the number of rows read
-  //////////////////////////////////////////////////////////////////////////////
-  
-  size_t getRowsRead() const { return _rowsRead; }
-
   //////////////////////////////////////////////////////////////////////////////
   /// @brief get the error message
   ///
@@ -225,24 +236,34 @@ class ImportHelper {
   std::string getErrorMessage() { return _errorMessage; }
 
  private:
-  static void ProcessCsvBegin(TRI_csv_parser_t*, size_t);
-  static void ProcessCsvAdd(TRI_csv_parser_t*, char const*, size_t, size_t,
-                            size_t, bool);
-  static void ProcessCsvEnd(TRI_csv_parser_t*, char const*, size_t, size_t,
-                            size_t, bool);
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief complete rows of delimited input, starting at row `firstRow`
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct CsvBlock {
+    std::string data;
+    size_t firstRow;
+  };
 
   void reportProgress(int64_t, int64_t, double&);
 
   std::string getCollectionUrlPart() const;
-  void beginLine(size_t row);
-  void addField(char const*, size_t, size_t row, size_t column, bool escaped);
-  void addLastField(char const*, size_t, size_t row, size_t column,
-                    bool escaped);
+  bool readCsvHeader(std::string const& row);
+  void addField(velocypack::Builder&, char const*, size_t, size_t column,
+                bool escaped) const;
+  void convertCsvBlock(CsvBlock&, velocypack::Builder&,
+                       std::vector<size_t>& rows);
+  void sendCsvBlock(httpclient::SimpleHttpClient*, CsvBlock&);
+  void queueCsvBlock(CsvBlock&&);
+  void csvWorker(httpclient::SimpleHttpClient*);
 
   bool checkCreateCollection();
-  void sendCsvBuffer();
+  void sendVPackBuffer(httpclient::SimpleHttpClient*, velocypack::Builder const&,
+                       std::vector<size_t> const& rows);
   void sendJsonBuffer(char const* str, size_t len, bool isObject);
-  void handleResult(httpclient::SimpleHttpResult* result);
+  void handleResult(httpclient::SimpleHttpResult* result,
+                    std::vector<size_t> const* rows = nullptr);
+  void setError(std::string const& message);
 
  private:
   httpclient::SimpleHttpClient* _client;
@@ -257,6 +278,8 @@ class ImportHelper {
   bool _overwrite;
   bool _progress;
   bool _firstChunk;
+  size_t _threads;
+  ClientFactory _clientFactory;
 
   size_t _numberLines;
   size_t _numberCreated;
@@ -264,23 +287,31 @@ class ImportHelper {
   size_t _numberUpdated;
   size_t _numberIgnored;
 
-  size_t _rowsRead;
-  size_t _rowOffset;
   size_t _rowsToSkip;
 
   int64_t _keyColumn;
+  char _csvSeparator;
+  char _csvQuote;
+  bool _csvUseQuote;
+  std::vector<std::string> _csvHeader;
 
   std::string _onDuplicateAction;
   std::string _collectionName;
   std::string _fromCollectionPrefix;
   std::string _toCollectionPrefix;
-  arangodb::basics::StringBuffer _lineBuffer;
   arangodb::basics::StringBuffer _outputBuffer;
-  std::string _firstLine;
 
   std::unordered_map<std::string, std::string> _translations;
 
-  bool _hasError;
+  // blocks of delimited input waiting for the threads to send them
+  basics::ConditionVariable _queueCondition;
+  std::deque<CsvBlock> _queue;
+  bool _queueDone;
+
+  // protects the counters and the error message, which are updated by the
+  // threads sending delimited input
+  Mutex _resultLock;
+  std::atomic<bool> _hasError;
   std::string _errorMessage;
 
   static double const ProgressStep;
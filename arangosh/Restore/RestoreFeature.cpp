@@ -65,6 +65,7 @@ RestoreFeature::RestoreFeature(application_features::ApplicationServer* server,
       _overwrite(true),
       _recycleIds(false),
       _force(false),
+      _bulkLoad(false),
       _ignoreDistributeShardsLikeErrors(false),
       _clusterMode(false),
       _defaultNumberOfShards(1),
@@ -133,6 +134,13 @@ void RestoreFeature::collectOptions(
   options->addOption(
     "--force", "continue restore even in the face of some server-side errors",
     new BooleanParameter(&_force));
+
+  options->addOption(
+      "--bulk-load",
+      "let the RocksDB engine write the data files directly, bypassing its "
+      "write-ahead log. The data is not replicated (single server without "
+      "replication clients only, documents must not exist yet)",
+      new BooleanParameter(&_bulkLoad));
 }
 
 void RestoreFeature::validateOptions(
@@ -319,7 +327,8 @@ int RestoreFeature::sendRestoreData(std::string const& cname,
   std::string const url = "/_api/replication/restore-data?collection=" +
                           StringUtils::urlEncode(cname) + "&recycleIds=" +
                           (_recycleIds ? "true" : "false") + "&force=" +
-                          (_force ? "true" : "false");
+                          (_force ? "true" : "false") + "&bulkLoad=" +
+                          (_bulkLoad ? "true" : "false");
 
   std::unique_ptr<SimpleHttpResult> response(
       _httpClient->request(rest::RequestType::PUT, url, buffer, bufferSize));
@@ -22,8 +22,12 @@
 
 #include "ApplicationFeatures/JemallocFeature.h"
 
+#include "Basics/ConditionLocker.h"
+#include "Basics/ConditionVariable.h"
 #include "Basics/FileUtils.h"
+#include "Basics/MemoryArenas.h"
 #include "Basics/StringUtils.h"
+#include "Basics/Thread.h"
 #include "Basics/process-utils.h"
 #include "Logger/Logger.h"
 #include "ProgramOptions/ProgramOptions.h"
@@ -38,6 +42,43 @@ using namespace arangodb::options;
 char JemallocFeature::_staticPath[PATH_MAX + 1];
 #endif
 
+#ifdef ARANGODB_HAVE_JEMALLOC
+/// @brief returns unused dirty pages to the operating system periodically
+class arangodb::JemallocPurgeThread final : public Thread {
+ public:
+  explicit JemallocPurgeThread(double interval)
+      : Thread("JemallocPurge"), _interval(interval) {}
+  ~JemallocPurgeThread() { shutdown(); }
+
+ public:
+  void beginShutdown() override {
+    Thread::beginShutdown();
+
+    // wake up the thread that may be waiting in run()
+    CONDITION_LOCKER(guard, _condition);
+    guard.broadcast();
+  }
+
+ protected:
+  void run() override {
+    while (!isStopping()) {
+      {
+        CONDITION_LOCKER(guard, _condition);
+        guard.wait(static_cast<uint64_t>(_interval * 1000000.0));
+      }
+
+      if (!isStopping()) {
+        MemoryArenas::purge();
+      }
+    }
+  }
+
+ private:
+  double const _interval;
+  basics::ConditionVariable _condition;
+};
+#endif
+
 JemallocFeature::JemallocFeature(
     application_features::ApplicationServer* server)
     : ApplicationFeature(server, "Jemalloc"), _defaultPath("./") {
@@ -45,10 +86,25 @@ JemallocFeature::JemallocFeature(
   requiresElevatedPrivileges(false);
 }
 
+JemallocFeature::~JemallocFeature() {}
+
 void JemallocFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
-#if ARANGODB_MMAP_JEMALLOC
+#ifdef ARANGODB_HAVE_JEMALLOC
   options->addSection("vm", "Virtual memory");
 
+  options->addOption("--vm.subsystem-arenas",
+                     "use separate jemalloc arenas for the cache, AQL, "
+                     "RocksDB, V8 and replication, so their memory usage "
+                     "is reported in the statistics",
+                     new BooleanParameter(&_subsystemArenas));
+
+  options->addOption("--vm.purge-interval",
+                     "interval (in seconds) for returning unused memory to "
+                     "the operating system (0 = leave it to jemalloc)",
+                     new DoubleParameter(&_purgeInterval));
+#endif
+
+#if ARANGODB_MMAP_JEMALLOC
   options->addOption("--vm.resident-limit", "resident limit in bytes",
                      new Int64Parameter(&_residentLimit, TRI_PhysicalMemory));
 
@@ -58,6 +114,14 @@ void JemallocFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
 }
 
 void JemallocFeature::validateOptions(std::shared_ptr<ProgramOptions>) {
+#ifdef ARANGODB_HAVE_JEMALLOC
+  if (_purgeInterval < 0.0) {
+    LOG_TOPIC(FATAL, Logger::MEMORY)
+        << "invalid value for '--vm.purge-interval', must not be negative";
+    FATAL_ERROR_EXIT();
+  }
+#endif
+
 #if ARANGODB_MMAP_JEMALLOC
   static int64_t const MIN_LIMIT = 512 * 1024 * 1024;
 
@@ -104,6 +168,14 @@ void JemallocFeature::setDefaultPath(std::string const& path) {
   _defaultPath += TRI_DIR_SEPARATOR_STR;
 }
 
+void JemallocFeature::prepare() {
+#ifdef ARANGODB_HAVE_JEMALLOC
+  if (_subsystemArenas) {
+    MemoryArenas::initialize();
+  }
+#endif
+}
+
 void JemallocFeature::start() {
 #if ARANGODB_MMAP_JEMALLOC
   *_staticPath = '\0';
@@ -147,4 +219,34 @@ void JemallocFeature::start() {
     adb_jemalloc_set_limit(static_cast<uint64_t>(_residentLimit), _staticPath);
   }
 #endif
+
+#ifdef ARANGODB_HAVE_JEMALLOC
+  if (_purgeInterval > 0.0) {
+    _purgeThread.reset(new JemallocPurgeThread(_purgeInterval));
+
+    if (!_purgeThread->start()) {
+      LOG_TOPIC(FATAL, Logger::MEMORY) << "could not start jemalloc purge thread";
+      FATAL_ERROR_EXIT();
+    }
+  }
+#endif
+}
+
+void JemallocFeature::beginShutdown() {
+#ifdef ARANGODB_HAVE_JEMALLOC
+  if (_purgeThread != nullptr) {
+    _purgeThread->beginShutdown();
+  }
+#endif
+}
+
+void JemallocFeature::stop() {
+#ifdef ARANGODB_HAVE_JEMALLOC
+  if (_purgeThread != nullptr) {
+    while (_purgeThread->isRunning()) {
+      usleep(10000);
+    }
+  }
+  _purgeThread.reset();
+#endif
 }
@@ -26,14 +26,20 @@
 #include "ApplicationFeatures/ApplicationFeature.h"
 
 namespace arangodb {
+class JemallocPurgeThread;
+
 class JemallocFeature final : public application_features::ApplicationFeature {
  public:
   explicit JemallocFeature(application_features::ApplicationServer* server);
+  ~JemallocFeature();
 
  public:
   void collectOptions(std::shared_ptr<options::ProgramOptions>) override final;
   void validateOptions(std::shared_ptr<options::ProgramOptions>) override final;
+  void prepare() override final;
   void start() override final;
+  void beginShutdown() override final;
+  void stop() override final;
 
  public:
   void setDefaultPath(std::string const&);
@@ -45,6 +51,12 @@ class JemallocFeature final : public application_features::ApplicationFeature {
 #endif
   std::string _defaultPath;
 
+#ifdef ARANGODB_HAVE_JEMALLOC
+  bool _subsystemArenas = true;
+  double _purgeInterval = 0.0;
+  std::unique_ptr<JemallocPurgeThread> _purgeThread;
+#endif
+
 #if ARANGODB_MMAP_JEMALLOC
   static char _staticPath[PATH_MAX + 1];
 #endif
@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "HyperLogLog.h"
+
+#include "Basics/Exceptions.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <cmath>
+
+using namespace arangodb::basics;
+
+namespace {
+
+/// @brief number of leading zeros of a non-zero value
+static inline uint8_t leadingZeros(uint64_t value) {
+  TRI_ASSERT(value != 0);
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<uint8_t>(__builtin_clzll(value));
+#else
+  uint8_t n = 0;
+  while ((value & (1ULL << 63)) == 0) {
+    value <<= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
+static double alpha(size_t m) {
+  switch (m) {
+    case 16:
+      return 0.673;
+    case 32:
+      return 0.697;
+    case 64:
+      return 0.709;
+    default:
+      return 0.7213 / (1.0 + 1.079 / static_cast<double>(m));
+  }
+}
+
+}
+
+HyperLogLog::HyperLogLog(uint8_t precision) : _precision(precision) {
+  if (precision < MinPrecision || precision > MaxPrecision) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   "invalid HyperLogLog precision");
+  }
+}
+
+void HyperLogLog::clear() {
+  // give the memory back, a cleared sketch is as cheap as a new one
+  std::vector<uint8_t>().swap(_registers);
+}
+
+void HyperLogLog::insert(uint64_t hash) {
+  if (_registers.empty()) {
+    _registers.resize(size_t(1) << _precision, 0);
+  }
+
+  size_t const index = static_cast<size_t>(hash >> (64 - _precision));
+  // the sentinel bit limits the rank to 64 - precision + 1
+  uint64_t const rest = (hash << _precision) | (1ULL << (_precision - 1));
+  uint8_t const rank = leadingZeros(rest) + 1;
+
+  if (rank > _registers[index]) {
+    _registers[index] = rank;
+  }
+}
+
+void HyperLogLog::merge(HyperLogLog const& other) {
+  if (other._precision != _precision) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_BAD_PARAMETER,
+        "cannot merge HyperLogLog sketches with different precisions");
+  }
+  if (other._registers.empty()) {
+    return;
+  }
+  if (_registers.empty()) {
+    _registers = other._registers;
+    return;
+  }
+  for (size_t i = 0; i < _registers.size(); ++i) {
+    if (other._registers[i] > _registers[i]) {
+      _registers[i] = other._registers[i];
+    }
+  }
+}
+
+uint64_t HyperLogLog::estimate() const {
+  if (_registers.empty()) {
+    return 0;
+  }
+
+  size_t const m = _registers.size();
+  double sum = 0.0;
+  size_t zeros = 0;
+  for (uint8_t r : _registers) {
+    sum += std::ldexp(1.0, -static_cast<int>(r));
+    if (r == 0) {
+      ++zeros;
+    }
+  }
+
+  double const dm = static_cast<double>(m);
+  double estimate = alpha(m) * dm * dm / sum;
+
+  if (estimate <= 2.5 * dm && zeros != 0) {
+    // small range correction (linear counting)
+    estimate = dm * std::log(dm / static_cast<double>(zeros));
+  }
+  // no large range correction needed, the hashes have 64 bits
+
+  return static_cast<uint64_t>(std::llround(estimate));
+}
+
+void HyperLogLog::toVelocyPack(VPackBuilder& builder) const {
+  builder.openObject();
+  builder.add("precision", VPackValue(_precision));
+  if (!_registers.empty()) {
+    builder.add("registers",
+                VPackValuePair(_registers.data(), _registers.size(),
+                               VPackValueType::Binary));
+  }
+  builder.close();
+}
+
+HyperLogLog HyperLogLog::fromVelocyPack(VPackSlice const& slice) {
+  if (!slice.isObject()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   "invalid HyperLogLog state");
+  }
+  VPackSlice p = slice.get("precision");
+  if (!p.isNumber()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   "invalid HyperLogLog precision");
+  }
+  HyperLogLog result(p.getNumber<uint8_t>());
+
+  VPackSlice registers = slice.get("registers");
+  if (registers.isBinary()) {
+    VPackValueLength length;
+    uint8_t const* data = registers.getBinary(length);
+    if (length != (VPackValueLength(1) << result._precision)) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                     "invalid HyperLogLog registers");
+    }
+    result._registers.assign(data, data + length);
+  } else if (!registers.isNone()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   "invalid HyperLogLog registers");
+  }
+  return result;
+}
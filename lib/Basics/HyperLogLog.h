@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BASICS_HYPER_LOG_LOG_H
+#define ARANGODB_BASICS_HYPER_LOG_LOG_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+class Slice;
+}
+
+namespace basics {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief HyperLogLog sketch for estimating the number of distinct values in
+/// constant memory. Values are inserted by their 64 bit hash. The sketch
+/// uses 2^precision one-byte registers, which are only allocated once the
+/// first value is inserted, and has a standard error of about
+/// 1.04 / sqrt(2^precision). Sketches with the same precision can be merged
+////////////////////////////////////////////////////////////////////////////////
+
+class HyperLogLog {
+ public:
+  static constexpr uint8_t MinPrecision = 4;
+  static constexpr uint8_t MaxPrecision = 18;
+
+  /// @brief 4096 registers, standard error about 1.6 %
+  static constexpr uint8_t DefaultPrecision = 12;
+
+  explicit HyperLogLog(uint8_t precision = DefaultPrecision);
+
+ public:
+  uint8_t precision() const { return _precision; }
+
+  bool empty() const { return _registers.empty(); }
+
+  void clear();
+
+  void insert(uint64_t hash);
+
+  /// @brief merges another sketch into this one, throws if the precisions
+  /// differ
+  void merge(HyperLogLog const& other);
+
+  /// @brief estimated number of distinct values inserted
+  uint64_t estimate() const;
+
+  /// @brief serializes the sketch as { precision, registers }, with the
+  /// registers as a binary value which is left out for an empty sketch
+  void toVelocyPack(velocypack::Builder& builder) const;
+
+  /// @brief creates a sketch from the output of toVelocyPack(), throws on
+  /// invalid input
+  static HyperLogLog fromVelocyPack(velocypack::Slice const& slice);
+
+ private:
+  uint8_t _precision;
+  std::vector<uint8_t> _registers;
+};
+
+}
+}
+
+#endif
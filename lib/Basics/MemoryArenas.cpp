@@ -0,0 +1,213 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MemoryArenas.h"
+
+#include "Logger/Logger.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#ifdef ARANGODB_HAVE_JEMALLOC
+#include <jemalloc/jemalloc.h>
+#endif
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+namespace {
+static size_t const NumArenas =
+    static_cast<size_t>(MemoryArena::REPLICATION) + 1;
+
+static char const* const ArenaNames[NumArenas] = {"cache", "aql", "rocksdb",
+                                                   "v8", "replication"};
+
+#ifdef ARANGODB_HAVE_JEMALLOC
+static std::atomic<bool> Enabled(false);
+
+/// @brief jemalloc arena indexes of the subsystems
+static unsigned ArenaIndexes[NumArenas];
+
+template <typename T>
+static bool readValue(char const* name, T& value) {
+  size_t size = sizeof(T);
+  return mallctl(name, &value, &size, nullptr, 0) == 0;
+}
+
+template <typename T>
+static bool readArenaValue(unsigned arena, char const* name, T& value) {
+  std::string key("stats.arenas.");
+  key.append(std::to_string(arena));
+  key.push_back('.');
+  key.append(name);
+  return readValue(key.c_str(), value);
+}
+#endif
+}
+
+constexpr unsigned MemoryArenas::NoArena;
+
+void MemoryArenas::initialize() {
+#ifdef ARANGODB_HAVE_JEMALLOC
+  TRI_ASSERT(!Enabled.load());
+
+  for (size_t i = 0; i < NumArenas; ++i) {
+    unsigned index;
+    if (!readValue("arenas.extend", index)) {
+      LOG_TOPIC(WARN, Logger::MEMORY)
+          << "unable to create jemalloc arena for " << ArenaNames[i]
+          << ", memory is not accounted per subsystem";
+      return;
+    }
+    ArenaIndexes[i] = index;
+  }
+  Enabled.store(true);
+
+  LOG_TOPIC(DEBUG, Logger::MEMORY) << "created " << NumArenas
+                                   << " jemalloc arenas for subsystems";
+#endif
+}
+
+bool MemoryArenas::enabled() {
+#ifdef ARANGODB_HAVE_JEMALLOC
+  return Enabled.load(std::memory_order_relaxed);
+#else
+  return false;
+#endif
+}
+
+char const* MemoryArenas::name(MemoryArena arena) {
+  return ArenaNames[static_cast<size_t>(arena)];
+}
+
+void* MemoryArenas::allocate(MemoryArena arena, size_t size) {
+  void* ptr;
+#ifdef ARANGODB_HAVE_JEMALLOC
+  if (enabled()) {
+    unsigned index = ArenaIndexes[static_cast<size_t>(arena)];
+    ptr = mallocx((std::max)(size, size_t(1)),
+                  MALLOCX_ARENA(index) | MALLOCX_TCACHE_NONE);
+  } else {
+    ptr = malloc(size);
+  }
+#else
+  ptr = malloc(size);
+#endif
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void MemoryArenas::deallocate(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+#ifdef ARANGODB_HAVE_JEMALLOC
+  // jemalloc finds the arena of every pointer it handed out, so this also
+  // works for memory allocated before the arenas were enabled
+  dallocx(ptr, MALLOCX_TCACHE_NONE);
+#else
+  free(ptr);
+#endif
+}
+
+unsigned MemoryArenas::bindThread(MemoryArena arena) {
+#ifdef ARANGODB_HAVE_JEMALLOC
+  if (enabled()) {
+    unsigned index = ArenaIndexes[static_cast<size_t>(arena)];
+    unsigned previous;
+    size_t size = sizeof(previous);
+    if (mallctl("thread.arena", &previous, &size, &index, sizeof(index)) ==
+            0 &&
+        previous != index) {
+      return previous;
+    }
+  }
+#endif
+  return NoArena;
+}
+
+void MemoryArenas::restoreThread(unsigned previous) {
+#ifdef ARANGODB_HAVE_JEMALLOC
+  if (previous != NoArena) {
+    mallctl("thread.arena", nullptr, nullptr, &previous, sizeof(previous));
+  }
+#endif
+}
+
+void MemoryArenas::purge() {
+#ifdef ARANGODB_HAVE_JEMALLOC
+  // arena.<narenas>.purge purges all arenas
+  unsigned narenas;
+  if (readValue("arenas.narenas", narenas)) {
+    std::string key("arena.");
+    key.append(std::to_string(narenas));
+    key.append(".purge");
+    mallctl(key.c_str(), nullptr, nullptr, nullptr, 0);
+  }
+#endif
+}
+
+void MemoryArenas::toVelocyPack(VPackBuilder& builder) {
+  builder.openObject();
+#ifdef ARANGODB_HAVE_JEMALLOC
+  // refresh the statistics
+  uint64_t epoch = 1;
+  size_t size = sizeof(epoch);
+  mallctl("epoch", &epoch, &size, &epoch, size);
+
+  size_t value;
+  for (char const* name : {"allocated", "active", "resident", "mapped"}) {
+    std::string key("stats.");
+    key.append(name);
+    if (readValue(key.c_str(), value)) {
+      builder.add(name, VPackValue(static_cast<uint64_t>(value)));
+    }
+  }
+
+  size_t page;
+  if (enabled() && readValue("arenas.page", page)) {
+    builder.add("arenas", VPackValue(VPackValueType::Object));
+    for (size_t i = 0; i < NumArenas; ++i) {
+      unsigned index = ArenaIndexes[i];
+      size_t small = 0, large = 0, huge = 0, active = 0, dirty = 0;
+      if (!readArenaValue(index, "small.allocated", small) ||
+          !readArenaValue(index, "large.allocated", large) ||
+          !readArenaValue(index, "huge.allocated", huge) ||
+          !readArenaValue(index, "pactive", active) ||
+          !readArenaValue(index, "pdirty", dirty)) {
+        // jemalloc was built without statistics
+        break;
+      }
+      builder.add(ArenaNames[i], VPackValue(VPackValueType::Object));
+      builder.add("allocated",
+                  VPackValue(static_cast<uint64_t>(small + large + huge)));
+      builder.add("resident",
+                  VPackValue(static_cast<uint64_t>((active + dirty) * page)));
+      builder.close();
+    }
+    builder.close();
+  }
+#endif
+  builder.close();
+}
@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BASICS_MEMORY_ARENAS_H
+#define ARANGODB_BASICS_MEMORY_ARENAS_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
+namespace basics {
+
+/// @brief subsystems which get a jemalloc arena of their own
+enum class MemoryArena : uint8_t { CACHE = 0, AQL, ROCKSDB, V8, REPLICATION };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief jemalloc arenas for the major subsystems, so their memory usage
+/// can be told apart in the statistics. Memory is attributed to an arena
+/// either by allocating from it explicitly, or by binding the allocating
+/// thread to it for a while. Thread caches are not flushed when the binding
+/// changes, so the attribution of small allocations is approximate.
+/// Without jemalloc, or before initialize() has been called, all functions
+/// fall back to the default allocator and no statistics are reported
+////////////////////////////////////////////////////////////////////////////////
+
+class MemoryArenas {
+ public:
+  /// @brief returned by bindThread() if the thread was not rebound
+  static constexpr unsigned NoArena = UINT32_MAX;
+
+  /// @brief deleter for memory obtained from allocate()
+  struct Deleter {
+    void operator()(void* ptr) const { MemoryArenas::deallocate(ptr); }
+  };
+
+ public:
+  /// @brief creates the arenas, must be called once at startup before any
+  /// other thread uses them
+  static void initialize();
+
+  static bool enabled();
+
+  static char const* name(MemoryArena);
+
+  /// @brief allocates from the arena of a subsystem, bypassing the thread
+  /// cache. throws std::bad_alloc if out of memory
+  static void* allocate(MemoryArena, size_t size);
+
+  /// @brief frees memory obtained from allocate()
+  static void deallocate(void* ptr);
+
+  /// @brief binds the calling thread to the arena of a subsystem. Returns
+  /// the arena the thread used before, or NoArena if nothing was changed
+  static unsigned bindThread(MemoryArena);
+
+  /// @brief undoes bindThread()
+  static void restoreThread(unsigned previous);
+
+  /// @brief returns unused dirty pages of all arenas to the operating system
+  static void purge();
+
+  /// @brief adds the total allocator statistics and the allocated and
+  /// resident bytes per subsystem arena as an object
+  static void toVelocyPack(velocypack::Builder&);
+};
+
+/// @brief binds the current thread to the arena of a subsystem while in scope
+class MemoryArenaScope {
+ public:
+  explicit MemoryArenaScope(MemoryArena arena)
+      : _previous(MemoryArenas::bindThread(arena)) {}
+
+  ~MemoryArenaScope() { MemoryArenas::restoreThread(_previous); }
+
+  MemoryArenaScope(MemoryArenaScope const&) = delete;
+  MemoryArenaScope& operator=(MemoryArenaScope const&) = delete;
+
+ private:
+  unsigned const _previous;
+};
+
+}
+}
+
+#endif
@@ -75,6 +75,8 @@ std::string const StaticStrings::AccessControlMaxAge("access-control-max-age");
 std::string const StaticStrings::AccessControlRequestHeaders(
     "access-control-request-headers");
 std::string const StaticStrings::Allow("allow");
+std::string const StaticStrings::AllowDirtyReadHeader(
+    "x-arango-allow-dirty-read");
 std::string const StaticStrings::Async("x-arango-async");
 std::string const StaticStrings::AsyncId("x-arango-async-id");
 std::string const StaticStrings::Authorization("authorization");
@@ -107,6 +109,7 @@ std::string const StaticStrings::MultiPartContentType("multipart/form-data");
 std::string const StaticStrings::NoSniff("nosniff");
 std::string const StaticStrings::Origin("origin");
 std::string const StaticStrings::Queue("x-arango-queue");
+std::string const StaticStrings::ReadTickHeader("x-arango-read-tick");
 std::string const StaticStrings::Server("server");
 std::string const StaticStrings::StartThread("x-arango-start-thread");
 std::string const StaticStrings::WwwAuthenticate("www-authenticate");
@@ -75,6 +75,7 @@ class StaticStrings {
   static std::string const AccessControlMaxAge;
   static std::string const AccessControlRequestHeaders;
   static std::string const Allow;
+  static std::string const AllowDirtyReadHeader;
   static std::string const Async;
   static std::string const AsyncId;
   static std::string const Authorization;
@@ -103,6 +104,7 @@ class StaticStrings {
   static std::string const NoSniff;
   static std::string const Origin;
   static std::string const Queue;
+  static std::string const ReadTickHeader;
   static std::string const Server;
   static std::string const StartThread;
   static std::string const WwwAuthenticate;
@@ -0,0 +1,247 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "TDigest.h"
+
+#include "Basics/Exceptions.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <cmath>
+
+using namespace arangodb::basics;
+
+namespace {
+
+static double const Pi = 3.14159265358979323846;
+
+/// @brief the k1 scale function, maps a quantile to [-compression / 4,
+/// compression / 4]. Adjacent centroids may be merged as long as they span
+/// less than one unit of k
+static inline double kOfQ(double q, double compression) {
+  return compression / (2.0 * Pi) * std::asin(2.0 * q - 1.0);
+}
+
+static inline double qOfK(double k, double compression) {
+  if (k >= compression / 4.0) {
+    return 1.0;
+  }
+  return (std::sin(k * 2.0 * Pi / compression) + 1.0) / 2.0;
+}
+
+}
+
+TDigest::TDigest(double compression)
+    : _compression(compression), _count(0), _min(0.0), _max(0.0) {
+  if (!(compression >= 10.0 && compression <= 10000.0)) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   "invalid t-digest compression");
+  }
+}
+
+size_t TDigest::bufferSize() const {
+  return static_cast<size_t>(_compression) * 5;
+}
+
+void TDigest::clear() {
+  _count = 0;
+  _min = 0.0;
+  _max = 0.0;
+  _centroids.clear();
+  _buffer.clear();
+}
+
+void TDigest::insert(double value) {
+  TRI_ASSERT(std::isfinite(value));
+  if (_count == 0 || value < _min) {
+    _min = value;
+  }
+  if (_count == 0 || value > _max) {
+    _max = value;
+  }
+  ++_count;
+  _buffer.emplace_back(value, 1.0);
+  if (_buffer.size() >= bufferSize()) {
+    compress();
+  }
+}
+
+void TDigest::merge(TDigest const& other) {
+  if (other._count == 0) {
+    return;
+  }
+  other.compress();
+  if (_count == 0 || other._min < _min) {
+    _min = other._min;
+  }
+  if (_count == 0 || other._max > _max) {
+    _max = other._max;
+  }
+  _count += other._count;
+  _buffer.insert(_buffer.end(), other._centroids.begin(),
+                 other._centroids.end());
+  compress();
+}
+
+void TDigest::compress() const {
+  if (_buffer.empty()) {
+    return;
+  }
+
+  _buffer.insert(_buffer.end(), _centroids.begin(), _centroids.end());
+  std::sort(_buffer.begin(), _buffer.end(),
+            [](Centroid const& a, Centroid const& b) { return a.mean < b.mean; });
+
+  double total = 0.0;
+  for (auto const& c : _buffer) {
+    total += c.weight;
+  }
+
+  _centroids.clear();
+  Centroid current = _buffer[0];
+  double weightSoFar = 0.0;
+  double limit = total * qOfK(kOfQ(0.0, _compression) + 1.0, _compression);
+
+  for (size_t i = 1; i < _buffer.size(); ++i) {
+    Centroid const& next = _buffer[i];
+    if (weightSoFar + current.weight + next.weight <= limit) {
+      double const weight = current.weight + next.weight;
+      current.mean += (next.mean - current.mean) * next.weight / weight;
+      current.weight = weight;
+    } else {
+      weightSoFar += current.weight;
+      _centroids.push_back(current);
+      limit = total * qOfK(kOfQ(weightSoFar / total, _compression) + 1.0,
+                           _compression);
+      current = next;
+    }
+  }
+  _centroids.push_back(current);
+  _buffer.clear();
+}
+
+double TDigest::quantile(double q) const {
+  TRI_ASSERT(_count > 0);
+  TRI_ASSERT(q >= 0.0 && q <= 1.0);
+
+  compress();
+  TRI_ASSERT(!_centroids.empty());
+
+  if (_centroids.size() == 1) {
+    return _centroids[0].mean;
+  }
+
+  double const total = static_cast<double>(_count);
+  double const index = q * total;
+
+  // the outermost half centroids are interpolated towards min and max
+  Centroid const& first = _centroids.front();
+  if (index < first.weight / 2.0) {
+    return _min + (first.mean - _min) * index / (first.weight / 2.0);
+  }
+  Centroid const& last = _centroids.back();
+  if (index > total - last.weight / 2.0) {
+    return _max -
+           (_max - last.mean) * (total - index) / (last.weight / 2.0);
+  }
+
+  double weightSoFar = first.weight / 2.0;
+  for (size_t i = 0; i + 1 < _centroids.size(); ++i) {
+    Centroid const& left = _centroids[i];
+    Centroid const& right = _centroids[i + 1];
+    double const delta = (left.weight + right.weight) / 2.0;
+    if (weightSoFar + delta > index) {
+      double const t = (index - weightSoFar) / delta;
+      return left.mean + t * (right.mean - left.mean);
+    }
+    weightSoFar += delta;
+  }
+  return last.mean;
+}
+
+void TDigest::toVelocyPack(VPackBuilder& builder) const {
+  compress();
+
+  builder.openObject();
+  builder.add("compression", VPackValue(_compression));
+  if (_count > 0) {
+    builder.add("min", VPackValue(_min));
+    builder.add("max", VPackValue(_max));
+  }
+  builder.add("centroids", VPackValue(VPackValueType::Array));
+  for (auto const& c : _centroids) {
+    builder.add(VPackValue(c.mean));
+    builder.add(VPackValue(c.weight));
+  }
+  builder.close();
+  builder.close();
+}
+
+TDigest TDigest::fromVelocyPack(VPackSlice const& slice) {
+  if (!slice.isObject()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   "invalid t-digest state");
+  }
+  VPackSlice compression = slice.get("compression");
+  VPackSlice centroids = slice.get("centroids");
+  if (!compression.isNumber() || !centroids.isArray() ||
+      centroids.length() % 2 != 0) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   "invalid t-digest state");
+  }
+
+  TDigest result(compression.getNumber<double>());
+  if (centroids.length() == 0) {
+    return result;
+  }
+
+  VPackSlice min = slice.get("min");
+  VPackSlice max = slice.get("max");
+  if (!min.isNumber() || !max.isNumber()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   "invalid t-digest state");
+  }
+  result._min = min.getNumber<double>();
+  result._max = max.getNumber<double>();
+
+  double total = 0.0;
+  VPackArrayIterator it(centroids);
+  while (it.valid()) {
+    VPackSlice mean = it.value();
+    it.next();
+    VPackSlice weight = it.value();
+    it.next();
+    if (!mean.isNumber() || !weight.isNumber() ||
+        weight.getNumber<double>() <= 0.0) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                     "invalid t-digest centroid");
+    }
+    result._centroids.emplace_back(mean.getNumber<double>(),
+                                   weight.getNumber<double>());
+    total += weight.getNumber<double>();
+  }
+  result._count = static_cast<uint64_t>(std::llround(total));
+  return result;
+}
@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BASICS_TDIGEST_H
+#define ARANGODB_BASICS_TDIGEST_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+class Slice;
+}
+
+namespace basics {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief merging t-digest for estimating quantiles of a stream of numbers.
+/// The digest keeps at most about `compression` centroids, which are small
+/// near both tails so that extreme quantiles stay accurate. Inserted values
+/// are buffered and merged into the centroids in batches. Digests can be
+/// merged, so partial results can be combined
+////////////////////////////////////////////////////////////////////////////////
+
+class TDigest {
+ public:
+  static constexpr double DefaultCompression = 100.0;
+
+  explicit TDigest(double compression = DefaultCompression);
+
+ public:
+  double compression() const { return _compression; }
+
+  bool empty() const { return _count == 0; }
+
+  /// @brief number of values inserted
+  uint64_t count() const { return _count; }
+
+  void clear();
+
+  /// @brief inserts a finite number
+  void insert(double value);
+
+  void merge(TDigest const& other);
+
+  /// @brief estimated value of the quantile q, which must be in [0, 1].
+  /// the digest must not be empty
+  double quantile(double q) const;
+
+  /// @brief serializes the digest as { compression, min, max, centroids },
+  /// with the centroids as a flat array of means and weights
+  void toVelocyPack(velocypack::Builder& builder) const;
+
+  /// @brief creates a digest from the output of toVelocyPack(), throws on
+  /// invalid input
+  static TDigest fromVelocyPack(velocypack::Slice const& slice);
+
+ private:
+  struct Centroid {
+    Centroid(double mean, double weight) : mean(mean), weight(weight) {}
+
+    double mean;
+    double weight;
+  };
+
+  /// @brief merges the buffered values into the centroids
+  void compress() const;
+
+  size_t bufferSize() const;
+
+ private:
+  double _compression;
+  uint64_t _count;
+  double _min;
+  double _max;
+  mutable std::vector<Centroid> _centroids;
+  mutable std::vector<Centroid> _buffer;
+};
+
+}
+}
+
+#endif
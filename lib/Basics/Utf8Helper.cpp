@@ -98,6 +98,36 @@ int Utf8Helper::compareUtf8(char const* left, size_t leftLength,
   return result;
 }
 
+bool Utf8Helper::appendSortKeyUtf8(char const* value, size_t length,
+                                   std::string& key) const {
+  TRI_ASSERT(value != nullptr);
+  if (!_coll) {
+    return false;
+  }
+
+  UnicodeString const str =
+      UnicodeString::fromUTF8(StringPiece(value, (int32_t)length));
+  size_t const offset = key.size();
+  // the key is usually not much longer than the string itself
+  int32_t capacity = static_cast<int32_t>(length * 2 + 16);
+
+  while (true) {
+    key.resize(offset + capacity);
+    int32_t const needed = _coll->getSortKey(
+        str, reinterpret_cast<uint8_t*>(&key[offset]), capacity);
+    if (needed == 0) {
+      key.resize(offset);
+      return false;
+    }
+    if (needed <= capacity) {
+      // strip the terminating null byte
+      key.resize(offset + needed - 1);
+      return true;
+    }
+    capacity = needed;
+  }
+}
+
 int Utf8Helper::compareUtf16(uint16_t const* left, size_t leftLength,
                              uint16_t const* right, size_t rightLength) const {
   TRI_ASSERT(left != nullptr);
@@ -85,6 +85,15 @@ class Utf8Helper {
   int compareUtf16(uint16_t const* left, size_t leftLength,
                    uint16_t const* right, size_t rightLength) const;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief appends the collation key of a utf8 string to `key`. Comparing
+  /// two such keys with memcmp yields the same order as compareUtf8. Returns
+  /// false if no key could be computed
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool appendSortKeyUtf8(char const* value, size_t length,
+                         std::string& key) const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief set collator by language
   /// @param lang   Lowercase two-letter or three-letter ISO-639 code.
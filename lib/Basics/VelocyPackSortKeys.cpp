@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "VelocyPackSortKeys.h"
+#include "Basics/Utf8Helper.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::basics;
+
+/// @brief integers up to this magnitude convert to double without loss
+static constexpr uint64_t MaxExactDouble = uint64_t(1) << 53;
+
+VelocyPackSortKeys::VelocyPackSortKeys(bool useUtf8)
+    : _useUtf8(useUtf8), _kind(Kind::NONE), _size(0) {}
+
+bool VelocyPackSortKeys::build(std::vector<VPackSlice> const& values) {
+  _kind = Kind::NONE;
+  _size = 0;
+  _doubles.clear();
+  _ints.clear();
+  _uints.clear();
+  _strings.clear();
+  _keys.clear();
+
+  if (values.empty()) {
+    return false;
+  }
+
+  bool ok;
+  VPackSlice first = values[0].resolveExternal();
+  if (first.isNumber()) {
+    ok = buildNumbers(values);
+  } else if (first.isString()) {
+    ok = buildStrings(values);
+  } else {
+    ok = false;
+  }
+
+  if (!ok) {
+    _kind = Kind::NONE;
+    return false;
+  }
+  _size = values.size();
+  return true;
+}
+
+bool VelocyPackSortKeys::buildNumbers(std::vector<VPackSlice> const& values) {
+  // VelocyPackHelper::compare() compares numbers of the same type exactly
+  // and numbers of different types as doubles. As long as all integers can
+  // be represented as doubles, both ways yield the same order
+  bool allExact = true;
+  bool allSigned = true;
+  bool allUnsigned = true;
+  for (auto const& v : values) {
+    VPackSlice value = v.resolveExternal();
+    switch (value.type()) {
+      case VPackValueType::Double:
+        allSigned = false;
+        allUnsigned = false;
+        break;
+      case VPackValueType::Int:
+      case VPackValueType::SmallInt: {
+        int64_t i = value.getInt();
+        if (i > static_cast<int64_t>(MaxExactDouble) ||
+            i < -static_cast<int64_t>(MaxExactDouble)) {
+          allExact = false;
+        }
+        allUnsigned = false;
+        break;
+      }
+      case VPackValueType::UInt:
+        if (value.getUInt() > MaxExactDouble) {
+          allExact = false;
+        }
+        allSigned = false;
+        break;
+      default:
+        return false;
+    }
+  }
+
+  if (allExact) {
+    _kind = Kind::DOUBLE;
+    _doubles.reserve(values.size());
+    for (auto const& v : values) {
+      _doubles.emplace_back(v.resolveExternal().getNumber<double>());
+    }
+  } else if (allSigned) {
+    _kind = Kind::INT;
+    _ints.reserve(values.size());
+    for (auto const& v : values) {
+      _ints.emplace_back(v.resolveExternal().getInt());
+    }
+  } else if (allUnsigned) {
+    _kind = Kind::UINT;
+    _uints.reserve(values.size());
+    for (auto const& v : values) {
+      _uints.emplace_back(v.resolveExternal().getUInt());
+    }
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool VelocyPackSortKeys::buildStrings(std::vector<VPackSlice> const& values) {
+  _kind = Kind::STRING;
+  _strings.reserve(values.size());
+  for (auto const& v : values) {
+    VPackSlice value = v.resolveExternal();
+    if (!value.isString()) {
+      return false;
+    }
+    VPackValueLength length;
+    char const* p = value.getString(length);
+    size_t const offset = _keys.size();
+    if (_useUtf8) {
+      if (!Utf8Helper::DefaultUtf8Helper.appendSortKeyUtf8(
+              p, static_cast<size_t>(length), _keys)) {
+        return false;
+      }
+    } else {
+      _keys.append(p, static_cast<size_t>(length));
+    }
+    _strings.emplace_back(StringKey{offset, _keys.size() - offset,
+                                    static_cast<size_t>(length)});
+  }
+  return true;
+}
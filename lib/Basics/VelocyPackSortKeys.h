@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BASICS_VELOCY_PACK_SORT_KEYS_H
+#define ARANGODB_BASICS_VELOCY_PACK_SORT_KEYS_H 1
+
+#include "Basics/Common.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace basics {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief keys for comparing a batch of VelocyPack values which are all
+/// numbers or all strings. compare(i, j) returns the same result as
+/// VelocyPackHelper::compare() for the i-th and the j-th value, but does not
+/// dispatch on the value types, and strings are compared with memcmp on
+/// collation keys which are computed once per value instead of running the
+/// collation in every comparison
+////////////////////////////////////////////////////////////////////////////////
+
+class VelocyPackSortKeys {
+ public:
+  explicit VelocyPackSortKeys(bool useUtf8);
+
+  VelocyPackSortKeys(VelocyPackSortKeys const&) = delete;
+  VelocyPackSortKeys& operator=(VelocyPackSortKeys const&) = delete;
+
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief computes the keys for the values. Returns false if the values
+  /// are not all numbers or all strings, compare() must not be used then
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool build(std::vector<velocypack::Slice> const& values);
+
+  size_t size() const { return _size; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief compares the values at the given positions
+  //////////////////////////////////////////////////////////////////////////////
+
+  int compare(size_t left, size_t right) const {
+    switch (_kind) {
+      case Kind::DOUBLE:
+        return compareValues(_doubles[left], _doubles[right]);
+      case Kind::INT:
+        return compareValues(_ints[left], _ints[right]);
+      case Kind::UINT:
+        return compareValues(_uints[left], _uints[right]);
+      case Kind::STRING:
+        return compareStrings(_strings[left], _strings[right]);
+      case Kind::NONE:
+        break;
+    }
+    TRI_ASSERT(false);
+    return 0;
+  }
+
+ private:
+  enum class Kind { NONE, DOUBLE, INT, UINT, STRING };
+
+  /// @brief position of a collation key in _keys, `length` is the length
+  /// of the original string, which breaks ties between equal keys
+  struct StringKey {
+    size_t offset;
+    size_t keyLength;
+    size_t length;
+  };
+
+  template <typename T>
+  static inline int compareValues(T left, T right) {
+    if (left == right) {
+      return 0;
+    }
+    return (left < right ? -1 : 1);
+  }
+
+  inline int compareStrings(StringKey const& left,
+                            StringKey const& right) const {
+    size_t const len = (std::min)(left.keyLength, right.keyLength);
+    int res = memcmp(_keys.data() + left.offset, _keys.data() + right.offset,
+                     len);
+    if (res != 0) {
+      return (res < 0 ? -1 : 1);
+    }
+    if (left.keyLength != right.keyLength) {
+      return (left.keyLength < right.keyLength ? -1 : 1);
+    }
+    return compareValues(left.length, right.length);
+  }
+
+  bool buildNumbers(std::vector<velocypack::Slice> const& values);
+  bool buildStrings(std::vector<velocypack::Slice> const& values);
+
+ private:
+  bool const _useUtf8;
+  Kind _kind;
+  size_t _size;
+  std::vector<double> _doubles;
+  std::vector<int64_t> _ints;
+  std::vector<uint64_t> _uints;
+  std::vector<StringKey> _strings;
+  std::string _keys;
+};
+
+}
+}
+
+#endif
@@ -23,6 +23,44 @@
 
 #include "csv.h"
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether any byte of a word equals the byte repeated in pattern
+////////////////////////////////////////////////////////////////////////////////
+
+static inline uint64_t HasByte(uint64_t word, uint64_t pattern) {
+  uint64_t const v = word ^ pattern;
+  return (v - 0x0101010101010101ULL) & ~v & 0x8080808080808080ULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the first occurrence of one of three characters, or end.
+/// eight bytes are checked at a time, so the long runs of plain characters
+/// within fields are skipped quickly
+////////////////////////////////////////////////////////////////////////////////
+
+static char const* FindAny(char const* ptr, char const* end, char c1, char c2,
+                           char c3) {
+  uint64_t const p1 = 0x0101010101010101ULL * static_cast<uint8_t>(c1);
+  uint64_t const p2 = 0x0101010101010101ULL * static_cast<uint8_t>(c2);
+  uint64_t const p3 = 0x0101010101010101ULL * static_cast<uint8_t>(c3);
+
+  while (end - ptr >= 8) {
+    uint64_t word;
+    memcpy(&word, ptr, sizeof(word));
+
+    if ((HasByte(word, p1) | HasByte(word, p2) | HasByte(word, p3)) != 0) {
+      break;
+    }
+    ptr += 8;
+  }
+
+  while (ptr < end && *ptr != c1 && *ptr != c2 && *ptr != c3) {
+    ++ptr;
+  }
+
+  return ptr;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief inits a CSV parser
 ////////////////////////////////////////////////////////////////////////////////
@@ -282,9 +320,16 @@ int TRI_ParseCsvString(TRI_csv_parser_t* parser, char const* line,
           break;
 
         case TRI_CSV_PARSER_WITHIN_FIELD:
-          while (ptr < parser->_stop && *ptr != parser->_separator &&
-                 *ptr != '\r' && *ptr != '\n') {
-            *qtr++ = *ptr++;
+          {
+            size_t n = FindAny(ptr, parser->_stop, parser->_separator, '\r',
+                               '\n') -
+                       ptr;
+
+            if (qtr != ptr) {
+              memmove(qtr, ptr, n);
+            }
+            qtr += n;
+            ptr += n;
           }
 
           // found separator or eol
@@ -331,9 +376,17 @@ int TRI_ParseCsvString(TRI_csv_parser_t* parser, char const* line,
         case TRI_CSV_PARSER_WITHIN_QUOTED_FIELD:
           TRI_ASSERT(parser->_useQuote);
 
-          while (ptr < parser->_stop && *ptr != parser->_quote &&
-                 (!parser->_useBackslash || *ptr != '\\')) {
-            *qtr++ = *ptr++;
+          {
+            size_t n = FindAny(ptr, parser->_stop, parser->_quote,
+                               parser->_useBackslash ? '\\' : parser->_quote,
+                               parser->_quote) -
+                       ptr;
+
+            if (qtr != ptr) {
+              memmove(qtr, ptr, n);
+            }
+            qtr += n;
+            ptr += n;
           }
 
           // found quote or a backslash, need at least another quote, a
@@ -411,3 +464,91 @@ int TRI_ParseCsvString(TRI_csv_parser_t* parser, char const* line,
 
   return TRI_ERROR_CORRUPTED_CSV;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the length of the complete rows at the start of a buffer
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_CompleteRowsCsv(char const* data, size_t length, char separator,
+                           char quote, bool useQuote, bool useBackslash,
+                           bool eof, size_t maxRows, size_t* rows) {
+  char const* ptr = data;
+  char const* end = data + length;
+  char const* lastRow = data;
+  size_t found = 0;
+
+  // this follows the states of TRI_ParseCsvString, but only looks at the
+  // characters which end fields and rows
+  while (ptr < end && found < maxRows) {
+    if (useQuote && *ptr == quote) {
+      // quoted field, which may contain separators and line breaks
+      ++ptr;
+
+      while (true) {
+        ptr = FindAny(ptr, end, quote, useBackslash ? '\\' : quote, quote);
+
+        if (ptr + 1 >= end) {
+          // the parser needs to see the character after a quote
+          ptr = end;
+          break;
+        }
+
+        bool foundBackslash = (useBackslash && *ptr == '\\');
+        ++ptr;
+
+        if ((foundBackslash && (*ptr == quote || *ptr == '\\')) ||
+            (!foundBackslash && *ptr == quote)) {
+          // escaped quote or backslash
+          ++ptr;
+          continue;
+        }
+
+        // end of the quoted field, ignore spaces
+        while ((*ptr == ' ' || *ptr == '\t') && ptr + 1 < end) {
+          ++ptr;
+        }
+
+        if (*ptr != separator && *ptr != '\r' && *ptr != '\n') {
+          // corrupted field, the parser skips it
+          while (ptr < end && *ptr != separator && *ptr != '\n') {
+            ++ptr;
+          }
+        }
+        break;
+      }
+    } else {
+      ptr = FindAny(ptr, end, separator, '\r', '\n');
+    }
+
+    if (ptr == end) {
+      break;
+    }
+
+    if (*ptr == separator) {
+      ++ptr;
+      continue;
+    }
+
+    // end of row. \r\n is a single line break
+    if (*ptr == '\r') {
+      if (ptr + 1 == end && !eof) {
+        break;
+      }
+      if (ptr + 1 < end && *(ptr + 1) == '\n') {
+        ++ptr;
+      }
+    }
+
+    lastRow = ++ptr;
+    ++found;
+  }
+
+  if (eof && found < maxRows && lastRow < end) {
+    // a last row without a line break
+    lastRow = end;
+    ++found;
+  }
+
+  *rows += found;
+  return static_cast<size_t>(lastRow - data);
+}
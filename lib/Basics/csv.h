@@ -121,4 +121,17 @@ void TRI_UseBackslashCsvParser(TRI_csv_parser_t* parser, bool value);
 
 int TRI_ParseCsvString(TRI_csv_parser_t*, char const*, size_t);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the length of the complete rows at the start of a buffer,
+/// which must begin at the start of a row, and adds their number to `rows`.
+/// quoted fields may contain separators and line breaks, so the input can
+/// only be split at the returned length. at most `maxRows` rows are
+/// counted. if `eof` is set, trailing data without a line break counts as
+/// a row as well
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_CompleteRowsCsv(char const* data, size_t length, char separator,
+                           char quote, bool useQuote, bool useBackslash,
+                           bool eof, size_t maxRows, size_t* rows);
+
 #endif
@@ -161,6 +161,8 @@ void TRI_InitializeErrorMessages () {
   REG_ERROR(ERROR_CLUSTER_CHAIN_OF_DISTRIBUTESHARDSLIKE, "chain of distributeShardsLike references");
   REG_ERROR(ERROR_CLUSTER_MUST_NOT_DROP_COLL_OTHER_DISTRIBUTESHARDSLIKE, "must not drop collection while another has a distributeShardsLike attribute pointing to it");
   REG_ERROR(ERROR_CLUSTER_UNKNOWN_DISTRIBUTESHARDSLIKE, "must not have a distributeShardsLike attribute pointing to an unknown collection");
+  REG_ERROR(ERROR_CLUSTER_FOLLOWER_NOT_IN_SYNC, "follower is not in sync");
+  REG_ERROR(ERROR_CLUSTER_COULD_NOT_REPORT_IN_CURRENT, "could not report in current");
   REG_ERROR(ERROR_QUERY_KILLED, "query killed");
   REG_ERROR(ERROR_QUERY_PARSE, "%s");
   REG_ERROR(ERROR_QUERY_EMPTY, "query is empty");
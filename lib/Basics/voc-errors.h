@@ -398,6 +398,9 @@
 /// - 1486: @LIT{must not have a distributeShardsLike attribute pointing to an unknown collection}
 ///   Will be raised if one tries to create a collection which points to an
 ///   unknown collection in its distributeShardsLike attribute.
+/// - 1487: @LIT{follower is not in sync}
+///   Will be raised if a read from a follower was requested, but the
+///   follower has not yet applied all writes up to the requested tick.
 /// - 1500: @LIT{query killed}
 ///   Will be raised when a running query is killed by an explicit admin
 ///   command.
@@ -2350,6 +2353,28 @@ void TRI_InitializeErrorMessages ();
 
 #define TRI_ERROR_CLUSTER_UNKNOWN_DISTRIBUTESHARDSLIKE                    (1486)
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief 1487: ERROR_CLUSTER_FOLLOWER_NOT_IN_SYNC
+///
+/// follower is not in sync
+///
+/// Will be raised if a read from a follower was requested, but the follower
+/// has not yet applied all writes up to the requested tick.
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_ERROR_CLUSTER_FOLLOWER_NOT_IN_SYNC                            (1487)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief 1488: ERROR_CLUSTER_COULD_NOT_REPORT_IN_CURRENT
+///
+/// could not report in current
+///
+/// Will be raised when a DBserver cannot report the state of its databases
+/// and shards in the Current hierarchy in the agency.
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_ERROR_CLUSTER_COULD_NOT_REPORT_IN_CURRENT                     (1488)
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief 1500: ERROR_QUERY_KILLED
 ///
@@ -461,6 +461,7 @@ rest::ResponseCode GeneralResponse::responseCode(int code) {
       return ResponseCode::SERVER_ERROR;
 
     case TRI_ERROR_CLUSTER_BACKEND_UNAVAILABLE:
+    case TRI_ERROR_CLUSTER_FOLLOWER_NOT_IN_SYNC:
       return ResponseCode::SERVICE_UNAVAILABLE;
 
     case TRI_ERROR_CLUSTER_UNSUPPORTED:
@@ -30,6 +30,7 @@
 #include <velocypack/velocypack-aliases.h>
 
 #include "Basics/Exceptions.h"
+#include "Basics/StaticStrings.h"
 #include "Basics/StringBuffer.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VPackStringBufferAdapter.h"
@@ -136,6 +137,17 @@ size_t HttpResponse::bodySize() const {
   return _body.length();
 }
 
+int HttpResponse::deflate(size_t bufferSize) {
+  int res = _body.deflate(bufferSize);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+
+  setHeaderNC(StaticStrings::ContentEncoding, "deflate");
+  return TRI_ERROR_NO_ERROR;
+}
+
 void HttpResponse::writeHeader(StringBuffer* output) {
   output->appendText(TRI_CHAR_LENGTH_PAIR("HTTP/1.1 "));
   output->appendText(responseString(_responseCode));
@@ -71,6 +71,11 @@ class HttpResponse : public GeneralResponse {
   // you should call writeHeader only after the body has been created
   void writeHeader(basics::StringBuffer*);  // override;
 
+  // the body must already be set. deflate is then run on the existing body
+  // and the Content-Encoding header is set. the body is left unchanged if
+  // compressing it fails
+  int deflate(size_t = 16384);
+
  public:
   void reset(ResponseCode code) override final;
 
@@ -92,10 +97,6 @@ class HttpResponse : public GeneralResponse {
     return arangodb::Endpoint::TransportType::HTTP;
   }
 
- private:
-  // the body must already be set. deflate is then run on the existing body
-  int deflate(size_t = 16384);
-
  private:
   bool _isHeadResponse;
   std::vector<std::string> _cookies;
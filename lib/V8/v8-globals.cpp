@@ -23,9 +23,12 @@
 
 #include "v8-globals.h"
 
+#include "V8/v8-vpack.h"
+
 TRI_v8_global_s::TRI_v8_global_s(v8::Isolate* isolate)
     : JSCollections(),
       JSViews(),
+      JSLazyVPackObjects(),
 
       AgencyTempl(),
       AgentTempl(),
@@ -34,6 +37,8 @@ TRI_v8_global_s::TRI_v8_global_s(v8::Isolate* isolate)
       ClusterCommTempl(),
       ArangoErrorTempl(),
       VPackTempl(),
+      VPackLazyTempl(),
+      VPackLazyPrototype(),
       VocbaseColTempl(),
       VocbaseViewTempl(),
       VocbaseTempl(),
@@ -212,7 +217,7 @@ TRI_v8_global_s::TRI_v8_global_s(v8::Isolate* isolate)
   _ToKey.Reset(isolate, TRI_V8_ASCII_STRING("_to"));
 }
 
-TRI_v8_global_s::~TRI_v8_global_s() {}
+TRI_v8_global_s::~TRI_v8_global_s() { TRI_FreeLazyVPackObjects(this); }
 
 /// @brief creates a global context
 TRI_v8_global_t* TRI_CreateV8Globals(v8::Isolate* isolate) {
@@ -30,6 +30,10 @@
 
 struct TRI_vocbase_t;
 
+namespace arangodb {
+struct LazyVPackObject;
+}
+
 /// @brief shortcut for fetching the isolate from the thread context
 #define ISOLATE v8::Isolate* isolate = v8::Isolate::GetCurrent()
 
@@ -346,6 +350,10 @@ typedef struct TRI_v8_global_s {
   /// @brief views mapping for weak pointers
   std::unordered_map<void*, v8::Persistent<v8::External>> JSViews;
 
+  /// @brief lazy VPack objects not yet garbage collected, freed along with
+  /// the globals
+  std::unordered_set<arangodb::LazyVPackObject*> JSLazyVPackObjects;
+
   /// @brief agency template
   v8::Persistent<v8::ObjectTemplate> AgencyTempl;
 
@@ -366,6 +374,12 @@ typedef struct TRI_v8_global_s {
 
   /// @brief VPack template
   v8::Persistent<v8::ObjectTemplate> VPackTempl;
+
+  /// @brief lazy VPack object template
+  v8::Persistent<v8::ObjectTemplate> VPackLazyTempl;
+
+  /// @brief prototype of lazy VPack objects, i.e. Object.prototype
+  v8::Persistent<v8::Value> VPackLazyPrototype;
   
   /// @brief collection template
   v8::Persistent<v8::ObjectTemplate> VocbaseColTempl;
@@ -37,6 +37,35 @@ using VelocyPackHelper = arangodb::basics::VelocyPackHelper;
 /// @brief maximum object nesting depth
 static int const MaxLevels = 64;
 
+/// @brief wrapped class for lazy VPack objects
+/// Layout:
+/// - SLOT_CLASS_TYPE
+/// - SLOT_CLASS: the LazyVPackObject
+/// - SLOT_EXTERNAL: object with the attributes converted or set so far, or
+///   undefined as long as there are none
+static int32_t const WRP_VPACK_LAZY_TYPE = 20;
+
+typedef std::shared_ptr<VPackBuffer<uint8_t>> SharedBuffer;
+
+namespace arangodb {
+/// @brief C++ side of a lazy VPack object. The buffer is shared by the lazy
+/// objects created for the values nested in it
+struct LazyVPackObject {
+  LazyVPackObject(SharedBuffer const& buffer, VPackSlice slice)
+      : buffer(buffer), slice(slice), modified(false) {}
+
+  SharedBuffer buffer;
+  VPackSlice slice;
+  /// @brief attributes of slice deleted in JavaScript
+  std::unordered_set<std::string> deleted;
+  /// @brief whether attributes have been set or deleted in JavaScript
+  bool modified;
+  v8::Persistent<v8::Object> handle;
+};
+}
+
+using arangodb::LazyVPackObject;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief converts a VelocyValueType::String into a V8 object
 ////////////////////////////////////////////////////////////////////////////////
@@ -245,6 +274,465 @@ v8::Handle<v8::Value> TRI_VPackToV8(v8::Isolate* isolate,
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the C++ side of a lazy VPack object, or nullptr
+////////////////////////////////////////////////////////////////////////////////
+
+static inline LazyVPackObject* UnwrapLazy(v8::Handle<v8::Object> obj) {
+  return TRI_UnwrapClass<LazyVPackObject>(obj, WRP_VPACK_LAZY_TYPE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the attributes of a lazy VPack object converted or set so
+/// far. The object keeping them is only created when needed, otherwise an
+/// empty handle is returned if there are none yet
+////////////////////////////////////////////////////////////////////////////////
+
+static v8::Handle<v8::Object> LazyCache(v8::Isolate* isolate,
+                                        v8::Handle<v8::Object> obj,
+                                        bool create) {
+  v8::Handle<v8::Value> cache = obj->GetInternalField(SLOT_EXTERNAL);
+
+  if (cache->IsObject()) {
+    return v8::Handle<v8::Object>::Cast(cache);
+  }
+  if (!create) {
+    return v8::Handle<v8::Object>();
+  }
+
+  // the cache must not inherit anything
+  v8::Handle<v8::Object> result = v8::Object::New(isolate);
+  result->SetPrototype(v8::Null(isolate));
+  obj->SetInternalField(SLOT_EXTERNAL, result);
+  return result;
+}
+
+static v8::Handle<v8::Value> LazyValue(v8::Isolate* isolate,
+                                       SharedBuffer const& buffer,
+                                       VPackSlice const& slice);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reads an attribute of a lazy VPack object, converting it on first
+/// access. Converted values are kept, so that changes to nested objects and
+/// arrays are not lost
+////////////////////////////////////////////////////////////////////////////////
+
+static void LazyGetter(v8::Local<v8::String> property,
+                       v8::PropertyCallbackInfo<v8::Value> const& args) {
+  v8::Isolate* isolate = args.GetIsolate();
+  v8::HandleScope scope(isolate);
+
+  LazyVPackObject* lazy = UnwrapLazy(args.Holder());
+  if (lazy == nullptr) {
+    return;
+  }
+
+  v8::Handle<v8::Object> cache = LazyCache(isolate, args.Holder(), false);
+  if (!cache.IsEmpty() && cache->HasOwnProperty(property)) {
+    TRI_V8_RETURN(cache->Get(property));
+  }
+
+  v8::String::Utf8Value key(property);
+  if (*key == nullptr) {
+    return;
+  }
+  std::string const name(*key, key.length());
+  if (lazy->deleted.find(name) != lazy->deleted.end()) {
+    return;
+  }
+
+  VPackSlice value = lazy->slice.get(name);
+  if (value.isNone()) {
+    // not intercepted, continue with the prototype
+    return;
+  }
+
+  v8::Handle<v8::Value> result = LazyValue(isolate, lazy->buffer, value);
+  LazyCache(isolate, args.Holder(), true)->ForceSet(property, result);
+  TRI_V8_RETURN(result);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sets an attribute of a lazy VPack object
+////////////////////////////////////////////////////////////////////////////////
+
+static void LazySetter(v8::Local<v8::String> property,
+                       v8::Local<v8::Value> value,
+                       v8::PropertyCallbackInfo<v8::Value> const& args) {
+  v8::Isolate* isolate = args.GetIsolate();
+  v8::HandleScope scope(isolate);
+
+  LazyVPackObject* lazy = UnwrapLazy(args.Holder());
+  if (lazy == nullptr) {
+    return;
+  }
+
+  LazyCache(isolate, args.Holder(), true)->ForceSet(property, value);
+
+  v8::String::Utf8Value key(property);
+  if (*key != nullptr) {
+    lazy->deleted.erase(std::string(*key, key.length()));
+  }
+  lazy->modified = true;
+
+  TRI_V8_RETURN(value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief checks whether a lazy VPack object has an attribute
+////////////////////////////////////////////////////////////////////////////////
+
+static void LazyQuery(v8::Local<v8::String> property,
+                      v8::PropertyCallbackInfo<v8::Integer> const& args) {
+  v8::Isolate* isolate = args.GetIsolate();
+  v8::HandleScope scope(isolate);
+
+  LazyVPackObject* lazy = UnwrapLazy(args.Holder());
+  if (lazy == nullptr) {
+    return;
+  }
+
+  v8::Handle<v8::Object> cache = LazyCache(isolate, args.Holder(), false);
+  if (!cache.IsEmpty() && cache->HasOwnProperty(property)) {
+    TRI_V8_RETURN(v8::Integer::New(isolate, v8::None));
+  }
+
+  v8::String::Utf8Value key(property);
+  if (*key == nullptr) {
+    return;
+  }
+  std::string const name(*key, key.length());
+  if (lazy->deleted.find(name) == lazy->deleted.end() &&
+      !lazy->slice.get(name).isNone()) {
+    TRI_V8_RETURN(v8::Integer::New(isolate, v8::None));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief deletes an attribute of a lazy VPack object
+////////////////////////////////////////////////////////////////////////////////
+
+static void LazyDeleter(v8::Local<v8::String> property,
+                        v8::PropertyCallbackInfo<v8::Boolean> const& args) {
+  v8::Isolate* isolate = args.GetIsolate();
+  v8::HandleScope scope(isolate);
+
+  LazyVPackObject* lazy = UnwrapLazy(args.Holder());
+  if (lazy == nullptr) {
+    return;
+  }
+
+  v8::Handle<v8::Object> cache = LazyCache(isolate, args.Holder(), false);
+  if (!cache.IsEmpty()) {
+    cache->Delete(property);
+  }
+
+  v8::String::Utf8Value key(property);
+  if (*key != nullptr) {
+    std::string name(*key, key.length());
+    if (!lazy->slice.get(name).isNone()) {
+      lazy->deleted.emplace(std::move(name));
+    }
+  }
+  lazy->modified = true;
+
+  TRI_V8_RETURN_TRUE();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether an attribute name is an array index, like "0" or "123".
+/// V8 passes these to the indexed interceptors instead of the named ones
+////////////////////////////////////////////////////////////////////////////////
+
+static bool IsArrayIndex(std::string const& name) {
+  if (name.empty() || name.size() > 10 || (name[0] == '0' && name.size() > 1)) {
+    return false;
+  }
+  uint64_t value = 0;
+  for (char c : name) {
+    if (c < '0' || c > '9') {
+      return false;
+    }
+    value = value * 10 + (c - '0');
+  }
+  // 2^32 - 1 is not an array index
+  return value < UINT32_MAX;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the attribute names of a lazy VPack object which are array
+/// indexes, or those which are not, the ones of the slice first, followed by
+/// the ones added in JavaScript
+////////////////////////////////////////////////////////////////////////////////
+
+static void LazyNames(v8::PropertyCallbackInfo<v8::Array> const& args,
+                      bool indexes) {
+  v8::Isolate* isolate = args.GetIsolate();
+  v8::HandleScope scope(isolate);
+
+  LazyVPackObject* lazy = UnwrapLazy(args.Holder());
+  if (lazy == nullptr) {
+    return;
+  }
+
+  std::vector<std::string> names;
+
+  for (auto const& it : VPackObjectIterator(lazy->slice, true)) {
+    std::string name = it.key.copyString();
+    if (IsArrayIndex(name) == indexes &&
+        lazy->deleted.find(name) == lazy->deleted.end()) {
+      names.emplace_back(std::move(name));
+    }
+  }
+
+  v8::Handle<v8::Object> cache = LazyCache(isolate, args.Holder(), false);
+  if (!cache.IsEmpty()) {
+    v8::Handle<v8::Array> keys = cache->GetOwnPropertyNames();
+    uint32_t const n = keys->Length();
+    for (uint32_t i = 0; i < n; ++i) {
+      v8::String::Utf8Value str(keys->Get(i));
+      if (*str == nullptr) {
+        continue;
+      }
+      std::string name(*str, str.length());
+      if (IsArrayIndex(name) == indexes && lazy->slice.get(name).isNone()) {
+        names.emplace_back(std::move(name));
+      }
+    }
+  }
+
+  if (indexes) {
+    // array indexes are enumerated in ascending order, as for other objects
+    std::sort(names.begin(), names.end(),
+              [](std::string const& lhs, std::string const& rhs) {
+                return lhs.size() < rhs.size() ||
+                       (lhs.size() == rhs.size() && lhs < rhs);
+              });
+  }
+
+  v8::Handle<v8::Array> result = v8::Array::New(isolate);
+  uint32_t j = 0;
+  for (auto const& name : names) {
+    result->Set(j++, TRI_V8_STD_STRING(name));
+  }
+
+  TRI_V8_RETURN(result);
+}
+
+static void LazyEnumerator(v8::PropertyCallbackInfo<v8::Array> const& args) {
+  LazyNames(args, false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief interceptors for attributes whose names are array indexes. They
+/// delegate to the named ones, which look the names up in the slice
+////////////////////////////////////////////////////////////////////////////////
+
+static inline v8::Local<v8::String> IndexName(v8::Isolate* isolate,
+                                              uint32_t index) {
+  std::string const name = std::to_string(index);
+  return TRI_V8_STD_STRING(name);
+}
+
+static void LazyIndexedGetter(uint32_t index,
+                              v8::PropertyCallbackInfo<v8::Value> const& args) {
+  LazyGetter(IndexName(args.GetIsolate(), index), args);
+}
+
+static void LazyIndexedSetter(uint32_t index, v8::Local<v8::Value> value,
+                              v8::PropertyCallbackInfo<v8::Value> const& args) {
+  LazySetter(IndexName(args.GetIsolate(), index), value, args);
+}
+
+static void LazyIndexedQuery(uint32_t index,
+                             v8::PropertyCallbackInfo<v8::Integer> const& args) {
+  LazyQuery(IndexName(args.GetIsolate(), index), args);
+}
+
+static void LazyIndexedDeleter(
+    uint32_t index, v8::PropertyCallbackInfo<v8::Boolean> const& args) {
+  LazyDeleter(IndexName(args.GetIsolate(), index), args);
+}
+
+static void LazyIndexedEnumerator(
+    v8::PropertyCallbackInfo<v8::Array> const& args) {
+  LazyNames(args, true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief frees the C++ side of a garbage collected lazy VPack object
+////////////////////////////////////////////////////////////////////////////////
+
+static void LazyWeakCallback(
+    v8::WeakCallbackInfo<LazyVPackObject> const& data) {
+  auto isolate = data.GetIsolate();
+  LazyVPackObject* lazy = data.GetParameter();
+  TRI_GET_GLOBALS();
+
+  v8g->JSLazyVPackObjects.erase(lazy);
+  lazy->handle.Reset();
+  delete lazy;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief frees the C++ side of all lazy VPack objects of an isolate
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_FreeLazyVPackObjects(TRI_v8_global_t* v8g) {
+  for (auto& lazy : v8g->JSLazyVPackObjects) {
+    lazy->handle.Reset();
+    delete lazy;
+  }
+  v8g->JSLazyVPackObjects.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief creates a lazy VPack object for an object slice in buffer
+////////////////////////////////////////////////////////////////////////////////
+
+static v8::Handle<v8::Value> LazyObject(v8::Isolate* isolate,
+                                        SharedBuffer const& buffer,
+                                        VPackSlice const& slice) {
+  TRI_ASSERT(slice.isObject());
+  TRI_GET_GLOBALS();
+
+  if (v8g->VPackLazyTempl.IsEmpty()) {
+    v8::Handle<v8::ObjectTemplate> rt = v8::ObjectTemplate::New(isolate);
+    rt->SetInternalFieldCount(3);
+    rt->SetNamedPropertyHandler(LazyGetter, LazySetter, LazyQuery,
+                                LazyDeleter, LazyEnumerator);
+    rt->SetIndexedPropertyHandler(LazyIndexedGetter, LazyIndexedSetter,
+                                  LazyIndexedQuery, LazyIndexedDeleter,
+                                  LazyIndexedEnumerator);
+    v8g->VPackLazyTempl.Reset(isolate, rt);
+    // lazy objects are plain objects to JavaScript code
+    v8g->VPackLazyPrototype.Reset(isolate,
+                                  v8::Object::New(isolate)->GetPrototype());
+  }
+
+  TRI_GET_GLOBAL(VPackLazyTempl, v8::ObjectTemplate);
+  v8::Handle<v8::Object> result = VPackLazyTempl->NewInstance();
+
+  if (result.IsEmpty()) {
+    return v8::Undefined(isolate);
+  }
+
+  TRI_GET_GLOBAL(VPackLazyPrototype, v8::Value);
+  result->SetPrototype(VPackLazyPrototype);
+
+  auto lazy = std::make_unique<LazyVPackObject>(buffer, slice);
+  v8g->JSLazyVPackObjects.emplace(lazy.get());
+  result->SetInternalField(SLOT_CLASS_TYPE,
+                           v8::Integer::New(isolate, WRP_VPACK_LAZY_TYPE));
+  result->SetInternalField(SLOT_CLASS, v8::External::New(isolate, lazy.get()));
+  result->SetInternalField(SLOT_EXTERNAL, v8::Undefined(isolate));
+
+  lazy->handle.Reset(isolate, result);
+  lazy->handle.SetWeak(lazy.get(), LazyWeakCallback,
+                       v8::WeakCallbackType::kParameter);
+  lazy.release();
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts a slice in buffer, objects become lazy VPack objects
+////////////////////////////////////////////////////////////////////////////////
+
+static v8::Handle<v8::Value> LazyValue(v8::Isolate* isolate,
+                                       SharedBuffer const& buffer,
+                                       VPackSlice const& slice) {
+  if (slice.isObject()) {
+    return LazyObject(isolate, buffer, slice);
+  }
+
+  if (slice.isArray()) {
+    v8::Handle<v8::Array> object =
+        v8::Array::New(isolate, static_cast<int>(slice.length()));
+
+    if (object.IsEmpty()) {
+      return v8::Undefined(isolate);
+    }
+
+    uint32_t j = 0;
+    for (auto const& it : VPackArrayIterator(slice)) {
+      v8::Handle<v8::Value> val = LazyValue(isolate, buffer, it);
+      if (!val.IsEmpty()) {
+        object->Set(j++, val);
+      }
+      if (arangodb::V8PlatformFeature::isOutOfMemory(isolate)) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+      }
+    }
+    return object;
+  }
+
+  return TRI_VPackToV8(isolate, slice);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief checks whether a lazy VPack object still equals its slice. Nested
+/// objects and arrays, which have been converted, may have been changed
+/// unless they are unmodified lazy VPack objects themselves
+////////////////////////////////////////////////////////////////////////////////
+
+static bool IsUnmodified(v8::Isolate* isolate, v8::Handle<v8::Object> obj,
+                         LazyVPackObject const* lazy) {
+  if (lazy->modified) {
+    return false;
+  }
+
+  v8::Handle<v8::Object> cache = LazyCache(isolate, obj, false);
+  if (cache.IsEmpty()) {
+    return true;
+  }
+
+  v8::Handle<v8::Array> names = cache->GetOwnPropertyNames();
+  uint32_t const n = names->Length();
+
+  for (uint32_t i = 0; i < n; ++i) {
+    v8::Handle<v8::Value> value = cache->Get(names->Get(i));
+    if (value->IsObject()) {
+      v8::Handle<v8::Object> sub = value->ToObject();
+      LazyVPackObject const* nested = UnwrapLazy(sub);
+      if (nested == nullptr || !IsUnmodified(isolate, sub, nested)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts a VPack value into a V8 value, with lazy objects
+////////////////////////////////////////////////////////////////////////////////
+
+v8::Handle<v8::Value> TRI_VPackToV8Lazy(v8::Isolate* isolate,
+                                        VPackSlice const& value,
+                                        VPackOptions const* options) {
+  VPackSlice slice = value.resolveExternal();
+
+  if (!slice.isObject() && !slice.isArray()) {
+    return TRI_VPackToV8(isolate, slice, options);
+  }
+
+  // the copy must not depend on the custom type handler of a transaction
+  std::unique_ptr<VPackBuffer<uint8_t>> copy(new VPackBuffer<uint8_t>(
+      VelocyPackHelper::sanitizeNonClientTypesChecked(slice, options)));
+
+  // let V8 know about the memory kept alive by its objects
+  int64_t const size = static_cast<int64_t>(copy->size());
+  isolate->AdjustAmountOfExternalAllocatedMemory(size);
+  SharedBuffer buffer(copy.release(),
+                      [isolate, size](VPackBuffer<uint8_t>* b) {
+                        isolate->AdjustAmountOfExternalAllocatedMemory(-size);
+                        delete b;
+                      });
+
+  return LazyValue(isolate, buffer, VPackSlice(buffer->data()));
+}
+
 struct BuilderContext {
   BuilderContext(v8::Isolate* isolate, VPackBuilder& builder,
                  bool keepTopLevelOpen)
@@ -400,6 +888,15 @@ static int V8ToVPack(BuilderContext& context,
 
     v8::Handle<v8::Object> o = parameter->ToObject();
 
+    // unmodified lazy VPack objects are copied as they are
+    if (!context.keepTopLevelOpen || context.level > 0) {
+      LazyVPackObject const* lazy = UnwrapLazy(o);
+      if (lazy != nullptr && IsUnmodified(context.isolate, o, lazy)) {
+        AddValue<VPackSlice, inObject>(context, attributeName, lazy->slice);
+        return TRI_ERROR_NO_ERROR;
+      }
+    }
+
     if (performAllChecks) {
       // first check if the object has a "toJSON" function
       if (o->Has(context.toJsonKey)) {
@@ -41,6 +41,26 @@ v8::Handle<v8::Value> TRI_VPackToV8(
         &arangodb::velocypack::Options::Defaults,
     arangodb::velocypack::Slice const* base = nullptr);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts a VPack value into a V8 value, objects are converted into
+/// lazy objects which only convert an attribute when it is accessed. The
+/// value is copied, custom types and externals are resolved using options,
+/// so the slice does not need to outlive the result. Arrays are converted
+/// into V8 arrays of lazy values, all other types as by TRI_VPackToV8
+////////////////////////////////////////////////////////////////////////////////
+
+v8::Handle<v8::Value> TRI_VPackToV8Lazy(
+    v8::Isolate* isolate, arangodb::velocypack::Slice const&,
+    arangodb::velocypack::Options const* options =
+        &arangodb::velocypack::Options::Defaults);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief frees the C++ side of all lazy VPack objects of an isolate, which
+/// V8 does not garbage collect when the isolate is disposed
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_FreeLazyVPackObjects(TRI_v8_global_t* v8g);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief convert a V8 value to VPack value
 ////////////////////////////////////////////////////////////////////////////////
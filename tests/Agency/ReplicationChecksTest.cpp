@@ -0,0 +1,219 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for the replication checks of the supervision
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+#include "catch.hpp"
+
+#include "Agency/Node.h"
+#include "Agency/ReplicationChecks.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::consensus;
+
+namespace arangodb {
+namespace tests {
+namespace replication_checks_test {
+
+const std::string PREFIX = "arango";
+
+const char* agency = R"=(
+{
+  "Plan": {
+    "Collections": {
+      "database": {
+        "c1": {"replicationFactor": 2},
+        "c2": {"replicationFactor": 2},
+        "c3": {"replicationFactor": 0}
+      },
+      "other": {
+        "c4": {"replicationFactor": 2}
+      }
+    }
+  }
+}
+)=";
+
+Node createNode(char const* c) {
+  Builder opBuilder;
+  { VPackObjectBuilder a(&opBuilder);
+    opBuilder.add("new", VPackParser::fromJson(c)->slice()); }
+  Node node("");
+  node.handle<SET>(opBuilder.slice());
+  return node;
+}
+
+/// @brief a transaction which sets each of the given keys
+std::shared_ptr<Builder> transaction(std::vector<std::string> const& keys) {
+  auto builder = std::make_shared<Builder>();
+  { VPackObjectBuilder t(builder.get());
+    for (auto const& key : keys) {
+      builder->add(key, VPackValue(1));
+    }}
+  return builder;
+}
+
+bool record(ReplicationChecks& checks,
+            std::vector<std::string> const& keys) {
+  auto builder = transaction(keys);
+  return checks.record(PREFIX, std::vector<VPackSlice>{builder->slice()});
+}
+
+std::vector<std::string> const all {
+  "database/c1", "database/c2", "database/c3", "other/c4"};
+
+TEST_CASE("ReplicationChecks", "[agency][supervision]") {
+
+  Node snapshot = createNode(agency);
+  ReplicationChecks checks;
+  auto now = std::chrono::system_clock::now();
+
+  // the first round checks all collections, all are in line
+  REQUIRE(checks.collect());
+  REQUIRE(checks.due(snapshot, now) == all);
+  for (auto const& name : all) {
+    checks.checked(name, false, true);
+  }
+  now += std::chrono::seconds(1);
+
+  SECTION("without changes no collection is due") {
+    REQUIRE_FALSE(checks.collect());
+    REQUIRE(checks.due(snapshot, now).empty());
+  }
+
+  SECTION("a Plan change marks exactly the affected collections") {
+    REQUIRE(record(checks, {
+          "/arango/Plan/Collections/database/c1/shards/s1",
+          "arango/Plan/Collections/other/c4"}));
+    REQUIRE(checks.collect());
+    REQUIRE(checks.due(snapshot, now) ==
+            std::vector<std::string>({"database/c1", "other/c4"}));
+    checks.checked("database/c1", false, true);
+    checks.checked("other/c4", false, true);
+    REQUIRE(checks.due(snapshot, now).empty());
+  }
+
+  SECTION("changes are only taken over by collect") {
+    REQUIRE(record(checks, {"/arango/Plan/Collections/database/c2"}));
+    REQUIRE(checks.due(snapshot, now).empty());
+    REQUIRE(checks.collect());
+    REQUIRE(checks.due(snapshot, now) ==
+            std::vector<std::string>({"database/c2"}));
+  }
+
+  SECTION("a Current change marks no collection") {
+    REQUIRE_FALSE(record(checks, {
+          "/arango/Current/Collections/database/c1/s1"}));
+    REQUIRE(checks.collect());
+    REQUIRE(checks.due(snapshot, now).empty());
+  }
+
+  SECTION("changes outside the agency prefix are ignored") {
+    REQUIRE_FALSE(record(checks, {
+          "/other/Plan/Collections/database/c1",
+          "/arangodb/Plan/Collections/database/c2"}));
+    REQUIRE_FALSE(checks.collect());
+    REQUIRE(checks.due(snapshot, now).empty());
+  }
+
+  SECTION("Plan/DBServers and Target/ToDo are relevant to other checks") {
+    REQUIRE(record(checks, {"/arango/Plan/DBServers/PRMR-1"}));
+    REQUIRE(record(checks, {"/arango/Target/ToDo/1"}));
+    REQUIRE(checks.collect());
+    REQUIRE(checks.due(snapshot, now).empty());
+  }
+
+  SECTION("creating or dropping a database marks all collections") {
+    REQUIRE(record(checks, {"/arango/Plan/Collections/new"}));
+    REQUIRE(checks.collect());
+    REQUIRE(checks.checksAll());
+    REQUIRE(checks.due(snapshot, now) == all);
+  }
+
+  SECTION("replacing the whole Plan marks all collections") {
+    REQUIRE(record(checks, {"/arango/Plan"}));
+    REQUIRE(checks.collect());
+    REQUIRE(checks.due(snapshot, now) == all);
+  }
+
+  SECTION("a replaced read store marks all collections") {
+    checks.recordAll();
+    REQUIRE(checks.collect());
+    REQUIRE(checks.due(snapshot, now) == all);
+  }
+
+  SECTION("a change of leadership checks all collections") {
+    checks.checkAll();
+    REQUIRE(checks.due(snapshot, now) == all);
+    REQUIRE_FALSE(checks.checksAll());
+  }
+
+  SECTION("collections out of line are checked until they are in line") {
+    REQUIRE(record(checks, {"/arango/Plan/Collections/database/c1"}));
+    REQUIRE(checks.collect());
+    REQUIRE(checks.due(snapshot, now) ==
+            std::vector<std::string>({"database/c1"}));
+    checks.checked("database/c1", false, false);
+    REQUIRE(checks.due(snapshot, now) ==
+            std::vector<std::string>({"database/c1"}));
+    checks.checked("database/c1", false, true);
+    REQUIRE(checks.due(snapshot, now).empty());
+  }
+
+  SECTION("satellites are checked in every round") {
+    checks.checked("database/c3", true, true);
+    REQUIRE(checks.satellites().size() == 1);
+    for (int i = 0; i < 3; ++i) {
+      REQUIRE(checks.due(snapshot, now) ==
+              std::vector<std::string>({"database/c3"}));
+      checks.checked("database/c3", true, true);
+    }
+    // no longer a satellite, or dropped
+    REQUIRE(checks.due(snapshot, now) ==
+            std::vector<std::string>({"database/c3"}));
+    checks.checked("database/c3", false, true);
+    REQUIRE(checks.satellites().empty());
+    REQUIRE(checks.due(snapshot, now).empty());
+  }
+
+  SECTION("the full check catches collections whose change was missed") {
+    // e.g. a change not announced by the agent
+    auto later = now + std::chrono::seconds(
+      static_cast<int>(ReplicationChecks::fullCheckInterval) - 2);
+    REQUIRE(checks.due(snapshot, later).empty());
+    later += std::chrono::seconds(2);
+    REQUIRE(checks.due(snapshot, later) == all);
+    for (auto const& name : all) {
+      checks.checked(name, false, true);
+    }
+    REQUIRE(checks.due(snapshot, later + std::chrono::seconds(1)).empty());
+  }
+}
+
+}
+}
+}
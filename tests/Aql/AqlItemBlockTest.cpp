@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for inheriting register values between AQL item blocks
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/ResourceUsage.h"
+
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql_item_block_test {
+
+static bool Same(AqlValue const& lhs, AqlValue const& rhs) {
+  return std::equal_to<AqlValue>()(lhs, rhs);
+}
+
+TEST_CASE("AqlItemBlockInheritValue", "[aql][itemblock]") {
+  ResourceMonitor monitor;
+  AqlItemBlock src(&monitor, 4, 2);
+  AqlItemBlock dst(&monitor, 4, 2);
+
+  // register 0 holds a managed value which is the same in rows 0 to 2,
+  // register 1 a value which can be stored inline
+  AqlValue shared(std::string(64, 'x'));
+  REQUIRE(shared.requiresDestruction());
+  AqlValue other(std::string(64, 'y'));
+  for (size_t row = 0; row < 3; ++row) {
+    src.setValue(row, 0, shared);
+    src.setValue(row, 1, AqlValue(static_cast<int64_t>(row)));
+  }
+  src.setValue(3, 0, other);
+  src.setValue(3, 1, AqlValue(static_cast<int64_t>(3)));
+
+  SECTION("unchanged values share the copy of the previous row") {
+    CHECK(dst.inheritValue(&src, 0, 0, 0));
+    CHECK_FALSE(dst.inheritValue(&src, 1, 1, 0));
+    CHECK_FALSE(dst.inheritValue(&src, 2, 2, 0));
+    CHECK(dst.inheritValue(&src, 3, 3, 0));
+
+    AqlValue const& copy = dst.getValueReference(0, 0);
+    CHECK_FALSE(Same(copy, shared));
+    CHECK(Same(dst.getValueReference(1, 0), copy));
+    CHECK(Same(dst.getValueReference(2, 0), copy));
+    CHECK(dst.valueCount(copy) == 3);
+    CHECK_FALSE(Same(dst.getValueReference(3, 0), copy));
+    CHECK(dst.getValueReference(3, 0).slice().copyString() ==
+          std::string(64, 'y'));
+  }
+
+  SECTION("the first row of a block gets a copy of its own") {
+    REQUIRE(dst.inheritValue(&src, 0, 0, 0));
+    AqlItemBlock next(&monitor, 1, 2);
+    CHECK(next.inheritValue(&src, 1, 0, 0));
+    CHECK_FALSE(Same(next.getValueReference(0, 0), dst.getValueReference(0, 0)));
+  }
+
+  SECTION("nothing is shared if the previous row was not inherited") {
+    CHECK(dst.inheritValue(&src, 1, 1, 0));
+    CHECK(dst.valueCount(dst.getValueReference(1, 0)) == 1);
+  }
+
+  SECTION("inline and empty values are copied") {
+    for (size_t row = 0; row < 4; ++row) {
+      dst.inheritValue(&src, row, row, 1);
+      CHECK(dst.getValueReference(row, 1).slice().getInt() ==
+            static_cast<int64_t>(row));
+    }
+
+    AqlItemBlock empty(&monitor, 2, 2);
+    CHECK_FALSE(dst.inheritValue(&empty, 1, 1, 0));
+    CHECK(dst.getValueReference(1, 0).isEmpty());
+  }
+}
+
+}
+}
+}
@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for the distinct values of COUNT_DISTINCT
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Aql/Aggregator.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace count_distinct_test {
+
+static bool Add(DistinctValues& values, std::string const& json) {
+  // the value is gone after adding it
+  auto builder = VPackParser::fromJson(json);
+  return values.add(builder->slice());
+}
+
+TEST_CASE("CountDistinct", "[aql][aggregator]") {
+  DistinctValues values(&VPackOptions::Defaults);
+
+  SECTION("equal values are counted once") {
+    CHECK(Add(values, "1"));
+    CHECK(Add(values, "\"1\""));
+    CHECK(Add(values, "null"));
+    CHECK_FALSE(Add(values, "1"));
+    CHECK_FALSE(Add(values, "\"1\""));
+    CHECK_FALSE(Add(values, "null"));
+    CHECK(values.size() == 3);
+  }
+
+  SECTION("values are compared as by the == operator") {
+    VPackBuilder numbers;
+    numbers.openArray();
+    numbers.add(VPackValue(2));
+    numbers.add(VPackValue(2.0));
+    numbers.add(VPackValue(static_cast<uint64_t>(2)));
+    numbers.close();
+    for (auto const& number : VPackArrayIterator(numbers.slice())) {
+      values.add(number);
+    }
+    CHECK(values.size() == 1);
+
+    CHECK(Add(values, "{\"a\":1,\"b\":[1,2]}"));
+    CHECK_FALSE(Add(values, "{\"b\":[1,2],\"a\":1}"));
+    CHECK(Add(values, "{\"b\":[2,1],\"a\":1}"));
+    CHECK(Add(values, "[]"));
+    CHECK(Add(values, "{}"));
+    CHECK(Add(values, "false"));
+    CHECK(values.size() == 5);
+  }
+
+  SECTION("large values are kept apart from small ones") {
+    std::string const large = "\"" + std::string(3000, 'x') + "\"";
+    for (int i = 0; i < 1000; ++i) {
+      CHECK(Add(values, std::to_string(i)));
+      if (i == 500) {
+        CHECK(Add(values, large));
+      }
+    }
+    CHECK(values.size() == 1001);
+
+    for (int i = 0; i < 1000; ++i) {
+      CHECK_FALSE(Add(values, std::to_string(i)));
+    }
+    CHECK_FALSE(Add(values, large));
+    CHECK(values.size() == 1001);
+  }
+
+  SECTION("clearing forgets all values") {
+    CHECK(Add(values, "\"a\""));
+    CHECK(Add(values, "\"b\""));
+    values.clear();
+    CHECK(values.size() == 0);
+    CHECK(Add(values, "\"a\""));
+    CHECK(values.size() == 1);
+  }
+}
+
+}
+}
+}
@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for the join order search of the AQL optimizer
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Aql/OptimizerRules.h"
+
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace join_order_test {
+
+TEST_CASE("JoinOrder", "[aql][optimizer]") {
+  std::vector<size_t> result;
+
+  SECTION("runs of one enumeration are not searched") {
+    CHECK_FALSE(findCheapestJoinOrder({ 100.0 }, {}, result));
+  }
+
+  SECTION("overlong runs are not searched") {
+    std::vector<double> counts(20, 10.0);
+    CHECK_FALSE(findCheapestJoinOrder(counts, {}, result));
+  }
+
+  SECTION("without join conditions the smaller collection is outermost") {
+    REQUIRE(findCheapestJoinOrder({ 10.0, 1000.0 }, {}, result));
+    // innermost first
+    CHECK(result == std::vector<size_t>({ 1, 0 }));
+  }
+
+  SECTION("an index lookup moves the looked up collection inside") {
+    // the large collection 0 can be looked up with values from collection 1
+    std::vector<JoinPredicate> predicates{ JoinPredicate{ 0, 1 << 1, 1.0 } };
+    REQUIRE(findCheapestJoinOrder({ 1000.0, 10.0 }, predicates, result));
+    CHECK(result == std::vector<size_t>({ 0, 1 }));
+
+    // the lookup pays off even if the driving collection is larger
+    REQUIRE(findCheapestJoinOrder({ 100.0, 500.0 }, predicates, result));
+    CHECK(result == std::vector<size_t>({ 0, 1 }));
+  }
+
+  SECTION("a chain of lookups is nested along the chain") {
+    // 0 is looked up by 1, 1 is looked up by 2, 2 is small
+    std::vector<JoinPredicate> predicates{ JoinPredicate{ 0, 1 << 1, 1.0 },
+                                           JoinPredicate{ 1, 1 << 2, 2.0 } };
+    REQUIRE(findCheapestJoinOrder({ 1000.0, 1000.0, 5.0 }, predicates, result));
+    CHECK(result == std::vector<size_t>({ 0, 1, 2 }));
+  }
+
+  SECTION("a lookup depending on two collections is nested inside both") {
+    std::vector<JoinPredicate> predicates{
+        JoinPredicate{ 0, (1 << 1) | (1 << 2), 1.0 } };
+    REQUIRE(findCheapestJoinOrder({ 1000.0, 10.0, 20.0 }, predicates,
+                                  result));
+    REQUIRE(result.size() == 3);
+    CHECK(result[0] == 0);
+    // the smaller of the two driving collections is outermost
+    CHECK(result[2] == 1);
+  }
+}
+
+}
+}
+}
@@ -0,0 +1,327 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for the AQL plan cache and prepared statements
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Aql/AstNode.h"
+#include "Aql/PlanCache.h"
+#include "Basics/voc-errors.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace plan_cache_test {
+
+static TRI_vocbase_t* Database(uintptr_t id) {
+  return reinterpret_cast<TRI_vocbase_t*>(id);
+}
+
+static std::shared_ptr<PlanCacheEntry> Entry(std::string const& queryString) {
+  auto builder = std::make_shared<VPackBuilder>();
+  builder->openObject();
+  builder->close();
+  return std::make_shared<PlanCacheEntry>(std::string(queryString), builder,
+                                          std::vector<std::string>(), false);
+}
+
+static std::shared_ptr<PlanCacheEntry> Lookup(PlanCache& cache,
+                                              TRI_vocbase_t* vocbase,
+                                              uint64_t hash,
+                                              std::string const& queryString) {
+  return cache.lookup(vocbase, hash, queryString.c_str(), queryString.size());
+}
+
+TEST_CASE("PlanCache", "[aql][plancache]") {
+  PlanCache cache(3, 2, 3600.0);
+  TRI_vocbase_t* db1 = Database(1);
+  TRI_vocbase_t* db2 = Database(2);
+  std::string const query("FOR doc IN c FILTER doc.value == @value RETURN doc");
+
+  SECTION("stored plans are found by key and query string") {
+    cache.store(db1, 1, Entry(query));
+    CHECK(Lookup(cache, db1, 1, query) != nullptr);
+    CHECK(Lookup(cache, db1, 2, query) == nullptr);
+    CHECK(Lookup(cache, db2, 1, query) == nullptr);
+    CHECK(Lookup(cache, db1, 1, "RETURN 1") == nullptr);
+  }
+
+  SECTION("storing an existing key replaces the plan") {
+    cache.store(db1, 1, Entry(query));
+    auto entry = Entry(query);
+    cache.store(db1, 1, entry);
+    CHECK(cache.numberOfPlans(db1) == 1);
+    CHECK(Lookup(cache, db1, 1, query) == entry);
+  }
+
+  SECTION("the least recently used plan is evicted") {
+    cache.store(db1, 1, Entry(query));
+    cache.store(db1, 2, Entry(query));
+    cache.store(db1, 3, Entry(query));
+    // plan 1 is now more recently used than plan 2
+    REQUIRE(Lookup(cache, db1, 1, query) != nullptr);
+
+    cache.store(db1, 4, Entry(query));
+    CHECK(cache.numberOfPlans(db1) == 3);
+    CHECK(Lookup(cache, db1, 1, query) != nullptr);
+    CHECK(Lookup(cache, db1, 2, query) == nullptr);
+    CHECK(Lookup(cache, db1, 3, query) != nullptr);
+    CHECK(Lookup(cache, db1, 4, query) != nullptr);
+  }
+
+  SECTION("the limit applies per database") {
+    for (uint64_t i = 1; i <= 3; ++i) {
+      cache.store(db1, i, Entry(query));
+      cache.store(db2, i, Entry(query));
+    }
+    CHECK(cache.numberOfPlans(db1) == 3);
+    CHECK(cache.numberOfPlans(db2) == 3);
+  }
+
+  SECTION("invalidation removes the plans of a database") {
+    cache.store(db1, 1, Entry(query));
+    cache.store(db2, 1, Entry(query));
+    cache.invalidate(db1);
+    CHECK(cache.numberOfPlans(db1) == 0);
+    CHECK(cache.numberOfPlans(db2) == 1);
+
+    cache.invalidate();
+    CHECK(cache.numberOfPlans(db2) == 0);
+  }
+
+  SECTION("statements are found by id") {
+    uint64_t id = cache.registerStatement(db1, std::string(query), {"value"});
+    auto statement = cache.lookupStatement(db1, id);
+    REQUIRE(statement != nullptr);
+    CHECK(statement->queryString == query);
+    CHECK(statement->bindParameters == std::vector<std::string>({"value"}));
+    CHECK(cache.lookupStatement(db2, id) == nullptr);
+  }
+
+  SECTION("removed statements are gone") {
+    uint64_t id = cache.registerStatement(db1, std::string(query), {});
+    CHECK(cache.removeStatement(db1, id));
+    CHECK(cache.lookupStatement(db1, id) == nullptr);
+    CHECK_FALSE(cache.removeStatement(db1, id));
+    CHECK(cache.numberOfStatements(db1) == 0);
+  }
+
+  SECTION("the least recently used statement is evicted") {
+    uint64_t id1 = cache.registerStatement(db1, std::string(query), {});
+    uint64_t id2 = cache.registerStatement(db1, std::string(query), {});
+    REQUIRE(cache.lookupStatement(db1, id1) != nullptr);
+
+    uint64_t id3 = cache.registerStatement(db1, std::string(query), {});
+    CHECK(cache.numberOfStatements(db1) == 2);
+    CHECK(cache.lookupStatement(db1, id1) != nullptr);
+    CHECK(cache.lookupStatement(db1, id2) == nullptr);
+    CHECK(cache.lookupStatement(db1, id3) != nullptr);
+  }
+
+  SECTION("dropping a database removes its plans and statements") {
+    cache.store(db1, 1, Entry(query));
+    uint64_t id = cache.registerStatement(db1, std::string(query), {});
+    cache.registerStatement(db2, std::string(query), {});
+
+    cache.drop(db1);
+    CHECK(cache.numberOfPlans(db1) == 0);
+    CHECK(cache.lookupStatement(db1, id) == nullptr);
+    CHECK(cache.numberOfStatements(db2) == 1);
+  }
+}
+
+static std::shared_ptr<VPackBuilder> Json(std::string const& json) {
+  return VPackParser::fromJson(json);
+}
+
+/// @brief a serialized plan with an index lookup and a calculation whose
+/// value looks like a parameter node, but is user data
+static std::shared_ptr<VPackBuilder> Template() {
+  std::string const parameter =
+      "{\"type\":\"parameter\",\"typeID\":" +
+      std::to_string(static_cast<int>(NODE_TYPE_PARAMETER)) +
+      ",\"name\":\"value\"}";
+  return Json(
+      "{\"nodes\":[{\"type\":\"IndexNode\",\"indexes\":[{\"id\":\"42\","
+      "\"type\":\"skiplist\",\"fields\":[\"value\"],\"sparse\":true}],"
+      "\"condition\":{\"type\":\"compare ==\",\"subNodes\":[{\"type\":"
+      "\"attribute access\",\"name\":\"value\"}," + parameter + "]}},"
+      "{\"type\":\"CalculationNode\",\"expression\":{\"type\":\"value\","
+      "\"typeID\":" + std::to_string(static_cast<int>(NODE_TYPE_VALUE)) +
+      ",\"value\":" + parameter + "}}]}");
+}
+
+/// @brief inject bind values into a plan template
+static std::shared_ptr<VPackBuilder> Inject(VPackSlice const& plan,
+                                            VPackSlice const& values) {
+  auto result = std::make_shared<VPackBuilder>();
+  PlanTemplate::inject(plan, *result, [&values](std::string const& name,
+                                                VPackBuilder& builder) {
+    VPackObjectBuilder guard(&builder);
+    builder.add("type", VPackValue("value"));
+    builder.add("typeID", VPackValue(static_cast<int>(NODE_TYPE_VALUE)));
+    builder.add("value", values.get(name));
+  });
+  return result;
+}
+
+static uint64_t ClassHash(std::string const& json) {
+  return PlanTemplate::hashValueClass(Json(json)->slice(), 0);
+}
+
+TEST_CASE("PlanTemplate", "[aql][plancache]") {
+  SECTION("null values and arrays containing null are part of the plan") {
+    CHECK(PlanTemplate::isDeferrable(Json("1")->slice()));
+    CHECK(PlanTemplate::isDeferrable(Json("\"abc\"")->slice()));
+    CHECK(PlanTemplate::isDeferrable(Json("[1,[null]]")->slice()));
+    CHECK(PlanTemplate::isDeferrable(Json("{\"a\":null}")->slice()));
+    CHECK_FALSE(PlanTemplate::isDeferrable(Json("null")->slice()));
+    CHECK_FALSE(PlanTemplate::isDeferrable(Json("[1,null]")->slice()));
+  }
+
+  SECTION("values of the same class share a plan") {
+    CHECK(ClassHash("1") == ClassHash("2.5"));
+    CHECK(ClassHash("-1") == ClassHash("12345678901"));
+    CHECK(ClassHash("\"a\"") == ClassHash("\"a much longer string value\""));
+    CHECK(ClassHash("[1,2]") == ClassHash("[\"a\",\"b\",\"c\"]"));
+    CHECK(ClassHash("{}") == ClassHash("{\"a\":1}"));
+  }
+
+  SECTION("values of another class are optimized again") {
+    CHECK(ClassHash("1") != ClassHash("\"1\""));
+    CHECK(ClassHash("true") != ClassHash("1"));
+    CHECK(ClassHash("[1]") != ClassHash("1"));
+    CHECK(ClassHash("[]") != ClassHash("[1]"));
+    CHECK(ClassHash("[1]") != ClassHash("[1,2]"));
+    CHECK(ClassHash("[1,2,3]") != ClassHash("[1,2,3,4]"));
+    CHECK(ClassHash("{}") != ClassHash("[]"));
+  }
+
+  SECTION("a template runs with different bind values and keeps its index") {
+    auto plan = Template();
+
+    std::unordered_map<std::string, size_t> nodes;
+    PlanTemplate::countParameterNodes(plan->slice(), nodes);
+    CHECK(nodes.size() == 1);
+    CHECK(nodes["value"] == 1);
+
+    for (auto const& value : {"17", "\"foo\"", "[1,2,3]"}) {
+      auto values = Json(std::string("{\"value\":") + value + "}");
+      auto injected = Inject(plan->slice(), values->slice());
+      VPackSlice index = injected->slice().get("nodes").at(0);
+      VPackSlice calculation = injected->slice().get("nodes").at(1);
+
+      // the index of the template is used for every value
+      CHECK(index.get("indexes").toJson() ==
+            plan->slice().get("nodes").at(0).get("indexes").toJson());
+      // the lookup value is the bound value
+      VPackSlice lookup = index.get("condition").get("subNodes").at(1);
+      CHECK(lookup.get("typeID").getNumber<int>() ==
+            static_cast<int>(NODE_TYPE_VALUE));
+      CHECK(lookup.get("value").toJson() == Json(value)->slice().toJson());
+      // user data is not replaced
+      CHECK(calculation.toJson() ==
+            plan->slice().get("nodes").at(1).toJson());
+
+      std::unordered_map<std::string, size_t> remaining;
+      PlanTemplate::countParameterNodes(injected->slice(), remaining);
+      CHECK(remaining.empty());
+    }
+  }
+}
+
+TEST_CASE("PreparedStatementBindParameters", "[aql][plancache]") {
+  PreparedStatement statement(1, "FOR d IN @@c FILTER d.v == @v RETURN d",
+                              {"@c", "v"});
+
+  SECTION("exactly the declared parameters are accepted") {
+    auto values = Json("{\"@c\":\"docs\",\"v\":1}");
+    CHECK(statement.checkBindParameters(values->slice()).ok());
+  }
+
+  SECTION("missing parameters are refused") {
+    auto values = Json("{\"@c\":\"docs\"}");
+    CHECK(statement.checkBindParameters(values->slice()).errorNumber() ==
+          TRI_ERROR_QUERY_BIND_PARAMETER_MISSING);
+    CHECK(statement.checkBindParameters(VPackSlice::noneSlice())
+              .errorNumber() == TRI_ERROR_QUERY_BIND_PARAMETER_MISSING);
+  }
+
+  SECTION("undeclared parameters are refused") {
+    auto values = Json("{\"@c\":\"docs\",\"v\":1,\"w\":2}");
+    CHECK(statement.checkBindParameters(values->slice()).errorNumber() ==
+          TRI_ERROR_QUERY_BIND_PARAMETER_UNDECLARED);
+  }
+
+  SECTION("statements without parameters need no values") {
+    PreparedStatement other(2, "RETURN 1", {});
+    CHECK(other.checkBindParameters(VPackSlice::noneSlice()).ok());
+    CHECK(other.checkBindParameters(Json("null")->slice()).ok());
+    CHECK(other.checkBindParameters(Json("{}")->slice()).ok());
+  }
+}
+
+TEST_CASE("PlanCacheStatementTtl", "[aql][plancache]") {
+  double now = 1000.0;
+  PlanCache cache(3, 10, 60.0, [&now]() { return now; });
+  TRI_vocbase_t* db = Database(1);
+
+  uint64_t unused = cache.registerStatement(db, "RETURN 1", {});
+  uint64_t used = cache.registerStatement(db, "RETURN 2", {});
+
+  SECTION("statements used within the ttl are kept") {
+    for (int i = 0; i < 6; ++i) {
+      now += 15.0;
+      REQUIRE(cache.lookupStatement(db, used) != nullptr);
+    }
+
+    CHECK(cache.lookupStatement(db, unused) == nullptr);
+    CHECK(cache.numberOfStatements(db) == 1);
+  }
+
+  SECTION("statements expire once the ttl has passed") {
+    now += 60.0;
+    CHECK(cache.lookupStatement(db, unused) != nullptr);
+
+    now += 60.5;
+    CHECK(cache.lookupStatement(db, used) == nullptr);
+    CHECK(cache.numberOfStatements(db) == 0);
+  }
+
+  SECTION("registering a statement expires the others") {
+    now += 61.0;
+    cache.registerStatement(db, "RETURN 3", {});
+    CHECK(cache.numberOfStatements(db) == 1);
+  }
+}
+
+}
+}
+}
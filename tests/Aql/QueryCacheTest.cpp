@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for the invalidation of the AQL query result cache
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Aql/QueryCache.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace query_cache_test {
+
+static std::string QueryString(uint64_t hash) {
+  return "RETURN " + std::to_string(hash);
+}
+
+static void Store(QueryCache& cache, TRI_vocbase_t* vocbase, uint64_t hash,
+                  std::vector<std::string> const& collections,
+                  QueryCacheKeyDependencies const& keys =
+                      QueryCacheKeyDependencies()) {
+  auto result = std::make_shared<VPackBuilder>();
+  result->openArray();
+  result->add(VPackValue(hash));
+  result->close();
+
+  std::string const queryString = QueryString(hash);
+  REQUIRE(cache.store(vocbase, hash, queryString.c_str(), queryString.size(),
+                      result, collections, keys) != nullptr);
+}
+
+static bool IsCached(QueryCache& cache, TRI_vocbase_t* vocbase,
+                     uint64_t hash) {
+  std::string const queryString = QueryString(hash);
+  auto entry =
+      cache.lookup(vocbase, hash, queryString.c_str(), queryString.size());
+  QueryCacheResultEntryGuard guard(entry);
+  return entry != nullptr;
+}
+
+TEST_CASE("QueryCacheInvalidation", "[aql][querycache]") {
+  QueryCache cache;
+  // the maximum number of results is global, and would evict results here
+  std::pair<std::string, size_t> properties;
+  cache.properties(properties);
+  cache.setMaxResults(100000);
+  TRI_vocbase_t* db = reinterpret_cast<TRI_vocbase_t*>(1);
+  TRI_vocbase_t* other = reinterpret_cast<TRI_vocbase_t*>(2);
+
+  SECTION("writing a key invalidates the results depending on it") {
+    Store(cache, db, 1, {"c"}, {{"c", {"a"}}});
+    Store(cache, db, 2, {"c"}, {{"c", {"b"}}});
+    Store(cache, db, 3, {"c"}, {{"c", {"a", "b"}}});
+
+    cache.invalidate(db, "c", {"a"});
+    CHECK_FALSE(IsCached(cache, db, 1));
+    CHECK(IsCached(cache, db, 2));
+    CHECK_FALSE(IsCached(cache, db, 3));
+  }
+
+  SECTION("writing a key invalidates the results depending on the collection") {
+    Store(cache, db, 1, {"c"});
+    Store(cache, db, 2, {"c", "d"}, {{"c", {"b"}}});
+
+    cache.invalidate(db, "c", {"a"});
+    CHECK_FALSE(IsCached(cache, db, 1));
+    CHECK(IsCached(cache, db, 2));
+  }
+
+  SECTION("writing a key only affects its collection and database") {
+    Store(cache, db, 1, {"c"}, {{"c", {"a"}}});
+    Store(cache, db, 2, {"d"}, {{"d", {"a"}}});
+    Store(cache, other, 3, {"c"}, {{"c", {"a"}}});
+
+    cache.invalidate(db, "c", {"a"});
+    CHECK_FALSE(IsCached(cache, db, 1));
+    CHECK(IsCached(cache, db, 2));
+    CHECK(IsCached(cache, other, 3));
+  }
+
+  SECTION("a result depending on keys of two collections") {
+    Store(cache, db, 1, {"c", "d"}, {{"c", {"a"}}, {"d", {"x"}}});
+
+    cache.invalidate(db, "c", {"x"});
+    CHECK(IsCached(cache, db, 1));
+    cache.invalidate(db, "d", {"x"});
+    CHECK_FALSE(IsCached(cache, db, 1));
+  }
+
+  SECTION("collection invalidation removes key dependent results") {
+    Store(cache, db, 1, {"c"}, {{"c", {"a"}}});
+    Store(cache, db, 2, {"c"});
+    Store(cache, db, 3, {"d"});
+
+    cache.invalidate(db, "c");
+    CHECK_FALSE(IsCached(cache, db, 1));
+    CHECK_FALSE(IsCached(cache, db, 2));
+    CHECK(IsCached(cache, db, 3));
+  }
+
+  SECTION("invalidation finds results in all parts") {
+    // the results are spread over the parts of the cache by their hashes
+    for (uint64_t i = 1; i <= 256; ++i) {
+      Store(cache, db, i, {"c"}, {{"c", {std::to_string(i % 2)}}});
+    }
+
+    cache.invalidate(db, "c", {"0"});
+    for (uint64_t i = 1; i <= 256; ++i) {
+      CHECK(IsCached(cache, db, i) == (i % 2 == 1));
+    }
+
+    cache.invalidate(db, std::vector<std::string>{"d", "c"});
+    for (uint64_t i = 1; i <= 256; ++i) {
+      CHECK_FALSE(IsCached(cache, db, i));
+    }
+  }
+
+  SECTION("results stored after an invalidation are invalidated again") {
+    Store(cache, db, 1, {"c"}, {{"c", {"a"}}});
+    cache.invalidate(db, "c", {"a"});
+    REQUIRE_FALSE(IsCached(cache, db, 1));
+
+    Store(cache, db, 1, {"c"}, {{"c", {"a"}}});
+    REQUIRE(IsCached(cache, db, 1));
+    cache.invalidate(db, "c", {"a"});
+    CHECK_FALSE(IsCached(cache, db, 1));
+  }
+
+  SECTION("results stored after a database invalidation are invalidated") {
+    Store(cache, db, 1, {"c"});
+    cache.invalidate(db);
+    REQUIRE_FALSE(IsCached(cache, db, 1));
+
+    Store(cache, db, 1, {"c"});
+    cache.invalidate(db, "c");
+    CHECK_FALSE(IsCached(cache, db, 1));
+  }
+
+  cache.setMaxResults(properties.second);
+}
+
+}
+}
+}
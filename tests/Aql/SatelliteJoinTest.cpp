@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for moving satellite joins into DB server snippets
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Aql/OptimizerRules.h"
+
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace satellite_join_test {
+
+typedef SatelliteJoinNode Node;
+
+TEST_CASE("SatelliteJoinMoves", "[aql][optimizer]") {
+  SECTION("nothing follows the gather") {
+    CHECK(satelliteJoinMoves({}) == 0);
+  }
+
+  SECTION("filters without a satellite join stay on the coordinator") {
+    CHECK(satelliteJoinMoves({Node::FILTER}) == 0);
+    CHECK(satelliteJoinMoves({Node::FILTER, Node::FILTER}) == 0);
+    CHECK(satelliteJoinMoves({Node::FILTER, Node::OTHER}) == 0);
+  }
+
+  SECTION("filters before a satellite join are moved along") {
+    CHECK(satelliteJoinMoves({Node::JOIN}) == 1);
+    CHECK(satelliteJoinMoves({Node::FILTER, Node::JOIN}) == 2);
+    CHECK(satelliteJoinMoves({Node::FILTER, Node::FILTER, Node::JOIN}) == 3);
+  }
+
+  SECTION("filters after the last satellite join stay on the coordinator") {
+    CHECK(satelliteJoinMoves({Node::JOIN, Node::FILTER}) == 1);
+    CHECK(satelliteJoinMoves(
+              {Node::FILTER, Node::JOIN, Node::FILTER, Node::JOIN,
+               Node::FILTER}) == 4);
+  }
+
+  SECTION("joins after another node are not moved") {
+    CHECK(satelliteJoinMoves({Node::OTHER, Node::JOIN}) == 0);
+    CHECK(satelliteJoinMoves({Node::FILTER, Node::OTHER, Node::JOIN}) == 0);
+    CHECK(satelliteJoinMoves({Node::JOIN, Node::OTHER, Node::JOIN}) == 1);
+  }
+}
+
+}
+}
+}
@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for the memory arenas of the subsystems
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Basics/MemoryArenas.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::basics;
+
+namespace arangodb {
+namespace tests {
+namespace memory_arenas_test {
+
+#ifdef ARANGODB_HAVE_JEMALLOC
+static uint64_t Allocated(MemoryArena arena) {
+  VPackBuilder builder;
+  MemoryArenas::toVelocyPack(builder);
+  return builder.slice()
+      .get("arenas")
+      .get(MemoryArenas::name(arena))
+      .get("allocated")
+      .getUInt();
+}
+#endif
+
+TEST_CASE("MemoryArenas", "[memory]") {
+  SECTION("memory is allocated and freed") {
+    std::unique_ptr<char, MemoryArenas::Deleter> ptr(static_cast<char*>(
+        MemoryArenas::allocate(MemoryArena::CACHE, 1024)));
+    REQUIRE(ptr != nullptr);
+    memset(ptr.get(), 'x', 1024);
+    CHECK(ptr.get()[1023] == 'x');
+
+    // an empty allocation is still a valid pointer
+    void* empty = MemoryArenas::allocate(MemoryArena::AQL, 0);
+    CHECK(empty != nullptr);
+    MemoryArenas::deallocate(empty);
+    MemoryArenas::deallocate(nullptr);
+  }
+
+  SECTION("the subsystems have names") {
+    CHECK(std::string(MemoryArenas::name(MemoryArena::CACHE)) == "cache");
+    CHECK(std::string(MemoryArenas::name(MemoryArena::REPLICATION)) ==
+          "replication");
+  }
+
+  SECTION("the statistics are an object") {
+    VPackBuilder builder;
+    MemoryArenas::toVelocyPack(builder);
+    REQUIRE(builder.slice().isObject());
+    CHECK(builder.slice().get("arenas").isNone() == !MemoryArenas::enabled());
+  }
+
+  if (!MemoryArenas::enabled()) {
+    SECTION("threads are not bound without arenas") {
+      CHECK(MemoryArenas::bindThread(MemoryArena::V8) ==
+            MemoryArenas::NoArena);
+      MemoryArenaScope scope(MemoryArena::AQL);
+      void* ptr = malloc(16);
+      CHECK(ptr != nullptr);
+      free(ptr);
+    }
+  }
+
+#ifdef ARANGODB_HAVE_JEMALLOC
+  static bool initialized = false;
+  if (!initialized) {
+    MemoryArenas::initialize();
+    initialized = true;
+  }
+  REQUIRE(MemoryArenas::enabled());
+
+  SECTION("explicit allocations are accounted to their arena") {
+    size_t const size = 1024 * 1024;
+    uint64_t before = Allocated(MemoryArena::CACHE);
+    void* ptr = MemoryArenas::allocate(MemoryArena::CACHE, size);
+    CHECK(Allocated(MemoryArena::CACHE) >= before + size);
+    MemoryArenas::deallocate(ptr);
+    CHECK(Allocated(MemoryArena::CACHE) < before + size);
+  }
+
+  SECTION("allocations of a bound thread are accounted to the arena") {
+    size_t const size = 4 * 1024 * 1024;
+    uint64_t before = Allocated(MemoryArena::REPLICATION);
+    void* ptr;
+    {
+      MemoryArenaScope scope(MemoryArena::REPLICATION);
+      ptr = malloc(size);
+    }
+    CHECK(Allocated(MemoryArena::REPLICATION) >= before + size);
+    free(ptr);
+
+    // the binding is undone at the end of the scope
+    before = Allocated(MemoryArena::REPLICATION);
+    ptr = malloc(size);
+    CHECK(Allocated(MemoryArena::REPLICATION) == before);
+    free(ptr);
+  }
+
+  SECTION("nested bindings are restored") {
+    unsigned outer = MemoryArenas::bindThread(MemoryArena::AQL);
+    CHECK(outer != MemoryArenas::NoArena);
+    // binding to the current arena changes nothing
+    CHECK(MemoryArenas::bindThread(MemoryArena::AQL) == MemoryArenas::NoArena);
+    unsigned inner = MemoryArenas::bindThread(MemoryArena::V8);
+    CHECK(inner != MemoryArenas::NoArena);
+    MemoryArenas::restoreThread(inner);
+    MemoryArenas::restoreThread(outer);
+  }
+#endif
+}
+
+}
+}
+}
@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for the HyperLogLog and TDigest sketches
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Basics/HyperLogLog.h"
+#include "Basics/TDigest.h"
+#include "Basics/fasthash.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+static uint64_t hashValue(uint64_t value) {
+  return fasthash64_uint64(value, 0xdeadbeef);
+}
+
+static double relativeError(double estimate, double actual) {
+  return std::abs(estimate - actual) / actual;
+}
+
+TEST_CASE("HyperLogLogTest", "[sketches]") {
+  SECTION("test_empty") {
+    HyperLogLog sketch;
+    CHECK(sketch.empty());
+    CHECK(sketch.estimate() == 0);
+  }
+
+  SECTION("test_small_cardinalities") {
+    HyperLogLog sketch;
+    for (uint64_t i = 0; i < 100; ++i) {
+      // duplicates must not be counted
+      sketch.insert(hashValue(i));
+      sketch.insert(hashValue(i));
+    }
+    CHECK(relativeError(static_cast<double>(sketch.estimate()), 100.0) <
+          0.03);
+  }
+
+  SECTION("test_large_cardinalities") {
+    HyperLogLog sketch;
+    for (uint64_t i = 0; i < 1000000; ++i) {
+      sketch.insert(hashValue(i));
+    }
+    CHECK(relativeError(static_cast<double>(sketch.estimate()), 1000000.0) <
+          0.05);
+  }
+
+  SECTION("test_merge_and_serialization") {
+    HyperLogLog left;
+    HyperLogLog right;
+    for (uint64_t i = 0; i < 50000; ++i) {
+      left.insert(hashValue(i));
+      right.insert(hashValue(i + 25000));
+    }
+
+    VPackBuilder builder;
+    right.toVelocyPack(builder);
+    HyperLogLog copy = HyperLogLog::fromVelocyPack(builder.slice());
+    CHECK(copy.estimate() == right.estimate());
+
+    left.merge(copy);
+    CHECK(relativeError(static_cast<double>(left.estimate()), 75000.0) < 0.05);
+
+    HyperLogLog other(HyperLogLog::DefaultPrecision + 1);
+    CHECK_THROWS(left.merge(other));
+  }
+}
+
+TEST_CASE("TDigestTest", "[sketches]") {
+  SECTION("test_empty") {
+    TDigest digest;
+    CHECK(digest.empty());
+    CHECK(digest.count() == 0);
+  }
+
+  SECTION("test_single_value") {
+    TDigest digest;
+    digest.insert(42.0);
+    CHECK(digest.quantile(0.0) == 42.0);
+    CHECK(digest.quantile(0.5) == 42.0);
+    CHECK(digest.quantile(1.0) == 42.0);
+  }
+
+  SECTION("test_uniform_quantiles") {
+    TDigest digest;
+    for (int i = 0; i < 100000; ++i) {
+      // insert in a scrambled order
+      digest.insert(static_cast<double>((i * 7919) % 100000));
+    }
+    CHECK(digest.count() == 100000);
+    CHECK(digest.quantile(0.0) == 0.0);
+    CHECK(digest.quantile(1.0) == 99999.0);
+    CHECK(std::abs(digest.quantile(0.5) - 50000.0) < 500.0);
+    CHECK(std::abs(digest.quantile(0.99) - 99000.0) < 100.0);
+    CHECK(std::abs(digest.quantile(0.001) - 100.0) < 50.0);
+  }
+
+  SECTION("test_merge_and_serialization") {
+    TDigest low;
+    TDigest high;
+    for (int i = 0; i < 10000; ++i) {
+      low.insert(static_cast<double>(i));
+      high.insert(static_cast<double>(i + 10000));
+    }
+
+    VPackBuilder builder;
+    high.toVelocyPack(builder);
+    TDigest copy = TDigest::fromVelocyPack(builder.slice());
+    CHECK(copy.count() == high.count());
+    CHECK(copy.quantile(0.5) == high.quantile(0.5));
+
+    low.merge(copy);
+    CHECK(low.count() == 20000);
+    CHECK(low.quantile(0.0) == 0.0);
+    CHECK(low.quantile(1.0) == 19999.0);
+    CHECK(std::abs(low.quantile(0.5) - 10000.0) < 200.0);
+    CHECK(std::abs(low.quantile(0.9) - 18000.0) < 100.0);
+  }
+}
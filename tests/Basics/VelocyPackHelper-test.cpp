@@ -30,10 +30,12 @@
 #include "catch.hpp"
 
 #include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
 #include <velocypack/Parser.h>
 #include <velocypack/velocypack-aliases.h>
 
 #include "Basics/VelocyPackHelper.h"
+#include "Basics/VelocyPackSortKeys.h"
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                                    private macros
@@ -169,6 +171,46 @@ SECTION("tst_compare_values_unequal") {
   VPACK_CHECK(-1, arangodb::basics::VelocyPackHelper::compare, "1", "{}");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test sort keys compare like VelocyPackHelper::compare
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("tst_sort_keys") {
+  auto checkAllPairs = [](char const* json, bool useUtf8) {
+    auto values = VPackParser::fromJson(json);
+    std::vector<VPackSlice> slices;
+    for (auto const& it : VPackArrayIterator(values->slice())) {
+      slices.emplace_back(it);
+    }
+
+    arangodb::basics::VelocyPackSortKeys keys(useUtf8);
+    REQUIRE(keys.build(slices));
+    REQUIRE(keys.size() == slices.size());
+    for (size_t i = 0; i < slices.size(); ++i) {
+      for (size_t j = 0; j < slices.size(); ++j) {
+        CHECK(keys.compare(i, j) ==
+              arangodb::basics::VelocyPackHelper::compare(slices[i], slices[j],
+                                                          useUtf8));
+      }
+    }
+  };
+
+  checkAllPairs("[ 0, 1, -1, 9, 10, 1000, -1000, 1.5, -0.5, 1.0, 9007199254740992 ]", true);
+  checkAllPairs("[ -9223372036854775807, -9007199254740993, -9007199254740992, -1, 0, 5 ]", true);
+  checkAllPairs("[ 18446744073709551615, 18446744073709551614, 10, 100 ]", true);
+  checkAllPairs("[ \"\", \" \", \"a\", \"A\", \"b\", \"B\", \"ab\", \"abc\", \"aBc\", \"\u00e4\", \"z\", \"10\", \"9\", \"a\" ]", true);
+  checkAllPairs("[ \"\", \" \", \"a\", \"A\", \"b\", \"B\", \"ab\", \"abc\", \"aBc\", \"\u00e4\", \"z\" ]", false);
+
+  arangodb::basics::VelocyPackSortKeys keys(true);
+  auto mixed = VPackParser::fromJson("[ 1, \"1\" ]");
+  CHECK(!keys.build({ mixed->slice().at(0), mixed->slice().at(1) }));
+  // large integers of different types would be compared as doubles
+  auto large = VPackParser::fromJson("[ -9223372036854775807, 18446744073709551615 ]");
+  CHECK(!keys.build({ large->slice().at(0), large->slice().at(1) }));
+  auto other = VPackParser::fromJson("[ null, [] ]");
+  CHECK(!keys.build({ other->slice().at(0), other->slice().at(1) }));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief generate tests
 ////////////////////////////////////////////////////////////////////////////////
@@ -384,6 +384,76 @@ SECTION("tst_csv_semicolon_noquote") {
   TRI_DestroyCsvParser(&parser);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test csv long fields
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("tst_csv_long_fields") {
+  INIT_PARSER
+  TRI_SetSeparatorCsvParser(&parser, ',');
+  TRI_SetQuoteCsvParser(&parser, '"', true);
+
+  const char* csv = 
+    "abcdefghijklmnopqrstuvwxyz,\"abcdefghij\"\"klmnopqrstuvwxyz\"" LF
+    "0123456789012345678901234567890123456789" LF;
+
+  TRI_ParseCsvString(&parser, csv, strlen(csv));
+  CHECK("0:abcdefghijklmnopqrstuvwxyz,ESCabcdefghij\"klmnopqrstuvwxyzESC\n1:0123456789012345678901234567890123456789\n" == setup.out.str());
+
+  TRI_DestroyCsvParser(&parser);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test splitting csv input at row boundaries
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("tst_csv_complete_rows") {
+  std::string csv = 
+    "a,b,c" LF
+    "\"quoted, with separator\",\"and" LF "line break\"" CR LF
+    "\"escaped \"\" quote\",x\"y" LF
+    "incomplete,\"row" LF;
+  size_t const third = csv.find("\"escaped");
+  size_t const fourth = csv.find("incomplete");
+
+  size_t rows = 0;
+  CHECK(fourth == TRI_CompleteRowsCsv(csv.c_str(), csv.size(), ',', '"', true, false, false, SIZE_MAX, &rows));
+  CHECK(3 == rows);
+
+  rows = 0;
+  CHECK(third == TRI_CompleteRowsCsv(csv.c_str(), csv.size(), ',', '"', true, false, false, 2, &rows));
+  CHECK(2 == rows);
+
+  // at the end of the input, the open row counts as well
+  rows = 0;
+  CHECK(csv.size() == TRI_CompleteRowsCsv(csv.c_str(), csv.size(), ',', '"', true, false, true, SIZE_MAX, &rows));
+  CHECK(4 == rows);
+
+  // a carriage return may be followed by a line feed
+  rows = 0;
+  CHECK(0 == TRI_CompleteRowsCsv("a" CR, 2, ',', '"', true, false, false, SIZE_MAX, &rows));
+  CHECK(0 == rows);
+
+  // without quotes, line breaks always end rows
+  rows = 0;
+  CHECK(third == TRI_CompleteRowsCsv(csv.c_str(), third, ',', '\0', false, false, false, SIZE_MAX, &rows));
+  CHECK(3 == rows);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test splitting csv input with backslash escapes
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("tst_csv_complete_rows_backslash") {
+  std::string csv = 
+    "\"a\\\"" LF "b\",c" LF
+    "d" LF;
+
+  size_t rows = 0;
+  CHECK(csv.size() == TRI_CompleteRowsCsv(csv.c_str(), csv.size(), ',', '"', true, true, false, SIZE_MAX, &rows));
+  CHECK(2 == rows);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief generate tests
 ////////////////////////////////////////////////////////////////////////////////
@@ -347,3 +347,47 @@ TEST_CASE("cache::PlainCache", "[cache][!hide][longRunning]") {
     manager.destroyCache(cacheMixed);
   }
 }
+
+TEST_CASE("cache::PlainCache key enumeration", "[cache]") {
+  SECTION("test that the cached keys can be enumerated") {
+    uint64_t cacheLimit = 256 * 1024;
+    Manager manager(nullptr, 4 * cacheLimit);
+    auto cache = manager.createCache(CacheType::Plain, false, cacheLimit);
+
+    uint64_t inserted = 0;
+    for (uint64_t i = 0; i < 1024; i++) {
+      CachedValue* value =
+          CachedValue::construct(&i, sizeof(uint64_t), &i, sizeof(uint64_t));
+      bool success = cache->insert(value);
+      if (success) {
+        inserted++;
+      } else {
+        delete value;
+      }
+    }
+    REQUIRE(inserted > 0);
+
+    std::vector<uint64_t> keys;
+    size_t found = cache->enumerateKeys(
+        [&keys](uint8_t const* key, uint32_t keySize) {
+          REQUIRE(keySize == sizeof(uint64_t));
+          uint64_t k;
+          memcpy(&k, key, sizeof(uint64_t));
+          keys.push_back(k);
+        },
+        1024);
+    REQUIRE(found == keys.size());
+    REQUIRE(found <= inserted);
+    REQUIRE(found > 0);
+    for (uint64_t k : keys) {
+      REQUIRE(k < 1024);
+      auto f = cache->find(&k, sizeof(uint64_t));
+      REQUIRE(f.found());
+    }
+
+    found = cache->enumerateKeys([](uint8_t const*, uint32_t) {}, 10);
+    REQUIRE(found <= 10);
+
+    manager.destroyCache(cache);
+  }
+}
@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for the ClusterComm response registry
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Basics/ConditionLocker.h"
+#include "Cluster/ClusterComm.h"
+
+#include <stdexcept>
+
+using namespace arangodb;
+
+namespace arangodb {
+namespace tests {
+namespace cluster_comm_registry_test {
+
+TEST_CASE("ClusterCommRegistry", "[cluster][clustercomm]") {
+  ClusterCommRegistry registry;
+  auto result = std::make_shared<ClusterCommResult>();
+
+  SECTION("a registration that is not done releases its transaction") {
+    {
+      ClusterCommRegistry::Registration registration(registry, 1);
+      CHECK(registry.findTransaction(1) != nullptr);
+    }
+    CHECK(registry.findTransaction(1) == nullptr);
+    CHECK(registry.numberOfTransactions() == 0);
+  }
+
+  SECTION("a failed send does not leak the transaction") {
+    try {
+      ClusterCommRegistry::Registration registration(registry, 1);
+      throw std::runtime_error("cannot send request");
+    } catch (std::runtime_error const&) {
+    }
+    CHECK(registry.numberOfTransactions() == 0);
+    CHECK(registry.numberOfResponses() == 0);
+  }
+
+  SECTION("a failed send keeps the other operations of the transaction") {
+    ClusterCommRegistry::Registration first(registry, 1);
+    {
+      CONDITION_LOCKER(locker, first.transaction()->condition);
+      first.done(100, result);
+    }
+    try {
+      ClusterCommRegistry::Registration second(registry, 1);
+      throw std::runtime_error("cannot send request");
+    } catch (std::runtime_error const&) {
+    }
+
+    auto trx = registry.findTransaction(1);
+    REQUIRE(trx != nullptr);
+    CHECK(trx->registered == 1);
+    CHECK(trx->operations.size() == 1);
+  }
+
+  SECTION("done operations stay registered until they are forgotten") {
+    {
+      ClusterCommRegistry::Registration registration(registry, 1);
+      CONDITION_LOCKER(locker, registration.transaction()->condition);
+      registration.done(100, result);
+    }
+    {
+      ClusterCommRegistry::Registration registration(registry, 1);
+      CONDITION_LOCKER(locker, registration.transaction()->condition);
+      registration.done(101, result);
+    }
+    auto trx = registry.findTransaction(1);
+    REQUIRE(trx != nullptr);
+    CHECK(trx->registered == 2);
+    CHECK(trx->operations.size() == 2);
+    CHECK(registry.numberOfResponses() == 2);
+
+    trx->operations.erase(100);
+    registry.forgetResponse(100, 1);
+    CHECK(registry.findTransaction(1) != nullptr);
+    CHECK(registry.numberOfResponses() == 1);
+
+    trx->operations.erase(101);
+    registry.forgetResponse(101, 1);
+    CHECK(registry.findTransaction(1) == nullptr);
+    CHECK(registry.numberOfResponses() == 0);
+  }
+
+  SECTION("transactions are registered independently") {
+    ClusterCommRegistry::Registration first(registry, 1);
+    {
+      ClusterCommRegistry::Registration second(registry, 17);
+      CHECK(registry.numberOfTransactions() == 2);
+    }
+    CHECK(registry.numberOfTransactions() == 1);
+    CHECK(registry.findTransaction(1) != nullptr);
+  }
+}
+
+}
+}
+}
@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for dirty reads from in-sync followers
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Cluster/ClusterComm.h"
+#include "Cluster/ClusterMethods.h"
+#include "Cluster/FollowerInfo.h"
+#include "Rest/HttpRequest.h"
+
+using namespace arangodb;
+
+namespace arangodb {
+namespace tests {
+namespace dirty_read_test {
+
+static ClusterCommRequest Answered(std::string const& shardId,
+                                   rest::ResponseCode code,
+                                   std::string const& body) {
+  ClusterCommRequest req("shard:" + shardId + "@PRMR-2",
+                         rest::RequestType::GET,
+                         "/_db/db/_api/document/" + shardId + "/a",
+                         std::make_shared<std::string const>());
+  req.result.shardID = shardId;
+  req.result.status = CL_COMM_RECEIVED;
+  req.result.answer_code = code;
+  req.result.answer.reset(HttpRequest::createHttpRequest(
+      ContentType::JSON, body.c_str(), static_cast<int64_t>(body.size()),
+      std::unordered_map<std::string, std::string>()));
+  req.done = true;
+  return req;
+}
+
+static ClusterCommRequest NotInSync(std::string const& shardId) {
+  return Answered(shardId, rest::ResponseCode::SERVICE_UNAVAILABLE,
+                  "{\"error\":true,\"code\":503,\"errorNum\":1487}");
+}
+
+TEST_CASE("FollowerReadTick", "[cluster][dirtyread]") {
+  FollowerInfo follower(nullptr);
+  follower.updateAppliedTick(100);
+
+  SECTION("a lagging follower rejects reads of later writes") {
+    CHECK(follower.canServeRead(100));
+    CHECK(follower.canServeRead(99));
+    CHECK_FALSE(follower.canServeRead(101));
+  }
+
+  SECTION("a read tick of 0 can be served by any follower") {
+    FollowerInfo empty(nullptr);
+    CHECK(empty.canServeRead(0));
+    CHECK(follower.canServeRead(0));
+  }
+
+  SECTION("the leader serves all reads") {
+    follower.setLeader(true);
+    CHECK(follower.canServeRead(1000));
+  }
+
+  SECTION("the applied tick never decreases") {
+    follower.updateAppliedTick(50);
+    CHECK(follower.appliedTick() == 100);
+    follower.updateAppliedTick(200);
+    CHECK(follower.appliedTick() == 200);
+  }
+
+  SECTION("all shards of a query part must have applied the tick") {
+    FollowerInfo upToDate(nullptr);
+    upToDate.updateAppliedTick(200);
+    FollowerInfo lagging(nullptr);
+    lagging.updateAppliedTick(10);
+
+    CHECK(FollowerInfo::canServeReads({&upToDate, &follower}, 100));
+    CHECK_FALSE(FollowerInfo::canServeReads({&upToDate, &lagging}, 100));
+    CHECK_FALSE(FollowerInfo::canServeReads({&lagging, &upToDate}, 100));
+    CHECK_FALSE(FollowerInfo::canServeReads({&upToDate, nullptr}, 100));
+    CHECK(FollowerInfo::canServeReads({&lagging, nullptr}, 0));
+  }
+}
+
+TEST_CASE("DirtyReadLeaderRetries", "[cluster][dirtyread]") {
+  std::unordered_map<std::string, std::string> headers{{"x-test", "1"}};
+
+  SECTION("only follower-not-in-sync answers are classified as rejected") {
+    CHECK(isFollowerNotInSync(NotInSync("s1").result));
+    CHECK_FALSE(isFollowerNotInSync(
+        Answered("s1", rest::ResponseCode::SERVICE_UNAVAILABLE,
+                 "{\"error\":true,\"code\":503,\"errorNum\":1004}")
+            .result));
+    CHECK_FALSE(isFollowerNotInSync(
+        Answered("s1", rest::ResponseCode::OK, "{\"_key\":\"a\"}").result));
+
+    ClusterCommRequest timeout = NotInSync("s1");
+    timeout.result.status = CL_COMM_TIMEOUT;
+    CHECK_FALSE(isFollowerNotInSync(timeout.result));
+  }
+
+  SECTION("rejected reads are retried on the shard leaders") {
+    std::vector<ClusterCommRequest> requests;
+    requests.emplace_back(
+        Answered("s1", rest::ResponseCode::OK, "{\"_key\":\"a\"}"));
+    requests.emplace_back(NotInSync("s2"));
+    requests.emplace_back(
+        Answered("s3", rest::ResponseCode::NOT_FOUND,
+                 "{\"error\":true,\"code\":404,\"errorNum\":1202}"));
+    requests.emplace_back(NotInSync("s4"));
+
+    std::vector<size_t> positions;
+    auto retries = leaderRetriesForDirtyReads(requests, headers, positions);
+
+    REQUIRE(retries.size() == 2);
+    CHECK(positions == std::vector<size_t>({1, 3}));
+    CHECK(retries[0].destination == "shard:s2");
+    CHECK(retries[1].destination == "shard:s4");
+    CHECK(retries[0].path == requests[1].path);
+    CHECK(retries[0].requestType == rest::RequestType::GET);
+    REQUIRE(retries[0].headerFields != nullptr);
+    CHECK(retries[0].headerFields->at("x-test") == "1");
+    CHECK_FALSE(retries[0].done);
+  }
+
+  SECTION("nothing is retried if all reads were served") {
+    std::vector<ClusterCommRequest> requests;
+    requests.emplace_back(
+        Answered("s1", rest::ResponseCode::OK, "{\"_key\":\"a\"}"));
+
+    std::vector<size_t> positions;
+    CHECK(leaderRetriesForDirtyReads(requests, headers, positions).empty());
+    CHECK(positions.empty());
+  }
+}
+
+}
+}
+}
@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for single document reads on coordinators
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Basics/StaticStrings.h"
+#include "Cluster/ClusterComm.h"
+#include "Cluster/ClusterMethods.h"
+#include "Rest/HttpRequest.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace arangodb {
+namespace tests {
+namespace document_read_test {
+
+static ClusterCommRequest Answered(
+    rest::RequestType type, std::string const& body,
+    std::unordered_map<std::string, std::string> const& headers) {
+  ClusterCommRequest req("shard:s1", type, "/_db/db/_api/document/s1/a",
+                         std::make_shared<std::string const>());
+  req.result.status = CL_COMM_RECEIVED;
+  req.result.answer_code = rest::ResponseCode::OK;
+  req.result.answer.reset(HttpRequest::createHttpRequest(
+      ContentType::JSON, body.c_str(), static_cast<int64_t>(body.size()),
+      headers));
+  return req;
+}
+
+TEST_CASE("DocumentResultBody", "[cluster][document]") {
+  std::unordered_map<std::string, std::string> headers{
+      {StaticStrings::Etag, "\"12345\""}};
+
+  SECTION("GET answers are passed on") {
+    auto req = Answered(rest::RequestType::GET,
+                        "{\"_key\":\"a\",\"_rev\":\"12345\",\"value\":1}",
+                        headers);
+    auto body = documentResultBody(req, "c", VPackSlice::noneSlice());
+    VPackSlice slice = body->slice();
+    REQUIRE(slice.isObject());
+    CHECK(slice.get("value").getNumber<int>() == 1);
+  }
+
+  SECTION("HEAD answers are built from the ETag") {
+    auto req = Answered(rest::RequestType::HEAD, "", headers);
+    VPackBuilder search;
+    search.add(VPackValue("a"));
+    auto body = documentResultBody(req, "c", search.slice());
+    VPackSlice slice = body->slice();
+    REQUIRE(slice.isObject());
+    CHECK(slice.get(StaticStrings::RevString).copyString() == "12345");
+    CHECK(slice.get(StaticStrings::KeyString).copyString() == "a");
+    CHECK(slice.get(StaticStrings::IdString).copyString() == "c/a");
+  }
+
+  SECTION("HEAD answers take the key from search objects") {
+    auto req = Answered(rest::RequestType::HEAD, "", headers);
+    auto search = VPackParser::fromJson("{\"_key\":\"b\",\"_rev\":\"1\"}");
+    auto body = documentResultBody(req, "c", search->slice());
+    VPackSlice slice = body->slice();
+    REQUIRE(slice.isObject());
+    CHECK(slice.get(StaticStrings::KeyString).copyString() == "b");
+    CHECK(slice.get(StaticStrings::RevString).copyString() == "12345");
+  }
+
+  SECTION("HEAD answers without an ETag have no revision") {
+    auto req = Answered(rest::RequestType::HEAD, "",
+                        std::unordered_map<std::string, std::string>());
+    VPackBuilder search;
+    search.add(VPackValue("a"));
+    auto body = documentResultBody(req, "c", search.slice());
+    VPackSlice slice = body->slice();
+    REQUIRE(slice.isObject());
+    CHECK_FALSE(slice.hasKey(StaticStrings::RevString));
+  }
+}
+
+}
+}
+}
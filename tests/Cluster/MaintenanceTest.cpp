@@ -0,0 +1,291 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for the DBServer maintenance
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+#include "catch.hpp"
+
+#include "Cluster/Maintenance.h"
+
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::maintenance;
+
+namespace arangodb {
+namespace tests {
+namespace maintenance_test {
+
+typedef ActionDescription::Type Type;
+
+static std::string const SERVER = "PRMR-1";
+
+static char const* plan = R"=({
+  "Version": 17,
+  "Databases": {
+    "_system": { "id": "1", "name": "_system" },
+    "db": { "id": "2", "name": "db" }
+  },
+  "Collections": {
+    "db": {
+      "100": {
+        "name": "led", "type": 2, "waitForSync": false,
+        "shards": { "s101": [ "PRMR-1", "PRMR-2" ] },
+        "indexes": [
+          { "id": "0", "type": "primary", "fields": [ "_key" ] },
+          { "id": "5", "type": "hash", "fields": [ "a" ], "unique": false }
+        ]
+      },
+      "200": {
+        "name": "followed", "type": 2, "waitForSync": false,
+        "shards": { "s201": [ "PRMR-2", "PRMR-1" ] },
+        "indexes": [ { "id": "0", "type": "primary", "fields": [ "_key" ] } ]
+      }
+    }
+  }
+})=";
+
+static char const* current = R"=({
+  "Version": 23,
+  "Databases": {},
+  "Collections": {
+    "db": {
+      "200": { "s201": { "servers": [ "PRMR-2" ] } },
+      "300": { "s301": { "servers": [ "PRMR-1" ] } }
+    }
+  }
+})=";
+
+static std::shared_ptr<VPackBuilder> parse(char const* json) {
+  return VPackParser::fromJson(json);
+}
+
+static size_t count(std::vector<ActionDescription> const& actions, Type type) {
+  return std::count_if(actions.begin(), actions.end(),
+                       [type](ActionDescription const& a) { return a.type == type; });
+}
+
+static ActionDescription const* find(std::vector<ActionDescription> const& actions,
+                                     Type type, std::string const& shard) {
+  for (auto const& a : actions) {
+    if (a.type == type && a.shard == shard) {
+      return &a;
+    }
+  }
+  return nullptr;
+}
+
+TEST_CASE("Maintenance", "[cluster][maintenance]") {
+  auto planBuilder = parse(plan);
+  auto currentBuilder = parse(current);
+
+  SECTION("an empty server creates the planned databases and shards") {
+    auto local = parse(R"=({ "_system": {} })=");
+    auto actions = diffPlanLocal(planBuilder->slice(), currentBuilder->slice(),
+                                 local->slice(), SERVER);
+
+    CHECK(count(actions, Type::CREATE_DATABASE) == 1);
+    CHECK(actions[0].type == Type::CREATE_DATABASE);
+    CHECK(actions[0].database == "db");
+    CHECK(count(actions, Type::CREATE_SHARD) == 2);
+
+    auto create = find(actions, Type::CREATE_SHARD, "s101");
+    REQUIRE(create != nullptr);
+    CHECK(create->leader.empty());
+    CHECK(create->properties->slice().get("name").copyString() == "s101");
+    CHECK(create->properties->slice().get("planId").copyString() == "100");
+    CHECK(create->properties->slice().get("shards").isNone());
+
+    auto ensure = find(actions, Type::ENSURE_INDEX, "s101");
+    REQUIRE(ensure != nullptr);
+    CHECK(ensure->index == "5");
+
+    auto follower = find(actions, Type::CREATE_SHARD, "s201");
+    REQUIRE(follower != nullptr);
+    CHECK(follower->leader == "PRMR-2");
+    REQUIRE(find(actions, Type::SYNCHRONIZE_SHARD, "s201") != nullptr);
+    CHECK(find(actions, Type::SYNCHRONIZE_SHARD, "s101") == nullptr);
+  }
+
+  SECTION("a server in line with the plan has nothing to do") {
+    auto local = parse(R"=({
+      "_system": {},
+      "db": {
+        "s101": { "planId": "100", "isLeader": true, "followers": [ "PRMR-2" ],
+                  "waitForSync": false,
+                  "indexes": [ { "id": "0", "type": "primary" },
+                               { "id": "5", "type": "hash" } ] },
+        "s201": { "planId": "200", "isLeader": false, "followers": [],
+                  "waitForSync": false,
+                  "indexes": [ { "id": "0", "type": "primary" } ] }
+      }
+    })=");
+    auto inSync = parse(R"=({
+      "Collections": { "db": { "200": { "s201": { "servers": [ "PRMR-2", "PRMR-1" ] } } } }
+    })=");
+    auto actions = diffPlanLocal(planBuilder->slice(), inSync->slice(),
+                                 local->slice(), SERVER);
+    CHECK(actions.empty());
+  }
+
+  SECTION("changed leadership, properties and indexes are applied") {
+    auto local = parse(R"=({
+      "_system": {},
+      "old": { "s900": { "planId": "900" } },
+      "db": {
+        "s101": { "planId": "100", "isLeader": false, "followers": [],
+                  "waitForSync": true,
+                  "indexes": [ { "id": "0", "type": "primary" },
+                               { "id": "7", "type": "skiplist" } ] },
+        "s301": { "planId": "300", "isLeader": true, "followers": [] },
+        "_local": { "planId": "400" }
+      }
+    })=");
+    auto actions = diffPlanLocal(planBuilder->slice(), currentBuilder->slice(),
+                                 local->slice(), SERVER);
+
+    auto update = find(actions, Type::UPDATE_SHARD, "s101");
+    REQUIRE(update != nullptr);
+    CHECK(update->leader.empty());
+    CHECK(update->properties->slice().get("waitForSync").isFalse());
+
+    auto drop = find(actions, Type::DROP_INDEX, "s101");
+    REQUIRE(drop != nullptr);
+    CHECK(drop->index == "7");
+    auto ensure = find(actions, Type::ENSURE_INDEX, "s101");
+    REQUIRE(ensure != nullptr);
+    CHECK(ensure->index == "5");
+
+    REQUIRE(find(actions, Type::DROP_SHARD, "s301") != nullptr);
+    CHECK(find(actions, Type::DROP_SHARD, "_local") == nullptr);
+    // shards of a dropped database are removed with the database
+    CHECK(find(actions, Type::DROP_SHARD, "s900") == nullptr);
+    CHECK(count(actions, Type::DROP_DATABASE) == 1);
+    CHECK(actions.back().type == Type::DROP_DATABASE);
+    CHECK(actions.back().database == "old");
+  }
+
+  SECTION("the leader reports its shards and removes unplanned ones") {
+    auto local = parse(R"=({
+      "_system": {},
+      "db": {
+        "s101": { "planId": "100", "isLeader": true, "followers": [ "PRMR-2" ],
+                  "indexes": [ { "id": "0", "type": "primary" } ] }
+      }
+    })=");
+    MaintenanceErrors errors;
+    VPackBuilder report;
+    reportInCurrent(planBuilder->slice(), currentBuilder->slice(),
+                    local->slice(), errors, SERVER, report);
+
+    VPackSlice entry = report.slice().get("Current/Collections/db/100/s101");
+    REQUIRE(entry.isObject());
+    CHECK(entry.get("error").isFalse());
+    REQUIRE(entry.get("servers").length() == 2);
+    CHECK(entry.get("servers")[0].copyString() == SERVER);
+    CHECK(entry.get("servers")[1].copyString() == "PRMR-2");
+
+    // not leading s201, so it is not reported
+    CHECK(report.slice().get("Current/Collections/db/200/s201").isNone());
+    CHECK(report.slice().get("Current/Collections/db/300/s301").isNull());
+    CHECK(report.slice().get("Current/Databases/db/" + SERVER).isObject());
+
+    // reporting the same state again changes nothing
+    VPackBuilder updated;
+    {
+      VPackObjectBuilder o(&updated);
+      updated.add(VPackValue("Databases"));
+      {
+        VPackObjectBuilder d(&updated);
+        updated.add(VPackValue("_system"));
+        {
+          VPackObjectBuilder s(&updated);
+          updated.add(SERVER, report.slice().get("Current/Databases/_system/" + SERVER));
+        }
+        updated.add(VPackValue("db"));
+        {
+          VPackObjectBuilder s(&updated);
+          updated.add(SERVER, report.slice().get("Current/Databases/db/" + SERVER));
+        }
+      }
+      updated.add(VPackValue("Collections"));
+      {
+        VPackObjectBuilder c(&updated);
+        updated.add(VPackValue("db"));
+        VPackObjectBuilder d(&updated);
+        updated.add(VPackValue("100"));
+        VPackObjectBuilder s(&updated);
+        updated.add("s101", entry);
+      }
+    }
+    VPackBuilder again;
+    reportInCurrent(planBuilder->slice(), updated.slice(), local->slice(),
+                    errors, SERVER, again);
+    CHECK(again.slice().length() == 0);
+  }
+
+  SECTION("databases which are gone from the plan are removed from current") {
+    auto local = parse(R"=({ "_system": {}, "db": {} })=");
+    auto stale = parse(R"=({
+      "Databases": {
+        "old": {
+          "PRMR-1": { "error": false, "id": "9", "name": "old" },
+          "PRMR-2": { "error": false, "id": "9", "name": "old" }
+        },
+        "other": {
+          "PRMR-2": { "error": false, "id": "8", "name": "other" }
+        }
+      }
+    })=");
+    MaintenanceErrors errors;
+    VPackBuilder report;
+    reportInCurrent(planBuilder->slice(), stale->slice(), local->slice(),
+                    errors, SERVER, report);
+
+    CHECK(report.slice().get("Current/Databases/old/" + SERVER).isNull());
+    // entries of other servers are left to them
+    CHECK(report.slice().get("Current/Databases/old/PRMR-2").isNone());
+    CHECK(report.slice().get("Current/Databases/other/" + SERVER).isNone());
+    CHECK(report.slice().get("Current/Databases/db/" + SERVER).isObject());
+  }
+
+  SECTION("failed actions are reported as errors") {
+    auto local = parse(R"=({ "_system": {}, "db": {} })=");
+    MaintenanceErrors errors;
+    errors.emplace("db/s101", Result(TRI_ERROR_ARANGO_DUPLICATE_NAME));
+    VPackBuilder report;
+    reportInCurrent(planBuilder->slice(), currentBuilder->slice(),
+                    local->slice(), errors, SERVER, report);
+
+    VPackSlice entry = report.slice().get("Current/Collections/db/100/s101");
+    REQUIRE(entry.isObject());
+    CHECK(entry.get("error").isTrue());
+    CHECK(entry.get("errorNum").getNumber<int>() == TRI_ERROR_ARANGO_DUPLICATE_NAME);
+    CHECK(entry.get("servers").length() == 1);
+  }
+}
+
+}
+}
+}
@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for running rest handlers in the synchronous engine
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "GeneralServer/RestHandler.h"
+#include "Rest/HttpRequest.h"
+#include "Rest/HttpResponse.h"
+
+using namespace arangodb;
+using namespace arangodb::rest;
+
+namespace arangodb {
+namespace tests {
+namespace rest_engine_test {
+
+/// @brief reads like RestDocumentHandler on a coordinator: it waits for an
+/// answer if the engine runs asynchronously, and reads blocking otherwise
+class ReadHandler : public RestHandler {
+ public:
+  explicit ReadHandler(bool alwaysWait)
+      : RestHandler(HttpRequest::createHttpRequest(
+                        ContentType::JSON, "", 0,
+                        std::unordered_map<std::string, std::string>()),
+                    new HttpResponse(ResponseCode::SERVER_ERROR)),
+        _alwaysWait(alwaysWait),
+        _blockingReads(0) {}
+
+  char const* name() const override { return "ReadHandler"; }
+  bool isDirect() const override { return true; }
+
+  RestStatus execute() override {
+    if (_alwaysWait || !executesSynchronously()) {
+      return RestStatus::WAIT_FOR([](std::function<void()> next) {})
+          .then([this]() { resetResponse(ResponseCode::OK); });
+    }
+    ++_blockingReads;
+    resetResponse(ResponseCode::OK);
+    return RestStatus::DONE;
+  }
+
+  void handleError(basics::Exception const& ex) override {
+    resetResponse(ResponseCode::SERVER_ERROR);
+    _errors.emplace_back(ex.code());
+  }
+
+  bool const _alwaysWait;
+  int _blockingReads;
+  std::vector<int> _errors;
+};
+
+TEST_CASE("RestEngineSynchronous", "[rest][engine]") {
+  SECTION("a read in the synchronous engine does not wait") {
+    auto handler = std::make_shared<ReadHandler>(false);
+    CHECK_FALSE(handler->executesSynchronously());
+
+    CHECK(handler->syncRunEngine() == TRI_ERROR_NO_ERROR);
+    CHECK(handler->executesSynchronously());
+    CHECK(handler->_blockingReads == 1);
+    CHECK(handler->_errors.empty());
+    CHECK(handler->response()->responseCode() == ResponseCode::OK);
+  }
+
+  SECTION("a handler waiting in the synchronous engine fails") {
+    // as document reads in batch requests did on coordinators
+    auto handler = std::make_shared<ReadHandler>(true);
+    CHECK(handler->syncRunEngine() == TRI_ERROR_INTERNAL);
+    CHECK(handler->_blockingReads == 0);
+    CHECK(handler->response()->responseCode() != ResponseCode::OK);
+  }
+}
+
+}
+}
+}
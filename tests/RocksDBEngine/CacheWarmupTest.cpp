@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for the snapshot and warmup of the RocksDB document cache
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Cache/CachedValue.h"
+#include "Cache/Common.h"
+#include "Cache/Manager.h"
+#include "Cache/PlainCache.h"
+#include "RocksDBEngine/RocksDBCollection.h"
+#include "RocksDBEngine/RocksDBKey.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <set>
+
+using namespace arangodb;
+using namespace arangodb::cache;
+
+namespace arangodb {
+namespace tests {
+namespace cache_warmup_test {
+
+static uint64_t const ObjectId = 4711;
+
+/// @brief caches a document the way the collection's lookups do
+static bool CacheDocument(std::shared_ptr<Cache> const& cache,
+                          TRI_voc_rid_t revisionId) {
+  auto key = RocksDBKey::Document(ObjectId, revisionId);
+  std::string const value = "document " + std::to_string(revisionId);
+  auto entry = CachedValue::construct(
+      key.string().data(), static_cast<uint32_t>(key.string().size()),
+      value.data(), static_cast<uint64_t>(value.size()));
+  bool cached = cache->insert(entry);
+  if (!cached) {
+    delete entry;
+  }
+  return cached;
+}
+
+static bool IsCached(std::shared_ptr<Cache> const& cache,
+                     TRI_voc_rid_t revisionId) {
+  auto key = RocksDBKey::Document(ObjectId, revisionId);
+  auto f = cache->find(key.string().data(),
+                       static_cast<uint32_t>(key.string().size()));
+  return f.found();
+}
+
+static std::set<TRI_voc_rid_t> Snapshot(std::shared_ptr<Cache> const& cache,
+                                        VPackBuilder& builder, size_t limit) {
+  builder.openArray();
+  size_t added = RocksDBCollection::snapshotCache(cache.get(), builder, limit);
+  builder.close();
+
+  std::set<TRI_voc_rid_t> revisions;
+  for (auto const& it : VPackArrayIterator(builder.slice())) {
+    revisions.emplace(it.getNumber<TRI_voc_rid_t>());
+  }
+  REQUIRE(added == builder.slice().length());
+  REQUIRE(revisions.size() == added);
+  return revisions;
+}
+
+TEST_CASE("RocksDBCollectionCacheWarmup", "[rocksdb][cache]") {
+  uint64_t cacheLimit = 256 * 1024;
+  Manager manager(nullptr, 4 * cacheLimit);
+  auto cache = manager.createCache(CacheType::Plain, false, cacheLimit);
+
+  std::set<TRI_voc_rid_t> cached;
+  for (TRI_voc_rid_t rev = 1000; rev < 1100; ++rev) {
+    if (CacheDocument(cache, rev)) {
+      cached.emplace(rev);
+    }
+  }
+  REQUIRE(!cached.empty());
+
+  SECTION("a snapshot contains the revision ids of the cached documents") {
+    VPackBuilder builder;
+    auto revisions = Snapshot(cache, builder, 1000);
+    CHECK(revisions == cached);
+  }
+
+  SECTION("a snapshot is limited") {
+    VPackBuilder builder;
+    auto revisions = Snapshot(cache, builder, 10);
+    CHECK(revisions.size() <= 10);
+    for (auto const& rev : revisions) {
+      CHECK(cached.find(rev) != cached.end());
+    }
+  }
+
+  SECTION("a collection without cache has an empty snapshot") {
+    VPackBuilder builder;
+    builder.openArray();
+    CHECK(RocksDBCollection::snapshotCache(nullptr, builder, 1000) == 0);
+    builder.close();
+    CHECK(builder.slice().length() == 0);
+  }
+
+  SECTION("warming up a new cache loads the documents of the snapshot") {
+    VPackBuilder builder;
+    auto revisions = Snapshot(cache, builder, 1000);
+
+    auto other = manager.createCache(CacheType::Plain, false, cacheLimit);
+    std::vector<TRI_voc_rid_t> lookups;
+    RocksDBCollection::warmupCache(
+        builder.slice(), [&other, &lookups](TRI_voc_rid_t rev) {
+          lookups.emplace_back(rev);
+          CacheDocument(other, rev);
+        });
+
+    CHECK(lookups.size() == revisions.size());
+    for (auto const& rev : revisions) {
+      CHECK(IsCached(other, rev));
+    }
+    CHECK_FALSE(IsCached(other, 999));
+
+    VPackBuilder again;
+    CHECK(Snapshot(other, again, 1000) == revisions);
+    manager.destroyCache(other);
+  }
+
+  SECTION("values other than revision ids are skipped on warmup") {
+    VPackBuilder builder;
+    builder.openArray();
+    builder.add(VPackValue(1000));
+    builder.add(VPackValue("1001"));
+    builder.add(VPackValue(VPackValueType::Null));
+    builder.add(VPackValue(1002));
+    builder.close();
+
+    std::vector<TRI_voc_rid_t> lookups;
+    RocksDBCollection::warmupCache(
+        builder.slice(),
+        [&lookups](TRI_voc_rid_t rev) { lookups.emplace_back(rev); });
+    CHECK(lookups == std::vector<TRI_voc_rid_t>({1000, 1002}));
+  }
+
+  manager.destroyCache(cache);
+}
+
+}
+}
+}
@@ -0,0 +1,296 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for the pages of large edge lists in the edge cache
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Basics/StringRef.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Cache/Common.h"
+#include "Cache/Manager.h"
+#include "Cache/Transaction.h"
+#include "Cache/TransactionalCache.h"
+#include "RocksDBEngine/RocksDBEdgeIndex.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <array>
+#include <atomic>
+#include <cstring>
+
+using namespace arangodb;
+using namespace arangodb::cache;
+
+namespace arangodb {
+namespace tests {
+namespace edge_cache_pages_test {
+
+static VPackBuilder Revisions(size_t n) {
+  VPackBuilder builder;
+  builder.openArray();
+  for (size_t i = 0; i < n; ++i) {
+    // small values keep the list below a quarter of the cache size
+    builder.add(VPackValue(static_cast<int>(i % 10)));
+  }
+  builder.close();
+  return builder;
+}
+
+/// @brief number of page entries in the cache, their keys contain a NUL byte
+static size_t CountPages(std::shared_ptr<Cache> const& cache) {
+  size_t pages = 0;
+  cache->enumerateKeys(
+      [&pages](uint8_t const* key, uint32_t keySize) {
+        if (std::memchr(key, '\0', keySize) != nullptr) {
+          ++pages;
+        }
+      },
+      1000);
+  return pages;
+}
+
+static bool IsCached(std::shared_ptr<Cache> const& cache,
+                     std::string const& vertex) {
+  auto f = cache->find(vertex.data(), static_cast<uint32_t>(vertex.size()));
+  return f.found();
+}
+
+static bool ReadPages(std::shared_ptr<Cache> const& cache,
+                      std::string const& vertex, VPackBuilder& revisions) {
+  VPackBuilder entry;
+  {
+    auto f = cache->find(vertex.data(), static_cast<uint32_t>(vertex.size()));
+    REQUIRE(f.found());
+    entry.add(VPackSlice(f.value()->value()));
+  }
+  REQUIRE(entry.slice().isObject());
+  return RocksDBEdgeIndex::readCachedPages(cache.get(), StringRef(vertex),
+                                           entry.slice(), revisions);
+}
+
+/// @brief the key of one of the pages in the cache
+static std::string AnyPage(std::shared_ptr<Cache> const& cache) {
+  std::string page;
+  cache->enumerateKeys(
+      [&page](uint8_t const* key, uint32_t keySize) {
+        if (page.empty() && std::memchr(key, '\0', keySize) != nullptr) {
+          page.assign(reinterpret_cast<char const*>(key), keySize);
+        }
+      },
+      1000);
+  return page;
+}
+
+/// @brief approximate read counters of large edge lists, as kept by an index
+struct Admission {
+  Admission() : reads(0) {
+    for (auto& it : frequency) {
+      it.store(0);
+    }
+  }
+
+  bool admit(std::string const& vertex) {
+    return RocksDBEdgeIndex::admitCachePages(
+        frequency.data(), frequency.size(), reads, StringRef(vertex));
+  }
+
+  /// @brief the number of the counter of a vertex
+  size_t counter(std::string const& vertex) const {
+    return std::hash<StringRef>()(StringRef(vertex)) & (frequency.size() - 1);
+  }
+
+  size_t total() const {
+    size_t total = 0;
+    for (auto const& it : frequency) {
+      total += it.load();
+    }
+    return total;
+  }
+
+  std::array<std::atomic<uint8_t>, 4> frequency;
+  std::atomic<uint64_t> reads;
+};
+
+TEST_CASE("EdgeCachePagesAdmission", "[rocksdb][edgeindex]") {
+  Admission admission;
+
+  SECTION("a large edge list is admitted from its second read on") {
+    CHECK_FALSE(admission.admit("v/1"));
+    CHECK(admission.admit("v/1"));
+    CHECK(admission.admit("v/1"));
+  }
+
+  SECTION("the counters are halved after 8 reads per counter") {
+    for (size_t i = 0; i < 31; ++i) {
+      admission.admit("v/1");
+    }
+    CHECK(admission.total() == 31);
+    admission.admit("v/1");
+    CHECK(admission.total() == 16);
+  }
+
+  SECTION("a list read once before the counters were halved starts over") {
+    CHECK_FALSE(admission.admit("v/1"));
+    // other lists, which do not share the counter of v/1
+    for (size_t i = 2; admission.reads < 32; ++i) {
+      std::string other("v/" + std::to_string(i));
+      if (admission.counter(other) != admission.counter("v/1")) {
+        admission.admit(other);
+      }
+    }
+    CHECK_FALSE(admission.admit("v/1"));
+    CHECK(admission.admit("v/1"));
+  }
+}
+
+TEST_CASE("EdgeCachePages", "[rocksdb][edgeindex]") {
+  Manager manager(nullptr, 4 * 1024 * 1024);
+  auto cache = manager.createCache(CacheType::Transactional, false,
+                                   1024 * 1024);
+  REQUIRE(cache != nullptr);
+  std::string const vertex("v/1");
+  VPackBuilder large = Revisions(2500);
+  REQUIRE(large.slice().byteSize() <= cache->usageLimit() / 4);
+
+  SECTION("a large edge list is read back from its pages") {
+    REQUIRE(RocksDBEdgeIndex::cacheEdgeList(cache.get(), StringRef(vertex),
+                                            large.slice(), 1));
+    CHECK(CountPages(cache) == 3);
+
+    VPackBuilder revisions;
+    REQUIRE(ReadPages(cache, vertex, revisions));
+    CHECK(basics::VelocyPackHelper::compare(revisions.slice(),
+                                          large.slice(), false) == 0);
+  }
+
+  SECTION("a small edge list is stored without pages") {
+    VPackBuilder small = Revisions(10);
+    REQUIRE(RocksDBEdgeIndex::cacheEdgeList(cache.get(), StringRef(vertex),
+                                            small.slice(), 0));
+    CHECK(CountPages(cache) == 0);
+    CHECK(IsCached(cache, vertex));
+  }
+
+  SECTION("a blacklisted vertex leaves no pages behind") {
+    Transaction* tx = manager.beginTransaction(false);
+    REQUIRE(cache->blacklist(vertex.data(),
+                             static_cast<uint32_t>(vertex.size())));
+
+    CHECK_FALSE(RocksDBEdgeIndex::cacheEdgeList(
+        cache.get(), StringRef(vertex), large.slice(), 1));
+    CHECK_FALSE(IsCached(cache, vertex));
+    CHECK(CountPages(cache) == 0);
+    manager.endTransaction(tx);
+  }
+
+  SECTION("removing the pages before blacklisting leaves none behind") {
+    REQUIRE(RocksDBEdgeIndex::cacheEdgeList(cache.get(), StringRef(vertex),
+                                            large.slice(), 1));
+    REQUIRE(CountPages(cache) == 3);
+
+    Transaction* tx = manager.beginTransaction(false);
+    RocksDBEdgeIndex::removeCachedPages(cache.get(), StringRef(vertex));
+    REQUIRE(cache->blacklist(vertex.data(),
+                             static_cast<uint32_t>(vertex.size())));
+    CHECK_FALSE(IsCached(cache, vertex));
+    CHECK(CountPages(cache) == 0);
+    manager.endTransaction(tx);
+  }
+
+  SECTION("caching a list again replaces the pages of the old version") {
+    REQUIRE(RocksDBEdgeIndex::cacheEdgeList(cache.get(), StringRef(vertex),
+                                            large.slice(), 1));
+    VPackBuilder larger = Revisions(3500);
+    REQUIRE(RocksDBEdgeIndex::cacheEdgeList(cache.get(), StringRef(vertex),
+                                            larger.slice(), 2));
+    CHECK(CountPages(cache) == 4);
+
+    VPackBuilder revisions;
+    REQUIRE(ReadPages(cache, vertex, revisions));
+    CHECK(basics::VelocyPackHelper::compare(revisions.slice(),
+                                          larger.slice(), false) == 0);
+
+    VPackBuilder small = Revisions(10);
+    REQUIRE(RocksDBEdgeIndex::cacheEdgeList(cache.get(), StringRef(vertex),
+                                            small.slice(), 0));
+    CHECK(CountPages(cache) == 0);
+  }
+
+  SECTION("a list with an evicted page is not read from the cache") {
+    REQUIRE(RocksDBEdgeIndex::cacheEdgeList(cache.get(), StringRef(vertex),
+                                            large.slice(), 1));
+    std::string other("v/2");
+    // removing the pages of another vertex does not affect this one
+    RocksDBEdgeIndex::removeCachedPages(cache.get(), StringRef(other));
+    REQUIRE(CountPages(cache) == 3);
+
+    VPackBuilder entry;
+    {
+      auto f = cache->find(vertex.data(), static_cast<uint32_t>(vertex.size()));
+      REQUIRE(f.found());
+      entry.add(VPackSlice(f.value()->value()));
+    }
+    RocksDBEdgeIndex::removeCachedPages(cache.get(), StringRef(vertex));
+    CHECK(CountPages(cache) == 0);
+
+    VPackBuilder revisions;
+    CHECK_FALSE(RocksDBEdgeIndex::readCachedPages(
+        cache.get(), StringRef(vertex), entry.slice(), revisions));
+  }
+
+  SECTION("a list with an evicted page is read again and cached anew") {
+    Admission admission;
+    // the iterator caches the list in pages from the second read on
+    REQUIRE_FALSE(admission.admit(vertex));
+    REQUIRE(admission.admit(vertex));
+    REQUIRE(RocksDBEdgeIndex::cacheEdgeList(cache.get(), StringRef(vertex),
+                                            large.slice(), 1));
+    std::string const page = AnyPage(cache);
+    REQUIRE_FALSE(page.empty());
+    REQUIRE(cache->remove(page.data(), static_cast<uint32_t>(page.size())));
+    REQUIRE(CountPages(cache) == 2);
+
+    // the iterator falls back to reading the list from RocksDB, which still
+    // counts as a read of a popular list
+    VPackBuilder revisions;
+    CHECK_FALSE(ReadPages(cache, vertex, revisions));
+    CHECK(admission.admit(vertex));
+
+    // the list read from RocksDB replaces the incomplete pages
+    REQUIRE(RocksDBEdgeIndex::cacheEdgeList(cache.get(), StringRef(vertex),
+                                            large.slice(), 2));
+    CHECK(CountPages(cache) == 3);
+    REQUIRE(ReadPages(cache, vertex, revisions));
+    CHECK(basics::VelocyPackHelper::compare(revisions.slice(),
+                                          large.slice(), false) == 0);
+  }
+
+  manager.destroyCache(cache);
+}
+
+}
+}
+}
@@ -131,5 +131,82 @@ SECTION("test_serialize_deserialize") {
   CHECK(est.computeEstimate() == copy.computeEstimate());
 }
 
+SECTION("test_replace_with_buffered_updates") {
+  RocksDBCuckooIndexEstimator<uint64_t> est(2048);
+  for (uint64_t i = 0; i < 100; ++i) {
+    est.insert(i % 10);
+  }
+
+  // writes after the snapshot the rebuild is made from
+  est.bufferUpdates();
+  for (uint64_t i = 0; i < 20; ++i) {
+    est.insert(100 + i);
+  }
+  for (uint64_t i = 0; i < 10; ++i) {
+    est.remove(i);
+  }
+
+  // the rebuilt estimator only knows the snapshot
+  RocksDBCuckooIndexEstimator<uint64_t> rebuilt(2048);
+  for (uint64_t i = 0; i < 100; ++i) {
+    rebuilt.insert(i % 10);
+  }
+
+  // an estimator fed with all writes
+  RocksDBCuckooIndexEstimator<uint64_t> expected(2048);
+  for (uint64_t i = 0; i < 100; ++i) {
+    expected.insert(i % 10);
+  }
+  for (uint64_t i = 0; i < 20; ++i) {
+    expected.insert(100 + i);
+  }
+  for (uint64_t i = 0; i < 10; ++i) {
+    expected.remove(i);
+  }
+
+  est.replaceWith(rebuilt);
+  CHECK(est.nrUsed() == expected.nrUsed());
+  CHECK(est.computeEstimate() == expected.computeEstimate());
+
+  // buffering has stopped, later writes only apply once
+  est.insert(1000);
+  expected.insert(1000);
+  CHECK(est.nrUsed() == expected.nrUsed());
+  CHECK(est.computeEstimate() == expected.computeEstimate());
+}
+
+SECTION("test_replace_drops_stale_content") {
+  RocksDBCuckooIndexEstimator<uint64_t> est(2048);
+  // entries of documents which are no longer in the collection
+  for (uint64_t i = 0; i < 50; ++i) {
+    est.insert(i);
+  }
+
+  est.bufferUpdates();
+  RocksDBCuckooIndexEstimator<uint64_t> rebuilt(2048);
+  for (uint64_t i = 0; i < 10; ++i) {
+    rebuilt.insert(7);
+  }
+  est.replaceWith(rebuilt);
+  CHECK(est.nrUsed() == 1);
+  CHECK(est.computeEstimate() == (double) 1 / 10);
+
+  // the old content is left in the rebuilt estimator
+  CHECK(rebuilt.nrUsed() == 50);
+}
+
+SECTION("test_discard_buffered_updates") {
+  RocksDBCuckooIndexEstimator<uint64_t> est(2048);
+  est.bufferUpdates();
+  est.insert(1);
+  est.discardBufferedUpdates();
+
+  RocksDBCuckooIndexEstimator<uint64_t> rebuilt(2048);
+  est.replaceWith(rebuilt);
+  // nothing is replayed after the rebuild was abandoned
+  CHECK(est.nrUsed() == 0);
+  CHECK(est.computeEstimate() == 1);
+}
+
 // @brief generate tests
 }
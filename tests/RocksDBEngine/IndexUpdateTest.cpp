@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for skipping unchanged index entries of RocksDB updates
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Basics/AttributeNameParser.h"
+#include "RocksDBEngine/RocksDBIndex.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace arangodb {
+namespace tests {
+namespace index_update_test {
+
+static std::vector<std::vector<basics::AttributeName>> Fields(
+    std::vector<std::string> const& attributes) {
+  std::vector<std::vector<basics::AttributeName>> fields;
+  for (auto const& attribute : attributes) {
+    fields.emplace_back();
+    TRI_ParseAttributeString(attribute, fields.back(), true);
+  }
+  return fields;
+}
+
+static bool SameValues(std::vector<std::string> const& attributes,
+                       std::string const& oldJson,
+                       std::string const& newJson) {
+  auto oldDoc = VPackParser::fromJson(oldJson);
+  auto newDoc = VPackParser::fromJson(newJson);
+  return RocksDBIndex::hasSameIndexedValues(Fields(attributes), oldDoc->slice(),
+                                            newDoc->slice());
+}
+
+TEST_CASE("RocksDBIndexUpdate", "[rocksdb][index]") {
+  SECTION("changes to other attributes skip the index") {
+    CHECK(SameValues({"a"}, "{\"_key\":\"1\",\"a\":1,\"b\":1}",
+                     "{\"_key\":\"1\",\"a\":1,\"b\":2}"));
+    CHECK(SameValues({"a", "b.c"}, "{\"a\":\"x\",\"b\":{\"c\":[1,2]}}",
+                     "{\"a\":\"x\",\"b\":{\"c\":[1,2],\"d\":3},\"e\":4}"));
+  }
+
+  SECTION("changes to indexed attributes update the index") {
+    CHECK_FALSE(SameValues({"a"}, "{\"a\":1}", "{\"a\":2}"));
+    CHECK_FALSE(SameValues({"a", "b"}, "{\"a\":1,\"b\":1}",
+                           "{\"a\":1,\"b\":\"1\"}"));
+    CHECK_FALSE(SameValues({"b.c"}, "{\"b\":{\"c\":1}}", "{\"b\":{\"c\":2}}"));
+  }
+
+  SECTION("missing attributes differ from null") {
+    CHECK(SameValues({"a"}, "{\"b\":1}", "{\"b\":2}"));
+    CHECK_FALSE(SameValues({"a"}, "{\"b\":1}", "{\"a\":null,\"b\":1}"));
+    CHECK_FALSE(SameValues({"a"}, "{\"a\":1}", "{}"));
+  }
+
+  SECTION("expanded attributes compare the whole array") {
+    CHECK(SameValues({"tags[*].name"},
+                     "{\"tags\":[{\"name\":\"x\"}],\"other\":1}",
+                     "{\"tags\":[{\"name\":\"x\"}],\"other\":2}"));
+    CHECK_FALSE(SameValues({"tags[*].name"},
+                           "{\"tags\":[{\"name\":\"x\",\"size\":1}]}",
+                           "{\"tags\":[{\"name\":\"x\",\"size\":2}]}"));
+    CHECK_FALSE(SameValues({"tags[*]"}, "{\"tags\":[1,2]}",
+                           "{\"tags\":[2,1]}"));
+  }
+}
+
+}
+}
+}
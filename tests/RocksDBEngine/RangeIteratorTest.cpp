@@ -0,0 +1,268 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for the RocksDB range iterator
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Basics/files.h"
+#include "RocksDBEngine/RocksDBKey.h"
+#include "RocksDBEngine/RocksDBKeyBounds.h"
+#include "RocksDBEngine/RocksDBMethods.h"
+
+#include <rocksdb/db.h>
+#include <rocksdb/options.h>
+#include <rocksdb/utilities/write_batch_with_index.h>
+
+using namespace arangodb;
+
+namespace arangodb {
+namespace tests {
+namespace range_iterator_test {
+
+/// @brief a RocksDB database in a temporary directory
+struct Database {
+  Database() : db(nullptr) {
+    static uint64_t sequence = 0;
+    path = TRI_GetTempPath() + TRI_DIR_SEPARATOR_STR +
+           "rocksdb-test-range-iterator-" + std::to_string(++sequence);
+    rocksdb::Options options;
+    options.create_if_missing = true;
+    REQUIRE(rocksdb::DB::Open(options, path, &db).ok());
+  }
+
+  ~Database() {
+    delete db;
+    TRI_RemoveDirectory(path.c_str());
+  }
+
+  void put(RocksDBKey const& key) {
+    REQUIRE(db->Put(rocksdb::WriteOptions(), key.string(), "").ok());
+  }
+
+  void remove(RocksDBKey const& key) {
+    REQUIRE(db->Delete(rocksdb::WriteOptions(), key.string()).ok());
+  }
+
+  /// @brief moves the data from the memtable into an SST file
+  void flush() { REQUIRE(db->Flush(rocksdb::FlushOptions()).ok()); }
+
+  std::string path;
+  rocksdb::DB* db;
+};
+
+/// @brief reads from the database. Keys written with put() are pending, and
+/// are merged into the iterators like the writes of a transaction
+class Methods final : public RocksDBMethods {
+ public:
+  explicit Methods(rocksdb::DB* db)
+      : RocksDBMethods(nullptr),
+        _db(db),
+        _batch(db->GetOptions().comparator, 0, true),
+        _pending(false) {}
+
+  // the pooled iterators may read from the batch
+  ~Methods() { clearIteratorPool(); }
+
+  rocksdb::ReadOptions const& readOptions() override { return _options; }
+
+  bool hasPendingWrites() const override { return _pending; }
+
+  bool Exists(RocksDBKey const&) override { return false; }
+  arangodb::Result Get(RocksDBKey const&, std::string*) override {
+    return arangodb::Result(TRI_ERROR_NOT_IMPLEMENTED);
+  }
+  arangodb::Result Put(RocksDBKey const& key, rocksdb::Slice const& val,
+                       rocksutils::StatusHint) override {
+    _batch.Put(key.string(), val);
+    _pending = true;
+    return arangodb::Result();
+  }
+  arangodb::Result Delete(RocksDBKey const&) override {
+    return arangodb::Result(TRI_ERROR_NOT_IMPLEMENTED);
+  }
+
+  std::unique_ptr<rocksdb::Iterator> NewIterator(
+      rocksdb::ReadOptions const& options) override {
+    rocksdb::Iterator* iterator = _db->NewIterator(options);
+    if (hasPendingWrites()) {
+      iterator = _batch.NewIteratorWithBase(iterator);
+    }
+    return std::unique_ptr<rocksdb::Iterator>(iterator);
+  }
+
+  void SetSavePoint() override {}
+  arangodb::Result RollbackToSavePoint() override { return arangodb::Result(); }
+
+ private:
+  rocksdb::DB* _db;
+  rocksdb::WriteBatchWithIndex _batch;
+  rocksdb::ReadOptions _options;
+  bool _pending;
+};
+
+static RocksDBKey Key(uint64_t indexId, char const* primaryKey) {
+  return RocksDBKey::PrimaryIndexValue(indexId, primaryKey);
+}
+
+/// @brief the primary keys the iterator visits from its current position
+static std::vector<std::string> Collect(RocksDBRangeIterator& iterator,
+                                        bool reverse) {
+  std::vector<std::string> keys;
+  while (iterator.valid()) {
+    keys.emplace_back(RocksDBKey::primaryKey(iterator->key()).toString());
+    if (reverse) {
+      iterator->Prev();
+    } else {
+      iterator->Next();
+    }
+  }
+  return keys;
+}
+
+TEST_CASE("RocksDBRangeIterator", "[rocksdb][iterator]") {
+  Database database;
+  rocksdb::Comparator const* cmp = database.db->GetOptions().comparator;
+  RocksDBKeyBounds const bounds = RocksDBKeyBounds::PrimaryIndex(2);
+  std::vector<std::string> const inRange{"a", "b", "c"};
+  std::vector<std::string> const inRangeReversed{"c", "b", "a"};
+
+  // the neighbouring ranges are not empty
+  database.put(Key(1, "z"));
+  database.put(Key(2, "a"));
+  database.put(Key(2, "b"));
+  database.put(Key(2, "c"));
+  database.put(Key(3, "a"));
+
+  Methods methods(database.db);
+
+  SECTION("a forward scan returns the first and the last key of the range") {
+    RocksDBRangeIterator iterator(&methods, bounds, false, cmp);
+    iterator.seekToFirst();
+    CHECK(Collect(iterator, false) == inRange);
+  }
+
+  SECTION("a reverse scan returns the last and the first key of the range") {
+    RocksDBRangeIterator iterator(&methods, bounds, true, cmp);
+    iterator.seekToLast();
+    CHECK(Collect(iterator, true) == inRangeReversed);
+  }
+
+  SECTION("scans of flushed data stop at both ends of the range") {
+    database.flush();
+
+    RocksDBRangeIterator forward(&methods, bounds, false, cmp);
+    forward.seekToFirst();
+    CHECK(Collect(forward, false) == inRange);
+
+    RocksDBRangeIterator reverse(&methods, bounds, true, cmp);
+    reverse.seekToLast();
+    CHECK(Collect(reverse, true) == inRangeReversed);
+  }
+
+  SECTION("deleted keys at the ends of the range are skipped") {
+    database.put(Key(2, "d"));
+    database.flush();
+    database.remove(Key(2, "a"));
+    database.remove(Key(2, "d"));
+    database.remove(Key(3, "a"));
+    std::vector<std::string> const remaining{"b", "c"};
+
+    RocksDBRangeIterator forward(&methods, bounds, false, cmp);
+    forward.seekToFirst();
+    CHECK(Collect(forward, false) == remaining);
+
+    RocksDBRangeIterator reverse(&methods, bounds, true, cmp);
+    reverse.seekToLast();
+    CHECK(Collect(reverse, true) ==
+          std::vector<std::string>(remaining.rbegin(), remaining.rend()));
+  }
+
+  SECTION("an empty range is not valid in either direction") {
+    RocksDBKeyBounds const empty = RocksDBKeyBounds::PrimaryIndex(4);
+    RocksDBRangeIterator forward(&methods, empty, false, cmp);
+    forward.seekToFirst();
+    CHECK_FALSE(forward.valid());
+
+    RocksDBRangeIterator reverse(&methods, empty, true, cmp);
+    reverse.seekToLast();
+    CHECK_FALSE(reverse.valid());
+  }
+
+  SECTION("a reverse scan does not leave the range at its end") {
+    RocksDBRangeIterator iterator(&methods, bounds, true, cmp);
+    iterator.seekToLast();
+    REQUIRE(iterator.valid());
+    iterator->Next();
+    CHECK_FALSE(iterator.valid());
+  }
+
+  SECTION("pending writes outside the range are not returned") {
+    REQUIRE(methods.Put(Key(1, "y"), rocksdb::Slice(),
+                        rocksutils::StatusHint::none).ok());
+    REQUIRE(methods.Put(Key(3, "b"), rocksdb::Slice(),
+                        rocksutils::StatusHint::none).ok());
+    REQUIRE(methods.Put(Key(2, "d"), rocksdb::Slice(),
+                        rocksutils::StatusHint::none).ok());
+    std::vector<std::string> const pending{"a", "b", "c", "d"};
+
+    RocksDBRangeIterator forward(&methods, bounds, false, cmp);
+    forward.seekToFirst();
+    CHECK(Collect(forward, false) == pending);
+
+    RocksDBRangeIterator reverse(&methods, bounds, true, cmp);
+    reverse.seekToLast();
+    CHECK(Collect(reverse, true) ==
+          std::vector<std::string>(pending.rbegin(), pending.rend()));
+  }
+
+  SECTION("a reused iterator is bounded by its new range") {
+    {
+      RocksDBRangeIterator iterator(&methods, RocksDBKeyBounds::PrimaryIndex(1),
+                                    false, cmp);
+      iterator.seekToFirst();
+      CHECK(Collect(iterator, false) == std::vector<std::string>{"z"});
+    }
+    // takes the iterator given back to the pool
+    RocksDBRangeIterator iterator(&methods, bounds, false, cmp);
+    iterator.seekToFirst();
+    CHECK(Collect(iterator, false) == inRange);
+
+    iterator.setBounds(RocksDBKeyBounds::PrimaryIndex(3));
+    iterator.seekToFirst();
+    CHECK(Collect(iterator, false) == std::vector<std::string>{"a"});
+  }
+
+  SECTION("a reverse iterator is bounded by its new range") {
+    RocksDBRangeIterator iterator(&methods, RocksDBKeyBounds::PrimaryIndex(1),
+                                  true, cmp);
+    iterator.setBounds(bounds);
+    iterator.seekToLast();
+    CHECK(Collect(iterator, true) == inRangeReversed);
+  }
+}
+
+}
+}
+}
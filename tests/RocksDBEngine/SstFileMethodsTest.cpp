@@ -0,0 +1,166 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for the bulk loads of the RocksDB engine
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Basics/files.h"
+#include "RocksDBEngine/RocksDBKey.h"
+#include "RocksDBEngine/RocksDBMethods.h"
+
+#include <rocksdb/db.h>
+#include <rocksdb/options.h>
+
+using namespace arangodb;
+
+namespace arangodb {
+namespace tests {
+namespace sst_file_methods_test {
+
+/// @brief a RocksDB database in a temporary directory
+struct Database {
+  Database() : db(nullptr) {
+    static uint64_t sequence = 0;
+    path = TRI_GetTempPath() + TRI_DIR_SEPARATOR_STR +
+           "rocksdb-test-sst-file-methods-" + std::to_string(++sequence);
+    rocksdb::Options options;
+    options.create_if_missing = true;
+    REQUIRE(rocksdb::DB::Open(options, path, &db).ok());
+  }
+
+  ~Database() {
+    delete db;
+    TRI_RemoveDirectory(path.c_str());
+  }
+
+  bool contains(RocksDBKey const& key) {
+    std::string value;
+    return db->Get(rocksdb::ReadOptions(), key.string(), &value).ok();
+  }
+
+  /// @brief number of bulk load files which are not ingested
+  size_t pendingFiles() {
+    size_t files = 0;
+    for (auto const& name : TRI_FilesDirectory(path.c_str())) {
+      if (name.compare(0, 9, "bulkload-") == 0) {
+        ++files;
+      }
+    }
+    return files;
+  }
+
+  std::string path;
+  rocksdb::DB* db;
+};
+
+TEST_CASE("RocksDBSstFileMethods", "[rocksdb][bulkload]") {
+  Database database;
+  RocksDBKey const a = RocksDBKey::Document(1, 1);
+  RocksDBKey const b = RocksDBKey::Document(1, 2);
+  RocksDBKey const c = RocksDBKey::Document(1, 3);
+
+  SECTION("data is only visible after it is ingested") {
+    RocksDBSstFileMethods methods(nullptr, database.db);
+    // not in key order
+    REQUIRE(methods.Put(b, rocksdb::Slice("b")).ok());
+    REQUIRE(methods.Put(a, rocksdb::Slice("a")).ok());
+
+    REQUIRE(methods.prepare().ok());
+    CHECK(database.pendingFiles() == 1);
+    CHECK_FALSE(database.contains(a));
+
+    REQUIRE(methods.ingest().ok());
+    CHECK(database.contains(a));
+    CHECK(database.contains(b));
+    CHECK(database.pendingFiles() == 0);
+  }
+
+  SECTION("a discarded file is removed and not ingested") {
+    RocksDBSstFileMethods methods(nullptr, database.db);
+    REQUIRE(methods.Put(a, rocksdb::Slice("a")).ok());
+    REQUIRE(methods.prepare().ok());
+
+    // e.g. the transaction failed to commit
+    methods.discard();
+    CHECK(database.pendingFiles() == 0);
+    CHECK(methods.ingest().ok());
+    CHECK_FALSE(database.contains(a));
+  }
+
+  SECTION("a prepared file is removed with the methods") {
+    {
+      RocksDBSstFileMethods methods(nullptr, database.db);
+      REQUIRE(methods.Put(a, rocksdb::Slice("a")).ok());
+      REQUIRE(methods.prepare().ok());
+      REQUIRE(database.pendingFiles() == 1);
+    }
+    CHECK(database.pendingFiles() == 0);
+    CHECK_FALSE(database.contains(a));
+  }
+
+  SECTION("writes after a savepoint are rolled back") {
+    RocksDBSstFileMethods methods(nullptr, database.db);
+    REQUIRE(methods.Put(a, rocksdb::Slice("a")).ok());
+    methods.SetSavePoint();
+    REQUIRE(methods.Put(b, rocksdb::Slice("b")).ok());
+    REQUIRE(methods.Put(c, rocksdb::Slice("c")).ok());
+    REQUIRE(methods.RollbackToSavePoint().ok());
+    CHECK(methods.RollbackToSavePoint().fail());
+
+    REQUIRE(methods.prepare().ok());
+    REQUIRE(methods.ingest().ok());
+    CHECK(database.contains(a));
+    CHECK_FALSE(database.contains(b));
+    CHECK_FALSE(database.contains(c));
+  }
+
+  SECTION("existing data is neither overwritten nor removed") {
+    RocksDBSstFileMethods methods(nullptr, database.db);
+    REQUIRE(methods.Put(a, rocksdb::Slice("a")).ok());
+    CHECK(methods.Put(a, rocksdb::Slice("x")).errorNumber() ==
+          TRI_ERROR_NOT_IMPLEMENTED);
+    CHECK(methods.Delete(a).errorNumber() == TRI_ERROR_NOT_IMPLEMENTED);
+
+    REQUIRE(database.db->Put(rocksdb::WriteOptions(), b.string(), "b").ok());
+    CHECK(methods.Put(b, rocksdb::Slice("x")).errorNumber() ==
+          TRI_ERROR_NOT_IMPLEMENTED);
+    REQUIRE(methods.prepare().ok());
+    REQUIRE(methods.ingest().ok());
+    std::string value;
+    REQUIRE(database.db->Get(rocksdb::ReadOptions(), b.string(), &value).ok());
+    CHECK(value == "b");
+  }
+
+  SECTION("nothing is written without data") {
+    RocksDBSstFileMethods methods(nullptr, database.db);
+    CHECK(methods.prepare().ok());
+    CHECK(database.pendingFiles() == 0);
+    CHECK(methods.ingest().ok());
+  }
+}
+
+}
+}
+}
@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for the costs of vertex-centric indexes
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Aql/AstNode.h"
+#include "Aql/Variable.h"
+#include "Basics/AttributeNameParser.h"
+#include "Basics/StaticStrings.h"
+#include "Indexes/SimpleAttributeEqualityMatcher.h"
+#include "RocksDBEngine/RocksDBVPackIndex.h"
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+namespace arangodb {
+namespace tests {
+namespace vertex_centric_index_test {
+
+static std::vector<std::vector<AttributeName>> Fields(
+    std::vector<std::string> const& names) {
+  std::vector<std::vector<AttributeName>> fields;
+  for (auto const& name : names) {
+    std::vector<AttributeName> field;
+    TRI_ParseAttributeString(name, field, true);
+    fields.emplace_back(std::move(field));
+  }
+  return fields;
+}
+
+/// @brief an index on `_from` with a fixed selectivity estimate, which the
+/// SimpleAttributeEqualityMatcher sees like the edge index
+class EdgeIndexMock final : public Index {
+ public:
+  explicit EdgeIndexMock(double estimate)
+      : Index(1, nullptr, Fields({StaticStrings::FromString}), false, false),
+        _estimate(estimate) {}
+
+  char const* typeName() const override { return "edge"; }
+  bool allowExpansion() const override { return false; }
+  IndexType type() const override { return TRI_IDX_TYPE_EDGE_INDEX; }
+  bool canBeDropped() const override { return false; }
+  bool isSorted() const override { return false; }
+  bool hasSelectivityEstimate() const override { return true; }
+  double selectivityEstimate(StringRef const* = nullptr) const override {
+    return _estimate;
+  }
+  size_t memory() const override { return 0; }
+  int insert(transaction::Methods*, TRI_voc_rid_t, velocypack::Slice const&,
+             bool) override {
+    return TRI_ERROR_NOT_IMPLEMENTED;
+  }
+  int remove(transaction::Methods*, TRI_voc_rid_t, velocypack::Slice const&,
+             bool) override {
+    return TRI_ERROR_NOT_IMPLEMENTED;
+  }
+  int unload() override { return TRI_ERROR_NO_ERROR; }
+
+ private:
+  double const _estimate;
+};
+
+/// @brief the condition `e._from == value` of an edge lookup, or
+/// `e._from IN [...]` for several vertices
+struct EdgeCondition {
+  explicit EdgeCondition(size_t values) : variable("e", 0) {
+    auto reference = node(aql::NODE_TYPE_REFERENCE);
+    reference->setData(&variable);
+    auto access =
+        node(aql::NODE_TYPE_ATTRIBUTE_ACCESS, aql::VALUE_TYPE_STRING);
+    access->setStringValue(StaticStrings::FromString.c_str(),
+                           StaticStrings::FromString.size());
+    access->addMember(reference);
+
+    aql::AstNode* op;
+    if (values == 1) {
+      op = node(aql::NODE_TYPE_OPERATOR_BINARY_EQ);
+      op->addMember(access);
+      op->addMember(vertex());
+    } else {
+      auto array = node(aql::NODE_TYPE_ARRAY);
+      for (size_t i = 0; i < values; ++i) {
+        array->addMember(vertex());
+      }
+      op = node(aql::NODE_TYPE_OPERATOR_BINARY_IN);
+      op->addMember(access);
+      op->addMember(array);
+    }
+    root = node(aql::NODE_TYPE_OPERATOR_NARY_AND);
+    root->addMember(op);
+  }
+
+  aql::AstNode* node(aql::AstNodeType type,
+                     aql::AstNodeValueType valueType = aql::VALUE_TYPE_NULL) {
+    nodes.emplace_back(new aql::AstNode(type, valueType));
+    return nodes.back().get();
+  }
+
+  aql::AstNode* vertex() {
+    nodes.emplace_back(new aql::AstNode("v/1", 3, aql::VALUE_TYPE_STRING));
+    return nodes.back().get();
+  }
+
+  aql::Variable variable;
+  std::vector<std::unique_ptr<aql::AstNode>> nodes;
+  aql::AstNode* root;
+};
+
+/// @brief costs of the edge index for an edge lookup, as calculated by
+/// RocksDBEdgeIndex::supportsFilterCondition
+static double EdgeIndexCosts(double estimate, size_t values) {
+  EdgeIndexMock index(estimate);
+  EdgeCondition condition(values);
+  SimpleAttributeEqualityMatcher matcher(index.fields());
+  size_t estimatedItems = 0;
+  double estimatedCost = 0.0;
+  REQUIRE(matcher.matchOne(&index, condition.root, &condition.variable, 1000,
+                           estimatedItems, estimatedCost));
+  CHECK(estimatedItems ==
+        (std::max)(static_cast<size_t>(1.0 / estimate),
+                   static_cast<size_t>(1)) * values);
+  return estimatedCost;
+}
+
+static double VertexCentricCosts(double estimate, size_t values) {
+  size_t estimatedItems = 0;
+  double estimatedCost = 0.0;
+  REQUIRE(RocksDBVPackIndex::vertexCentricCosts(estimate, 2, values,
+                                                estimatedItems, estimatedCost));
+  CHECK(estimatedItems ==
+        (std::max)(static_cast<size_t>(1.0 / estimate),
+                   static_cast<size_t>(1)) * values);
+  return estimatedCost;
+}
+
+TEST_CASE("VertexCentricIndex", "[rocksdb][optimizer]") {
+  SECTION("only indexes on edge collections starting with _from or _to") {
+    CHECK(RocksDBVPackIndex::isVertexCentric(Fields({"_from", "type"}),
+                                             TRI_COL_TYPE_EDGE));
+    CHECK(RocksDBVPackIndex::isVertexCentric(Fields({"_to", "type"}),
+                                             TRI_COL_TYPE_EDGE));
+    CHECK_FALSE(RocksDBVPackIndex::isVertexCentric(Fields({"type", "_from"}),
+                                                   TRI_COL_TYPE_EDGE));
+    CHECK_FALSE(RocksDBVPackIndex::isVertexCentric(Fields({"_from", "type"}),
+                                                   TRI_COL_TYPE_DOCUMENT));
+    CHECK_FALSE(RocksDBVPackIndex::isVertexCentric(Fields({"_from[*]"}),
+                                                   TRI_COL_TYPE_EDGE));
+    CHECK_FALSE(
+        RocksDBVPackIndex::isVertexCentric(Fields({}), TRI_COL_TYPE_EDGE));
+  }
+
+  SECTION("a more selective vertex-centric index wins over the edge index") {
+    // 100 edges per vertex, 10 per vertex and type
+    CHECK(VertexCentricCosts(0.1, 1) < EdgeIndexCosts(0.01, 1));
+    // lookups for several vertices
+    CHECK(VertexCentricCosts(0.1, 5) < EdgeIndexCosts(0.01, 5));
+  }
+
+  SECTION("an equally selective vertex-centric index wins") {
+    // all edges of a vertex have the same type
+    CHECK(VertexCentricCosts(0.01, 1) < EdgeIndexCosts(0.01, 1));
+  }
+
+  SECTION("a less selective vertex-centric index loses") {
+    // the estimate of the combined index is based on other vertices
+    CHECK(VertexCentricCosts(0.005, 1) > EdgeIndexCosts(0.01, 1));
+  }
+
+  SECTION("without an estimate the generic costs are used") {
+    size_t estimatedItems = 42;
+    double estimatedCost = 42.0;
+    CHECK_FALSE(RocksDBVPackIndex::vertexCentricCosts(0.0, 2, 1, estimatedItems,
+                                                      estimatedCost));
+    CHECK(estimatedItems == 42);
+    CHECK(estimatedCost == 42.0);
+  }
+}
+
+}
+}
+}
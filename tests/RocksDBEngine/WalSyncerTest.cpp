@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for the group commit of WAL syncs
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+#include "catch.hpp"
+
+#include "RocksDBEngine/RocksDBWalSyncer.h"
+
+#include <thread>
+
+using namespace arangodb;
+
+TEST_CASE("RocksDBWalSyncer", "[rocksdb][walsyncer]") {
+  std::atomic<uint64_t> latest(0);
+  std::atomic<uint64_t> synced(0);
+  std::atomic<bool> fail(false);
+
+  RocksDBWalSyncer syncer(
+      [&]() {
+        if (fail.load()) {
+          return rocksdb::Status::IOError("sync failed");
+        }
+        uint64_t seq = latest.load();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        synced = seq;
+        return rocksdb::Status::OK();
+      },
+      [&]() { return latest.load(); });
+
+  SECTION("a single commit syncs once") {
+    latest = 10;
+    CHECK(syncer.waitForSync(10).ok());
+    CHECK(synced == 10);
+    CHECK(syncer.numberSyncs() == 1);
+
+    // already synced
+    CHECK(syncer.waitForSync(7).ok());
+    CHECK(syncer.numberSyncs() == 1);
+    CHECK(syncer.numberWaits() == 2);
+  }
+
+  SECTION("concurrent commits share syncs") {
+    size_t const n = 32;
+    std::vector<std::thread> threads;
+    std::atomic<size_t> errors(0);
+
+    for (size_t i = 0; i < n; ++i) {
+      threads.emplace_back([&]() {
+        uint64_t seq = ++latest;
+        if (!syncer.waitForSync(seq).ok() || synced.load() < seq) {
+          ++errors;
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    CHECK(errors == 0);
+    CHECK(syncer.numberWaits() == n);
+    CHECK(syncer.numberSyncs() >= 1);
+    CHECK(syncer.numberSyncs() < n);
+  }
+
+  SECTION("a failed sync is reported and retried") {
+    latest = 5;
+    fail = true;
+    CHECK(syncer.waitForSync(5).errorNumber() != TRI_ERROR_NO_ERROR);
+    fail = false;
+    CHECK(syncer.waitForSync(5).ok());
+    CHECK(synced == 5);
+    CHECK(syncer.numberSyncs() == 2);
+  }
+}
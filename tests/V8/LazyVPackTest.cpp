@@ -0,0 +1,248 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for lazy VelocyPack-backed V8 objects
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2017, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "ApplicationFeatures/V8PlatformFeature.h"
+#include "V8/v8-globals.h"
+#include "V8/v8-utils.h"
+#include "V8/v8-vpack.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace arangodb {
+namespace tests {
+namespace lazy_vpack_test {
+
+/// @brief V8 can only be initialized once per process
+static V8PlatformFeature* Platform() {
+  static std::unique_ptr<V8PlatformFeature> platform;
+
+  if (platform == nullptr) {
+    platform.reset(new V8PlatformFeature(nullptr));
+    platform->start();
+  }
+  return platform.get();
+}
+
+/// @brief an isolate with the globals, and a document for lazy objects
+struct LazyContext {
+  explicit LazyContext(std::string const& json)
+      : document(VPackParser::fromJson(json)),
+        isolate(Platform()->createIsolate()) {
+    isolate->Enter();
+    TRI_CreateV8Globals(isolate);
+  }
+
+  ~LazyContext() {
+    TRI_GET_GLOBALS();
+    delete v8g;
+    isolate->SetData(V8PlatformFeature::V8_DATA_SLOT, nullptr);
+    isolate->Exit();
+    isolate->Dispose();
+  }
+
+  std::shared_ptr<VPackBuilder> document;
+  v8::Isolate* isolate;
+};
+
+static v8::Handle<v8::Value> Run(v8::Isolate* isolate,
+                                 std::string const& script) {
+  auto context = isolate->GetCurrentContext();
+  auto compiled =
+      v8::Script::Compile(context, TRI_V8_STD_STRING(script)).ToLocalChecked();
+  return compiled->Run(context).ToLocalChecked();
+}
+
+static bool Check(v8::Isolate* isolate, std::string const& script) {
+  return Run(isolate, script)->IsTrue();
+}
+
+static std::string Keys(v8::Isolate* isolate, std::string const& object) {
+  v8::String::Utf8Value keys(
+      Run(isolate, "Object.keys(" + object + ").join(',')"));
+  return std::string(*keys, keys.length());
+}
+
+TEST_CASE("LazyVPackObject", "[v8][vpack]") {
+  LazyContext lazy(
+      "{\"a\":1,\"sub\":{\"b\":\"x\",\"deep\":{\"c\":true}},"
+      "\"list\":[{\"d\":2},3]}");
+  v8::Isolate* isolate = lazy.isolate;
+  v8::HandleScope scope(isolate);
+  v8::Handle<v8::Context> context = v8::Context::New(isolate);
+  v8::Context::Scope contextScope(context);
+
+  context->Global()->Set(TRI_V8_ASCII_STRING("doc"),
+                         TRI_VPackToV8Lazy(isolate, lazy.document->slice()));
+
+  SECTION("attributes are read") {
+    CHECK(Check(isolate, "doc.a === 1"));
+    CHECK(Check(isolate, "doc.sub.b === 'x'"));
+    CHECK(Check(isolate, "doc.missing === undefined"));
+    CHECK(Check(isolate, "Object.getPrototypeOf(doc) === Object.prototype"));
+  }
+
+  SECTION("nested objects and arrays are accessed") {
+    CHECK(Check(isolate, "doc.sub.deep.c === true"));
+    CHECK(Check(isolate, "Array.isArray(doc.list) && doc.list.length === 2"));
+    CHECK(Check(isolate, "doc.list[0].d === 2 && doc.list[1] === 3"));
+    CHECK(Check(isolate, "doc.sub === doc.sub"));
+  }
+
+  SECTION("changes to nested objects are kept") {
+    Run(isolate, "doc.sub.deep.c = false; doc.list[0].e = 4;");
+    CHECK(Check(isolate, "doc.sub.deep.c === false"));
+    CHECK(Check(isolate, "doc.list[0].e === 4"));
+  }
+
+  SECTION("attributes are enumerated") {
+    CHECK(Keys(isolate, "doc") == "a,sub,list");
+    CHECK(Keys(isolate, "doc.sub") == "b,deep");
+    CHECK(Check(isolate,
+                "var n = []; for (var k in doc) { n.push(k); } "
+                "n.join(',') === 'a,sub,list'"));
+
+    Run(isolate, "doc.z = 5; doc.a = 6;");
+    CHECK(Keys(isolate, "doc") == "a,sub,list,z");
+    CHECK(Check(isolate, "JSON.stringify(doc.sub) === "
+                         "'{\"b\":\"x\",\"deep\":{\"c\":true}}'"));
+  }
+
+  SECTION("the in operator finds attributes") {
+    CHECK(Check(isolate, "'a' in doc"));
+    CHECK(Check(isolate, "'deep' in doc.sub"));
+    CHECK(Check(isolate, "!('missing' in doc)"));
+    CHECK(Check(isolate, "'hasOwnProperty' in doc"));
+    CHECK(Check(isolate, "doc.hasOwnProperty('a')"));
+
+    Run(isolate, "doc.z = 5;");
+    CHECK(Check(isolate, "'z' in doc"));
+  }
+
+  SECTION("attributes are deleted") {
+    Run(isolate, "delete doc.a; delete doc.sub.deep;");
+    CHECK(Check(isolate, "doc.a === undefined && !('a' in doc)"));
+    CHECK(Check(isolate, "!('deep' in doc.sub)"));
+    CHECK(Keys(isolate, "doc") == "sub,list");
+    CHECK(Keys(isolate, "doc.sub") == "b");
+
+    Run(isolate, "doc.a = 7;");
+    CHECK(Check(isolate, "doc.a === 7"));
+    CHECK(Keys(isolate, "doc") == "a,sub,list");
+  }
+
+  SECTION("objects are converted back") {
+    VPackBuilder unmodified;
+    REQUIRE(TRI_V8ToVPack(isolate, unmodified, Run(isolate, "doc.sub.b; doc"),
+                          false) == TRI_ERROR_NO_ERROR);
+    CHECK(unmodified.slice().toJson() == lazy.document->slice().toJson());
+
+    Run(isolate, "delete doc.a; doc.sub.deep.c = 8;");
+    VPackBuilder modified;
+    REQUIRE(TRI_V8ToVPack(isolate, modified, Run(isolate, "doc"), false) ==
+            TRI_ERROR_NO_ERROR);
+    CHECK(modified.slice().get("a").isNone());
+    CHECK(modified.slice().get("sub").get("deep").get("c").getNumber<int>() == 8);
+    CHECK(modified.slice().get("list").length() == 2);
+  }
+
+  SECTION("nested objects are created with the first access") {
+    TRI_GET_GLOBALS();
+    REQUIRE(v8g->JSLazyVPackObjects.size() == 1);
+
+    v8::Handle<v8::Object> doc = Run(isolate, "doc")->ToObject();
+    CHECK(doc->GetInternalField(SLOT_EXTERNAL)->IsUndefined());
+
+    v8::Handle<v8::Object> sub = Run(isolate, "doc.sub")->ToObject();
+    CHECK(v8g->JSLazyVPackObjects.size() == 2);
+    CHECK(doc->GetInternalField(SLOT_EXTERNAL)->IsObject());
+    CHECK(sub->GetInternalField(SLOT_EXTERNAL)->IsUndefined());
+  }
+
+  SECTION("objects are freed along with the globals") {
+    TRI_GET_GLOBALS();
+    Run(isolate, "doc.sub.deep; doc.list[0];");
+    REQUIRE(v8g->JSLazyVPackObjects.size() == 4);
+
+    TRI_FreeLazyVPackObjects(v8g);
+    CHECK(v8g->JSLazyVPackObjects.empty());
+  }
+}
+
+TEST_CASE("LazyVPackObjectIndexNames", "[v8][vpack]") {
+  std::string const json =
+      "{\"a\":1,\"0\":\"zero\",\"123\":{\"x\":1},\"01\":\"padded\"}";
+  LazyContext lazy(json);
+  v8::Isolate* isolate = lazy.isolate;
+  v8::HandleScope scope(isolate);
+  v8::Handle<v8::Context> context = v8::Context::New(isolate);
+  v8::Context::Scope contextScope(context);
+
+  context->Global()->Set(TRI_V8_ASCII_STRING("doc"),
+                         TRI_VPackToV8Lazy(isolate, lazy.document->slice()));
+  context->Global()->Set(TRI_V8_ASCII_STRING("json"), TRI_V8_STD_STRING(json));
+
+  SECTION("attributes with array index names are read") {
+    CHECK(Check(isolate, "doc[0] === 'zero' && doc['0'] === 'zero'"));
+    CHECK(Check(isolate, "doc[123].x === 1"));
+    CHECK(Check(isolate, "doc['01'] === 'padded' && doc[1] === undefined"));
+    CHECK(Check(isolate, "doc[5] === undefined"));
+  }
+
+  SECTION("attributes with array index names are found") {
+    CHECK(Check(isolate, "0 in doc && '123' in doc && !(1 in doc)"));
+    CHECK(Check(isolate, "doc.hasOwnProperty('0') && doc.hasOwnProperty(123)"));
+  }
+
+  SECTION("attributes with array index names are enumerated") {
+    // in the order of an eagerly converted object
+    CHECK(Keys(isolate, "doc") == Keys(isolate, "JSON.parse(json)"));
+    CHECK(Check(isolate,
+                "JSON.stringify(doc) === JSON.stringify(JSON.parse(json))"));
+  }
+
+  SECTION("attributes with array index names are changed") {
+    Run(isolate, "delete doc[0]; doc[7] = 'seven'; doc[123].x = 2;");
+    CHECK(Check(isolate, "!(0 in doc) && doc[7] === 'seven'"));
+    CHECK(Keys(isolate, "doc") == "7,123,a,01");
+
+    VPackBuilder modified;
+    REQUIRE(TRI_V8ToVPack(isolate, modified, Run(isolate, "doc"), false) ==
+            TRI_ERROR_NO_ERROR);
+    CHECK(modified.slice().get("0").isNone());
+    CHECK(modified.slice().get("7").copyString() == "seven");
+    CHECK(modified.slice().get("123").get("x").getNumber<int>() == 2);
+  }
+}
+
+}
+}
+}